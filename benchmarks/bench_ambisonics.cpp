@@ -0,0 +1,125 @@
+#include <gw/core/ambisonics.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr size_t BLOCK_SIZE = 256;
+    constexpr size_t NUM_BLOCKS = 48000 / BLOCK_SIZE * 2; // 2 seconds of audio
+    constexpr size_t NUM_CHANNELS = gw::core::get_ambisonic_channel_count(7);
+    constexpr size_t NUM_SPEAKERS = 32;
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    // Share of one core needed to keep up in real time
+    double core_load(std::chrono::steady_clock::duration elapsed) {
+        const double audio_seconds = static_cast<double>(NUM_BLOCKS * BLOCK_SIZE) / SAMPLE_RATE;
+        return 100.0 * std::chrono::duration<double>(elapsed).count() / audio_seconds;
+    }
+
+    void fill(gw::core::AudioBuffer &buffer) {
+        for (size_t ch = 0; ch < buffer.get_num_channels(); ++ch) {
+            for (size_t i = 0; i < buffer.get_num_samples(); ++i) {
+                buffer.set_sample(ch, i, static_cast<float>(std::sin(0.01 * static_cast<double>(i * (ch + 1)))));
+            }
+        }
+    }
+
+    std::vector<gw::core::BufferView> make_views(gw::core::AudioBuffer &buffer) {
+        std::vector<gw::core::BufferView> views;
+        for (size_t ch = 0; ch < buffer.get_num_channels(); ++ch) views.emplace_back(buffer, ch);
+        return views;
+    }
+
+    // The usual decode: every sample, every output, every input
+    double bench_naive(const float *matrix) {
+        gw::core::AudioBuffer input(NUM_CHANNELS, BLOCK_SIZE);
+        gw::core::AudioBuffer output(NUM_SPEAKERS, BLOCK_SIZE);
+        fill(input);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            for (size_t n = 0; n < BLOCK_SIZE; ++n) {
+                for (size_t o = 0; o < NUM_SPEAKERS; ++o) {
+                    float sum = 0.0f;
+                    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                        sum += matrix[o * NUM_CHANNELS + ch] * input.get_sample(ch, n);
+                    }
+                    output.set_sample(o, n, sum);
+                }
+            }
+            sink = output.get_sample(0, 0);
+        }
+        return core_load(std::chrono::steady_clock::now() - start);
+    }
+
+    double bench_decoder(const float *matrix) {
+        gw::core::AmbisonicDecoder decoder(7, NUM_SPEAKERS);
+        decoder.set_matrix(matrix);
+        gw::core::AudioBuffer input(NUM_CHANNELS, BLOCK_SIZE);
+        gw::core::AudioBuffer output(NUM_SPEAKERS, BLOCK_SIZE);
+        fill(input);
+        std::vector<gw::core::BufferView> inputs = make_views(input);
+        std::vector<gw::core::BufferView> outputs = make_views(output);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            decoder.process(inputs.data(), NUM_CHANNELS, outputs.data(), NUM_SPEAKERS);
+            sink = output.get_sample(0, 0);
+        }
+        return core_load(std::chrono::steady_clock::now() - start);
+    }
+
+    // Head tracking: the orientation changes every block
+    double bench_rotator() {
+        gw::core::AmbisonicRotator rotator(7);
+        rotator.prepare(SAMPLE_RATE, BLOCK_SIZE, NUM_CHANNELS);
+        gw::core::AudioBuffer buffer(NUM_CHANNELS, BLOCK_SIZE);
+        fill(buffer);
+        std::vector<gw::core::BufferView> views = make_views(buffer);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            const auto angle = static_cast<float>(b) * 0.01f;
+            rotator.set_rotation(angle, 0.5f * angle, 0.1f);
+            rotator.process(views.data(), NUM_CHANNELS);
+            sink = buffer.get_sample(0, 0);
+        }
+        return core_load(std::chrono::steady_clock::now() - start);
+    }
+
+    double bench_binaural() {
+        gw::core::BinauralRenderer renderer(7, 128);
+        renderer.use_spherical_head(SAMPLE_RATE);
+        gw::core::AudioBuffer input(NUM_CHANNELS, BLOCK_SIZE);
+        gw::core::AudioBuffer output(2, BLOCK_SIZE);
+        fill(input);
+        std::vector<gw::core::BufferView> inputs = make_views(input);
+        gw::core::BufferView left(output, 0), right(output, 1);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            renderer.process(inputs.data(), NUM_CHANNELS, left, right);
+            sink = output.get_sample(0, 0);
+        }
+        return core_load(std::chrono::steady_clock::now() - start);
+    }
+}
+
+int main() {
+    std::vector<float> matrix(NUM_SPEAKERS * NUM_CHANNELS);
+    for (size_t i = 0; i < matrix.size(); ++i) matrix[i] = static_cast<float>(std::cos(0.37 * static_cast<double>(i)));
+
+    std::printf("=== 7th-order ambisonics (%zu channels), block %zu, %.0f Hz ===\n", NUM_CHANNELS, BLOCK_SIZE,
+                SAMPLE_RATE);
+    std::printf("%-38s %s\n", "stage", "% of one core");
+    std::printf("%-38s %.2f\n", "decode 64 -> 32, per-sample loop", bench_naive(matrix.data()));
+    std::printf("%-38s %.2f\n", "decode 64 -> 32, AmbisonicDecoder", bench_decoder(matrix.data()));
+    std::printf("%-38s %.2f\n", "rotate, new orientation every block", bench_rotator());
+    std::printf("%-38s %.2f\n", "binaural, 128-sample partitions", bench_binaural());
+
+    return 0;
+}
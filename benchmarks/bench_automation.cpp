@@ -0,0 +1,78 @@
+#include <gw/core/automation.h>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 256;
+    constexpr size_t NUM_LANES = 1024;
+    constexpr uint64_t LENGTH = 48000 * 60; // One minute of timeline
+    constexpr size_t NUM_BLOCKS = 48000 * 2 / BLOCK_SIZE; // Two seconds rendered
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    gw::core::AutomationCurve make_curve(size_t num_points, std::mt19937 &rng) {
+        std::uniform_int_distribution<uint64_t> position(0, LENGTH);
+        std::uniform_real_distribution<float> value(0.0f, 1.0f);
+
+        std::vector<gw::core::AutomationPoint> points;
+        for (size_t i = 0; i < num_points; ++i) {
+            points.push_back({position(rng), value(rng)});
+        }
+        return gw::core::AutomationCurve(std::move(points));
+    }
+
+    double ns_per_lane_sample(std::chrono::steady_clock::duration elapsed) {
+        const double samples = static_cast<double>(NUM_BLOCKS * BLOCK_SIZE * NUM_LANES);
+        return std::chrono::duration<double, std::nano>(elapsed).count() / samples;
+    }
+}
+
+int main() {
+    std::printf("=== Automation (%zu lanes, block %zu) ===\n", NUM_LANES, BLOCK_SIZE);
+    std::printf("%-10s %-22s %-16s\n", "points", "method", "ns/lane/sample");
+
+    for (const size_t num_points: {16u, 1000u, 20000u}) {
+        std::mt19937 rng(1);
+        std::vector<gw::core::AutomationCurve> curves;
+        gw::core::AutomationTimeline timeline(NUM_LANES);
+        for (size_t lane = 0; lane < NUM_LANES; ++lane) {
+            curves.push_back(make_curve(num_points, rng));
+            timeline.set_lane(lane, curves.back());
+        }
+
+        // Start where the curves are dense, not before the first breakpoint
+        const uint64_t start_position = LENGTH / 2;
+        std::vector<float> block(BLOCK_SIZE);
+
+        // Binary search for every sample
+        auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            const uint64_t position = start_position + b * BLOCK_SIZE;
+            for (const gw::core::AutomationCurve &curve: curves) {
+                for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                    block[i] = curve.get_value(position + i);
+                }
+                sink = block[0];
+            }
+        }
+        const double search = ns_per_lane_sample(std::chrono::steady_clock::now() - start);
+        std::printf("%-10zu %-22s %-16.3f\n", num_points, "per-sample search", search);
+
+        // Cursor and ramps
+        start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            const uint64_t position = start_position + b * BLOCK_SIZE;
+            for (size_t lane = 0; lane < NUM_LANES; ++lane) {
+                timeline.render(lane, position, gw::core::BufferView(block.data(), BLOCK_SIZE));
+                sink = block[0];
+            }
+        }
+        const double cursor = ns_per_lane_sample(std::chrono::steady_clock::now() - start);
+        std::printf("%-10zu %-22s %-16.3f\n", num_points, "timeline cursor", cursor);
+    }
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <gw/core/dynamics.h>
+#include <gw/core/sliding_window_max.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr size_t BLOCK_SIZE = 256;
+    constexpr size_t NUM_SAMPLES = 48000 * 10; // 10 seconds of audio
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    double ns_per_sample(std::chrono::steady_clock::duration elapsed, size_t samples) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(samples);
+    }
+
+    // What the master bus limiter used to do: rescan the window every sample
+    double bench_naive(const std::vector<float> &input, size_t window) {
+        std::vector<float> history(window, 0.0f);
+        size_t position = 0;
+        float acc = 0.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const float sample: input) {
+            history[position] = sample;
+            if (++position == window) position = 0;
+            acc += *std::max_element(history.begin(), history.end());
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        sink = acc;
+        return ns_per_sample(elapsed, input.size());
+    }
+
+    double bench_deque(const std::vector<float> &input, size_t window) {
+        gw::core::SlidingWindowMax max(window);
+        std::vector<float> output(BLOCK_SIZE);
+        float acc = 0.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset + BLOCK_SIZE <= input.size(); offset += BLOCK_SIZE) {
+            max.process(input.data() + offset, output.data(), BLOCK_SIZE);
+            acc += output[BLOCK_SIZE - 1];
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        sink = acc;
+        return ns_per_sample(elapsed, input.size());
+    }
+
+    double bench_limiter(const std::vector<float> &input, float lookahead_ms, size_t num_channels) {
+        gw::core::LimiterSettings settings;
+        settings.lookahead_ms = lookahead_ms;
+        gw::core::PeakLimiter limiter(settings);
+        limiter.prepare(SAMPLE_RATE, BLOCK_SIZE, num_channels);
+
+        gw::core::AudioBuffer buffer(num_channels, BLOCK_SIZE);
+        std::vector<gw::core::BufferView> views;
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            views.emplace_back(buffer, ch);
+        }
+
+        std::chrono::steady_clock::duration elapsed{};
+        for (size_t offset = 0; offset + BLOCK_SIZE <= input.size(); offset += BLOCK_SIZE) {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                std::copy_n(input.data() + offset, BLOCK_SIZE, buffer.get_channel_data(ch));
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            limiter.process(views.data(), num_channels);
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+
+        sink = buffer.get_sample(0, 0);
+        return ns_per_sample(elapsed, input.size() * num_channels);
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.5f);
+    std::vector<float> input(NUM_SAMPLES);
+    for (auto &sample: input) sample = dist(rng);
+
+    std::printf("=== Lookahead peak detection (%zu samples, block %zu) ===\n", NUM_SAMPLES, BLOCK_SIZE);
+    std::printf("%-12s %-10s %-16s %-16s %-8s\n", "lookahead", "window", "naive ns/smp", "deque ns/smp", "speedup");
+
+    for (const float lookahead_ms: {1.0f, 2.0f, 5.0f, 10.0f}) {
+        const auto window = static_cast<size_t>(lookahead_ms * 0.001f * static_cast<float>(SAMPLE_RATE));
+        const double naive = bench_naive(input, window);
+        const double deque = bench_deque(input, window);
+        std::printf("%-9.1f ms %-10zu %-16.2f %-16.2f %.1fx\n", static_cast<double>(lookahead_ms), window, naive,
+                    deque, naive / deque);
+    }
+
+    std::printf("\n=== PeakLimiter (stereo, linked) ===\n");
+    std::printf("%-12s %-16s\n", "lookahead", "ns/sample/ch");
+    for (const float lookahead_ms: {1.0f, 5.0f, 10.0f}) {
+        std::printf("%-9.1f ms %-16.2f\n", static_cast<double>(lookahead_ms), bench_limiter(input, lookahead_ms, 2));
+    }
+
+    return 0;
+}
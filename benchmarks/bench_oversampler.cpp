@@ -0,0 +1,85 @@
+#include <gw/core/oversampler.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr size_t BLOCK_SIZE = 256;
+    constexpr size_t NUM_CHANNELS = 2;
+    constexpr size_t NUM_BLOCKS = 48000 / BLOCK_SIZE; // 1 second of audio
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    double ns_per_sample(std::chrono::steady_clock::duration elapsed) {
+        const double samples = static_cast<double>(NUM_BLOCKS * BLOCK_SIZE * NUM_CHANNELS);
+        return std::chrono::duration<double, std::nano>(elapsed).count() / samples;
+    }
+
+    // What ad hoc oversampling usually looks like: zero-stuff, then one long
+    // lowpass at the top rate (every tap, zeros included), and the same on
+    // the way down computing every output before dropping most of them
+    double bench_direct(size_t factor, size_t num_taps) {
+        std::vector<float> taps(num_taps, 1.0f / static_cast<float>(num_taps));
+        std::vector<float> up(BLOCK_SIZE * factor + num_taps, 0.0f);
+        std::vector<float> filtered(BLOCK_SIZE * factor + num_taps, 0.0f);
+        std::vector<float> block(BLOCK_SIZE, 0.25f);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                for (size_t n = 0; n < BLOCK_SIZE; ++n) up[num_taps + n * factor] = block[n];
+
+                for (size_t n = 0; n < BLOCK_SIZE * factor; ++n) {
+                    float sum = 0.0f;
+                    for (size_t k = 0; k < num_taps; ++k) sum += taps[k] * up[n + k];
+                    filtered[num_taps + n] = sum;
+                }
+                for (size_t n = 0; n < BLOCK_SIZE * factor; ++n) {
+                    float sum = 0.0f;
+                    for (size_t k = 0; k < num_taps; ++k) sum += taps[k] * filtered[n + k];
+                    if (n % factor == 0) block[n / factor] = sum;
+                }
+            }
+            sink = block[0];
+        }
+        return ns_per_sample(std::chrono::steady_clock::now() - start);
+    }
+
+    double bench_oversampler(size_t factor) {
+        gw::core::Oversampler oversampler(factor, NUM_CHANNELS, BLOCK_SIZE);
+        gw::core::AudioBuffer buffer(NUM_CHANNELS, BLOCK_SIZE);
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            const auto value = static_cast<float>(std::sin(0.05 * static_cast<double>(i)));
+            buffer.set_sample(0, i, value);
+            buffer.set_sample(1, i, value);
+        }
+        gw::core::BufferView views[NUM_CHANNELS] = {{buffer, 0}, {buffer, 1}};
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            oversampler.upsample(views, NUM_CHANNELS);
+            oversampler.downsample(views, NUM_CHANNELS);
+            sink = buffer.get_sample(0, 0);
+        }
+        return ns_per_sample(std::chrono::steady_clock::now() - start);
+    }
+}
+
+int main() {
+    std::printf("=== Oversampling round trip (stereo, block %zu, %.0f Hz) ===\n", BLOCK_SIZE, SAMPLE_RATE);
+    std::printf("%-8s %-10s %-26s %-18s\n", "factor", "latency", "direct FIR ns/sample", "half-band ns/sample");
+
+    for (const size_t factor: {2u, 4u, 8u, 16u}) {
+        // A single filter as steep as the first half-band stage, at the top rate
+        const size_t num_taps = 127 * factor / 2;
+        const double direct = bench_direct(factor, num_taps);
+        const double cascade = bench_oversampler(factor);
+        std::printf("%-8zu %-10zu %-26.2f %-18.2f\n", factor, gw::core::Oversampler::get_latency_for_factor(factor),
+                    direct, cascade);
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <gw/core/external_processor.h>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr size_t NUM_CHANNELS = 8;
+    constexpr size_t BUFFER_SIZE = 256;
+    constexpr size_t TOTAL_SAMPLES = 4 * 1024 * 1024; // Per channel, per measurement
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    // Both processors do the least a real one would: touch every channel
+    class TouchProcessor : public gw::core::Processor {
+    public:
+        void prepare(double, size_t, size_t) override {
+        }
+
+        void process(gw::core::BufferView *channels, size_t num_channels) override {
+            for (size_t ch = 0; ch < num_channels; ++ch) sum += channels[ch][0];
+        }
+
+        float sum = 0.0f;
+    };
+
+    class TouchBlockProcessor : public gw::core::BlockProcessor {
+    public:
+        bool prepare(double, size_t, size_t) override { return true; }
+
+        void process(const gw_process_block &block) override {
+            for (uint32_t ch = 0; ch < block.num_channels; ++ch) sum += block.channels[ch][0];
+        }
+
+        float sum = 0.0f;
+    };
+
+    int32_t create_touch(uint32_t host_abi_version, gw_processor *out) {
+        return gw::core::export_processor(std::make_unique<TouchBlockProcessor>(), host_abi_version, out);
+    }
+
+    double ns_per_block(std::chrono::steady_clock::duration elapsed, size_t block_size) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() /
+               static_cast<double>(TOTAL_SAMPLES / block_size);
+    }
+
+    // The Processor interface: a BufferView per channel, one virtual call per block.
+    // prebuilt measures the call alone, with every view made up front.
+    double bench_virtual(gw::core::AudioBuffer &buffer, size_t block_size, bool prebuilt) {
+        auto owned = std::make_unique<TouchProcessor>();
+        gw::core::Processor *volatile processor = owned.get(); // No devirtualization
+        const size_t num_blocks = BUFFER_SIZE / block_size;
+        std::vector<gw::core::BufferView> views(NUM_CHANNELS * num_blocks);
+        for (size_t b = 0; b < num_blocks; ++b) {
+            for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                views[b * NUM_CHANNELS + ch] = gw::core::BufferView(buffer.get_channel_data(ch) + b * block_size,
+                                                                    block_size);
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t done = 0; done < TOTAL_SAMPLES; done += BUFFER_SIZE) {
+            for (size_t b = 0; b < num_blocks; ++b) {
+                gw::core::BufferView *block = views.data() + (prebuilt ? b * NUM_CHANNELS : 0);
+                if (!prebuilt) {
+                    for (size_t ch = 0; ch < NUM_CHANNELS; ++ch) {
+                        block[ch] = gw::core::BufferView(buffer.get_channel_data(ch) + b * block_size, block_size);
+                    }
+                }
+                processor->process(block, NUM_CHANNELS);
+            }
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        sink = owned->sum;
+        return ns_per_block(elapsed, block_size);
+    }
+
+    // One descriptor per block and one call across the ABI per block, or
+    // (batched) every block of the buffer in one call
+    double bench_abi(gw::core::AudioBuffer &buffer, size_t block_size, bool batched, bool prebuilt) {
+        gw::core::ExternalProcessor external;
+        external.open(create_touch);
+        external.prepare(48000.0, BUFFER_SIZE, NUM_CHANNELS);
+        const size_t num_blocks = BUFFER_SIZE / block_size;
+        gw::core::ProcessBlockBatch batch(num_blocks, NUM_CHANNELS);
+
+        uint64_t position = 0;
+        const auto fill = [&] {
+            batch.clear();
+            for (size_t b = 0; b < num_blocks; ++b) {
+                batch.add_block(buffer, b * block_size, block_size, position);
+                position += block_size;
+            }
+        };
+        if (prebuilt) fill();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t done = 0; done < TOTAL_SAMPLES; done += BUFFER_SIZE) {
+            if (!prebuilt) fill();
+            if (batched) {
+                external.process_batch(batch);
+            } else {
+                for (size_t b = 0; b < num_blocks; ++b) external.process(batch.get_blocks()[b]);
+            }
+        }
+        return ns_per_block(std::chrono::steady_clock::now() - start, block_size);
+    }
+}
+
+int main() {
+    gw::core::AudioBuffer buffer(NUM_CHANNELS, BUFFER_SIZE);
+
+    for (const bool prebuilt: {false, true}) {
+        std::printf("=== %s (%zu channels, near-empty processor) ===\n",
+                    prebuilt ? "Call only, views/descriptors made up front" : "Host loop: build per block + call",
+                    NUM_CHANNELS);
+        std::printf("%-8s %-22s %-22s %-22s\n", "block", "Processor ns/block", "ABI ns/block",
+                    "ABI batched ns/block");
+
+        for (const size_t block_size: {1u, 4u, 16u, 64u}) {
+            const double virtual_call = bench_virtual(buffer, block_size, prebuilt);
+            const double abi = bench_abi(buffer, block_size, false, prebuilt);
+            const double batched = bench_abi(buffer, block_size, true, prebuilt);
+            std::printf("%-8zu %-22.2f %-22.2f %-22.2f\n", block_size, virtual_call, abi, batched);
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <gw/core/graph_snapshot.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr uint32_t NUM_NODES = 2000;
+    constexpr size_t NUM_PARAMETERS = 64;
+    constexpr size_t STATE_BYTES = 4096; // Filter memories, smoothed values, ...
+    constexpr int NUM_RUNS = 20;
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    double elapsed_ms(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Touch every node the way a session start does
+    float walk(const gw::core::GraphSnapshot &snapshot) {
+        float sum = 0.0f;
+        for (size_t node = 0; node < snapshot.get_num_nodes(); ++node) {
+            sum += snapshot.get_parameters(node)[0] + static_cast<float>(snapshot.get_state(node)[0]);
+        }
+        return sum;
+    }
+}
+
+int main() {
+    gw::core::GraphSnapshotWriter writer;
+    std::vector<float> parameters(NUM_PARAMETERS, 0.5f);
+    std::vector<uint8_t> state(STATE_BYTES, 1);
+
+    for (uint32_t i = 0; i < NUM_NODES; ++i) {
+        writer.add_node(i % 16, "node " + std::to_string(i), 2, 2, parameters.data(), parameters.size(),
+                        state.data(), state.size());
+        if (i > 0) writer.connect(i - 1, 0, i, 0);
+        if (i > 1) writer.connect(i - 2, 1, i, 1);
+    }
+
+    const std::string path = "/tmp/gw-bench-snapshot-" + std::to_string(getpid()) + ".gwgs";
+    if (!writer.save(path)) {
+        std::printf("Could not write %s\n", path.c_str());
+        return 1;
+    }
+
+    std::printf("=== Graph snapshot load (%u nodes, %.1f MiB, warm page cache) ===\n", NUM_NODES,
+                static_cast<double>(writer.get_image_size()) / (1024.0 * 1024.0));
+    std::printf("%-28s %-12s\n", "method", "ms");
+
+    gw::core::SnapshotArena arena(writer.get_image_size());
+    double best = 1e9;
+    for (int run = 0; run < NUM_RUNS; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        if (!arena.load(path)) return 1;
+        sink = walk(arena.get_snapshot());
+        best = std::min(best, elapsed_ms(start));
+    }
+    std::printf("%-28s %-12.3f\n", "arena load + walk", best);
+
+    best = 1e9;
+    for (int run = 0; run < NUM_RUNS; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        if (!arena.load(path, true)) return 1;
+        sink = walk(arena.get_snapshot());
+        best = std::min(best, elapsed_ms(start));
+    }
+    std::printf("%-28s %-12.3f\n", "arena load + checksum + walk", best);
+
+    best = 1e9;
+    for (int run = 0; run < NUM_RUNS; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        gw::core::MappedSnapshot mapped;
+        if (!mapped.open(path)) return 1;
+        sink = walk(mapped.get_snapshot());
+        best = std::min(best, elapsed_ms(start));
+    }
+    std::printf("%-28s %-12.3f\n", "mmap + walk", best);
+
+    std::remove(path.c_str());
+    return 0;
+}
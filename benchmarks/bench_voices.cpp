@@ -0,0 +1,133 @@
+#include <gw/core/voice_engine.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr size_t BLOCK_SIZE = 256;
+    constexpr size_t NUM_BLOCKS = 48000 * 5 / BLOCK_SIZE; // 5 seconds of audio
+
+    // Keeps the optimizer from discarding results
+    volatile float sink;
+
+    struct Result {
+        double ns_per_voice_sample;
+        double voices_per_core; // Voices one core sustains in real time
+    };
+
+    Result make_result(std::chrono::steady_clock::duration elapsed, size_t num_voices) {
+        const double samples = static_cast<double>(NUM_BLOCKS * BLOCK_SIZE * num_voices);
+        const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / samples;
+        return {ns, 1e9 / (ns * SAMPLE_RATE)};
+    }
+
+    // What a sampler voice loop looks like without batching: one voice at a
+    // time, scalar polyBLEP saw with a branchy envelope, panned into the mix
+    struct ScalarVoice {
+        float phase = 0.0f;
+        float increment = 0.0f;
+        float level = 0.0f;
+        float gain_left = 0.0f;
+        float gain_right = 0.0f;
+    };
+
+    Result bench_scalar(size_t num_voices) {
+        std::vector<ScalarVoice> voices(num_voices);
+        for (size_t v = 0; v < num_voices; ++v) {
+            const float note = 36.0f + static_cast<float>(v % 60);
+            voices[v].increment = 440.0f * std::exp2((note - 69.0f) / 12.0f) / static_cast<float>(SAMPLE_RATE);
+            voices[v].gain_left = 0.7f / static_cast<float>(num_voices);
+            voices[v].gain_right = 0.7f / static_cast<float>(num_voices);
+        }
+
+        std::vector<float> left(BLOCK_SIZE), right(BLOCK_SIZE);
+        const float attack_step = 1.0f / 240.0f;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            std::fill(left.begin(), left.end(), 0.0f);
+            std::fill(right.begin(), right.end(), 0.0f);
+
+            for (ScalarVoice &voice: voices) {
+                for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                    const float p = voice.phase;
+                    const float dt = voice.increment;
+                    float value = 2.0f * p - 1.0f;
+                    if (p < dt) {
+                        const float t = p / dt;
+                        value -= t + t - t * t - 1.0f;
+                    } else if (p > 1.0f - dt) {
+                        const float t = (p - 1.0f) / dt;
+                        value -= t * t + t + t + 1.0f;
+                    }
+
+                    voice.phase += dt;
+                    if (voice.phase >= 1.0f) voice.phase -= 1.0f;
+                    if (voice.level < 1.0f) voice.level = std::min(1.0f, voice.level + attack_step);
+
+                    left[i] += value * voice.level * voice.gain_left;
+                    right[i] += value * voice.level * voice.gain_right;
+                }
+            }
+            sink = left[0] + right[0];
+        }
+        return make_result(std::chrono::steady_clock::now() - start, num_voices);
+    }
+
+    Result bench_engine(size_t num_voices, gw::core::Waveform waveform, const gw::core::Wavetable *wavetable) {
+        gw::core::VoiceEngineSettings settings;
+        settings.max_voices = num_voices;
+        settings.waveform = waveform;
+        settings.gain = 1.0f / static_cast<float>(num_voices);
+        gw::core::VoiceEngine engine(settings);
+        engine.set_wavetable(wavetable);
+        engine.prepare(SAMPLE_RATE, BLOCK_SIZE, 2);
+
+        for (size_t v = 0; v < num_voices; ++v) {
+            engine.note_on(36.0f + static_cast<float>(v % 60), 1.0f);
+        }
+
+        gw::core::AudioBuffer buffer(2, BLOCK_SIZE);
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+            engine.render(buffer, BLOCK_SIZE);
+            sink = buffer.get_sample(0, 0);
+        }
+        return make_result(std::chrono::steady_clock::now() - start, num_voices);
+    }
+}
+
+int main() {
+    const gw::core::Wavetable wavetable = gw::core::Wavetable::make_saw();
+
+    std::printf("=== Polyphonic voices (stereo, block %zu, %.0f Hz) ===\n", BLOCK_SIZE, SAMPLE_RATE);
+    std::printf("%-8s %-12s %-18s %-16s\n", "voices", "renderer", "ns/voice/sample", "voices/core");
+
+    for (const size_t num_voices: {16u, 64u, 256u}) {
+        const Result scalar = bench_scalar(num_voices);
+        std::printf("%-8zu %-12s %-18.3f %-16.0f\n", num_voices, "scalar saw", scalar.ns_per_voice_sample,
+                    scalar.voices_per_core);
+
+        const struct {
+            const char *name;
+            gw::core::Waveform waveform;
+        } cases[] = {
+            {"saw", gw::core::Waveform::Saw},
+            {"square", gw::core::Waveform::Square},
+            {"triangle", gw::core::Waveform::Triangle},
+            {"sine", gw::core::Waveform::Sine},
+            {"wavetable", gw::core::Waveform::Wavetable},
+        };
+
+        for (const auto &c: cases) {
+            const Result result = bench_engine(num_voices, c.waveform, &wavetable);
+            std::printf("%-8zu %-12s %-18.3f %-16.0f\n", num_voices, c.name, result.ns_per_voice_sample,
+                        result.voices_per_core);
+        }
+    }
+
+    return 0;
+}
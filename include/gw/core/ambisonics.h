@@ -0,0 +1,317 @@
+#ifndef GW_CORE_AMBISONICS_H
+#define GW_CORE_AMBISONICS_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/buffer_view.h"
+#include "gw/core/fft.h"
+#include "gw/core/processor.h"
+
+namespace gw::core {
+    /**
+     *  Highest supported ambisonic order (64 channels).
+     */
+    constexpr size_t AMBISONIC_MAX_ORDER = 7;
+
+    /**
+     *  Number of channels of a full-sphere signal of the given order: (order + 1)^2.
+     */
+    [[nodiscard]] constexpr size_t get_ambisonic_channel_count(size_t order) {
+        return (order + 1) * (order + 1);
+    }
+
+    /**
+     *  Real spherical harmonics for one direction, in the AmbiX convention:
+     *  ACN channel order, SN3D normalization, no Condon-Shortley phase.
+     *
+     *  Directions are in radians. Azimuth is counter-clockwise from the
+     *  front (+x towards +y, the listener's left); elevation is up from the
+     *  horizontal plane.
+     *
+     *  @param coefficients get_ambisonic_channel_count(order) values
+     */
+    void compute_ambisonic_coefficients(size_t order, float azimuth, float elevation, float *coefficients);
+
+    /**
+     *  Per-order max-rE weights, which trade a little localization for
+     *  much smaller side lobes when decoding.
+     *
+     *  @param weights order + 1 values, one per order
+     */
+    void compute_max_re_weights(size_t order, float *weights);
+
+    /**
+     *  Sampling (projection) decoder for a set of directions.
+     *
+     *  Fills a num_directions x get_ambisonic_channel_count(order)
+     *  row-major matrix. The directions should cover the sphere roughly
+     *  evenly: this is the right decoder for regular layouts and for
+     *  virtual speaker sets, not for irregular real rooms (pass a designed
+     *  matrix to AmbisonicDecoder::set_matrix() for those).
+     */
+    void make_sampling_decoder(size_t order, const float *azimuths, const float *elevations,
+                               size_t num_directions, bool max_re, float *matrix);
+
+    /**
+     *  Encodes mono sources into an ambisonic signal.
+     *
+     *  Each source has a direction. When a direction changes the gains
+     *  ramp linearly over the next block, so moving sources don't click.
+     *
+     *  Memory is allocated in the constructor; set_direction() and
+     *  process() are real-time safe and belong on the audio thread.
+     */
+    class AmbisonicEncoder {
+    public:
+        AmbisonicEncoder(size_t order, size_t num_sources);
+
+        [[nodiscard]] size_t get_order() const { return order_; }
+        [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
+        [[nodiscard]] size_t get_num_sources() const { return num_sources_; }
+
+        /**
+         *  Set a source's direction (radians); takes effect over the next block.
+         */
+        void set_direction(size_t source, float azimuth, float elevation);
+
+        /**
+         *  Encode one block.
+         *
+         *  @param sources One view per source, all of the same size
+         *  @param ambisonic Output channels, overwritten; pass fewer than
+         *  get_num_channels() to encode at a lower order
+         */
+        void process(const BufferView *sources, size_t num_sources, BufferView *ambisonic, size_t num_channels);
+
+        /**
+         *  Jump to the current directions without a ramp.
+         */
+        void reset();
+
+    private:
+        size_t order_;
+        size_t num_channels_;
+        size_t num_sources_;
+        std::vector<float> gains_; // num_channels x num_sources, as used by the last block
+        std::vector<float> targets_;
+        std::vector<float> deltas_;
+        std::vector<const float *> inputs_;
+        std::vector<float *> outputs_;
+        bool ramping_;
+    };
+
+    /**
+     *  Rotates an ambisonic signal in place.
+     *
+     *  A rotation of the sound field only mixes channels within an order,
+     *  so the full matrix is block diagonal and each order's
+     *  (2l + 1) x (2l + 1) block is applied on its own: 1 + 9 + 25 + ...
+     *  multiply-adds per sample instead of 64^2 at 7th order.
+     *
+     *  The blocks are rebuilt only when the orientation changes, each
+     *  order's block from the one below it (the Ivanic-Ruedenberg
+     *  recursion), which for 7th order is a few thousand operations. The
+     *  block after a change crossfades from the old matrix to the new one
+     *  per sample.
+     *
+     *  Orientation setters and process() are real-time safe and belong on
+     *  the audio thread; prepare() allocates.
+     */
+    class AmbisonicRotator : public Processor {
+    public:
+        explicit AmbisonicRotator(size_t order);
+
+        [[nodiscard]] size_t get_order() const { return order_; }
+
+        /**
+         *  Rotate the sound field by yaw (about +z), then pitch (about +y),
+         *  then roll (about +x), in radians: R = Rz(yaw) Ry(pitch) Rx(roll).
+         *  A source at direction d is heard at R d.
+         *
+         *  To compensate a tracked head orientation, pass the transpose of
+         *  the head's matrix to set_rotation_matrix().
+         */
+        void set_rotation(float yaw, float pitch, float roll);
+
+        /**
+         *  Set the rotation from a row-major 3x3 matrix acting on (x, y, z).
+         */
+        void set_rotation_matrix(const float *matrix);
+
+        /**
+         *  The current (2l + 1) x (2l + 1) block for order l, row-major.
+         */
+        [[nodiscard]] const float *get_order_matrix(size_t order) const;
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void reset() override;
+
+    private:
+        size_t order_;
+        std::vector<float> matrix_; // All order blocks back to back
+        std::vector<float> previous_; // The blocks the last processed block ended on
+        std::vector<float> deltas_;
+        std::vector<double> rotation_; // Per-order blocks in double while building
+        AudioBuffer scratch_;
+        std::vector<const float *> inputs_;
+        std::vector<float *> outputs_;
+        bool changed_;
+
+        void rebuild(const double *matrix);
+    };
+
+    /**
+     *  Decodes an ambisonic signal to speaker feeds with a decoding matrix.
+     *
+     *  The mix is a matrix multiply over planar blocks: time is tiled so a
+     *  tile of every input channel stays in L1, and each pass over the
+     *  inputs accumulates four outputs at once, vectorized across samples
+     *  (AVX2/AVX-512 chosen at runtime). 64 in / 32 out at 48 kHz uses a
+     *  small fraction of one core.
+     *
+     *  set_matrix() and set_speakers() allocate nothing after construction
+     *  but are not synchronized with process(): call them from the audio
+     *  thread or while it is stopped.
+     */
+    class AmbisonicDecoder {
+    public:
+        AmbisonicDecoder(size_t order, size_t num_outputs);
+
+        [[nodiscard]] size_t get_order() const { return order_; }
+        [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
+        [[nodiscard]] size_t get_num_outputs() const { return num_outputs_; }
+
+        /**
+         *  Use a designed matrix: get_num_outputs() rows of get_num_channels()
+         *  gains, row-major.
+         */
+        void set_matrix(const float *matrix);
+
+        /**
+         *  Use a sampling decoder for speakers at these directions (radians).
+         *
+         *  @param num_speakers Must equal get_num_outputs()
+         */
+        bool set_speakers(const float *azimuths, const float *elevations, size_t num_speakers, bool max_re = true);
+
+        [[nodiscard]] const float *get_matrix() const { return matrix_.data(); }
+
+        /**
+         *  Decode one block.
+         *
+         *  @param ambisonic Input channels; fewer than get_num_channels()
+         *  decodes a lower-order signal with the matching columns
+         *  @param outputs Speaker feeds, overwritten
+         */
+        void process(const BufferView *ambisonic, size_t num_channels, BufferView *outputs, size_t num_outputs);
+
+    private:
+        size_t order_;
+        size_t num_channels_;
+        size_t num_outputs_;
+        std::vector<float> matrix_;
+        std::vector<const float *> inputs_;
+        std::vector<float *> outputs_;
+    };
+
+    /**
+     *  Renders an ambisonic signal to two ears.
+     *
+     *  HRIRs for a set of directions are folded into one filter per
+     *  ambisonic channel and ear (through a sampling decoder), so the cost
+     *  does not depend on how many directions were measured. The filters
+     *  run as uniformly partitioned overlap-save convolution: every
+     *  partition_size samples each channel is transformed once, multiplied
+     *  against every filter partition through a frequency-domain delay
+     *  line, and each ear takes one inverse transform.
+     *
+     *  process() takes blocks of any size; the output is delayed by
+     *  get_latency_samples() (one partition).
+     *
+     *  use_spherical_head() builds HRIRs from a spherical head model
+     *  (interaural delay and head shadow only, no pinna cues), which is
+     *  enough for lateralization and monitoring. Load measured HRIRs with
+     *  set_hrirs() for real externalization. Both allocate and must not
+     *  run concurrently with process(); process() is real-time safe.
+     */
+    class BinauralRenderer {
+    public:
+        /**
+         *  @param partition_size Samples per partition (rounded up to a power of two)
+         *  @param max_hrir_length Longest HRIR set_hrirs() accepts
+         */
+        BinauralRenderer(size_t order, size_t partition_size = 128, size_t max_hrir_length = 512);
+
+        [[nodiscard]] size_t get_order() const { return order_; }
+        [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
+        [[nodiscard]] size_t get_partition_size() const { return partition_size_; }
+        [[nodiscard]] size_t get_latency_samples() const { return partition_size_; }
+
+        /**
+         *  Load HRIRs measured at num_directions directions (radians).
+         *
+         *  @param left, right num_directions impulse responses of length samples each
+         *  @return false if length exceeds max_hrir_length or nothing was given
+         */
+        bool set_hrirs(const float *azimuths, const float *elevations, const float *const *left,
+                       const float *const *right, size_t num_directions, size_t length);
+
+        /**
+         *  Load HRIRs from the built-in spherical head model.
+         */
+        void use_spherical_head(double sample_rate);
+
+        /**
+         *  The time-domain filter for one ambisonic channel and ear (0 left, 1 right).
+         */
+        [[nodiscard]] const float *get_filter(size_t channel, size_t ear) const;
+
+        [[nodiscard]] size_t get_filter_length() const { return filter_length_; }
+
+        /**
+         *  Render one block.
+         *
+         *  @param ambisonic Input channels; missing higher-order channels count as silent
+         */
+        void process(const BufferView *ambisonic, size_t num_channels, BufferView &left, BufferView &right);
+
+        /**
+         *  Clear the convolution state.
+         */
+        void reset();
+
+    private:
+        size_t order_;
+        size_t num_channels_;
+        size_t partition_size_;
+        size_t max_partitions_;
+        size_t num_bins_;
+
+        size_t filter_length_;
+        size_t num_partitions_;
+        std::vector<float> filters_; // Time domain: 2 ears x channels x max_hrir_length
+        std::vector<float> spectra_; // Partitions x ears x channels x (re, im) x bins
+
+        RealFft fft_;
+        std::vector<float> delay_line_; // Partitions x channels x (re, im) x bins
+        size_t head_; // Newest partition in delay_line_
+        size_t active_channels_;
+
+        AudioBuffer input_; // Per channel: previous partition, then the one being filled
+        AudioBuffer output_; // Per ear: the partition being played out
+        size_t position_;
+
+        std::vector<float> time_;
+        std::vector<std::complex<float> > spectrum_;
+        std::vector<float> accumulator_; // (re, im) x bins
+
+        void run_partition();
+    };
+}
+
+#endif //GW_CORE_AMBISONICS_H
@@ -2,8 +2,19 @@
 #define GW_CORE_AUDIO_BUFFER_H
 
 #include <cstddef>
+#include <algorithm>
+#include "gw/core/sample_types.h"
+#include "gw/core/sample_convert.h"
 
 namespace gw::core {
+    /**
+     *  Where an AudioBuffer's samples live.
+     */
+    enum class BufferMemory {
+        Heap, // aligned_alloc per channel
+        HugePages // One huge-page backed mapping for all channels (see rt::allocate_huge_pages)
+    };
+
     /**
      *  A multichannel audio buffer with aligned memory.
      *
@@ -14,41 +25,55 @@ namespace gw::core {
      *
      *  This is the format preferred by most DSP algorithms and SIMD operations
      *
+     *  The sample type is a template parameter. AudioBuffer (float) is the
+     *  default; DoubleAudioBuffer, HalfAudioBuffer and BFloat16AudioBuffer
+     *  are provided for filter state and compact sample storage.
+     *  Use copy_from() to convert between them.
+     *
      *  IMPORTANT: This class allocates memory in the constructor.
      *  DO NOT create AudioBuffer objects in the real-time audio thread!
      *  Create them in advance and reuse them.
      */
-    class AudioBuffer {
+    template<typename T>
+    class BasicAudioBuffer {
+        static_assert(is_sample_type_v<T>, "BasicAudioBuffer requires a gw::core sample type");
+
     public:
+        using sample_type = T;
+
         /**
          *  Create an audio buffer
          *
          *  @param num_channels Number of audio channels
          *  @param num_samples Number of samples per channel
          *
+         *  @param memory Heap, or HugePages for large buffers (fewer TLB misses,
+         *  no first-touch THP splits); falls back to the heap if mapping fails
+         *
          *  Memory is allocated and zero-initialized.
          *  Allocation uses 32-byte alignment for AVX compatibility.
          */
-        AudioBuffer(size_t num_channels, size_t num_samples);
+        BasicAudioBuffer(size_t num_channels, size_t num_samples, BufferMemory memory = BufferMemory::Heap);
 
         /**
          *  Destructor frees aligned memory.
          */
-        ~AudioBuffer();
+        ~BasicAudioBuffer();
 
         // Audio buffers are expensive to copy - disable copy operations
-        AudioBuffer(const AudioBuffer &) = delete;
+        BasicAudioBuffer(const BasicAudioBuffer &) = delete;
 
-        AudioBuffer &operator=(const AudioBuffer &) = delete;
+        BasicAudioBuffer &operator=(const BasicAudioBuffer &) = delete;
 
         // Move operations are allowed (transfer ownership)
-        AudioBuffer(AudioBuffer &&other) noexcept;
+        BasicAudioBuffer(BasicAudioBuffer &&other) noexcept;
 
-        AudioBuffer &operator=(AudioBuffer &&other) noexcept;
+        BasicAudioBuffer &operator=(BasicAudioBuffer &&other) noexcept;
 
         // Accessors
         [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
         [[nodiscard]] size_t get_num_samples() const { return num_samples_; };
+        [[nodiscard]] bool uses_huge_pages() const { return huge_region_ != nullptr; }
 
         /**
          *  Get pointer to a specific channel's data.
@@ -56,18 +81,18 @@ namespace gw::core {
          *  @param channel Channel index (0 to num_channels-1)
          *  @return Pointer to channel data, or null ptr if channel is out of range
          */
-        float *get_channel_data(size_t channel);
+        T *get_channel_data(size_t channel);
 
-        [[nodiscard]] const float *get_channel_data(size_t channel) const;
+        [[nodiscard]] const T *get_channel_data(size_t channel) const;
 
         /**
          *  Get a specific sample from a specific channel
          *
          *  @param channel Channel index
          *  @param sample Sample index
-         *  @return Sample value, or 0.0f if the indices are out of range.
+         *  @return Sample value, or zero if the indices are out of range.
          */
-        [[nodiscard]] float get_sample(size_t channel, size_t sample) const;
+        [[nodiscard]] T get_sample(size_t channel, size_t sample) const;
 
         /**
          *  Set a specific sample in a specific channel
@@ -76,7 +101,7 @@ namespace gw::core {
          *  @param sample Sample index
          *  @param value Sample value
          */
-        void set_sample(size_t channel, size_t sample, float value);
+        void set_sample(size_t channel, size_t sample, T value);
 
         /**
          *  Clear all samples to zero (silence).
@@ -84,6 +109,15 @@ namespace gw::core {
          */
         void clear();
 
+        /**
+         *  Touch every page of every channel so the audio thread never takes
+         *  the first-touch page fault. Contents are preserved.
+         *
+         *  NOT real-time safe. Call after construction (and after
+         *  rt::lock_memory()) before handing the buffer to the audio thread.
+         */
+        void prefault();
+
         /**
          *  Copy data from another buffer.
          *
@@ -95,16 +129,51 @@ namespace gw::core {
          *  This is NOT real-time safe due to potential cache misses
          *  with large buffers, but it's fine for offline processing.
          */
-        void copy_from(const AudioBuffer &source);
+        void copy_from(const BasicAudioBuffer &source);
+
+        /**
+         *  Copy data from a buffer of another sample type, converting on the way.
+         *
+         *  @param source Buffer to copy from
+         *
+         *  Same channel/sample clipping rules as copy_from() above.
+         *  Uses the vectorized convert_samples() paths (F16C/AVX-512 for Half).
+         */
+        template<typename U>
+        void copy_from(const BasicAudioBuffer<U> &source);
 
     private:
         size_t num_channels_;
         size_t num_samples_;
-        float **channel_data_; // Array of pointers to channel data
+        T **channel_data_; // Array of pointers to channel data
+        void *huge_region_; // Backing mapping for BufferMemory::HugePages, else null
+        size_t huge_region_bytes_;
 
         // Helper to free memory
         void free_memory();
     };
+
+    template<typename T>
+    template<typename U>
+    void BasicAudioBuffer<T>::copy_from(const BasicAudioBuffer<U> &source) {
+        const size_t channels_to_copy = std::min(num_channels_, source.get_num_channels());
+        const size_t samples_to_copy = std::min(num_samples_, source.get_num_samples());
+
+        for (size_t ch = 0; ch < channels_to_copy; ++ch) {
+            convert_samples(source.get_channel_data(ch), get_channel_data(ch), samples_to_copy);
+        }
+    }
+
+    // Instantiated in audio_buffer.cpp
+    extern template class BasicAudioBuffer<float>;
+    extern template class BasicAudioBuffer<double>;
+    extern template class BasicAudioBuffer<Half>;
+    extern template class BasicAudioBuffer<BFloat16>;
+
+    using AudioBuffer = BasicAudioBuffer<float>;
+    using DoubleAudioBuffer = BasicAudioBuffer<double>;
+    using HalfAudioBuffer = BasicAudioBuffer<Half>;
+    using BFloat16AudioBuffer = BasicAudioBuffer<BFloat16>;
 }
 
 #endif
@@ -0,0 +1,144 @@
+#ifndef GW_CORE_AUDIO_IO_H
+#define GW_CORE_AUDIO_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/audio_format.h"
+
+namespace gw::core {
+    /**
+     *  Something that produces audio in blocks (a file, a generator, ...).
+     *
+     *  Sources are pulled from worker threads by the OfflineRenderer.
+     *  They are NOT used on the real-time audio thread.
+     */
+    class AudioSource {
+    public:
+        virtual ~AudioSource() = default;
+
+        [[nodiscard]] virtual size_t get_num_channels() const = 0;
+
+        [[nodiscard]] virtual double get_sample_rate() const = 0;
+
+        /**
+         *  Read the next frames into the start of a buffer.
+         *
+         *  @param dest Buffer to fill (frames go to index 0 onwards)
+         *  @param max_frames Maximum frames to read (<= dest.get_num_samples())
+         *  @return Number of frames read, 0 once the source is exhausted
+         */
+        virtual size_t read(AudioBuffer &dest, size_t max_frames) = 0;
+    };
+
+    /**
+     *  Something that consumes audio in blocks.
+     */
+    class AudioSink {
+    public:
+        virtual ~AudioSink() = default;
+
+        /**
+         *  Write frames from a buffer.
+         *
+         *  @param source Buffer to read from
+         *  @param offset First frame to write
+         *  @param num_frames Number of frames to write
+         *  @return true on success
+         */
+        virtual bool write(const AudioBuffer &source, size_t offset, size_t num_frames) = 0;
+    };
+
+    /**
+     *  Reads a headerless interleaved PCM file (see pcm_codec.h for encodings).
+     *
+     *  Check is_open() after construction; a source that failed to open
+     *  behaves as an empty file.
+     */
+    class PcmFileSource : public AudioSource {
+    public:
+        PcmFileSource(const std::string &path, const AudioFormat &format);
+
+        ~PcmFileSource() override;
+
+        PcmFileSource(const PcmFileSource &) = delete;
+
+        PcmFileSource &operator=(const PcmFileSource &) = delete;
+
+        [[nodiscard]] bool is_open() const { return file_ != nullptr; }
+
+        [[nodiscard]] size_t get_num_channels() const override { return format_.get_num_channels(); }
+        [[nodiscard]] double get_sample_rate() const override { return format_.get_sample_rate(); }
+
+        size_t read(AudioBuffer &dest, size_t max_frames) override;
+
+    private:
+        std::FILE *file_;
+        AudioFormat format_;
+        std::vector<uint8_t> scratch_;
+    };
+
+    /**
+     *  Writes a headerless interleaved PCM file (see pcm_codec.h for encodings).
+     */
+    class PcmFileSink : public AudioSink {
+    public:
+        PcmFileSink(const std::string &path, const AudioFormat &format);
+
+        ~PcmFileSink() override;
+
+        PcmFileSink(const PcmFileSink &) = delete;
+
+        PcmFileSink &operator=(const PcmFileSink &) = delete;
+
+        [[nodiscard]] bool is_open() const { return file_ != nullptr; }
+
+        bool write(const AudioBuffer &source, size_t offset, size_t num_frames) override;
+
+    private:
+        std::FILE *file_;
+        AudioFormat format_;
+        std::vector<uint8_t> scratch_;
+    };
+
+    /**
+     *  Plays back the contents of an AudioBuffer (e.g. a preloaded stem).
+     *  The buffer must outlive the source.
+     */
+    class BufferSource : public AudioSource {
+    public:
+        BufferSource(const AudioBuffer &buffer, double sample_rate);
+
+        [[nodiscard]] size_t get_num_channels() const override { return buffer_.get_num_channels(); }
+        [[nodiscard]] double get_sample_rate() const override { return sample_rate_; }
+
+        size_t read(AudioBuffer &dest, size_t max_frames) override;
+
+    private:
+        const AudioBuffer &buffer_;
+        double sample_rate_;
+        size_t position_;
+    };
+
+    /**
+     *  Records into a fixed-size AudioBuffer, dropping anything past its end.
+     *  The buffer must outlive the sink.
+     */
+    class BufferSink : public AudioSink {
+    public:
+        explicit BufferSink(AudioBuffer &buffer);
+
+        bool write(const AudioBuffer &source, size_t offset, size_t num_frames) override;
+
+        [[nodiscard]] size_t get_frames_written() const { return position_; }
+
+    private:
+        AudioBuffer &buffer_;
+        size_t position_;
+    };
+}
+
+#endif //GW_CORE_AUDIO_IO_H
@@ -0,0 +1,168 @@
+#ifndef GW_CORE_AUTOMATION_H
+#define GW_CORE_AUTOMATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gw/core/buffer_view.h"
+
+namespace gw::core {
+    /**
+     *  How the value moves from one breakpoint to the next.
+     */
+    enum class CurveShape : uint8_t {
+        Linear, // Straight line to the next breakpoint
+        Hold // Stay at this value until the next breakpoint
+    };
+
+    /**
+     *  One breakpoint of an automation lane.
+     */
+    struct AutomationPoint {
+        uint64_t position; // In samples from the start of the timeline
+        float value;
+        CurveShape shape = CurveShape::Linear; // Shape of the segment that starts here
+    };
+
+    /**
+     *  Immutable, sorted breakpoint list for one lane.
+     *
+     *  Positions, values and per-segment slopes are kept in separate
+     *  contiguous arrays, so walking the curve touches only what it needs.
+     *  Before the first breakpoint the curve holds the first value, after
+     *  the last one it holds the last value. Breakpoints at the same
+     *  position make a jump; the later one wins.
+     */
+    class AutomationCurve {
+    public:
+        AutomationCurve() = default;
+
+        /**
+         *  @param points Breakpoints in any order (sorted stably by position)
+         */
+        explicit AutomationCurve(std::vector<AutomationPoint> points);
+
+        [[nodiscard]] size_t get_num_points() const { return positions_.size(); }
+        [[nodiscard]] bool empty() const { return positions_.empty(); }
+
+        [[nodiscard]] const uint64_t *get_positions() const { return positions_.data(); }
+        [[nodiscard]] const float *get_values() const { return values_.data(); }
+
+        /**
+         *  Value at a position, by binary search. For random access (UI,
+         *  seeking); playback goes through AutomationTimeline's cursors.
+         */
+        [[nodiscard]] float get_value(uint64_t position) const;
+
+        /**
+         *  Index of the segment containing position: the last breakpoint at or
+         *  before it, or 0 if position is before the first one.
+         */
+        [[nodiscard]] size_t find_segment(uint64_t position) const;
+
+        /**
+         *  Value at a position inside the given segment.
+         */
+        [[nodiscard]] double evaluate(size_t segment, uint64_t position) const;
+
+        /**
+         *  Change per sample inside the given segment (0 for Hold, and before
+         *  the first and after the last breakpoint).
+         */
+        [[nodiscard]] double get_slope(size_t segment, uint64_t position) const;
+
+    private:
+        std::vector<uint64_t> positions_;
+        std::vector<float> values_;
+        std::vector<double> slopes_; // Per sample, per segment; 0 for the last
+    };
+
+    /**
+     *  Sample-accurate automation for many lanes, read from the audio thread.
+     *
+     *  Each lane keeps a cursor on the segment it played last. As long as
+     *  blocks follow each other, finding the segment for the next block is
+     *  a step forward past at most the breakpoints that block crossed, so
+     *  lookups are O(1) amortized; any jump in position (seek, loop) falls
+     *  back to one binary search. Segments are rendered as ramps straight
+     *  into the destination BufferView with SIMD (runtime AVX2/AVX-512
+     *  dispatch).
+     *
+     *  Lanes can be replaced while playing without locks. set_lane() is
+     *  called from one control thread: it publishes a heap-allocated curve
+     *  through an atomic pointer, and the audio thread swaps it in at the
+     *  start of its next render call for that lane. The curve it replaced is
+     *  handed back through a second atomic pointer and freed on the control
+     *  thread by the next set_lane() or collect_garbage(); the audio thread
+     *  never allocates or frees. Until the previous replacement has been
+     *  collected, a newer one waits.
+     */
+    class AutomationTimeline {
+    public:
+        explicit AutomationTimeline(size_t num_lanes);
+
+        ~AutomationTimeline();
+
+        AutomationTimeline(const AutomationTimeline &) = delete;
+
+        AutomationTimeline &operator=(const AutomationTimeline &) = delete;
+
+        [[nodiscard]] size_t get_num_lanes() const { return num_lanes_; }
+
+        /**
+         *  Control thread: replace a lane's curve. An empty curve clears the lane.
+         *
+         *  @return false if lane is out of range
+         */
+        bool set_lane(size_t lane, AutomationCurve curve);
+
+        /**
+         *  Control thread: free curves the audio thread has swapped out.
+         */
+        void collect_garbage();
+
+        /**
+         *  Audio thread: render a lane's values for output.size() samples
+         *  starting at position.
+         *
+         *  @return false (and output untouched) if the lane has no automation
+         */
+        bool render(size_t lane, uint64_t position, BufferView output);
+
+        /**
+         *  Audio thread: render lanes 0 to num_outputs - 1 into one view each.
+         *
+         *  @return Number of lanes that had automation
+         */
+        size_t render(uint64_t position, BufferView *outputs, size_t num_outputs);
+
+        /**
+         *  Audio thread: a lane's value at position, moving its cursor there.
+         *  For parameters that are only updated once per block.
+         *
+         *  @return false (and value untouched) if the lane has no automation
+         */
+        bool get_value(size_t lane, uint64_t position, float &value);
+
+    private:
+        struct Lane {
+            std::atomic<AutomationCurve *> pending{nullptr}; // Control -> audio
+            std::atomic<AutomationCurve *> retired{nullptr}; // Audio -> control
+
+            // Audio thread only
+            AutomationCurve *current = nullptr;
+            size_t segment = 0;
+            uint64_t next_position = 0; // Where the cursor expects the next block
+        };
+
+        size_t num_lanes_;
+        std::vector<Lane> lanes_;
+
+        Lane *acquire(size_t lane);
+
+        static void move_cursor(Lane &lane, uint64_t position);
+    };
+}
+
+#endif //GW_CORE_AUTOMATION_H
@@ -2,14 +2,19 @@
 #define GW_CORE_BUFFER_VIEW_H
 
 #include <cstddef>
+#include <algorithm>
+#include "gw/core/sample_types.h"
+#include "gw/core/sample_convert.h"
 
 namespace gw::core {
     // Forward declaration
-    class AudioBuffer;
+    template<typename T>
+    class BasicAudioBuffer;
     /**
         *  A non-owning view into an audio buffer or channel.
         *
-        *  This is like std::span<float> but with channel awareness.
+        *  This is like std::span<T> but with channel awareness.
+        *  BufferView (float) is the default sample type.
         *
         *  BufferView is cheap to copy (just like pointers and sizes).
         *  It does NOT own the memory - the underlying buffer must
@@ -17,12 +22,17 @@ namespace gw::core {
         *
         *  This is real-time safe (no allocations).
         */
-    class BufferView {
+    template<typename T>
+    class BasicBufferView {
+        static_assert(is_sample_type_v<T>, "BasicBufferView requires a gw::core sample type");
+
     public:
+        using sample_type = T;
+
         /**
          *  Construct an empty view.
          */
-        BufferView();
+        BasicBufferView();
 
         /**
          *  Construct a view of a single channel.
@@ -30,7 +40,7 @@ namespace gw::core {
          *  @param data Pointer to sample data
          *  @param num_samples Number of samples
          */
-        BufferView(float *data, size_t num_samples);
+        BasicBufferView(T *data, size_t num_samples);
 
         /**
          *  Construct a view from an AudioBuffer channel.
@@ -38,26 +48,26 @@ namespace gw::core {
          *  @param buffer Buffer to view
          *  @param channel Channel index
          */
-        BufferView(AudioBuffer &buffer, size_t channel);
+        BasicBufferView(BasicAudioBuffer<T> &buffer, size_t channel);
 
         // Default copy/move - all cheap
-        BufferView(const BufferView &) = default;
+        BasicBufferView(const BasicBufferView &) = default;
 
-        BufferView &operator=(const BufferView &) = default;
+        BasicBufferView &operator=(const BasicBufferView &) = default;
 
-        BufferView(BufferView &&) = default;
+        BasicBufferView(BasicBufferView &&) = default;
 
-        BufferView &operator=(BufferView &&) = default;
+        BasicBufferView &operator=(BasicBufferView &&) = default;
 
         // Accessors
-        float *data() { return data_; }
-        [[nodiscard]] const float *data() const { return data_; }
+        T *data() { return data_; }
+        [[nodiscard]] const T *data() const { return data_; }
         [[nodiscard]] size_t size() const { return num_samples_; }
         [[nodiscard]] bool empty() const { return num_samples_ == 0 || data_ == nullptr; }
 
         // Array-like access
-        float &operator[](size_t index) { return data_[index]; }
-        const float &operator[](size_t index) const { return data_[index]; }
+        T &operator[](size_t index) { return data_[index]; }
+        const T &operator[](size_t index) const { return data_[index]; }
 
         /**
          *  Get a sub-view (slice) of this view.
@@ -66,13 +76,13 @@ namespace gw::core {
          *  @param count Number of samples (or 0 for "rest of buffer")
          *  @return View of the subrange
          */
-        [[nodiscard]] BufferView subview(size_t offset, size_t count = 0) const;
+        [[nodiscard]] BasicBufferView subview(size_t offset, size_t count = 0) const;
 
         /**
          *  Fill with a constant value.
          *  Real-time safe.
          */
-        void fill(float value);
+        void fill(T value);
 
         /**
          *  Clear to zero (silence).
@@ -80,10 +90,38 @@ namespace gw::core {
          */
         void clear();
 
+        /**
+         *  Copy samples from another view, converting the sample type if needed.
+         *
+         *  @param source View to copy from
+         *
+         *  Copies min(this->size(), source.size()) samples.
+         *  Real-time safe.
+         */
+        template<typename U>
+        void copy_from(const BasicBufferView<U> &source);
+
     private:
-        float *data_;
+        T *data_;
         size_t num_samples_;
     };
+
+    template<typename T>
+    template<typename U>
+    void BasicBufferView<T>::copy_from(const BasicBufferView<U> &source) {
+        convert_samples(source.data(), data_, std::min(num_samples_, source.size()));
+    }
+
+    // Instantiated in buffer_view.cpp
+    extern template class BasicBufferView<float>;
+    extern template class BasicBufferView<double>;
+    extern template class BasicBufferView<Half>;
+    extern template class BasicBufferView<BFloat16>;
+
+    using BufferView = BasicBufferView<float>;
+    using DoubleBufferView = BasicBufferView<double>;
+    using HalfBufferView = BasicBufferView<Half>;
+    using BFloat16BufferView = BasicBufferView<BFloat16>;
 }
 
 #endif //GW_CORE_BUFFER_VIEW_H
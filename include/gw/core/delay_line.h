@@ -0,0 +1,204 @@
+#ifndef GW_CORE_DELAY_LINE_H
+#define GW_CORE_DELAY_LINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/processor.h"
+
+namespace gw::core {
+    /**
+     *  How a DelayLine reads between samples.
+     */
+    enum class DelayInterpolation {
+        None, // Round to the nearest whole sample
+        Linear, // 2-point, any delay >= 0
+        Lagrange3, // 4-point third-order Lagrange, delay >= 1; less HF loss than linear
+        Allpass // First-order allpass, delay >= 1; flat magnitude, for fixed or slowly moving delays
+    };
+
+    /**
+     *  Multichannel delay line on a power-of-two circular AudioBuffer.
+     *
+     *  Every sample is stored twice, at i and i + size, so any window of up to
+     *  `size` samples is contiguous in memory. Block reads therefore never
+     *  wrap, and a multi-tap read is a handful of straight loops over
+     *  contiguous data that the compiler vectorizes.
+     *
+     *  Usage per block:
+     *      write() each channel, then read()/read_taps() any number of
+     *      times, then advance() once.
+     *
+     *  A read with delay D returns output[i] = x[t + i - D], where t is the
+     *  time of the first sample written in this block.
+     *
+     *  Memory is allocated in the constructor; everything else is real-time safe.
+     */
+    class DelayLine {
+    public:
+        /**
+         *  @param num_channels Number of channels
+         *  @param max_delay Longest delay that will be read, in samples
+         *  @param max_block_size Largest block passed to write()/read()
+         */
+        DelayLine(size_t num_channels, size_t max_delay, size_t max_block_size);
+
+        [[nodiscard]] size_t get_num_channels() const { return buffer_.get_num_channels(); }
+        [[nodiscard]] size_t get_max_delay() const { return max_delay_; }
+        [[nodiscard]] size_t get_max_block_size() const { return max_block_size_; }
+
+        /**
+         *  Clear the history to silence.
+         */
+        void reset();
+
+        /**
+         *  Write a block of input for one channel at the current position.
+         */
+        void write(size_t channel, const float *input, size_t count);
+
+        /**
+         *  Read a block at a fixed delay.
+         *
+         *  @param channel Channel to read
+         *  @param delay Delay in samples (clamped to the interpolation's minimum and get_max_delay())
+         *  @param output Destination, count samples
+         *  @param count Number of samples (<= max_block_size)
+         *  @param interpolation How to read fractional delays
+         */
+        void read(size_t channel, float delay, float *output, size_t count,
+                  DelayInterpolation interpolation = DelayInterpolation::Linear);
+
+        /**
+         *  Read a block with a per-sample delay (chorus, flanger, Doppler).
+         *  Allpass falls back to Linear here.
+         *
+         *  @param delays count delays in samples, one per output sample
+         */
+        void read_modulated(size_t channel, const float *delays, float *output, size_t count,
+                            DelayInterpolation interpolation = DelayInterpolation::Linear) const;
+
+        /**
+         *  Sum several fixed-delay taps into a block.
+         *
+         *  @param delays num_taps delays in samples
+         *  @param gains num_taps linear gains
+         *  @param output Destination, count samples (overwritten)
+         *
+         *  Allpass falls back to Lagrange3 (allpass taps would each need state).
+         */
+        void read_taps(size_t channel, const float *delays, const float *gains, size_t num_taps,
+                       float *output, size_t count,
+                       DelayInterpolation interpolation = DelayInterpolation::Linear) const;
+
+        /**
+         *  Move the write position forward after all channels were written.
+         */
+        void advance(size_t count);
+
+        /**
+         *  Convenience: delay channels in place by a fixed amount.
+         *  Equivalent to write() + read() per channel, then advance().
+         */
+        void process(BufferView *channels, size_t num_channels, float delay,
+                     DelayInterpolation interpolation = DelayInterpolation::Linear);
+
+    private:
+        AudioBuffer buffer_; // 2 * size_ samples per channel (mirrored)
+        size_t size_;
+        size_t mask_;
+        size_t max_delay_;
+        size_t max_block_size_;
+        uint64_t position_;
+
+        // Allpass interpolation state per channel
+        std::vector<float> allpass_state_;
+
+        // Pointer to the sample at absolute time `time` (contiguous for up to size_ samples)
+        [[nodiscard]] const float *at(size_t channel, uint64_t time) const;
+
+        [[nodiscard]] float clamp_delay(float delay, DelayInterpolation interpolation) const;
+    };
+
+    /**
+     *  A fixed whole-sample delay as a Processor, for latency compensation.
+     *
+     *  Reports its delay as latency so chains containing it add up correctly.
+     */
+    class CompensationDelay : public Processor {
+    public:
+        explicit CompensationDelay(size_t delay = 0);
+
+        /**
+         *  Change the delay. NOT real-time safe: takes effect at the next prepare().
+         */
+        void set_delay(size_t delay) { delay_ = delay; }
+
+        [[nodiscard]] size_t get_delay() const { return delay_; }
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void reset() override;
+
+        [[nodiscard]] size_t get_latency_samples() const override { return delay_; }
+
+    private:
+        size_t delay_;
+        size_t prepared_delay_;
+        std::unique_ptr<DelayLine> line_; // Null while the delay is zero
+    };
+
+    /**
+     *  Lines up parallel processing paths that report different latencies.
+     *
+     *  Each registered chain gets a CompensationDelay appended to it. update()
+     *  asks every chain for its latency (excluding the compensation itself)
+     *  and sets each compensation delay to (longest latency - own latency).
+     *
+     *  Call update() then prepare() the chains whenever a processor's reported
+     *  latency changes. NOT real-time safe.
+     */
+    class LatencyCompensator {
+    public:
+        /**
+         *  Register a parallel path. The compensator appends a CompensationDelay
+         *  to the chain; the chain must outlive the compensator.
+         *
+         *  @return Index of the path
+         */
+        size_t add_path(ProcessorChain &chain);
+
+        /**
+         *  Recompute the delays from the chains' reported latencies.
+         *
+         *  @return The common latency of every path after compensation
+         */
+        size_t update();
+
+        [[nodiscard]] size_t get_num_paths() const { return paths_.size(); }
+
+        /**
+         *  The compensation delay currently assigned to a path.
+         */
+        [[nodiscard]] size_t get_path_delay(size_t path) const;
+
+    private:
+        struct Path {
+            ProcessorChain *chain;
+            CompensationDelay *delay;
+        };
+
+        std::vector<Path> paths_;
+    };
+
+    /**
+     *  Delays needed to line up paths with the given latencies: max - latency.
+     */
+    std::vector<size_t> compute_compensation_delays(const std::vector<size_t> &latencies);
+}
+
+#endif //GW_CORE_DELAY_LINE_H
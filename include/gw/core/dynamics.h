@@ -0,0 +1,182 @@
+#ifndef GW_CORE_DYNAMICS_H
+#define GW_CORE_DYNAMICS_H
+
+#include <cstddef>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/processor.h"
+#include "gw/core/sliding_window_max.h"
+
+namespace gw::core {
+    /**
+     *  How a multichannel dynamics processor derives its gain.
+     */
+    enum class ChannelLink {
+        Linked, // One gain from the loudest channel, applied to all (keeps the stereo image)
+        Independent // Each channel has its own detector and gain
+    };
+
+    /**
+     *  Shared machinery for lookahead dynamics processors.
+     *
+     *  Per block:
+     *      1. detector input = |x| (max across channels when linked)
+     *      2. peak = max over the lookahead window (SlidingWindowMax, O(1) per sample)
+     *      3. gain = compute_gain(peak) - implemented by the subclass
+     *      4. output = input delayed by the lookahead * gain
+     *
+     *  Steps 1 and 4 are straight loops over whole blocks that the compiler
+     *  vectorizes; only the envelope recursion in step 3 runs sample by sample.
+     */
+    class DynamicsProcessor : public Processor {
+    public:
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void reset() override;
+
+        /**
+         *  The signal is delayed by the lookahead window.
+         */
+        [[nodiscard]] size_t get_latency_samples() const override { return window_ - 1; }
+
+        /**
+         *  Largest gain reduction applied during the last block, in dB (<= 0).
+         *  Intended for metering.
+         */
+        [[nodiscard]] float get_gain_reduction_db() const { return gain_reduction_db_; }
+
+    protected:
+        DynamicsProcessor(float lookahead_ms, ChannelLink link);
+
+        [[nodiscard]] double get_sample_rate() const { return sample_rate_; }
+        [[nodiscard]] size_t get_window() const { return window_; }
+        [[nodiscard]] size_t get_num_detectors() const { return detectors_.size(); }
+
+        /**
+         *  Allocate per-detector state. Called from prepare().
+         */
+        virtual void prepare_detectors(size_t num_detectors) = 0;
+
+        /**
+         *  Clear per-detector state. Called from reset() and after prepare().
+         */
+        virtual void reset_detectors() = 0;
+
+        /**
+         *  Turn windowed peak levels into linear gains, in place.
+         *
+         *  @param levels Windowed peak level per sample on input, gain on output
+         *  @param count Number of samples
+         *  @param detector Detector index (always 0 when linked)
+         */
+        virtual void compute_gain(float *levels, size_t count, size_t detector) = 0;
+
+    private:
+        float lookahead_ms_;
+        ChannelLink link_;
+        double sample_rate_;
+        size_t window_; // Lookahead window in samples (latency + 1)
+
+        std::vector<SlidingWindowMax> detectors_;
+        AudioBuffer detector_buffer_; // One channel per detector, max_block_size long
+        AudioBuffer delay_buffer_; // One power-of-two ring per audio channel
+        size_t delay_mask_;
+        size_t delay_write_;
+        float gain_reduction_db_;
+    };
+
+    /**
+     *  Settings for PeakLimiter.
+     */
+    struct LimiterSettings {
+        float ceiling_db = -0.3f;
+        float lookahead_ms = 5.0f;
+        float release_ms = 80.0f;
+        ChannelLink link = ChannelLink::Linked;
+    };
+
+    /**
+     *  Brickwall peak limiter with lookahead.
+     *
+     *  The gain needed for each sample is held over the lookahead window and
+     *  then smoothed with a moving average of the same length, so the gain
+     *  ramps down ahead of a peak and reaches the required value exactly when
+     *  the (delayed) peak arrives. No sample leaves above the ceiling.
+     */
+    class PeakLimiter : public DynamicsProcessor {
+    public:
+        explicit PeakLimiter(const LimiterSettings &settings = LimiterSettings());
+
+        /**
+         *  Change the ceiling / release. Call from the audio thread or while stopped.
+         */
+        void set_ceiling_db(float ceiling_db);
+
+        void set_release_ms(float release_ms);
+
+    protected:
+        void prepare_detectors(size_t num_detectors) override;
+
+        void reset_detectors() override;
+
+        void compute_gain(float *levels, size_t count, size_t detector) override;
+
+    private:
+        float ceiling_;
+        float release_ms_;
+        float release_coeff_;
+
+        std::vector<float> release_state_;
+        AudioBuffer average_history_; // Moving-average ring per detector, one window long
+        std::vector<double> average_sum_;
+        size_t average_position_;
+    };
+
+    /**
+     *  Settings for Compressor.
+     */
+    struct CompressorSettings {
+        float threshold_db = -18.0f;
+        float ratio = 4.0f;
+        float knee_db = 6.0f;
+        float attack_ms = 5.0f;
+        float release_ms = 120.0f;
+        float makeup_db = 0.0f;
+        float lookahead_ms = 0.0f;
+        ChannelLink link = ChannelLink::Linked;
+    };
+
+    /**
+     *  Feed-forward peak compressor with soft knee and optional lookahead.
+     */
+    class Compressor : public DynamicsProcessor {
+    public:
+        explicit Compressor(const CompressorSettings &settings = CompressorSettings());
+
+        /**
+         *  Change the settings except lookahead and linking, which are fixed
+         *  at construction. Call from the audio thread or while stopped.
+         */
+        void set_settings(const CompressorSettings &settings);
+
+    protected:
+        void prepare_detectors(size_t num_detectors) override;
+
+        void reset_detectors() override;
+
+        void compute_gain(float *levels, size_t count, size_t detector) override;
+
+    private:
+        CompressorSettings settings_;
+        float attack_coeff_;
+        float release_coeff_;
+
+        std::vector<float> envelope_;
+
+        void update_coefficients();
+    };
+}
+
+#endif //GW_CORE_DYNAMICS_H
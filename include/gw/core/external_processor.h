@@ -0,0 +1,215 @@
+#ifndef GW_CORE_EXTERNAL_PROCESSOR_H
+#define GW_CORE_EXTERNAL_PROCESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/buffer_view.h"
+#include "gw/core/processor.h"
+#include "gw/core/processor_abi.h"
+
+namespace gw::core {
+    /**
+     *  Block descriptors for one call across the processor ABI.
+     *
+     *  Holds a run of consecutive gw_process_block descriptors together
+     *  with the channel pointer arrays, events and parameter changes they
+     *  point into. Capacity is fixed at construction, so filling a batch
+     *  on the audio thread never allocates: adding past a limit fails.
+     *
+     *  Events and parameter changes go to the most recently added block
+     *  and must be added in sample order.
+     */
+    class ProcessBlockBatch {
+    public:
+        ProcessBlockBatch(size_t max_blocks, size_t max_channels, size_t max_events = 256,
+                          size_t max_parameter_changes = 256);
+
+        [[nodiscard]] size_t get_max_blocks() const { return max_blocks_; }
+        [[nodiscard]] size_t get_max_channels() const { return max_channels_; }
+
+        /**
+         *  Remove every block, event and parameter change.
+         */
+        void clear();
+
+        /**
+         *  Append a block over samples [offset, offset + num_samples) of every channel of buffer.
+         *
+         *  @return false if the batch is full, the buffer has too many
+         *  channels or the range runs past its end
+         */
+        bool add_block(AudioBuffer &buffer, size_t offset, size_t num_samples, uint64_t sample_position,
+                       uint32_t flags = 0);
+
+        /**
+         *  Append a block over channel memory the host manages itself.
+         */
+        bool add_block(float *const *channels, size_t num_channels, size_t num_samples, uint64_t sample_position,
+                       uint32_t flags = 0);
+
+        /**
+         *  Add an event to the last block.
+         *
+         *  @return false without a block, when full, or if the event lies
+         *  outside the block or before the previous event
+         */
+        bool add_event(const gw_event &event);
+
+        bool add_parameter_change(uint32_t sample_offset, uint32_t parameter_id, float value);
+
+        [[nodiscard]] size_t size() const { return num_blocks_; }
+        [[nodiscard]] bool empty() const { return num_blocks_ == 0; }
+        [[nodiscard]] const gw_process_block *get_blocks() const { return blocks_.data(); }
+
+    private:
+        size_t max_blocks_;
+        size_t max_channels_;
+        size_t num_blocks_;
+        size_t num_events_;
+        size_t num_parameter_changes_;
+        std::vector<gw_process_block> blocks_;
+        std::vector<float *> channels_; // max_channels slots per block
+        std::vector<gw_event> events_;
+        std::vector<gw_parameter_change> parameter_changes_;
+    };
+
+    /**
+     *  Host side of the processor ABI: owns one processor instance behind a
+     *  gw_processor table and drives it.
+     *
+     *  It is also a Processor, so an external processor can sit in a
+     *  ProcessorChain; that path builds a single descriptor from the views
+     *  (no events). Hosts that have events, parameter changes or several
+     *  blocks ready call process(const gw_process_block &) or
+     *  process_batch() directly, which cross the boundary once per call.
+     *  Processors without process_batch() get one process() call per block.
+     */
+    class ExternalProcessor : public Processor {
+    public:
+        ExternalProcessor() = default;
+
+        ~ExternalProcessor() override;
+
+        ExternalProcessor(const ExternalProcessor &) = delete;
+
+        ExternalProcessor &operator=(const ExternalProcessor &) = delete;
+
+        /**
+         *  Create an instance through a processor library's entry point.
+         *
+         *  @return false if it failed, speaks another ABI version or left
+         *  required entry points empty
+         */
+        bool open(gw_create_processor_fn create);
+
+        /**
+         *  Take ownership of an instance whose table is already filled in.
+         *  A shorter table from an older processor is accepted as long as it
+         *  reaches destroy; the optional entry points it lacks count as NULL.
+         *  On failure nothing is taken (the caller still owns the instance).
+         */
+        bool open(const gw_processor &processor);
+
+        /**
+         *  Destroy the instance. NOT real-time safe.
+         */
+        void close();
+
+        [[nodiscard]] bool is_open() const { return processor_.instance != nullptr; }
+        [[nodiscard]] bool is_prepared() const { return prepared_; }
+        [[nodiscard]] bool supports_batch() const { return processor_.process_batch != nullptr; }
+
+        /**
+         *  Calls the processor's prepare(); process calls are ignored until one succeeds.
+         */
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void process(const gw_process_block &block);
+
+        void process_batch(const gw_process_block *blocks, size_t num_blocks);
+
+        void process_batch(const ProcessBlockBatch &batch) { process_batch(batch.get_blocks(), batch.size()); }
+
+        void reset() override;
+
+        [[nodiscard]] size_t get_latency_samples() const override;
+
+    private:
+        gw_processor processor_{};
+        bool prepared_ = false;
+        std::vector<float *> channels_; // Scratch for process(BufferView *), sized in prepare()
+        uint64_t position_ = 0; // Samples through process(BufferView *) since the last reset
+    };
+
+    /**
+     *  Plugin side of the processor ABI: a processor that works on block
+     *  descriptors directly. Export it with export_processor().
+     *
+     *  No exception crosses the ABI: one thrown from prepare() is reported
+     *  to the host as GW_STATUS_ERROR, one thrown from any other call
+     *  terminates the process.
+     */
+    class BlockProcessor {
+    public:
+        virtual ~BlockProcessor() = default;
+
+        /**
+         *  NOT real-time safe, allocate everything here.
+         *
+         *  @return false if the configuration isn't supported
+         */
+        virtual bool prepare(double sample_rate, size_t max_block_size, size_t num_channels) = 0;
+
+        virtual void process(const gw_process_block &block) = 0;
+
+        /**
+         *  Consecutive blocks in order. The default calls process() for each.
+         */
+        virtual void process_batch(const gw_process_block *blocks, size_t num_blocks);
+
+        virtual void reset() {
+        }
+
+        [[nodiscard]] virtual size_t get_latency_samples() const { return 0; }
+    };
+
+    /**
+     *  Runs an ordinary Processor behind the ABI: every block becomes one
+     *  process() call on views of its channels. Events and parameter
+     *  changes are ignored.
+     */
+    class ProcessorBlockAdapter : public BlockProcessor {
+    public:
+        explicit ProcessorBlockAdapter(std::unique_ptr<Processor> processor);
+
+        bool prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(const gw_process_block &block) override;
+
+        void reset() override;
+
+        [[nodiscard]] size_t get_latency_samples() const override;
+
+    private:
+        std::unique_ptr<Processor> processor_;
+        std::vector<BufferView> views_; // Sized in prepare()
+    };
+
+    /**
+     *  Fill a gw_processor table for a BlockProcessor; the table's destroy()
+     *  deletes it. This is what a processor library's gw_create_processor
+     *  calls.
+     *
+     *  @return GW_STATUS_OK, or GW_STATUS_VERSION_MISMATCH,
+     *  GW_STATUS_INVALID_ARGUMENT or GW_STATUS_ERROR (processor is destroyed)
+     */
+    int32_t export_processor(std::unique_ptr<BlockProcessor> processor, uint32_t host_abi_version,
+                             gw_processor *out) noexcept;
+}
+
+#endif //GW_CORE_EXTERNAL_PROCESSOR_H
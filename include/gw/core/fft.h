@@ -0,0 +1,77 @@
+#ifndef GW_CORE_FFT_H
+#define GW_CORE_FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gw::core {
+    struct FftPlan;
+
+    /**
+     *  FFT of real-valued signals.
+     *
+     *  A size-N real transform is computed as an N/2-point complex FFT plus
+     *  a split step, which is about twice as fast as a full complex FFT.
+     *
+     *  The complex FFT works on split real/imaginary arrays with per-stage
+     *  contiguous twiddles, so every butterfly loop is unit-stride and
+     *  vectorizes; the butterfly kernel is built for SSE2, AVX2 and AVX-512
+     *  and picked at runtime.
+     *
+     *  Twiddle factors and the bit-reversal table live in a plan that is
+     *  computed once per size and shared by every RealFft of that size
+     *  (the cache is thread-safe). Constructing a RealFft allocates only
+     *  its own scratch; forward() and inverse() are real-time safe.
+     *  A RealFft is not thread-safe (it has internal scratch): use one per thread.
+     */
+    class RealFft {
+    public:
+        /**
+         *  @param size Transform size, a power of two >= 4
+         *  (other sizes are rounded up to the next power of two)
+         */
+        explicit RealFft(size_t size);
+
+        [[nodiscard]] size_t get_size() const { return size_; }
+
+        /**
+         *  Number of complex bins produced by forward(): size / 2 + 1.
+         */
+        [[nodiscard]] size_t get_num_bins() const { return size_ / 2 + 1; }
+
+        /**
+         *  Forward transform (unscaled).
+         *
+         *  @param input get_size() real samples
+         *  @param output get_num_bins() complex bins, DC to Nyquist
+         */
+        void forward(const float *input, std::complex<float> *output);
+
+        /**
+         *  Inverse transform, scaled so that inverse(forward(x)) == x.
+         *
+         *  @param input get_num_bins() complex bins
+         *  @param output get_size() real samples
+         */
+        void inverse(const std::complex<float> *input, float *output);
+
+        /**
+         *  Number of distinct sizes with a live plan (for tests and diagnostics).
+         */
+        static size_t get_cached_plan_count();
+
+    private:
+        size_t size_;
+        size_t half_size_;
+        std::shared_ptr<const FftPlan> plan_;
+        std::vector<float> work_real_;
+        std::vector<float> work_imag_;
+
+        void transform(bool inverse);
+    };
+}
+
+#endif //GW_CORE_FFT_H
@@ -0,0 +1,256 @@
+#ifndef GW_CORE_GRAPH_SNAPSHOT_H
+#define GW_CORE_GRAPH_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+
+namespace gw::core {
+    /**
+     *  On-disk layout of a processing-graph snapshot (.gwgs), version 1.
+     *
+     *  A snapshot is one contiguous image: a fixed header, then five
+     *  sections, each starting on a SNAPSHOT_ALIGN boundary:
+     *
+     *      nodes        SnapshotNode[num_nodes]
+     *      connections  SnapshotConnection[num_connections]
+     *      parameters   float[], each node's values contiguous
+     *      state        bytes, each node's blob 16-byte aligned
+     *      strings      node names, not null-terminated
+     *
+     *  Records are stored in host layout (little-endian, fixed-width
+     *  fields, no padding the compiler could choose differently), so a
+     *  loaded image is used as it is: nothing is decoded, copied field by
+     *  field or allocated per node. Readers reject images whose major
+     *  version or byte order differ.
+     */
+    constexpr uint32_t SNAPSHOT_MAGIC = 0x53475747; // "GWGS"
+    constexpr uint16_t SNAPSHOT_VERSION_MAJOR = 1; // Incompatible layout changes
+    constexpr uint16_t SNAPSHOT_VERSION_MINOR = 0; // Additions older readers can ignore
+    constexpr uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+    constexpr size_t SNAPSHOT_ALIGN = 64;
+
+    enum class SnapshotSection : uint32_t {
+        Nodes,
+        Connections,
+        Parameters,
+        State,
+        Strings,
+        Count
+    };
+
+    struct SnapshotSectionEntry {
+        uint64_t offset; // From the start of the image
+        uint64_t size; // In bytes
+    };
+
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint16_t version_major;
+        uint16_t version_minor;
+        uint32_t byte_order; // SNAPSHOT_BYTE_ORDER as written by the host
+        uint32_t header_size; // sizeof(SnapshotHeader) of the writer
+        uint64_t image_size; // Header and all sections
+        uint64_t checksum; // FNV-1a over bytes header_size to image_size
+        uint64_t num_nodes;
+        uint64_t num_connections;
+        SnapshotSectionEntry sections[static_cast<size_t>(SnapshotSection::Count)];
+    };
+
+    struct SnapshotNode {
+        uint32_t type_id; // Application-defined processor type
+        uint32_t flags; // Application-defined (bypass, ...)
+        uint32_t num_inputs;
+        uint32_t num_outputs;
+        uint64_t parameter_index; // First value in the parameters section
+        uint64_t parameter_count;
+        uint64_t state_offset; // From the start of the state section
+        uint64_t state_size;
+        uint64_t name_offset; // From the start of the strings section
+        uint64_t name_size;
+    };
+
+    struct SnapshotConnection {
+        uint32_t source_node;
+        uint32_t source_port;
+        uint32_t dest_node;
+        uint32_t dest_port;
+    };
+
+    /**
+     *  Builds a snapshot image. Not real-time safe.
+     */
+    class GraphSnapshotWriter {
+    public:
+        /**
+         *  Append a node.
+         *
+         *  @param parameters Parameter values, copied (may be null if num_parameters is 0)
+         *  @param state Opaque state blob, copied (may be null if state_size is 0)
+         *  @return Index of the node, for connect()
+         */
+        uint32_t add_node(uint32_t type_id, std::string_view name, uint32_t num_inputs, uint32_t num_outputs,
+                          const float *parameters, size_t num_parameters,
+                          const void *state, size_t state_size, uint32_t flags = 0);
+
+        /**
+         *  Connect an output port of one node to an input port of another.
+         *
+         *  @return false if a node index or port is out of range
+         */
+        bool connect(uint32_t source_node, uint32_t source_port, uint32_t dest_node, uint32_t dest_port);
+
+        [[nodiscard]] size_t get_num_nodes() const { return nodes_.size(); }
+
+        /**
+         *  Size of the image write() produces.
+         */
+        [[nodiscard]] size_t get_image_size() const;
+
+        /**
+         *  Write the image to memory.
+         *
+         *  @param dest At least get_image_size() bytes
+         *  @return Bytes written, or 0 if capacity is too small
+         */
+        size_t write(void *dest, size_t capacity) const;
+
+        /**
+         *  Write the image to a file. The file appears atomically (written
+         *  under a temporary name and renamed), so a reader never maps a
+         *  partial snapshot.
+         */
+        bool save(const std::string &path) const;
+
+    private:
+        std::vector<SnapshotNode> nodes_;
+        std::vector<SnapshotConnection> connections_;
+        std::vector<float> parameters_;
+        std::vector<uint8_t> state_;
+        std::string strings_;
+    };
+
+    /**
+     *  Read-only view of a snapshot image in memory.
+     *
+     *  open() checks the header and that every node's parameters, state and
+     *  name, and every connection, lie inside the image; after that all
+     *  accessors are plain pointer arithmetic on the image. The view does
+     *  not own the image.
+     */
+    class GraphSnapshot {
+    public:
+        GraphSnapshot() = default;
+
+        /**
+         *  @param data Image, SNAPSHOT_ALIGN-aligned (as mmap and SnapshotArena provide)
+         *  @param verify_checksum Also hash the whole image (O(size) instead of O(nodes))
+         *  @return false if the image is malformed; the view is then empty
+         */
+        bool open(const void *data, size_t size, bool verify_checksum = false);
+
+        [[nodiscard]] bool is_valid() const { return header_ != nullptr; }
+
+        [[nodiscard]] const SnapshotHeader *get_header() const { return header_; }
+        [[nodiscard]] size_t get_num_nodes() const { return num_nodes_; }
+        [[nodiscard]] size_t get_num_connections() const { return num_connections_; }
+
+        [[nodiscard]] const SnapshotNode *get_nodes() const { return nodes_; }
+        [[nodiscard]] const SnapshotConnection *get_connections() const { return connections_; }
+
+        // Per node; index must be below get_num_nodes()
+        [[nodiscard]] const float *get_parameters(size_t node) const;
+        [[nodiscard]] const uint8_t *get_state(size_t node) const;
+        [[nodiscard]] std::string_view get_name(size_t node) const;
+
+    private:
+        const SnapshotHeader *header_ = nullptr;
+        const SnapshotNode *nodes_ = nullptr;
+        const SnapshotConnection *connections_ = nullptr;
+        const float *parameters_ = nullptr;
+        const uint8_t *state_ = nullptr;
+        const char *strings_ = nullptr;
+        size_t num_nodes_ = 0;
+        size_t num_connections_ = 0;
+    };
+
+    /**
+     *  Preallocated memory a snapshot is loaded into.
+     *
+     *  Size it once for the largest session expected (optionally on huge
+     *  pages); loading is then one read of the file straight into place and
+     *  a GraphSnapshot::open(), with no allocation. Parameters and state in
+     *  the arena are writable, so the live session can keep using them.
+     */
+    class SnapshotArena {
+    public:
+        explicit SnapshotArena(size_t capacity, BufferMemory memory = BufferMemory::Heap);
+
+        ~SnapshotArena();
+
+        SnapshotArena(const SnapshotArena &) = delete;
+
+        SnapshotArena &operator=(const SnapshotArena &) = delete;
+
+        /**
+         *  Read a snapshot file into the arena.
+         *
+         *  @return false if the file can't be read, doesn't fit or is malformed
+         */
+        bool load(const std::string &path, bool verify_checksum = false);
+
+        /**
+         *  Copy an image already in memory into the arena.
+         */
+        bool load(const void *data, size_t size, bool verify_checksum = false);
+
+        [[nodiscard]] const GraphSnapshot &get_snapshot() const { return snapshot_; }
+
+        // Writable views of a loaded node's values, for the live session
+        [[nodiscard]] float *get_parameters(size_t node);
+        [[nodiscard]] uint8_t *get_state(size_t node);
+
+        [[nodiscard]] uint8_t *get_data() { return data_; }
+        [[nodiscard]] size_t get_capacity() const { return capacity_; }
+        [[nodiscard]] size_t get_size() const { return size_; }
+
+    private:
+        uint8_t *data_;
+        size_t capacity_;
+        size_t size_;
+        bool huge_pages_;
+        GraphSnapshot snapshot_;
+    };
+
+    /**
+     *  A snapshot file mapped read-only. Pages are faulted in by the kernel
+     *  as nodes are touched, so opening costs the same for any session size.
+     *  Linux only (mmap); elsewhere open() returns false, use SnapshotArena.
+     */
+    class MappedSnapshot {
+    public:
+        MappedSnapshot() = default;
+
+        ~MappedSnapshot();
+
+        MappedSnapshot(const MappedSnapshot &) = delete;
+
+        MappedSnapshot &operator=(const MappedSnapshot &) = delete;
+
+        bool open(const std::string &path, bool verify_checksum = false);
+
+        void close();
+
+        [[nodiscard]] const GraphSnapshot &get_snapshot() const { return snapshot_; }
+
+    private:
+        void *map_ = nullptr;
+        size_t map_bytes_ = 0;
+        GraphSnapshot snapshot_;
+    };
+}
+
+#endif //GW_CORE_GRAPH_SNAPSHOT_H
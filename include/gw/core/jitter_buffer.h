@@ -0,0 +1,183 @@
+#ifndef GW_CORE_JITTER_BUFFER_H
+#define GW_CORE_JITTER_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/audio_format.h"
+#include "gw/core/buffer_view.h"
+#include "gw/core/ring_buffer.h"
+
+namespace gw::core {
+    /**
+     *  Settings for JitterBuffer.
+     */
+    struct JitterBufferSettings {
+        float min_latency_ms = 2.0f; // Lower bound for the adaptive target
+        float max_latency_ms = 200.0f; // Upper bound; also sizes the ring buffers
+        float jitter_multiplier = 4.0f; // Target covers this many times the measured jitter
+        size_t reorder_packets = 2; // Out-of-order packets held while waiting for a gap to fill
+        size_t max_packet_frames = 1024; // Largest packet accepted
+        size_t max_block_size = 1024; // Largest pull()
+        float max_ratio_correction = 0.005f; // Resampling limit, +-0.5%
+        float drift_time_constant_s = 2.0f; // How quickly the fill level is steered to the target
+    };
+
+    /**
+     *  Counters kept by a JitterBuffer. Read with get_stats() from any thread.
+     */
+    struct JitterBufferStats {
+        uint64_t packets_received = 0;
+        uint64_t packets_lost = 0; // Gaps concealed with silence
+        uint64_t packets_late = 0; // Arrived after their audio was already concealed or played
+        uint64_t packets_reordered = 0; // Arrived out of order but in time
+        uint64_t packets_rejected = 0; // Wrong size or too large
+        uint64_t overflows = 0; // Frames dropped because the ring buffers were full
+        uint64_t underruns = 0; // pull() calls that ran dry and re-buffered
+    };
+
+    /**
+     *  Adaptive receive buffer for a network audio stream.
+     *
+     *  Network thread (push): packets are placed in order by their frame
+     *  position, with a small reorder window; gaps that the window cannot
+     *  fill are concealed with silence so the timeline stays intact. The
+     *  decoded audio goes into one RingBuffer per channel.
+     *
+     *  Audio thread (pull): reads the rings through a cubic resampler whose
+     *  ratio is steered by a PI controller so the fill level tracks the
+     *  target latency. That corrects the clock drift between sender and
+     *  receiver, and lets the latency follow the target when it moves.
+     *
+     *  The target is (reorder window + one packet + jitter_multiplier *
+     *  measured interarrival jitter), clamped to the min/max settings.
+     *  Jitter is estimated as in RTP (RFC 3550, section 6.4.1).
+     *
+     *  Exactly one thread pushes and one thread pulls. Memory is allocated
+     *  in the constructor; push() and pull() are real-time safe.
+     */
+    class JitterBuffer {
+    public:
+        /**
+         *  @param format Format of the incoming PCM (interleaved, see pcm_codec.h)
+         *  @param settings Latency and resampling settings
+         */
+        explicit JitterBuffer(const AudioFormat &format,
+                              const JitterBufferSettings &settings = JitterBufferSettings());
+
+        [[nodiscard]] const AudioFormat &get_format() const { return format_; }
+        [[nodiscard]] const JitterBufferSettings &get_settings() const { return settings_; }
+
+        /**
+         *  Add one packet of interleaved PCM. Network thread only.
+         *
+         *  @param frame_position Stream position of the first frame in the packet
+         *  @param pcm Interleaved samples in get_format()
+         *  @param num_frames Frames in the packet
+         *  @param arrival_seconds Arrival time on any monotonic clock (for the jitter estimate)
+         *  @return false if the packet was rejected or late
+         */
+        bool push(uint64_t frame_position, const uint8_t *pcm, size_t num_frames, double arrival_seconds);
+
+        /**
+         *  Fill the output channels with resampled audio. Audio thread only.
+         *  Outputs silence while (re)buffering up to the target latency.
+         *
+         *  @param channels Output views, all of the same size (<= max_block_size)
+         *  @param num_channels Number of views; extra channels get silence
+         *  @return Frames of stream audio produced (0 while buffering)
+         */
+        size_t pull(BufferView *channels, size_t num_channels);
+
+        /**
+         *  Drop all buffered audio and start over. Call while neither side is running.
+         */
+        void reset();
+
+        /**
+         *  Frames currently buffered (rings plus resampler staging). Audio thread.
+         */
+        [[nodiscard]] double get_fill_frames() const;
+
+        /**
+         *  Latency the controller currently steers towards, in frames.
+         */
+        [[nodiscard]] size_t get_target_frames() const { return target_frames_.load(std::memory_order_relaxed); }
+
+        /**
+         *  Current resampling ratio (input frames consumed per output frame).
+         *  Above 1 means the sender's clock runs fast relative to ours.
+         */
+        [[nodiscard]] double get_ratio() const { return ratio_.load(std::memory_order_relaxed); }
+
+        /**
+         *  Interarrival jitter estimate in seconds.
+         */
+        [[nodiscard]] double get_jitter_seconds() const { return jitter_seconds_.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] bool is_playing() const { return playing_; }
+
+        [[nodiscard]] JitterBufferStats get_stats() const;
+
+    private:
+        struct HeldPacket {
+            bool used = false;
+            uint64_t frame_position = 0;
+            size_t num_frames = 0;
+            std::vector<uint8_t> pcm;
+        };
+
+        AudioFormat format_;
+        JitterBufferSettings settings_;
+        size_t num_channels_;
+        size_t bytes_per_frame_;
+        size_t min_target_frames_;
+        size_t max_target_frames_;
+
+        // Network side
+        bool started_;
+        uint64_t expected_position_;
+        std::vector<HeldPacket> held_;
+        AudioBuffer decode_scratch_;
+        bool have_transit_;
+        double last_transit_;
+        double jitter_;
+        size_t last_packet_frames_;
+        std::vector<std::unique_ptr<RingBuffer> > rings_;
+
+        // Audio side
+        bool playing_;
+        AudioBuffer staging_; // Resampler input, per channel
+        size_t staged_;
+        double phase_;
+        double smoothed_error_;
+        double integral_;
+
+        std::atomic<size_t> target_frames_;
+        std::atomic<double> ratio_;
+        std::atomic<double> jitter_seconds_;
+
+        std::atomic<uint64_t> packets_received_;
+        std::atomic<uint64_t> packets_lost_;
+        std::atomic<uint64_t> packets_late_;
+        std::atomic<uint64_t> packets_reordered_;
+        std::atomic<uint64_t> packets_rejected_;
+        std::atomic<uint64_t> overflows_;
+        std::atomic<uint64_t> underruns_;
+
+        void write_frames(const uint8_t *pcm, size_t num_frames);
+
+        void write_silence(size_t num_frames);
+
+        void flush_held();
+
+        void update_jitter(uint64_t frame_position, double arrival_seconds, size_t num_frames);
+
+        [[nodiscard]] size_t get_ring_available() const;
+    };
+}
+
+#endif //GW_CORE_JITTER_BUFFER_H
@@ -0,0 +1,304 @@
+#ifndef GW_CORE_METERING_H
+#define GW_CORE_METERING_H
+
+#include <atomic>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "gw/core/fft.h"
+#include "gw/core/processor.h"
+#include "gw/core/ring_buffer.h"
+#include "gw/core/seqlock.h"
+#include "gw/core/triple_buffer.h"
+
+namespace gw::core {
+    /**
+     *  Levels of one metering window, as published by a MeterTap.
+     */
+    struct MeterLevels {
+        static constexpr size_t MAX_CHANNELS = 16;
+
+        uint32_t num_channels = 0;
+        uint32_t window_index = 0; // Increments with every published window
+        float peak[MAX_CHANNELS] = {}; // Linear absolute peak over the window
+        float rms[MAX_CHANNELS] = {}; // Linear RMS over the window
+    };
+
+    /**
+     *  Settings for MeterTap.
+     */
+    struct MeterTapSettings {
+        // Length of one metering window. Levels are published once per window.
+        float window_ms = 50.0f;
+
+        // Seconds of audio buffered for background analysis (LUFS, spectrum).
+        // 0 disables the feed entirely; the tap then costs only the level reduction.
+        float analysis_seconds = 0.0f;
+    };
+
+    /**
+     *  A pass-through processor that meters the audio flowing through it.
+     *
+     *  Audio thread cost: one pass over the block computing |x| max and sum of
+     *  squares per channel, plus, once per window, a seqlock publish of a few
+     *  hundred bytes. Nothing is copied out unless the analysis feed is on.
+     *
+     *  UI threads call get_levels() at any rate; they always get the most
+     *  recent complete window. Heavier analysis (LUFS, spectra) runs on a
+     *  MeterAnalyzer thread fed by per-channel RingBuffers.
+     *
+     *  Channels beyond MeterLevels::MAX_CHANNELS are not metered.
+     */
+    class MeterTap : public Processor {
+    public:
+        explicit MeterTap(const MeterTapSettings &settings = MeterTapSettings());
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        /**
+         *  Meter the block. The audio is not modified. Real-time safe.
+         */
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void reset() override;
+
+        /**
+         *  Latest published levels. Safe from any thread.
+         */
+        [[nodiscard]] MeterLevels get_levels() const { return levels_.load(); }
+
+        [[nodiscard]] double get_sample_rate() const { return sample_rate_; }
+        [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
+        [[nodiscard]] bool has_analysis_feed() const { return !feeds_.empty(); }
+
+        /**
+         *  Consumer side of the analysis feed (one background thread only).
+         *
+         *  @return Samples read from the channel's feed
+         */
+        size_t read_analysis(size_t channel, float *dest, size_t count);
+
+        /**
+         *  Samples waiting in a channel's analysis feed.
+         */
+        [[nodiscard]] size_t get_analysis_available(size_t channel) const;
+
+        /**
+         *  Samples dropped because the analysis thread fell behind.
+         */
+        [[nodiscard]] uint64_t get_analysis_overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+    private:
+        MeterTapSettings settings_;
+        double sample_rate_;
+        size_t num_channels_;
+        size_t window_samples_;
+
+        // Audio thread accumulators for the current window
+        size_t window_position_;
+        uint32_t window_index_;
+        float peak_[MeterLevels::MAX_CHANNELS];
+        double sum_squares_[MeterLevels::MAX_CHANNELS];
+
+        Seqlock<MeterLevels> levels_;
+
+        std::vector<std::unique_ptr<RingBuffer> > feeds_;
+        std::atomic<uint64_t> overruns_;
+    };
+
+    /**
+     *  Snapshot of an EBU R128 loudness measurement, in LUFS.
+     *  Values are -INFINITY until enough audio has been measured.
+     */
+    struct LoudnessReading {
+        float momentary = 0.0f; // 400 ms window
+        float short_term = 0.0f; // 3 s window
+        float integrated = 0.0f; // Gated, since the last reset
+    };
+
+    /**
+     *  ITU-R BS.1770 / EBU R128 loudness meter.
+     *
+     *  K-weighting (high shelf + high pass), 400 ms gating blocks with 75%
+     *  overlap, absolute gate at -70 LUFS and relative gate at -10 LU.
+     *
+     *  Integrated loudness is gated over a histogram of block loudness in
+     *  0.1 LU bins (the relative gate is resolved to one bin), so memory is
+     *  fixed at construction however long it runs: process() never
+     *  allocates and get_reading() costs the same after hours as after
+     *  seconds. The double-precision filters still make it a job for a
+     *  background thread (see MeterAnalyzer).
+     */
+    class LoudnessMeter {
+    public:
+        /**
+         *  @param sample_rate Sample rate in Hz
+         *  @param num_channels Number of channels
+         *  @param weights Per-channel weights (default 1.0; use ~1.41 for surrounds, 0 for LFE)
+         */
+        LoudnessMeter(double sample_rate, size_t num_channels, std::vector<float> weights = {});
+
+        /**
+         *  Measure a block.
+         *
+         *  @param channels Array of num_channels pointers
+         *  @param count Samples per channel
+         */
+        void process(const float *const *channels, size_t count);
+
+        [[nodiscard]] LoudnessReading get_reading() const;
+
+        void reset();
+
+    private:
+        struct Biquad {
+            double b0, b1, b2, a1, a2;
+        };
+
+        size_t num_channels_;
+        std::vector<double> weights_;
+        Biquad shelf_;
+        Biquad high_pass_;
+        std::vector<double> filter_state_; // 4 per channel per stage
+
+        size_t step_samples_; // 100 ms
+        size_t step_position_;
+        double step_sum_; // Weighted sum of squares of the current 100 ms step
+        std::vector<double> recent_steps_; // Mean square of the last 30 steps (3 s), circular
+        size_t steps_seen_;
+        double block_power_; // Mean square of the latest 400 ms gating block
+        std::vector<uint64_t> gate_counts_; // Gating blocks above the absolute gate, per 0.1 LU bin
+        std::vector<double> gate_sums_; // Their summed mean squares, per bin
+
+        static double loudness(double power);
+    };
+
+    /**
+     *  Magnitude spectrum with a Hann window and exponential averaging.
+     *  NOT real-time safe to construct; process() does not allocate.
+     */
+    class SpectrumAnalyzer {
+    public:
+        /**
+         *  @param fft_size FFT size (power of two)
+         *  @param smoothing Averaging factor per frame, 0 (none) to <1
+         */
+        explicit SpectrumAnalyzer(size_t fft_size, float smoothing = 0.7f);
+
+        [[nodiscard]] size_t get_fft_size() const { return fft_.get_size(); }
+        [[nodiscard]] size_t get_num_bins() const { return fft_.get_num_bins(); }
+
+        /**
+         *  Add samples. A new spectrum is computed every fft_size / 2 samples.
+         *
+         *  @return true if the spectrum was updated
+         */
+        bool process(const float *samples, size_t count);
+
+        /**
+         *  Smoothed magnitude per bin, in dB relative to a full-scale sine.
+         */
+        [[nodiscard]] const std::vector<float> &get_magnitudes_db() const { return magnitudes_db_; }
+
+    private:
+        RealFft fft_;
+        float smoothing_;
+        std::vector<float> window_;
+        float window_gain_;
+        std::vector<float> history_; // Last fft_size samples
+        size_t history_fill_;
+        size_t samples_since_frame_;
+        std::vector<float> frame_;
+        std::vector<std::complex<float> > bins_;
+        std::vector<float> power_;
+        std::vector<float> magnitudes_db_;
+    };
+
+    /**
+     *  Settings for one tap attached to a MeterAnalyzer.
+     */
+    struct AnalysisSettings {
+        bool loudness = true;
+        size_t spectrum_size = 0; // FFT size, 0 = no spectrum
+        std::vector<float> channel_weights; // For loudness, see LoudnessMeter
+    };
+
+    /**
+     *  Background thread that runs LUFS and spectrum analysis for MeterTaps.
+     *
+     *  Usage:
+     *      1. prepare() the taps (with analysis_seconds > 0)
+     *      2. attach() each tap
+     *      3. start(); results are available from get_loudness()/get_spectrum()
+     *      4. stop() (or destroy) before the taps go away
+     */
+    class MeterAnalyzer {
+    public:
+        /**
+         *  @param poll_interval_ms How often the background thread drains the feeds
+         */
+        explicit MeterAnalyzer(float poll_interval_ms = 10.0f);
+
+        ~MeterAnalyzer();
+
+        MeterAnalyzer(const MeterAnalyzer &) = delete;
+
+        MeterAnalyzer &operator=(const MeterAnalyzer &) = delete;
+
+        /**
+         *  Attach a prepared tap. NOT allowed while running.
+         *
+         *  @return Index used with get_loudness()/get_spectrum(), or -1 if
+         *  the tap has no analysis feed or the analyzer is running
+         */
+        int attach(MeterTap &tap, const AnalysisSettings &settings = AnalysisSettings());
+
+        void start();
+
+        void stop();
+
+        /**
+         *  Drain all feeds and update results once, on the calling thread.
+         *  For tests and for hosts that run their own background loop.
+         *  Do not call while the analyzer thread is running.
+         */
+        void poll();
+
+        /**
+         *  Latest loudness for an attached tap. Safe from any thread.
+         */
+        [[nodiscard]] LoudnessReading get_loudness(int index) const;
+
+        /**
+         *  Latest spectrum for an attached tap (mono sum of its channels).
+         *  Call from a single UI thread.
+         *
+         *  @return false if the tap has no spectrum
+         */
+        bool get_spectrum(int index, std::vector<float> &magnitudes_db);
+
+    private:
+        struct Attachment {
+            MeterTap *tap;
+            std::unique_ptr<LoudnessMeter> loudness;
+            std::unique_ptr<SpectrumAnalyzer> spectrum;
+            std::vector<std::vector<float> > scratch;
+            std::vector<const float *> scratch_pointers;
+            std::vector<float> mono;
+            Seqlock<LoudnessReading> loudness_reading;
+            std::unique_ptr<TripleBuffer<std::vector<float> > > spectrum_output;
+        };
+
+        float poll_interval_ms_;
+        std::vector<std::unique_ptr<Attachment> > attachments_;
+        std::atomic<bool> running_;
+        std::thread thread_;
+
+        void drain(Attachment &attachment);
+    };
+}
+
+#endif //GW_CORE_METERING_H
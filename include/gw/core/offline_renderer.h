@@ -0,0 +1,101 @@
+#ifndef GW_CORE_OFFLINE_RENDERER_H
+#define GW_CORE_OFFLINE_RENDERER_H
+
+#include <cstddef>
+#include <vector>
+#include "gw/core/audio_io.h"
+#include "gw/core/processor.h"
+
+namespace gw::core {
+    /**
+     *  Settings for an offline (faster than real-time) render.
+     */
+    struct RenderConfig {
+        // Frames per block. Offline rendering favors large blocks:
+        // per-block overhead is amortized and file I/O is more efficient.
+        size_t block_size = 8192;
+
+        // Number of blocks circulating between the read, process and write
+        // stages. More blocks absorb more I/O jitter at the cost of memory.
+        size_t blocks_in_flight = 4;
+
+        // Run read -> process -> write on three threads. When false
+        // everything runs on the calling thread.
+        bool pipelined = true;
+
+        // Remove the processors' reported latency from the output: the first
+        // get_latency_samples() frames are dropped and the tail is flushed
+        // with silence, so the output lines up with the input.
+        bool compensate_latency = true;
+    };
+
+    /**
+     *  What a render achieved.
+     */
+    struct RenderStats {
+        size_t frames_rendered = 0;
+        double audio_seconds = 0.0;
+        double wall_seconds = 0.0;
+
+        // audio_seconds / wall_seconds: 10.0 means ten times faster than real time
+        double realtime_factor = 0.0;
+
+        // False if the sink reported a write failure
+        bool ok = true;
+    };
+
+    /**
+     *  One independent source -> processor -> sink render (e.g. one stem).
+     *
+     *  processor may be null for a straight copy.
+     *  Jobs rendered together must not share sources, processors or sinks.
+     */
+    struct RenderJob {
+        AudioSource *source = nullptr;
+        Processor *processor = nullptr;
+        AudioSink *sink = nullptr;
+        RenderStats stats; // Filled in by OfflineRenderer::render_all()
+    };
+
+    /**
+     *  Drives processors as fast as the CPU allows, for bouncing and stem export.
+     *
+     *  This calls exactly the same Processor::prepare()/process() code as the
+     *  live audio path; only the block size and the clock differ.
+     *
+     *  Memory for the blocks is allocated per render, so this is NOT meant
+     *  to be used while a real-time stream is sharing the same processors.
+     */
+    class OfflineRenderer {
+    public:
+        explicit OfflineRenderer(const RenderConfig &config = RenderConfig());
+
+        [[nodiscard]] const RenderConfig &get_config() const { return config_; }
+
+        /**
+         *  Render one source through a processor into a sink.
+         *  Blocks until the source is exhausted.
+         */
+        RenderStats render(AudioSource &source, Processor &processor, AudioSink &sink) const;
+
+        /**
+         *  Render independent jobs concurrently.
+         *
+         *  @param jobs Jobs to render; each job's stats are filled in
+         *  @param num_threads Worker threads, 0 = one per hardware thread
+         *  @return Totals across all jobs (realtime_factor is for the whole batch)
+         *
+         *  Jobs are only pipelined when there are enough threads for all three
+         *  stages of every job; otherwise each worker renders its job serially
+         *  so the machine isn't oversubscribed.
+         */
+        RenderStats render_all(std::vector<RenderJob> &jobs, size_t num_threads = 0) const;
+
+    private:
+        RenderConfig config_;
+
+        RenderStats render_job(AudioSource &source, Processor *processor, AudioSink &sink, bool pipelined) const;
+    };
+}
+
+#endif //GW_CORE_OFFLINE_RENDERER_H
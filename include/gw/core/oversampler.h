@@ -0,0 +1,153 @@
+#ifndef GW_CORE_OVERSAMPLER_H
+#define GW_CORE_OVERSAMPLER_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/buffer_view.h"
+#include "gw/core/processor.h"
+
+namespace gw::core {
+    /**
+     *  Integer-factor up/downsampler built from cascaded half-band stages.
+     *
+     *  Each stage doubles (or halves) the rate with a linear-phase half-band
+     *  FIR in polyphase form: half the taps are zero and the centre tap is
+     *  a pure delay, so a stage only filters at its lower rate and does one
+     *  multiply-add per nonzero tap per output pair. The first stage carries
+     *  the steep transition (20 kHz at 44.1 kHz); later stages only have to
+     *  reject what folds back into the base band and are much shorter. Stop
+     *  bands are better than 90 dB at every factor.
+     *
+     *  The filter loops run across outputs (one tap at a time), which
+     *  vectorizes; AVX2/AVX-512 builds are selected at runtime.
+     *
+     *  A round trip upsample() -> downsample() delays the signal by exactly
+     *  get_latency_samples() base-rate samples: a short pad at the top rate
+     *  rounds the stages' combined delay up to a whole base-rate sample.
+     *
+     *  Memory is allocated in the constructor; upsample() and downsample()
+     *  are real-time safe.
+     */
+    class Oversampler {
+    public:
+        static constexpr size_t MAX_FACTOR = 16;
+
+        /**
+         *  @param factor 2, 4, 8 or 16 (rounded up to a power of two, clamped to [2, 16])
+         *  @param num_channels Channels upsample()/downsample() will see
+         *  @param max_block_size Largest base-rate block
+         */
+        Oversampler(size_t factor, size_t num_channels, size_t max_block_size);
+
+        [[nodiscard]] size_t get_factor() const { return factor_; }
+        [[nodiscard]] size_t get_num_stages() const { return stages_.size(); }
+        [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
+        [[nodiscard]] size_t get_max_block_size() const { return max_block_size_; }
+
+        /**
+         *  Round-trip delay in base-rate samples.
+         */
+        [[nodiscard]] size_t get_latency_samples() const { return latency_; }
+
+        /**
+         *  The round-trip delay an Oversampler with this factor will have.
+         */
+        [[nodiscard]] static size_t get_latency_for_factor(size_t factor);
+
+        /**
+         *  The factor an Oversampler constructed with this factor will use.
+         */
+        [[nodiscard]] static size_t normalize_factor(size_t factor);
+
+        /**
+         *  Upsample a base-rate block into the internal oversampled buffer.
+         *
+         *  @param channels Views of num_samples samples each (at most max_block_size)
+         *  @return Number of oversampled samples per channel (num_samples * factor)
+         */
+        size_t upsample(const BufferView *channels, size_t num_channels);
+
+        /**
+         *  The oversampled buffer upsample() filled; process it in place.
+         */
+        AudioBuffer &get_oversampled_buffer() { return oversampled_; }
+
+        /**
+         *  Downsample the internal oversampled buffer back into base-rate views.
+         *
+         *  @param channels Views of num_samples samples each; the oversampled
+         *  buffer must hold num_samples * factor samples per channel
+         */
+        void downsample(BufferView *channels, size_t num_channels);
+
+        /**
+         *  Clear all filter state.
+         */
+        void reset();
+
+    private:
+        struct Stage {
+            size_t half_taps; // M: the FIR has 4M - 1 taps, 2M of them nonzero besides the centre
+            std::vector<float> coefficients; // The 2M nonzero side taps, in dot-product order
+            AudioBuffer up_history; // Last 2M - 1 inputs of the interpolator
+            AudioBuffer even_history; // Last 2M - 1 even-phase inputs of the decimator
+            AudioBuffer odd_history; // Last M odd-phase inputs of the decimator
+
+            Stage(size_t half_taps, double beta, size_t num_channels);
+        };
+
+        size_t factor_;
+        size_t num_channels_;
+        size_t max_block_size_;
+        size_t latency_;
+        size_t pad_; // Top-rate samples added to make the round trip whole
+
+        std::vector<Stage> stages_;
+        AudioBuffer oversampled_;
+        AudioBuffer scratch_; // Ping-pong partner for oversampled_ between stages
+        AudioBuffer pad_history_;
+        std::vector<float> line_; // History + block, so every filter reads contiguously
+        std::vector<float> odd_line_;
+
+        void upsample_stage(Stage &stage, size_t channel, const float *input, float *output, size_t count);
+
+        void downsample_stage(Stage &stage, size_t channel, const float *input, float *output, size_t count);
+
+        void apply_pad(size_t channel, float *data, size_t count);
+    };
+
+    /**
+     *  Runs a processor at factor times the host rate.
+     *
+     *  prepare() prepares the wrapped processor at the oversampled rate and
+     *  block size; process() upsamples, processes in place and downsamples.
+     *  The reported latency includes the filters and the wrapped
+     *  processor's own latency, converted to base-rate samples (rounded to
+     *  nearest).
+     */
+    class OversampledProcessor : public Processor {
+    public:
+        OversampledProcessor(std::unique_ptr<Processor> processor, size_t factor);
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void reset() override;
+
+        [[nodiscard]] size_t get_latency_samples() const override;
+
+        [[nodiscard]] size_t get_factor() const { return factor_; }
+        [[nodiscard]] Processor *get_processor() { return processor_.get(); }
+
+    private:
+        std::unique_ptr<Processor> processor_;
+        size_t factor_;
+        std::unique_ptr<Oversampler> oversampler_;
+        std::vector<BufferView> views_; // Oversampled views, sized in prepare()
+    };
+}
+
+#endif //GW_CORE_OVERSAMPLER_H
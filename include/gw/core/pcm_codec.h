@@ -0,0 +1,60 @@
+#ifndef GW_CORE_PCM_CODEC_H
+#define GW_CORE_PCM_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/audio_format.h"
+
+namespace gw::core {
+    /**
+     *  Conversion between planar AudioBuffers and interleaved PCM bytes.
+     *
+     *  The byte layout is described by an AudioFormat:
+     *      16 bit - signed little-endian integer
+     *      24 bit - signed little-endian integer, packed (3 bytes)
+     *      32 bit - IEEE float, little-endian
+     *
+     *  Integer encodings clip to [-1, 1] and round to nearest.
+     *  All functions are real-time safe (no allocations).
+     */
+
+    /**
+     *  True if the codec supports the format's bit depth.
+     */
+    bool is_pcm_format_supported(const AudioFormat &format);
+
+    /**
+     *  Interleave and encode frames from a buffer.
+     *
+     *  @param source Buffer to read from
+     *  @param source_offset First frame in the buffer to encode
+     *  @param num_frames Number of frames to encode
+     *  @param format Target format; channels beyond the buffer's are encoded as silence
+     *  @param dest Destination, at least num_frames * format.get_bytes_per_frame() bytes
+     *  @return Number of bytes written (0 if the format is unsupported)
+     */
+    size_t encode_pcm(const AudioBuffer &source,
+                      size_t source_offset,
+                      size_t num_frames,
+                      const AudioFormat &format,
+                      uint8_t *dest);
+
+    /**
+     *  Decode and de-interleave frames into a buffer.
+     *
+     *  @param source Interleaved bytes, num_frames * format.get_bytes_per_frame() long
+     *  @param num_frames Number of frames to decode
+     *  @param format Source format; channels beyond the buffer's are skipped
+     *  @param dest Buffer to write to
+     *  @param dest_offset First frame in the buffer to write
+     *  @return Number of frames decoded (clipped to the buffer's length)
+     */
+    size_t decode_pcm(const uint8_t *source,
+                      size_t num_frames,
+                      const AudioFormat &format,
+                      AudioBuffer &dest,
+                      size_t dest_offset);
+}
+
+#endif //GW_CORE_PCM_CODEC_H
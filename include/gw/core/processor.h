@@ -0,0 +1,103 @@
+#ifndef GW_CORE_PROCESSOR_H
+#define GW_CORE_PROCESSOR_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/buffer_view.h"
+
+namespace gw::core {
+    /**
+     *  Base class for anything that processes audio in place.
+     *
+     *  The same Processor objects are driven by the live audio callback and
+     *  by the OfflineRenderer, so implementations must not assume anything
+     *  about wall-clock timing.
+     *
+     *  Lifecycle:
+     *      prepare()  - NOT real-time safe, allocate everything here
+     *      process()  - real-time safe, called once per block
+     *      reset()    - real-time safe, clear internal state (e.g. on seek)
+     */
+    class Processor {
+    public:
+        virtual ~Processor() = default;
+
+        /**
+         *  Prepare for processing.
+         *
+         *  @param sample_rate Sample rate in Hz
+         *  @param max_block_size Largest number of samples process() will see
+         *  @param num_channels Number of channels process() will see
+         */
+        virtual void prepare(double sample_rate, size_t max_block_size, size_t num_channels) = 0;
+
+        /**
+         *  Process one block in place.
+         *
+         *  @param channels Array of channel views, all of the same size
+         *  @param num_channels Number of views in the array
+         *
+         *  The block size is channels[0].size() and never exceeds the
+         *  max_block_size passed to prepare().
+         */
+        virtual void process(BufferView *channels, size_t num_channels) = 0;
+
+        /**
+         *  Clear internal state (delay lines, envelopes, ...).
+         */
+        virtual void reset() {
+        }
+
+        /**
+         *  Latency this processor adds, in samples.
+         *  Used for delay compensation on parallel paths.
+         */
+        [[nodiscard]] virtual size_t get_latency_samples() const { return 0; }
+    };
+
+    /**
+     *  A serial chain of processors, run in insertion order.
+     *
+     *  The chain owns its processors and is itself a Processor,
+     *  so chains can be nested.
+     */
+    class ProcessorChain : public Processor {
+    public:
+        ProcessorChain() = default;
+
+        /**
+         *  Append a processor to the end of the chain.
+         *  NOT real-time safe.
+         *
+         *  @return Raw pointer to the added processor (owned by the chain)
+         */
+        Processor *add(std::unique_ptr<Processor> processor);
+
+        [[nodiscard]] size_t size() const { return processors_.size(); }
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        /**
+         *  Process the first num_samples samples of every channel of a buffer.
+         *  Real-time safe once prepare() has been called.
+         */
+        void process(AudioBuffer &buffer, size_t num_samples);
+
+        void reset() override;
+
+        /**
+         *  Sum of the latencies of all processors in the chain.
+         */
+        [[nodiscard]] size_t get_latency_samples() const override;
+
+    private:
+        std::vector<std::unique_ptr<Processor> > processors_;
+        std::vector<BufferView> views_; // Scratch for process(AudioBuffer &), sized in prepare()
+    };
+}
+
+#endif //GW_CORE_PROCESSOR_H
@@ -0,0 +1,149 @@
+#ifndef GW_CORE_PROCESSOR_ABI_H
+#define GW_CORE_PROCESSOR_ABI_H
+
+/**
+ *  Stable C ABI between a host and processors built separately against
+ *  gw-core (plugins).
+ *
+ *  Everything that crosses the boundary is a plain C struct or a C
+ *  function pointer, so a processor built with a different compiler,
+ *  standard library or gw-core version can be loaded as long as the ABI
+ *  version matches. This header is valid C99 and C++.
+ *
+ *  One call processes one block described by a gw_process_block: every
+ *  channel pointer, the events and the parameter changes that fall in the
+ *  block. process_batch() takes several consecutive blocks in one call;
+ *  the host uses it when it can wait for all of them (offline rendering,
+ *  a device block split at automation points, tiny blocks).
+ *
+ *  Compatibility rules:
+ *      - GW_PROCESSOR_ABI_VERSION changes only for incompatible changes;
+ *        host and processor must agree on it
+ *      - Structs only grow at the end; every struct that can grow starts
+ *        with struct_size, and readers ignore fields past the size they
+ *        were given
+ *      - reserved fields are written as zero and ignored
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GW_PROCESSOR_ABI_VERSION 1u
+
+/** Name of the function a processor library exports (see gw_create_processor_fn). */
+#define GW_PROCESSOR_ENTRY_NAME "gw_create_processor"
+
+/** Status codes returned across the boundary. */
+#define GW_STATUS_OK 0
+#define GW_STATUS_ERROR (-1)
+#define GW_STATUS_VERSION_MISMATCH (-2)
+#define GW_STATUS_INVALID_ARGUMENT (-3)
+
+/** Event types. Values below 0x10000 are reserved for gw-core. */
+#define GW_EVENT_NOTE_ON 1u
+#define GW_EVENT_NOTE_OFF 2u
+#define GW_EVENT_MIDI 3u
+
+/** gw_process_block flags. */
+#define GW_BLOCK_SILENT_INPUT 0x1u /* Every input sample is zero */
+#define GW_BLOCK_OFFLINE 0x2u /* Rendering faster or slower than real time */
+
+/**
+ *  A timestamped event within a block. 24 bytes.
+ */
+typedef struct gw_event {
+    uint32_t sample_offset; /* From the start of the block, < num_samples */
+    uint32_t type; /* GW_EVENT_* */
+    uint32_t id; /* Note or voice id */
+    float value; /* Velocity, pressure, ... */
+    uint8_t midi[4]; /* Raw bytes for GW_EVENT_MIDI */
+    uint32_t reserved;
+} gw_event;
+
+/**
+ *  A parameter value taking effect at a sample within a block. 16 bytes.
+ */
+typedef struct gw_parameter_change {
+    uint32_t sample_offset;
+    uint32_t parameter_id;
+    float value;
+    uint32_t reserved;
+} gw_parameter_change;
+
+/**
+ *  Everything a processor needs for one block. 64 bytes on 64-bit targets.
+ *
+ *  channels points at num_channels sample pointers, each valid for
+ *  num_samples floats, processed in place. Events and parameter changes
+ *  are sorted by sample_offset. All pointers are owned by the host and
+ *  only valid during the call.
+ */
+typedef struct gw_process_block {
+    uint32_t struct_size; /* sizeof(gw_process_block) as the host built it */
+    uint32_t flags; /* GW_BLOCK_* */
+    uint32_t num_channels;
+    uint32_t num_samples;
+    uint64_t sample_position; /* Of the block's first sample, since the transport started */
+    float *const *channels;
+    const gw_event *events;
+    const gw_parameter_change *parameter_changes;
+    uint32_t num_events;
+    uint32_t num_parameter_changes;
+    uint64_t reserved;
+} gw_process_block;
+
+/**
+ *  A processor instance and its entry points, filled in by the processor.
+ *
+ *  The entry points up to destroy are required. The ones after it are
+ *  optional and may be NULL; a table whose struct_size ends at destroy
+ *  (GW_PROCESSOR_MIN_STRUCT_SIZE) is valid, and new optional entry points
+ *  are only ever appended.
+ *
+ *  Threading follows gw::core::Processor: prepare() and destroy() are
+ *  called from a non-real-time thread, everything else from the audio
+ *  thread and never concurrently.
+ */
+typedef struct gw_processor {
+    uint32_t struct_size; /* sizeof(gw_processor) as the processor filled it */
+    uint32_t abi_version; /* GW_PROCESSOR_ABI_VERSION */
+    void *instance; /* Passed back as the first argument of every call */
+
+    /* Allocate for at most max_block_size samples and num_channels channels. */
+    int32_t (*prepare)(void *instance, double sample_rate, uint32_t max_block_size, uint32_t num_channels);
+
+    /* Process one block in place. */
+    void (*process)(void *instance, const gw_process_block *block);
+
+    /* Free the instance. The table must not be used afterwards. */
+    void (*destroy)(void *instance);
+
+    /* Process consecutive blocks in order, as if by one process() call
+     * each. May be NULL: the host then calls process() per block. */
+    void (*process_batch)(void *instance, const gw_process_block *blocks, uint32_t num_blocks);
+
+    void (*reset)(void *instance);
+
+    uint32_t (*get_latency_samples)(const void *instance);
+} gw_processor;
+
+/** Smallest valid gw_processor::struct_size: everything up to destroy. */
+#define GW_PROCESSOR_MIN_STRUCT_SIZE (offsetof(gw_processor, destroy) + sizeof(void (*)(void *)))
+
+/**
+ *  Signature of the function a processor library exports as
+ *  GW_PROCESSOR_ENTRY_NAME. Fills out (whose struct_size the host sets)
+ *  and returns GW_STATUS_OK, or GW_STATUS_VERSION_MISMATCH if it can't
+ *  speak host_abi_version.
+ */
+typedef int32_t (*gw_create_processor_fn)(uint32_t host_abi_version, gw_processor *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GW_CORE_PROCESSOR_ABI_H */
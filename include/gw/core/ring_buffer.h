@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <atomic>
+#include "gw/core/sample_types.h"
 
 namespace gw::core {
     /**
@@ -19,32 +20,38 @@ namespace gw::core {
         *  This implementation uses atomic operations for thread safety
         *  without locks, making it suitable for real-time audio
         *
-        *  The buffer stores float samples. For multichannel audio,
-        *  you typically create one RingBuffer per channel or interleave
-        *  the channels yourself.
+        *  The buffer stores samples of type T (RingBuffer is float).
+        *  For multichannel audio, you typically create one RingBuffer
+        *  per channel or interleave the channels yourself.
         */
-    class RingBuffer {
+    template<typename T>
+    class BasicRingBuffer {
+        static_assert(is_sample_type_v<T>, "BasicRingBuffer requires a gw::core sample type");
+
     public:
+        using sample_type = T;
+
         /**
          *  Create a ring buffer.
          *
          *  @param capacity Number of samples the buffer can hold
          *
-         *  Note: Actual capacity is capacity-1 to distinguish full from empty
+         *  Note: One extra slot is allocated to distinguish full from empty,
+         *  so get_capacity() returns capacity + 1
          */
-        explicit RingBuffer(size_t capacity);
+        explicit BasicRingBuffer(size_t capacity);
 
-        ~RingBuffer();
+        ~BasicRingBuffer();
 
         // Ring buffers should not be copied (they manage memory)
-        RingBuffer(const RingBuffer &) = delete;
+        BasicRingBuffer(const BasicRingBuffer &) = delete;
 
-        RingBuffer &operator=(const RingBuffer &) = delete;
+        BasicRingBuffer &operator=(const BasicRingBuffer &) = delete;
 
         // Move is allowed
-        RingBuffer(RingBuffer &&other) noexcept;
+        BasicRingBuffer(BasicRingBuffer &&other) noexcept;
 
-        RingBuffer &operator=(RingBuffer &&other) noexcept;
+        BasicRingBuffer &operator=(BasicRingBuffer &&other) noexcept;
 
         /**
          *  Write samples to the buffer (producer side)
@@ -53,10 +60,10 @@ namespace gw::core {
          *  @param count Number of samples
          *  @return Number of samples actually written (may be less if the buffer is full)
          *
-         *  NOT real-time safe (allocates if buffer is full).
+         *  Real-time safe (never allocates; a full buffer just writes less).
          *  Typically called from main/UI thread
          */
-        size_t write(const float *data, size_t count);
+        size_t write(const T *data, size_t count);
 
         /**
          *  Read samples from the buffer (consumer side).
@@ -68,12 +75,13 @@ namespace gw::core {
          *  IS real-time safe.
          *  Typically called from the audio thread.
          */
-        size_t read(float *data, size_t count);
+        size_t read(T *data, size_t count);
 
         /**
-         *  Get number of samples available to ead.
+         *  Get number of samples available to read.
          *
-         *  Real-time safe.
+         *  Real-time safe. From either side the answer is a lower bound: the
+         *  other thread may have moved on since.
          */
         [[nodiscard]] size_t get_available_read() const;
 
@@ -93,20 +101,40 @@ namespace gw::core {
         void clear();
 
         /**
-         *  Get total capacity
+         *  Touch every page of the storage so neither side takes a first-touch
+         *  page fault on the audio thread. Contents are preserved.
+         *
+         *  NOT real-time safe. Call before the producer and consumer start.
+         */
+        void prefault();
+
+        /**
+         *  Get the number of slots, including the one that always stays free
          */
         [[nodiscard]] size_t get_capacity() const { return capacity_; }
 
     private:
         size_t capacity_;
-        float *buffer_;
+        T *buffer_;
 
-        // Atomic indices for lock-free operation
-        std::atomic<size_t> write_pos_;
-        std::atomic<size_t> read_pos_;
+        // Atomic indices for lock-free operation, on separate cache lines so
+        // the producer and consumer don't invalidate each other on every call
+        alignas(64) std::atomic<size_t> write_pos_;
+        alignas(64) std::atomic<size_t> read_pos_;
 
         void free_memory();
     };
+
+    // Instantiated in ring_buffer.cpp
+    extern template class BasicRingBuffer<float>;
+    extern template class BasicRingBuffer<double>;
+    extern template class BasicRingBuffer<Half>;
+    extern template class BasicRingBuffer<BFloat16>;
+
+    using RingBuffer = BasicRingBuffer<float>;
+    using DoubleRingBuffer = BasicRingBuffer<double>;
+    using HalfRingBuffer = BasicRingBuffer<Half>;
+    using BFloat16RingBuffer = BasicRingBuffer<BFloat16>;
 }
 
 #endif //GW_CORE_RING_BUFFER_H
@@ -0,0 +1,252 @@
+#ifndef GW_CORE_RT_H
+#define GW_CORE_RT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ *  Real-time thread setup (Linux).
+ *
+ *  An audio thread misses its deadline for reasons unrelated to the DSP
+ *  itself: it is preempted by a normal-priority thread, migrated to a busy
+ *  core, or takes a page fault the first time it touches a buffer that
+ *  was swapped out or split from a huge page. These helpers cover the
+ *  usual setup done once, before the thread starts processing:
+ *
+ *      1. lock_memory()                 keep every page resident
+ *      2. prefault buffers and stacks   so the first touch is not in the callback
+ *      3. set_fifo_priority() / set_deadline()
+ *      4. pin_to_cpus(get_isolated_cpus())
+ *
+ *  and a FaultMonitor to verify, per block, that processing really did
+ *  not fault or block.
+ *
+ *  Scheduling and memory locking usually need CAP_SYS_NICE / CAP_IPC_LOCK
+ *  or suitable rlimits (RLIMIT_RTPRIO, RLIMIT_MEMLOCK). Every call
+ *  reports failure instead of aborting, so a host can run without them.
+ *
+ *  On other systems the library still builds: scheduling, affinity and
+ *  memory locking return false, prefault_stack() does nothing,
+ *  allocate_huge_pages() returns nullptr (callers fall back to the heap)
+ *  and the thread counters read as zero. prefault() works everywhere.
+ *
+ *  None of these functions are real-time safe, except the FaultMonitor
+ *  calls noted below.
+ */
+namespace gw::core::rt {
+    /**
+     *  Make the calling thread SCHED_FIFO.
+     *
+     *  @param priority 1 (lowest) to 99; audio usually runs around 70-90
+     *  @return false if the policy could not be set (e.g. no permission)
+     */
+    bool set_fifo_priority(int priority);
+
+    /**
+     *  Make the calling thread SCHED_DEADLINE: it is guaranteed `runtime_ns`
+     *  of CPU in every `period_ns`, finished within `deadline_ns` of the
+     *  period start. For an audio callback, period = block duration and
+     *  runtime = the worst-case processing time plus a margin.
+     *
+     *  SCHED_DEADLINE threads cannot be pinned to a subset of CPUs with
+     *  pin_to_cpus(); isolate them with cpusets instead.
+     *
+     *  @return false if the kernel rejected the parameters or permission is missing
+     */
+    bool set_deadline(uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns);
+
+    /**
+     *  Return the calling thread to SCHED_OTHER.
+     */
+    bool set_normal_priority();
+
+    /**
+     *  Restrict the calling thread to the given CPUs.
+     *
+     *  @return false if the list is empty or names no usable CPU
+     */
+    bool pin_to_cpus(const std::vector<int> &cpus);
+
+    /**
+     *  CPUs the calling thread may run on.
+     */
+    std::vector<int> get_allowed_cpus();
+
+    /**
+     *  CPUs removed from the general scheduler with isolcpus=, read from
+     *  /sys/devices/system/cpu/isolated. Empty if none are isolated.
+     */
+    std::vector<int> get_isolated_cpus();
+
+    /**
+     *  Parse a kernel CPU list such as "2-3,6".
+     *
+     *  @return The CPUs in order, or empty if the string is malformed
+     */
+    std::vector<int> parse_cpu_list(const std::string &list);
+
+    /**
+     *  mlockall(MCL_CURRENT | MCL_FUTURE): keep every current and future
+     *  page of the process in RAM.
+     *
+     *  @return false if locking failed (usually RLIMIT_MEMLOCK)
+     */
+    bool lock_memory();
+
+    /**
+     *  Undo lock_memory().
+     */
+    bool unlock_memory();
+
+    /**
+     *  Touch every page in a range so it is mapped and writable.
+     *  Contents are preserved. Do not call while another thread writes
+     *  the range.
+     */
+    void prefault(void *data, size_t bytes);
+
+    /**
+     *  Touch `bytes` of the calling thread's stack below the current frame,
+     *  so deep calls in the audio callback do not fault in new stack pages.
+     *  Keep it well below the thread's stack size.
+     */
+    void prefault_stack(size_t bytes = 256 * 1024);
+
+    /**
+     *  Size of a transparent or explicit huge page (usually 2 MiB).
+     */
+    size_t get_huge_page_size();
+
+    /**
+     *  Allocate memory backed by huge pages where the system allows it.
+     *
+     *  Tries explicit huge pages (MAP_HUGETLB) first, then a huge-page
+     *  aligned anonymous mapping with MADV_HUGEPAGE, so the allocation
+     *  succeeds whenever plain memory is available. The memory is zeroed
+     *  and page-aligned.
+     *
+     *  @return Pointer to free with free_huge_pages(pointer, bytes), or nullptr
+     */
+    void *allocate_huge_pages(size_t bytes);
+
+    /**
+     *  Free memory from allocate_huge_pages() with the same size.
+     */
+    void free_huge_pages(void *data, size_t bytes);
+
+    /**
+     *  Thread resource counters from getrusage(RUSAGE_THREAD).
+     */
+    struct ThreadCounters {
+        uint64_t minor_faults = 0; // Page mapped without I/O (first touch, COW, THP split)
+        uint64_t major_faults = 0; // Page read from disk or swap
+        uint64_t voluntary_switches = 0; // Thread blocked (lock, I/O, sleep)
+        uint64_t involuntary_switches = 0; // Thread preempted
+    };
+
+    /**
+     *  Counters of the calling thread. One syscall; cheap enough per block.
+     */
+    ThreadCounters read_thread_counters();
+
+    /**
+     *  Totals collected by a FaultMonitor.
+     */
+    struct FaultStats {
+        uint64_t blocks = 0;
+        uint64_t dirty_blocks = 0; // Blocks with any fault or switch
+        ThreadCounters totals;
+    };
+
+    /**
+     *  Detects page faults and context switches inside the audio callback.
+     *
+     *  Wrap the processing of each block with begin() and end() on the
+     *  audio thread. Any fault or switch between them means the callback
+     *  touched non-resident memory, blocked, or was preempted. Totals can
+     *  be read from any thread with get_stats().
+     *
+     *  begin() and end() each make one getrusage() syscall and never block.
+     */
+    class FaultMonitor {
+    public:
+        FaultMonitor();
+
+        /**
+         *  Snapshot the counters before processing. Audio thread only.
+         */
+        void begin();
+
+        /**
+         *  Compare against the snapshot taken by begin(). Audio thread only.
+         *
+         *  @return true if the block ran without faults or switches
+         */
+        bool end();
+
+        /**
+         *  Totals since construction or reset(). Safe from any thread;
+         *  the fields are read individually, so they may be one block apart.
+         */
+        [[nodiscard]] FaultStats get_stats() const;
+
+        /**
+         *  Zero the totals. Call while the audio thread is not inside begin()/end().
+         */
+        void reset();
+
+    private:
+        ThreadCounters start_;
+
+        std::atomic<uint64_t> blocks_;
+        std::atomic<uint64_t> dirty_blocks_;
+        std::atomic<uint64_t> minor_faults_;
+        std::atomic<uint64_t> major_faults_;
+        std::atomic<uint64_t> voluntary_switches_;
+        std::atomic<uint64_t> involuntary_switches_;
+    };
+
+    /**
+     *  Everything the audio thread setup needs, for make_realtime().
+     */
+    struct RealtimeConfig {
+        enum class Policy {
+            Normal, // Leave scheduling alone
+            Fifo,
+            Deadline
+        };
+
+        Policy policy = Policy::Fifo;
+        int priority = 80; // SCHED_FIFO priority
+        uint64_t runtime_ns = 0; // SCHED_DEADLINE parameters
+        uint64_t deadline_ns = 0;
+        uint64_t period_ns = 0;
+
+        // CPUs to pin to. Empty = the isolated CPUs if any, else no pinning.
+        std::vector<int> cpus;
+
+        bool lock_memory = true;
+        size_t prefault_stack_bytes = 256 * 1024;
+    };
+
+    /**
+     *  Which steps of make_realtime() succeeded.
+     */
+    struct RealtimeStatus {
+        bool scheduling = false;
+        bool affinity = false;
+        bool memory_locked = false;
+    };
+
+    /**
+     *  Apply a RealtimeConfig to the calling thread: lock memory, pre-fault
+     *  the stack, pin, then change the scheduling policy. Steps that are
+     *  not requested count as succeeded.
+     */
+    RealtimeStatus make_realtime(const RealtimeConfig &config = RealtimeConfig());
+}
+
+#endif //GW_CORE_RT_H
@@ -0,0 +1,234 @@
+#ifndef GW_CORE_SAMPLE_CACHE_H
+#define GW_CORE_SAMPLE_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/audio_io.h"
+#include "gw/core/buffer_view.h"
+
+namespace gw::core {
+    struct SampleCacheEntry;
+    class SampleCache;
+
+    /**
+     *  Settings for SampleCache.
+     */
+    struct SampleCacheSettings {
+        // Directory holding the content-addressed sample files (<hash>.gwsc).
+        // Shared by every cache (and process) pointed at it.
+        std::string directory;
+
+        // Upper bound on resident sample memory (attacks + streamed tails)
+        size_t memory_budget = 512u * 1024u * 1024u;
+
+        size_t chunk_frames = 16384; // Streaming granularity
+        size_t attack_frames = 32768; // Preloaded and locked per sample (rounded up to whole chunks)
+        size_t prefetch_chunks = 2; // Chunks requested ahead of each read
+
+        float poll_interval_ms = 5.0f; // Background reader period
+        size_t eviction_grace_polls = 20; // Chunks used this recently are never evicted
+    };
+
+    /**
+     *  Residency statistics of a SampleCache.
+     */
+    struct SampleCacheStats {
+        size_t samples = 0; // Mapped samples
+        size_t referenced_samples = 0; // Samples with live handles
+        size_t mapped_bytes = 0; // Total size of all mapped sample data
+        size_t resident_bytes = 0; // Attacks plus streamed chunks the cache keeps resident
+        size_t attack_bytes = 0;
+        size_t memory_budget = 0;
+        uint64_t hits = 0; // Loads satisfied by an already mapped or stored sample
+        uint64_t loads = 0; // Samples written to the store
+        uint64_t chunks_streamed = 0;
+        uint64_t chunks_evicted = 0;
+        uint64_t samples_evicted = 0;
+        uint64_t misses = 0; // Reads cut short because a chunk was not resident yet
+    };
+
+    /**
+     *  Reference-counted handle to a cached sample. Copying a handle adds a
+     *  reference; the sample's memory stays mapped, and its attack stays
+     *  resident, while any handle exists. Handles must not outlive the cache.
+     *
+     *  Copying and destroying handles is lock-free but NOT meant for the
+     *  audio thread; hand voices a handle prepared in advance.
+     */
+    class SampleHandle {
+    public:
+        SampleHandle() : entry_(nullptr) {}
+
+        ~SampleHandle();
+
+        SampleHandle(const SampleHandle &other);
+
+        SampleHandle &operator=(const SampleHandle &other);
+
+        SampleHandle(SampleHandle &&other) noexcept;
+
+        SampleHandle &operator=(SampleHandle &&other) noexcept;
+
+        [[nodiscard]] bool is_valid() const { return entry_ != nullptr; }
+
+        [[nodiscard]] uint64_t get_id() const;
+        [[nodiscard]] size_t get_num_channels() const;
+        [[nodiscard]] size_t get_num_frames() const;
+        [[nodiscard]] double get_sample_rate() const;
+
+        /**
+         *  Frames from the start that are always resident (the preloaded attack).
+         */
+        [[nodiscard]] size_t get_attack_frames() const;
+
+        /**
+         *  Zero-copy view of frames [start, start + count) of a channel,
+         *  shortened to the part that is resident right now. Queues the
+         *  chunks it could not return, and the next prefetch_chunks after
+         *  them, for the background reader.
+         *
+         *  The view points into read-only shared memory: never write to it.
+         *
+         *  Real-time safe (atomics only); never touches non-resident pages.
+         *
+         *  @return The view; shorter than count (possibly empty) on a miss
+         */
+        [[nodiscard]] BufferView get_resident_view(size_t channel, size_t start, size_t count) const;
+
+        /**
+         *  View of a whole channel with no residency guarantee: reading it
+         *  may page in from disk. For offline use. Read-only, as above.
+         */
+        [[nodiscard]] BufferView get_view(size_t channel) const;
+
+    private:
+        friend class SampleCache;
+
+        explicit SampleHandle(SampleCacheEntry *entry);
+
+        SampleCacheEntry *entry_;
+    };
+
+    /**
+     *  Shared, content-addressed cache of sample data for samplers.
+     *
+     *  Loading a sample hashes its contents. Identical samples loaded by
+     *  any number of sampler instances map the same file once; separate
+     *  processes using the same directory share it through the page cache.
+     *
+     *  Each sample is stored as planar 32-bit float, one page-aligned
+     *  region per channel, so voices read through BufferViews straight
+     *  from the mapping with no copies and no conversion.
+     *
+     *  Only the first attack_frames of each sample are preloaded (and
+     *  mlock'd where permitted). Voices that play past the attack get
+     *  shorter views while the tail is not resident yet; their requests
+     *  are served by a background reader thread that pages chunks in
+     *  ahead of playback. When resident memory exceeds the budget, the
+     *  least recently used tail chunks are dropped, then unreferenced
+     *  samples are unmapped.
+     *
+     *  Linux only (mmap/madvise/mincore): built when GW_CORE_SAMPLE_CACHE
+     *  is on (the default there), which defines GW_CORE_HAS_SAMPLE_CACHE.
+     */
+    class SampleCache {
+    public:
+        explicit SampleCache(const SampleCacheSettings &settings);
+
+        ~SampleCache();
+
+        SampleCache(const SampleCache &) = delete;
+
+        SampleCache &operator=(const SampleCache &) = delete;
+
+        /**
+         *  Add a sample from a buffer, or share the existing copy.
+         *  NOT real-time safe.
+         *
+         *  @param num_frames Frames to take from the buffer (clipped to its length)
+         *  @return Handle, invalid if the store could not be written or mapped
+         */
+        SampleHandle load(const AudioBuffer &samples, size_t num_frames, double sample_rate);
+
+        /**
+         *  Add a sample by reading a source to its end. NOT real-time safe.
+         */
+        SampleHandle load(AudioSource &source);
+
+        /**
+         *  Content hash used as the sample's id (and file name).
+         */
+        static uint64_t compute_id(const AudioBuffer &samples, size_t num_frames, double sample_rate);
+
+        /**
+         *  Start/stop the background reader thread.
+         */
+        void start();
+
+        void stop();
+
+        /**
+         *  Serve queued chunk requests and enforce the budget once, on the
+         *  calling thread. For tests and hosts with their own I/O thread.
+         *  Do not call while the reader thread is running.
+         */
+        void poll();
+
+        [[nodiscard]] SampleCacheStats get_stats() const;
+
+        /**
+         *  Bytes of mapped sample data the kernel actually has in RAM right
+         *  now (mincore), which may exceed the cache's own accounting when
+         *  other processes share the files.
+         */
+        [[nodiscard]] size_t measure_resident_bytes() const;
+
+        [[nodiscard]] const SampleCacheSettings &get_settings() const { return settings_; }
+
+    private:
+        friend class SampleHandle;
+
+        SampleCacheSettings settings_;
+        size_t page_size_;
+
+        mutable std::mutex mutex_; // Guards entries_ and the budget bookkeeping
+        std::unordered_map<uint64_t, std::unique_ptr<SampleCacheEntry> > entries_;
+
+        std::atomic<uint32_t> tick_; // Advances once per poll; the LRU clock
+        std::atomic<size_t> resident_bytes_;
+        std::atomic<uint64_t> hits_;
+        std::atomic<uint64_t> loads_;
+        std::atomic<uint64_t> chunks_streamed_;
+        std::atomic<uint64_t> chunks_evicted_;
+        std::atomic<uint64_t> samples_evicted_;
+        std::atomic<uint64_t> misses_;
+
+        std::atomic<bool> running_;
+        std::thread thread_;
+
+        SampleHandle share(uint64_t id, const float *const *channels, size_t num_channels,
+                           size_t num_frames, double sample_rate);
+
+        bool write_store_file(const std::string &path, uint64_t id, const float *const *channels,
+                              size_t num_channels, size_t num_frames, double sample_rate) const;
+
+        std::unique_ptr<SampleCacheEntry> map_store_file(const std::string &path, uint64_t id);
+
+        void stream_chunk(SampleCacheEntry &entry, size_t chunk);
+
+        void enforce_budget();
+
+        void unmap(SampleCacheEntry &entry);
+
+        [[nodiscard]] std::string get_path(uint64_t id) const;
+    };
+}
+
+#endif //GW_CORE_SAMPLE_CACHE_H
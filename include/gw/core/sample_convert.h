@@ -0,0 +1,54 @@
+#ifndef GW_CORE_SAMPLE_CONVERT_H
+#define GW_CORE_SAMPLE_CONVERT_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "gw/core/sample_types.h"
+
+namespace gw::core {
+    /**
+     *  Convert a block of samples between sample types.
+     *
+     *  The float <-> Half and float <-> BFloat16 overloads are vectorized and
+     *  pick the widest instruction set available at runtime (AVX-512F, then
+     *  F16C, then a portable scalar loop). All of them round to nearest even.
+     *
+     *  Real-time safe (no allocations). src and dst must not overlap.
+     */
+    void convert_samples(const float *src, Half *dst, size_t count);
+
+    void convert_samples(const Half *src, float *dst, size_t count);
+
+    void convert_samples(const float *src, BFloat16 *dst, size_t count);
+
+    void convert_samples(const BFloat16 *src, float *dst, size_t count);
+
+    void convert_samples(const float *src, double *dst, size_t count);
+
+    void convert_samples(const double *src, float *dst, size_t count);
+
+    /**
+     *  Fallback for every other pair of sample types.
+     *
+     *  Same-type conversions are a plain memcpy; anything else goes through
+     *  float one sample at a time (e.g. double -> Half).
+     */
+    template<typename Src, typename Dst>
+    void convert_samples(const Src *src, Dst *dst, size_t count) {
+        static_assert(is_sample_type_v<Src> && is_sample_type_v<Dst>,
+                      "convert_samples only supports gw::core sample types");
+
+        if (!src || !dst) return;
+
+        if constexpr (std::is_same_v<Src, Dst>) {
+            std::memcpy(dst, src, count * sizeof(Src));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = Dst(static_cast<float>(src[i]));
+            }
+        }
+    }
+}
+
+#endif //GW_CORE_SAMPLE_CONVERT_H
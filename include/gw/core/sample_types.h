@@ -0,0 +1,171 @@
+#ifndef GW_CORE_SAMPLE_TYPES_H
+#define GW_CORE_SAMPLE_TYPES_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace gw::core {
+    /**
+     *  IEEE 754 binary16 ("half precision") sample storage.
+     *
+     *  This is a storage format, not an arithmetic type: convert to float,
+     *  do the math, and convert back. Half has an 11-bit significand, which is
+     *  roughly 66 dB of resolution - plenty for sample caches and transport,
+     *  not enough for filter state.
+     *
+     *  Conversions round to nearest even, matching the F16C instructions.
+     *  Trivial type: Half{} is +0.0, a default-initialized Half is indeterminate
+     *  (just like float).
+     */
+    class Half {
+    public:
+        Half() = default;
+
+        explicit Half(float value) : bits_(from_float_bits(value)) {
+        }
+
+        operator float() const { return to_float(bits_); }
+
+        [[nodiscard]] uint16_t get_bits() const { return bits_; }
+
+        static Half from_bits(uint16_t bits) {
+            Half h;
+            h.bits_ = bits;
+            return h;
+        }
+
+        static uint16_t from_float_bits(float value) {
+            constexpr uint32_t f32_infinity = 255u << 23;
+            constexpr uint32_t f16_max = (127u + 16u) << 23;
+            constexpr uint32_t denorm_magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+            uint32_t x;
+            std::memcpy(&x, &value, sizeof(x));
+            const uint32_t sign = x & 0x80000000u;
+            x ^= sign;
+
+            uint32_t out;
+            if (x >= f16_max) {
+                // Overflow becomes infinity, NaN stays a (quiet) NaN
+                out = (x > f32_infinity) ? 0x7e00u : 0x7c00u;
+            } else if (x < (113u << 23)) {
+                // Result is a half subnormal (or zero): let the FPU do the rounding
+                float f;
+                float magic;
+                std::memcpy(&f, &x, sizeof(f));
+                std::memcpy(&magic, &denorm_magic_bits, sizeof(magic));
+                f += magic;
+                std::memcpy(&out, &f, sizeof(out));
+                out -= denorm_magic_bits;
+            } else {
+                // Normal number: rebias the exponent and round to nearest even
+                const uint32_t mantissa_odd = (x >> 13) & 1u;
+                x += 0xc8000fffu; // ((15 - 127) << 23) + 0xfff, wrapping
+                x += mantissa_odd;
+                out = x >> 13;
+            }
+
+            return static_cast<uint16_t>(out | (sign >> 16));
+        }
+
+        static float to_float(uint16_t bits) {
+            constexpr uint32_t shifted_exponent = 0x7c00u << 13;
+            constexpr uint32_t magic_bits = 113u << 23;
+
+            uint32_t out = (static_cast<uint32_t>(bits) & 0x7fffu) << 13;
+            const uint32_t exponent = shifted_exponent & out;
+            out += (127u - 15u) << 23;
+
+            if (exponent == shifted_exponent) {
+                // Infinity or NaN
+                out += (128u - 16u) << 23;
+            } else if (exponent == 0) {
+                // Zero or subnormal: renormalize through the FPU
+                out += 1u << 23;
+                float f;
+                float magic;
+                std::memcpy(&f, &out, sizeof(f));
+                std::memcpy(&magic, &magic_bits, sizeof(magic));
+                f -= magic;
+                std::memcpy(&out, &f, sizeof(out));
+            }
+
+            out |= (static_cast<uint32_t>(bits) & 0x8000u) << 16;
+
+            float result;
+            std::memcpy(&result, &out, sizeof(result));
+            return result;
+        }
+
+    private:
+        uint16_t bits_;
+    };
+
+    /**
+     *  bfloat16 sample storage (the top 16 bits of an IEEE float).
+     *
+     *  Same dynamic range as float with only 8 bits of significand.
+     *  Useful where range matters more than resolution, e.g. transporting
+     *  intermediate mix busses between render nodes.
+     */
+    class BFloat16 {
+    public:
+        BFloat16() = default;
+
+        explicit BFloat16(float value) : bits_(from_float_bits(value)) {
+        }
+
+        operator float() const { return to_float(bits_); }
+
+        [[nodiscard]] uint16_t get_bits() const { return bits_; }
+
+        static BFloat16 from_bits(uint16_t bits) {
+            BFloat16 b;
+            b.bits_ = bits;
+            return b;
+        }
+
+        static uint16_t from_float_bits(float value) {
+            uint32_t x;
+            std::memcpy(&x, &value, sizeof(x));
+
+            if ((x & 0x7fffffffu) > 0x7f800000u) {
+                // Keep NaN a NaN even if the payload lives in the low bits
+                return static_cast<uint16_t>((x >> 16) | 0x40u);
+            }
+
+            // Round to nearest even
+            x += 0x7fffu + ((x >> 16) & 1u);
+            return static_cast<uint16_t>(x >> 16);
+        }
+
+        static float to_float(uint16_t bits) {
+            const uint32_t x = static_cast<uint32_t>(bits) << 16;
+            float result;
+            std::memcpy(&result, &x, sizeof(result));
+            return result;
+        }
+
+    private:
+        uint16_t bits_;
+    };
+
+    static_assert(sizeof(Half) == 2, "Half must be exactly 16 bits");
+    static_assert(sizeof(BFloat16) == 2, "BFloat16 must be exactly 16 bits");
+    static_assert(std::is_trivial_v<Half> && std::is_trivial_v<BFloat16>,
+                  "16-bit sample types must be memcpy/memset-able");
+
+    /**
+     *  True for the sample types the containers are instantiated for:
+     *  float (the default), double, Half and BFloat16.
+     */
+    template<typename T>
+    inline constexpr bool is_sample_type_v =
+            std::is_same_v<T, float> ||
+            std::is_same_v<T, double> ||
+            std::is_same_v<T, Half> ||
+            std::is_same_v<T, BFloat16>;
+}
+
+#endif //GW_CORE_SAMPLE_TYPES_H
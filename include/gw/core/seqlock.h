@@ -0,0 +1,99 @@
+#ifndef GW_CORE_SEQLOCK_H
+#define GW_CORE_SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace gw::core {
+    /**
+     *  Single-writer sequence lock for publishing small values.
+     *
+     *  The writer never waits, which makes it suitable for the audio thread
+     *  publishing meter values. Readers retry if they overlap a write, so they
+     *  always see a complete, consistent value.
+     *
+     *  The payload is copied through relaxed atomic words rather than a raw
+     *  memcpy, so concurrent reads and writes are well-defined (and clean
+     *  under ThreadSanitizer).
+     *
+     *  T must be trivially copyable and a multiple of 4 bytes.
+     */
+    template<typename T>
+    class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "Seqlock requires a trivially copyable type");
+        static_assert(sizeof(T) % sizeof(uint32_t) == 0, "Seqlock payload must be a multiple of 4 bytes");
+
+    public:
+        Seqlock() : sequence_(0) {
+            for (auto &word: words_) {
+                word.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        Seqlock(const Seqlock &) = delete;
+
+        Seqlock &operator=(const Seqlock &) = delete;
+
+        /**
+         *  Publish a new value. Only one thread may call this.
+         *  Real-time safe and wait-free.
+         */
+        void store(const T &value) {
+            uint32_t words[NUM_WORDS];
+            std::memcpy(words, &value, sizeof(T));
+
+            const uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+            sequence_.store(sequence + 1, std::memory_order_relaxed); // Odd: write in progress
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (size_t i = 0; i < NUM_WORDS; ++i) {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+
+            sequence_.store(sequence + 2, std::memory_order_release);
+        }
+
+        /**
+         *  Read the latest value. Any number of threads may call this.
+         *  Lock-free, but may retry while the writer is mid-update.
+         */
+        [[nodiscard]] T load() const {
+            uint32_t words[NUM_WORDS];
+            uint32_t before;
+            uint32_t after;
+
+            do {
+                before = sequence_.load(std::memory_order_acquire);
+
+                for (size_t i = 0; i < NUM_WORDS; ++i) {
+                    words[i] = words_[i].load(std::memory_order_relaxed);
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence_.load(std::memory_order_relaxed);
+            } while ((before & 1u) != 0 || before != after);
+
+            T value;
+            std::memcpy(&value, words, sizeof(T));
+            return value;
+        }
+
+        /**
+         *  Number of values published so far.
+         */
+        [[nodiscard]] uint32_t get_version() const {
+            return sequence_.load(std::memory_order_acquire) / 2;
+        }
+
+    private:
+        static constexpr size_t NUM_WORDS = sizeof(T) / sizeof(uint32_t);
+
+        std::atomic<uint32_t> sequence_;
+        std::atomic<uint32_t> words_[NUM_WORDS];
+    };
+}
+
+#endif //GW_CORE_SEQLOCK_H
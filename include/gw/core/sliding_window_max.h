@@ -0,0 +1,88 @@
+#ifndef GW_CORE_SLIDING_WINDOW_MAX_H
+#define GW_CORE_SLIDING_WINDOW_MAX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gw::core {
+    /**
+     *  Running maximum over the last N samples in O(1) amortized time.
+     *
+     *  Keeps a monotonic deque of (value, position) candidates: a new sample
+     *  evicts every older candidate that is not larger, so each sample is
+     *  pushed and popped at most once regardless of the window length.
+     *  A naive rescan costs O(N) per sample, which at 10 ms lookahead is
+     *  480 comparisons per sample at 48 kHz.
+     *
+     *  Used as the peak detector for lookahead dynamics. Feed it |x|.
+     *
+     *  Memory is allocated in the constructor only; everything else is
+     *  real-time safe.
+     */
+    class SlidingWindowMax {
+    public:
+        /**
+         *  @param max_window Largest window that set_window() will accept
+         */
+        explicit SlidingWindowMax(size_t max_window);
+
+        /**
+         *  Change the window length (clamped to 1..max_window).
+         *  Resets the history.
+         */
+        void set_window(size_t window);
+
+        [[nodiscard]] size_t get_window() const { return window_; }
+        [[nodiscard]] size_t get_max_window() const { return max_window_; }
+
+        /**
+         *  Forget all previous samples.
+         */
+        void reset();
+
+        /**
+         *  Add a sample and get the maximum of the last get_window() samples
+         *  (or of every sample since reset(), if fewer have been pushed).
+         */
+        float push(float value) {
+            // Drop candidates that can never be the maximum again
+            while (size_ > 0 && values_[(head_ + size_ - 1) & mask_] <= value) {
+                --size_;
+            }
+
+            const size_t slot = (head_ + size_) & mask_;
+            values_[slot] = value;
+            positions_[slot] = position_;
+            ++size_;
+
+            // Drop the oldest candidate once it slides out of the window
+            if (position_ - positions_[head_] >= window_) {
+                head_ = (head_ + 1) & mask_;
+                --size_;
+            }
+
+            ++position_;
+            return values_[head_];
+        }
+
+        /**
+         *  Block version of push(): output[i] = push(input[i]).
+         *  input and output may be the same array.
+         */
+        void process(const float *input, float *output, size_t count);
+
+    private:
+        size_t max_window_;
+        size_t window_;
+        size_t mask_;
+
+        std::vector<float> values_;
+        std::vector<uint64_t> positions_;
+        size_t head_;
+        size_t size_;
+        uint64_t position_;
+    };
+}
+
+#endif //GW_CORE_SLIDING_WINDOW_MAX_H
@@ -0,0 +1,133 @@
+#ifndef GW_CORE_STFT_H
+#define GW_CORE_STFT_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/buffer_view.h"
+#include "gw/core/fft.h"
+#include "gw/core/processor.h"
+#include "gw/core/ring_buffer.h"
+
+namespace gw::core {
+    /**
+     *  Window shapes for analysis and resynthesis. All are periodic
+     *  (DFT-even), which is what overlap-add needs.
+     */
+    enum class WindowType {
+        Rectangular,
+        Hann,
+        Hamming,
+        Blackman,
+        SqrtHann // Use for both windows to get Hann overall
+    };
+
+    /**
+     *  Fill dest with a periodic window of the given size.
+     */
+    void make_window(WindowType type, float *dest, size_t size);
+
+    /**
+     *  Settings for Stft.
+     */
+    struct StftSettings {
+        size_t fft_size = 2048; // Rounded up to a power of two
+        size_t hop_size = 512; // Clamped to [1, fft_size]
+        WindowType analysis_window = WindowType::Hann;
+        WindowType synthesis_window = WindowType::Hann;
+
+        // Capacity reserved at construction; process() takes blocks of any
+        // size, so max_block_size only sets how much is handled at once
+        size_t max_channels = 2;
+        size_t max_block_size = 4096;
+    };
+
+    /**
+     *  One analysis frame, handed to the spectrum callback.
+     *
+     *  Each spectrum holds fft_size / 2 + 1 bins (DC to Nyquist) in 32-byte
+     *  aligned storage, and may be modified in place; the modified spectra
+     *  are what gets resynthesized.
+     */
+    struct StftFrame {
+        std::complex<float> *const *spectra; // One per channel
+        size_t num_channels;
+        size_t num_bins;
+        uint64_t index; // Frames since the last reset
+    };
+
+    using StftCallback = std::function<void(const StftFrame &frame)>;
+
+    /**
+     *  Streaming short-time Fourier transform with overlap-add resynthesis.
+     *
+     *  Audio goes through in place in blocks of any size. Input collects in
+     *  a RingBuffer per channel; every hop_size samples the last fft_size
+     *  samples are windowed and transformed, the callback sees (and may
+     *  change) the spectra of all channels at once, and the inverse
+     *  transforms are windowed again and overlap-added into a second
+     *  RingBuffer the output is read from.
+     *
+     *  The synthesis window is normalized by the overlapped product of both
+     *  windows, so with a callback that leaves the spectra alone the output
+     *  is the input delayed by get_latency_samples(), for any window pair
+     *  whose product overlaps to a nonzero sum at the chosen hop.
+     *
+     *  Everything is allocated in the constructor (and in prepare() only if
+     *  it asks for more channels than max_channels); process() and the
+     *  callback path never allocate. The FFT plan is shared with every other
+     *  RealFft of the same size.
+     */
+    class Stft : public Processor {
+    public:
+        /**
+         *  @param callback Called on the audio thread once per frame; may be empty
+         */
+        Stft(const StftSettings &settings, StftCallback callback);
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        void reset() override;
+
+        /**
+         *  fft_size - 1: a sample has to wait for the frame that ends with it,
+         *  and that frame's first hop only completes a full frame later.
+         */
+        [[nodiscard]] size_t get_latency_samples() const override { return fft_size_ - 1; }
+
+        [[nodiscard]] size_t get_fft_size() const { return fft_size_; }
+        [[nodiscard]] size_t get_hop_size() const { return hop_size_; }
+        [[nodiscard]] size_t get_num_bins() const { return fft_size_ / 2 + 1; }
+        [[nodiscard]] uint64_t get_frames_processed() const { return frame_index_; }
+
+    private:
+        StftSettings settings_;
+        StftCallback callback_;
+        size_t fft_size_;
+        size_t hop_size_;
+        size_t num_channels_;
+        size_t block_size_;
+
+        RealFft fft_;
+        AudioBuffer windows_; // 0: analysis, 1: synthesis (normalized)
+        AudioBuffer history_; // Last fft_size input samples per channel
+        AudioBuffer frame_; // Windowed frame / inverse transform scratch
+        AudioBuffer spectra_; // Interleaved complex bins per channel
+        AudioBuffer overlap_; // Overlap-add accumulator per channel
+        std::vector<std::complex<float> *> spectrum_pointers_;
+        std::vector<RingBuffer> input_;
+        std::vector<RingBuffer> output_;
+        uint64_t frame_index_;
+
+        void allocate(size_t num_channels);
+
+        void run_frame(size_t num_channels);
+    };
+}
+
+#endif //GW_CORE_STFT_H
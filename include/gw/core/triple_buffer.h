@@ -0,0 +1,85 @@
+#ifndef GW_CORE_TRIPLE_BUFFER_H
+#define GW_CORE_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace gw::core {
+    /**
+     *  Lock-free single-producer single-consumer triple buffer.
+     *
+     *  For handing large values (spectra, waveforms) from one thread to
+     *  another where only the latest value matters. The writer fills the back
+     *  buffer and publishes it; the reader picks up the most recent published
+     *  buffer. Neither side ever waits or copies.
+     *
+     *  The three buffers are constructed up front. If T allocates (e.g.
+     *  std::vector), size all three through get_write_buffer()/init before
+     *  handing the triple buffer to a real-time thread.
+     */
+    template<typename T>
+    class TripleBuffer {
+    public:
+        TripleBuffer() : middle_(1), back_(0), front_(2) {
+        }
+
+        /**
+         *  Construct all three buffers as copies of an initial value.
+         */
+        explicit TripleBuffer(const T &initial)
+            : buffers_{initial, initial, initial},
+              middle_(1),
+              back_(0),
+              front_(2) {
+        }
+
+        TripleBuffer(const TripleBuffer &) = delete;
+
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        /**
+         *  Writer side: the buffer to fill. Contents are whatever was there
+         *  two publishes ago.
+         */
+        T &get_write_buffer() { return buffers_[back_]; }
+
+        /**
+         *  Writer side: make the write buffer visible to the reader.
+         */
+        void publish() {
+            const uint32_t previous = middle_.exchange(back_ | DIRTY, std::memory_order_acq_rel);
+            back_ = previous & INDEX_MASK;
+        }
+
+        /**
+         *  Reader side: pick up the latest published buffer, if there is a new one.
+         *
+         *  @return true if get_read_buffer() changed
+         */
+        bool update() {
+            if ((middle_.load(std::memory_order_relaxed) & DIRTY) == 0) {
+                return false;
+            }
+
+            const uint32_t previous = middle_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX_MASK;
+            return true;
+        }
+
+        /**
+         *  Reader side: the most recent buffer picked up by update().
+         */
+        const T &get_read_buffer() const { return buffers_[front_]; }
+
+    private:
+        static constexpr uint32_t DIRTY = 4;
+        static constexpr uint32_t INDEX_MASK = 3;
+
+        T buffers_[3];
+        std::atomic<uint32_t> middle_; // Index of the spare buffer, plus DIRTY if unread
+        uint32_t back_; // Writer-owned
+        uint32_t front_; // Reader-owned
+    };
+}
+
+#endif //GW_CORE_TRIPLE_BUFFER_H
@@ -0,0 +1,240 @@
+#ifndef GW_CORE_UDP_TRANSPORT_H
+#define GW_CORE_UDP_TRANSPORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/audio_format.h"
+#include "gw/core/jitter_buffer.h"
+
+namespace gw::core {
+    /**
+     *  Header at the start of every audio packet, little-endian on the wire:
+     *
+     *      0  magic "GWAU"        4 bytes
+     *      4  version             1
+     *      5  bit depth           1
+     *      6  channels            2
+     *      8  sample rate         4
+     *      12 sequence            4   (wraps)
+     *      16 frame position      8   (first frame of the packet in the stream)
+     *      24 frames              2
+     *      26 reserved            2
+     *
+     *  The payload that follows is interleaved PCM as produced by encode_pcm().
+     */
+    struct PacketHeader {
+        static constexpr uint32_t MAGIC = 0x55415747; // "GWAU"
+        static constexpr uint8_t VERSION = 1;
+        static constexpr size_t SIZE = 28;
+
+        uint32_t sequence = 0;
+        uint64_t frame_position = 0;
+        uint32_t sample_rate = 0;
+        uint16_t num_channels = 0;
+        uint8_t bit_depth = 0;
+        uint16_t num_frames = 0;
+    };
+
+    /**
+     *  Serialize a header.
+     *
+     *  @param dest At least PacketHeader::SIZE bytes
+     *  @return PacketHeader::SIZE
+     */
+    size_t write_packet_header(const PacketHeader &header, uint8_t *dest);
+
+    /**
+     *  Parse and validate a header.
+     *
+     *  @param packet Received bytes
+     *  @param size Size of the packet; must cover the header and its payload
+     *  @return false if the magic, version, format or size do not check out
+     */
+    bool read_packet_header(const uint8_t *packet, size_t size, PacketHeader &header);
+
+    /**
+     *  Preallocated packet slots and the kernel message headers for one
+     *  sendmmsg()/recvmmsg() batch. Defined in the implementation, so this
+     *  header doesn't pull in the socket headers.
+     */
+    struct MessageBatch;
+
+    /**
+     *  A bound IPv4 UDP socket.
+     *
+     *  The transport is Linux only; it is built when GW_CORE_UDP_TRANSPORT
+     *  is on (the default there), which defines GW_CORE_HAS_UDP_TRANSPORT.
+     *
+     *  Check is_open() after construction. Sends block; receives wait up to
+     *  a timeout. Send and receive may be used from two different threads.
+     */
+    class UdpSocket {
+    public:
+        /**
+         *  @param port Local port, 0 for any
+         *  @param address Local address to bind, e.g. "0.0.0.0" or "127.0.0.1"
+         */
+        explicit UdpSocket(uint16_t port = 0, const char *address = "0.0.0.0");
+
+        ~UdpSocket();
+
+        UdpSocket(const UdpSocket &) = delete;
+
+        UdpSocket &operator=(const UdpSocket &) = delete;
+
+        [[nodiscard]] bool is_open() const { return fd_ >= 0; }
+
+        /**
+         *  Local port the socket is bound to.
+         */
+        [[nodiscard]] uint16_t get_port() const { return port_; }
+
+        /**
+         *  Set the default destination for send_messages().
+         */
+        bool connect(const char *address, uint16_t port);
+
+        /**
+         *  Enlarge the kernel socket buffers (bursts of packets per block).
+         */
+        bool set_buffer_sizes(int send_bytes, int receive_bytes);
+
+        /**
+         *  sendmmsg() wrapper: sends the first count messages of a batch.
+         *  Retries until every message went out.
+         *
+         *  @return Messages sent
+         */
+        size_t send_messages(MessageBatch &batch, size_t count);
+
+        /**
+         *  recvmmsg() wrapper: waits up to timeout_ms for the first message,
+         *  then fills the rest of the batch with whatever is already queued
+         *  without waiting.
+         *
+         *  @return Messages received (the batch holds each size)
+         */
+        size_t receive_messages(MessageBatch &batch, int timeout_ms);
+
+    private:
+        int fd_;
+        uint16_t port_;
+    };
+
+    /**
+     *  Simulated network faults for loopback testing of the sender.
+     */
+    struct TransportImpairment {
+        float loss_probability = 0.0f; // Chance each packet is dropped
+        size_t reorder_distance = 0; // Packets in a batch may swap places up to this far
+        uint32_t seed = 1;
+    };
+
+    /**
+     *  Packetizes AudioBuffer blocks and sends them in batches with sendmmsg().
+     *
+     *  Each packet is encoded straight into a preallocated send slot and the
+     *  whole batch goes to the kernel in one syscall: the interleave/convert
+     *  step is the only user-space copy, and nothing is allocated after
+     *  construction.
+     *
+     *  Keep header + frames_per_packet * bytes_per_frame within the path MTU
+     *  (1472 bytes payload on plain Ethernet) to avoid IP fragmentation.
+     */
+    class PacketSender {
+    public:
+        /**
+         *  @param socket Connected socket (see UdpSocket::connect())
+         *  @param format Wire format; channels beyond the buffer's are sent as silence
+         *  @param frames_per_packet Frames per packet (<= 65535)
+         *  @param max_batch Packets per sendmmsg() call
+         */
+        PacketSender(UdpSocket &socket, const AudioFormat &format, size_t frames_per_packet, size_t max_batch = 32);
+
+        ~PacketSender();
+
+        PacketSender(const PacketSender &) = delete;
+
+        PacketSender &operator=(const PacketSender &) = delete;
+
+        /**
+         *  Send frames [offset, offset + num_frames) of a buffer. A short
+         *  final packet is sent as is; the frame position carries on from it.
+         *
+         *  @return Frames sent (0 if the format is unsupported)
+         */
+        size_t send(const AudioBuffer &source, size_t offset, size_t num_frames);
+
+        void set_impairment(const TransportImpairment &impairment);
+
+        [[nodiscard]] size_t get_frames_per_packet() const { return frames_per_packet_; }
+        [[nodiscard]] uint64_t get_frame_position() const { return frame_position_; }
+        [[nodiscard]] uint64_t get_packets_sent() const { return packets_sent_; }
+        [[nodiscard]] uint64_t get_packets_dropped() const { return packets_dropped_; }
+
+    private:
+        UdpSocket &socket_;
+        AudioFormat format_;
+        size_t frames_per_packet_;
+        size_t packet_bytes_;
+        size_t max_batch_;
+
+        std::unique_ptr<MessageBatch> batch_; // max_batch packet slots
+
+        uint32_t sequence_;
+        uint64_t frame_position_;
+        uint64_t packets_sent_;
+        uint64_t packets_dropped_;
+
+        TransportImpairment impairment_;
+        uint32_t random_state_;
+
+        float next_random();
+    };
+
+    /**
+     *  Receives packets in batches with recvmmsg() and feeds a JitterBuffer.
+     *
+     *  Run receive() in a loop on a network thread; the audio thread pulls
+     *  from the JitterBuffer. Packets whose format differs from the
+     *  JitterBuffer's are counted as invalid and dropped.
+     */
+    class PacketReceiver {
+    public:
+        PacketReceiver(UdpSocket &socket, JitterBuffer &jitter_buffer, size_t max_batch = 32);
+
+        ~PacketReceiver();
+
+        PacketReceiver(const PacketReceiver &) = delete;
+
+        PacketReceiver &operator=(const PacketReceiver &) = delete;
+
+        /**
+         *  Wait up to timeout_ms for packets and push them, timestamped with
+         *  the steady clock.
+         *
+         *  @return Packets received
+         */
+        size_t receive(int timeout_ms);
+
+        /**
+         *  As above, with an explicit arrival time (for simulated timelines).
+         */
+        size_t receive(int timeout_ms, double arrival_seconds);
+
+        [[nodiscard]] uint64_t get_packets_invalid() const { return packets_invalid_; }
+
+    private:
+        UdpSocket &socket_;
+        JitterBuffer &jitter_buffer_;
+        size_t packet_bytes_;
+
+        std::unique_ptr<MessageBatch> batch_;
+
+        uint64_t packets_invalid_;
+    };
+}
+
+#endif //GW_CORE_UDP_TRANSPORT_H
@@ -0,0 +1,215 @@
+#ifndef GW_CORE_VOICE_ENGINE_H
+#define GW_CORE_VOICE_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gw/core/audio_buffer.h"
+#include "gw/core/processor.h"
+
+namespace gw::core {
+    /**
+     *  Oscillator shapes. All are band-limited: Saw and Square use polyBLEP
+     *  corrections, Triangle uses polyBLAMP, Wavetable uses mipmapped tables.
+     */
+    enum class Waveform {
+        Sine,
+        Saw,
+        Square,
+        Triangle,
+        Wavetable
+    };
+
+    /**
+     *  A single-cycle waveform stored as a set of band-limited tables, one per
+     *  octave. Each level holds only the harmonics that stay below Nyquist for
+     *  the pitches it is selected for, so playback never aliases.
+     *
+     *  Built once (NOT real-time safe), then read-only and shareable.
+     */
+    class Wavetable {
+    public:
+        static constexpr size_t TABLE_SIZE = 2048;
+
+        /**
+         *  @param harmonics Amplitude of each harmonic, [0] is the fundamental.
+         *  Every level is normalized to the peak of the full-band level.
+         */
+        explicit Wavetable(const std::vector<float> &harmonics);
+
+        /**
+         *  Band-limited sawtooth (harmonic k at 1/k).
+         */
+        static Wavetable make_saw();
+
+        [[nodiscard]] size_t get_num_levels() const { return num_levels_; }
+
+        /**
+         *  Level to play at a given phase increment (cycles per sample).
+         */
+        [[nodiscard]] size_t select_level(float phase_increment) const;
+
+        /**
+         *  TABLE_SIZE + 1 samples of a level; the last repeats the first for
+         *  interpolation.
+         */
+        [[nodiscard]] const float *get_level(size_t level) const;
+
+    private:
+        size_t num_levels_;
+        std::vector<float> tables_; // num_levels_ * (TABLE_SIZE + 1)
+    };
+
+    /**
+     *  Settings for VoiceEngine.
+     */
+    struct VoiceEngineSettings {
+        size_t max_voices = 256; // Rounded up to a multiple of VoiceEngine::LANES
+        Waveform waveform = Waveform::Saw;
+        float attack_ms = 5.0f;
+        float decay_ms = 100.0f;
+        float sustain = 0.7f; // Linear level
+        float release_ms = 200.0f;
+        float gain = 0.25f; // Applied to every voice
+        float tuning_hz = 440.0f; // Frequency of note 69 (A4)
+    };
+
+    /**
+     *  Polyphonic oscillator voices with a linear ADSR each.
+     *
+     *  Voice state is kept as structure-of-arrays (one aligned row per
+     *  field) and voices are rendered LANES at a time: the inner loops run
+     *  across a group of voices for one sample, so they map onto vector
+     *  registers instead of rendering each voice with scalar code. The
+     *  per-lane partial sums are only reduced to the output once per sample
+     *  for all groups together. The group kernels are built for SSE2, AVX2
+     *  and AVX-512 and picked at runtime.
+     *
+     *  Active voices always occupy the first slots, oldest first. Voices
+     *  whose release has finished are compacted out, so a block only costs
+     *  as many groups as there are sounding voices. When every voice is in
+     *  use, a note-on steals the quietest releasing voice, else the oldest.
+     *
+     *  Envelope stages change at control rate (every CONTROL_FRAMES);
+     *  levels ramp per sample.
+     *
+     *  process() adds the voices to the block: to channel 0 on mono, panned
+     *  to channels 0 and 1 otherwise (further channels are left untouched).
+     *  note_on()/note_off() are real-time safe; call them from the audio
+     *  thread between blocks.
+     */
+    class VoiceEngine : public Processor {
+    public:
+        static constexpr size_t LANES = 16;
+        static constexpr size_t CONTROL_FRAMES = 32;
+
+        explicit VoiceEngine(const VoiceEngineSettings &settings = VoiceEngineSettings());
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override;
+
+        void process(BufferView *channels, size_t num_channels) override;
+
+        /**
+         *  Clear the buffer and render the first num_frames frames into it.
+         */
+        void render(AudioBuffer &output, size_t num_frames);
+
+        /**
+         *  Silence every voice immediately.
+         */
+        void reset() override;
+
+        /**
+         *  Start a voice.
+         *
+         *  @param note MIDI note number (fractional for microtuning)
+         *  @param velocity 0..1
+         *  @param pan -1 (left) .. 1 (right), constant power
+         */
+        void note_on(float note, float velocity, float pan = 0.0f);
+
+        /**
+         *  Release every held voice playing this note.
+         */
+        void note_off(float note);
+
+        void all_notes_off();
+
+        /**
+         *  Table used by Waveform::Wavetable. Not owned; must outlive the
+         *  engine. Call while stopped.
+         */
+        void set_wavetable(const Wavetable *wavetable);
+
+        [[nodiscard]] size_t get_num_active_voices() const { return num_active_; }
+        [[nodiscard]] size_t get_max_voices() const { return max_voices_; }
+        [[nodiscard]] uint64_t get_voices_stolen() const { return voices_stolen_; }
+
+        /**
+         *  Note of the voice in slot i (i < get_num_active_voices()).
+         */
+        [[nodiscard]] float get_voice_note(size_t i) const { return notes_[i]; }
+
+        /**
+         *  Whether the voice in slot i is releasing.
+         */
+        [[nodiscard]] bool is_voice_releasing(size_t i) const;
+
+    private:
+        // Hot per-voice rows, read and written by the group kernels
+        enum Row : size_t {
+            PHASE, // 0..1
+            INCREMENT, // Cycles per sample
+            LEVEL, // Envelope level
+            STEP, // Envelope change per sample
+            TARGET, // Envelope stops here
+            GAIN_LEFT,
+            GAIN_RIGHT,
+            NUM_ROWS
+        };
+
+        enum class Stage : uint8_t {
+            Attack,
+            Decay,
+            Sustain,
+            Release
+        };
+
+        VoiceEngineSettings settings_;
+        size_t max_voices_;
+        double sample_rate_;
+        float attack_step_;
+        float decay_step_;
+        float release_samples_;
+
+        AudioBuffer state_; // NUM_ROWS rows of max_voices_
+        std::vector<int32_t> table_offsets_; // Wavetable level per voice (hot, per lane)
+
+        // Cold per-voice data, touched at control rate
+        std::vector<float> notes_;
+        std::vector<float> velocities_;
+        std::vector<Stage> stages_;
+
+        size_t num_active_;
+        uint64_t voices_stolen_;
+        const Wavetable *wavetable_;
+
+        // LANES partial sums per frame of a control block
+        std::vector<float> sums_left_;
+        std::vector<float> sums_right_;
+
+        [[nodiscard]] float *row(Row r) { return state_.get_channel_data(r); }
+
+        void update_stages();
+
+        void compact();
+
+        void move_voice(size_t from, size_t to);
+
+        void start_voice(size_t slot, float note, float velocity, float pan);
+
+        void release_voice(size_t slot);
+    };
+}
+
+#endif //GW_CORE_VOICE_ENGINE_H
@@ -0,0 +1,779 @@
+#include "gw/core/ambisonics.h"
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gw::core {
+    namespace {
+        // Samples per tile: a tile of all 64 channels of a 7th-order signal
+        // is 32 KiB, so it stays in L1 while every output is accumulated
+        constexpr size_t MIX_TILE = 128;
+
+        struct RampTable {
+            float values[MIX_TILE];
+
+            constexpr RampTable() : values() {
+                for (size_t t = 0; t < MIX_TILE; ++t) values[t] = static_cast<float>(t);
+            }
+        };
+
+        constexpr RampTable RAMP{};
+
+        // outputs[o][n] = sum_i (matrix[o][i] + n * deltas[o][i]) * inputs[i][n],
+        // matrix and deltas row-major with a row stride, deltas optional.
+        // Each pass over the inputs accumulates four outputs into a tile, so
+        // every input tile is loaded once per four outputs and the inner
+        // loops run across samples without reductions.
+        GW_CORE_FORCE_INLINE void mix(const float *const *inputs, size_t num_inputs, const float *matrix,
+                                      const float *deltas, size_t stride, float *const *outputs,
+                                      size_t num_outputs, size_t count) {
+            alignas(64) float acc0[MIX_TILE];
+            alignas(64) float acc1[MIX_TILE];
+            alignas(64) float acc2[MIX_TILE];
+            alignas(64) float acc3[MIX_TILE];
+            float *const accumulators[4] = {acc0, acc1, acc2, acc3};
+            const float *__restrict ramp = RAMP.values;
+
+            for (size_t start = 0; start < count; start += MIX_TILE) {
+                const size_t n = std::min(MIX_TILE, count - start);
+                const auto offset = static_cast<float>(start);
+
+                for (size_t o = 0; o < num_outputs; o += 4) {
+                    const size_t rows = std::min<size_t>(4, num_outputs - o);
+                    std::fill_n(acc0, n, 0.0f);
+                    std::fill_n(acc1, n, 0.0f);
+                    std::fill_n(acc2, n, 0.0f);
+                    std::fill_n(acc3, n, 0.0f);
+
+                    for (size_t i = 0; i < num_inputs; ++i) {
+                        const float *__restrict x = inputs[i] + start;
+
+                        // Missing rows of the last group get zero gains
+                        float c[4] = {};
+                        float d[4] = {};
+                        for (size_t r = 0; r < rows; ++r) {
+                            c[r] = matrix[(o + r) * stride + i];
+                            if (deltas) {
+                                d[r] = deltas[(o + r) * stride + i];
+                                c[r] += d[r] * offset;
+                            }
+                        }
+
+                        if (!deltas) {
+                            for (size_t t = 0; t < n; ++t) {
+                                const float value = x[t];
+                                acc0[t] += c[0] * value;
+                                acc1[t] += c[1] * value;
+                                acc2[t] += c[2] * value;
+                                acc3[t] += c[3] * value;
+                            }
+                        } else {
+                            for (size_t t = 0; t < n; ++t) {
+                                const float value = x[t];
+                                acc0[t] += (c[0] + d[0] * ramp[t]) * value;
+                                acc1[t] += (c[1] + d[1] * ramp[t]) * value;
+                                acc2[t] += (c[2] + d[2] * ramp[t]) * value;
+                                acc3[t] += (c[3] + d[3] * ramp[t]) * value;
+                            }
+                        }
+                    }
+
+                    for (size_t r = 0; r < rows; ++r) {
+                        std::copy_n(accumulators[r], n, outputs[o + r] + start);
+                    }
+                }
+            }
+        }
+
+        // acc += x * h on split real/imaginary spectra
+        GW_CORE_FORCE_INLINE void multiply_accumulate(float *__restrict acc_re, float *__restrict acc_im,
+                                                      const float *__restrict x_re, const float *__restrict x_im,
+                                                      const float *__restrict h_re, const float *__restrict h_im,
+                                                      size_t count) {
+            for (size_t k = 0; k < count; ++k) {
+                acc_re[k] += x_re[k] * h_re[k] - x_im[k] * h_im[k];
+                acc_im[k] += x_re[k] * h_im[k] + x_im[k] * h_re[k];
+            }
+        }
+
+        using MixFn = void (*)(const float *const *, size_t, const float *, const float *, size_t, float *const *,
+                               size_t, size_t);
+        using MultiplyAccumulateFn = void (*)(float *, float *, const float *, const float *, const float *,
+                                              const float *, size_t);
+
+        void mix_generic(const float *const *inputs, size_t num_inputs, const float *matrix, const float *deltas,
+                         size_t stride, float *const *outputs, size_t num_outputs, size_t count) {
+            mix(inputs, num_inputs, matrix, deltas, stride, outputs, num_outputs, count);
+        }
+
+        void multiply_accumulate_generic(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                                         const float *h_re, const float *h_im, size_t count) {
+            multiply_accumulate(acc_re, acc_im, x_re, x_im, h_re, h_im, count);
+        }
+
+        GW_CORE_TARGET_AVX2
+        void mix_avx2(const float *const *inputs, size_t num_inputs, const float *matrix, const float *deltas,
+                      size_t stride, float *const *outputs, size_t num_outputs, size_t count) {
+            mix(inputs, num_inputs, matrix, deltas, stride, outputs, num_outputs, count);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void mix_avx512(const float *const *inputs, size_t num_inputs, const float *matrix, const float *deltas,
+                        size_t stride, float *const *outputs, size_t num_outputs, size_t count) {
+            mix(inputs, num_inputs, matrix, deltas, stride, outputs, num_outputs, count);
+        }
+
+        GW_CORE_TARGET_AVX2
+        void multiply_accumulate_avx2(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                                      const float *h_re, const float *h_im, size_t count) {
+            multiply_accumulate(acc_re, acc_im, x_re, x_im, h_re, h_im, count);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void multiply_accumulate_avx512(float *acc_re, float *acc_im, const float *x_re, const float *x_im,
+                                        const float *h_re, const float *h_im, size_t count) {
+            multiply_accumulate(acc_re, acc_im, x_re, x_im, h_re, h_im, count);
+        }
+
+        MixFn get_mix() {
+            // Resolved once on first use
+            static const MixFn kernel = select_kernel<MixFn>(mix_generic, mix_avx2, mix_avx512);
+            return kernel;
+        }
+
+        MultiplyAccumulateFn get_multiply_accumulate() {
+            static const MultiplyAccumulateFn kernel = select_kernel<MultiplyAccumulateFn>(
+                multiply_accumulate_generic, multiply_accumulate_avx2, multiply_accumulate_avx512);
+            return kernel;
+        }
+
+        // Offset of order l's (2l + 1)^2 block among all blocks
+        size_t block_offset(size_t order) {
+            size_t offset = 0;
+            for (size_t l = 0; l < order; ++l) offset += (2 * l + 1) * (2 * l + 1);
+            return offset;
+        }
+
+        // Element (m, n) of order l's block, m and n in [-l, l]
+        double element(const double *block, int l, int m, int n) {
+            return block[(m + l) * (2 * l + 1) + (n + l)];
+        }
+
+        // Ivanic-Ruedenberg recursion terms (J. Phys. Chem. 1996, with the
+        // 1998 corrections). r1 is order 1's block, previous order l - 1's.
+        double term_p(int i, int a, int b, int l, const double *r1, const double *previous) {
+            if (b == l) {
+                return element(r1, 1, i, 1) * element(previous, l - 1, a, l - 1) -
+                       element(r1, 1, i, -1) * element(previous, l - 1, a, -l + 1);
+            }
+            if (b == -l) {
+                return element(r1, 1, i, 1) * element(previous, l - 1, a, -l + 1) +
+                       element(r1, 1, i, -1) * element(previous, l - 1, a, l - 1);
+            }
+            return element(r1, 1, i, 0) * element(previous, l - 1, a, b);
+        }
+
+        double term_v(int m, int n, int l, const double *r1, const double *previous) {
+            if (m == 0) {
+                return term_p(1, 1, n, l, r1, previous) + term_p(-1, -1, n, l, r1, previous);
+            }
+            if (m > 0) {
+                const double first = term_p(1, m - 1, n, l, r1, previous);
+                if (m == 1) return first * std::sqrt(2.0);
+                return first - term_p(-1, -m + 1, n, l, r1, previous);
+            }
+            const double second = term_p(-1, -m - 1, n, l, r1, previous);
+            if (m == -1) return second * std::sqrt(2.0);
+            return term_p(1, m + 1, n, l, r1, previous) + second;
+        }
+
+        double term_w(int m, int n, int l, const double *r1, const double *previous) {
+            if (m > 0) return term_p(1, m + 1, n, l, r1, previous) + term_p(-1, -m - 1, n, l, r1, previous);
+            return term_p(1, m - 1, n, l, r1, previous) - term_p(-1, -m + 1, n, l, r1, previous);
+        }
+
+        // Fills all blocks up to order from a 3x3 rotation matrix on (x, y, z)
+        void build_rotation(size_t order, const double *rotation, double *blocks) {
+            blocks[0] = 1.0;
+            if (order == 0) return;
+
+            // Order 1 channels are (Y, Z, X): the rotation with its axes permuted
+            double *r1 = blocks + 1;
+            const size_t axis[3] = {1, 2, 0};
+            for (size_t m = 0; m < 3; ++m) {
+                for (size_t n = 0; n < 3; ++n) {
+                    r1[m * 3 + n] = rotation[axis[m] * 3 + axis[n]];
+                }
+            }
+
+            const double *previous = r1;
+            for (int l = 2; l <= static_cast<int>(order); ++l) {
+                double *block = blocks + block_offset(static_cast<size_t>(l));
+                for (int m = -l; m <= l; ++m) {
+                    for (int n = -l; n <= l; ++n) {
+                        const int abs_m = std::abs(m);
+                        const double denominator = std::abs(n) == l
+                                                       ? static_cast<double>(2 * l * (2 * l - 1))
+                                                       : static_cast<double>((l + n) * (l - n));
+                        const double centre = m == 0 ? 1.0 : 0.0;
+
+                        const double u = std::sqrt(static_cast<double>((l + m) * (l - m)) / denominator);
+                        const double v = 0.5 * std::sqrt((1.0 + centre) * static_cast<double>(
+                                                             (l + abs_m - 1) * (l + abs_m)) / denominator) *
+                                         (1.0 - 2.0 * centre);
+                        const double w = -0.5 * std::sqrt(static_cast<double>(
+                                                              (l - abs_m - 1) * (l - abs_m)) / denominator) *
+                                         (1.0 - centre);
+
+                        // A zero coefficient means its term would read outside order l - 1
+                        double value = 0.0;
+                        if (u != 0.0) value += u * term_p(0, m, n, l, r1, previous);
+                        if (v != 0.0) value += v * term_v(m, n, l, r1, previous);
+                        if (w != 0.0) value += w * term_w(m, n, l, r1, previous);
+                        block[(m + l) * (2 * l + 1) + (n + l)] = value;
+                    }
+                }
+                previous = block;
+            }
+        }
+
+        // Legendre polynomial P_l(x)
+        double legendre(size_t l, double x) {
+            double previous = 1.0;
+            double current = x;
+            if (l == 0) return previous;
+            for (size_t k = 2; k <= l; ++k) {
+                const auto kd = static_cast<double>(k);
+                const double next = ((2.0 * kd - 1.0) * x * current - (kd - 1.0) * previous) / kd;
+                previous = current;
+                current = next;
+            }
+            return current;
+        }
+
+        // Roughly even directions on the sphere (a Fibonacci lattice)
+        void make_sphere_directions(size_t count, float *azimuths, float *elevations) {
+            const double golden_angle = std::acos(-1.0) * (3.0 - std::sqrt(5.0));
+            for (size_t i = 0; i < count; ++i) {
+                const double z = 1.0 - (2.0 * static_cast<double>(i) + 1.0) / static_cast<double>(count);
+                azimuths[i] = static_cast<float>(std::remainder(golden_angle * static_cast<double>(i),
+                                                                2.0 * std::acos(-1.0)));
+                elevations[i] = static_cast<float>(std::asin(z));
+            }
+        }
+
+        // Spherical head model (Brown and Duda, 1998): a one-pole, one-zero
+        // head shadow filter and a frequency-independent interaural delay,
+        // for the ear on the given side (+1 left, -1 right)
+        void make_head_hrir(double sample_rate, float azimuth, float elevation, double side, float *hrir,
+                            size_t length) {
+            const double pi = std::acos(-1.0);
+            const double head_radius = 0.0875;
+            const double speed_of_sound = 343.0;
+            const double base_delay = 4.0; // Samples, so the earliest ear isn't cut off
+
+            // Angle between the source and the ear axis (+y is left)
+            const double cos_theta = side * std::sin(azimuth) * std::cos(elevation);
+            const double theta = std::acos(std::clamp(cos_theta, -1.0, 1.0));
+
+            const double radius_time = head_radius / speed_of_sound;
+            const double delay_seconds = theta < pi / 2.0
+                                             ? radius_time * (1.0 - std::cos(theta))
+                                             : radius_time * (1.0 + theta - pi / 2.0);
+            const double delay = base_delay + delay_seconds * sample_rate;
+
+            const double alpha_min = 0.1;
+            const double theta_min = 5.0 * pi / 6.0;
+            const double alpha = (1.0 + alpha_min / 2.0) + (1.0 - alpha_min / 2.0) * std::cos(theta / theta_min * pi);
+
+            // H(s) = (alpha s + beta) / (s + beta), bilinear transform
+            const double beta = 2.0 * speed_of_sound / head_radius;
+            const double k = 2.0 * sample_rate;
+            const double b0 = (alpha * k + beta) / (k + beta);
+            const double b1 = (beta - alpha * k) / (k + beta);
+            const double a1 = (beta - k) / (k + beta);
+
+            // Fractional-delay impulse through the shadow filter
+            const auto whole = static_cast<size_t>(delay);
+            const double fraction = delay - static_cast<double>(whole);
+            double previous_input = 0.0;
+            double previous_output = 0.0;
+            for (size_t n = 0; n < length; ++n) {
+                double input = 0.0;
+                if (n == whole) input = 1.0 - fraction;
+                if (n == whole + 1) input = fraction;
+                const double output = b0 * input + b1 * previous_input - a1 * previous_output;
+                previous_input = input;
+                previous_output = output;
+                hrir[n] = static_cast<float>(output);
+            }
+        }
+
+        size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Spherical harmonics
+    // ------------------------------------------------------------------
+
+    void compute_ambisonic_coefficients(size_t order, float azimuth, float elevation, float *coefficients) {
+        order = std::min(order, AMBISONIC_MAX_ORDER);
+        const double x = std::sin(static_cast<double>(elevation));
+        const double c = std::cos(static_cast<double>(elevation));
+
+        // Associated Legendre functions P_l^m(sin elevation), no Condon-Shortley phase
+        double p[AMBISONIC_MAX_ORDER + 1][AMBISONIC_MAX_ORDER + 1] = {};
+        double diagonal = 1.0;
+        for (size_t m = 0; m <= order; ++m) {
+            if (m > 0) diagonal *= static_cast<double>(2 * m - 1) * c;
+            p[m][m] = diagonal;
+            if (m + 1 <= order) p[m + 1][m] = x * static_cast<double>(2 * m + 1) * diagonal;
+            for (size_t l = m + 2; l <= order; ++l) {
+                p[l][m] = (static_cast<double>(2 * l - 1) * x * p[l - 1][m] -
+                           static_cast<double>(l + m - 1) * p[l - 2][m]) / static_cast<double>(l - m);
+            }
+        }
+
+        for (size_t l = 0; l <= order; ++l) {
+            const size_t centre = l * l + l;
+            coefficients[centre] = static_cast<float>(p[l][0]);
+
+            // SN3D: sqrt(2 (l - m)! / (l + m)!)
+            double ratio = 1.0;
+            for (size_t m = 1; m <= l; ++m) {
+                ratio /= static_cast<double>((l + m) * (l - m + 1));
+                const double value = std::sqrt(2.0 * ratio) * p[l][m];
+                const double angle = static_cast<double>(m) * static_cast<double>(azimuth);
+                coefficients[centre + m] = static_cast<float>(value * std::cos(angle));
+                coefficients[centre - m] = static_cast<float>(value * std::sin(angle));
+            }
+        }
+    }
+
+    void compute_max_re_weights(size_t order, float *weights) {
+        const double pi = std::acos(-1.0);
+        const double angle = 137.9 * pi / 180.0 / (static_cast<double>(order) + 1.51);
+        for (size_t l = 0; l <= order; ++l) {
+            weights[l] = static_cast<float>(legendre(l, std::cos(angle)));
+        }
+    }
+
+    void make_sampling_decoder(size_t order, const float *azimuths, const float *elevations,
+                               size_t num_directions, bool max_re, float *matrix) {
+        order = std::min(order, AMBISONIC_MAX_ORDER);
+        const size_t num_channels = get_ambisonic_channel_count(order);
+
+        float weights[AMBISONIC_MAX_ORDER + 1];
+        std::fill_n(weights, order + 1, 1.0f);
+        if (max_re) compute_max_re_weights(order, weights);
+
+        // SN3D in, so each order is scaled by 2l + 1 to project (N3D^2 = (2l + 1) SN3D^2)
+        const float scale = 1.0f / static_cast<float>(std::max<size_t>(num_directions, 1));
+        for (size_t d = 0; d < num_directions; ++d) {
+            float *row = matrix + d * num_channels;
+            compute_ambisonic_coefficients(order, azimuths[d], elevations[d], row);
+            for (size_t l = 0; l <= order; ++l) {
+                const float gain = scale * static_cast<float>(2 * l + 1) * weights[l];
+                for (size_t ch = l * l; ch < (l + 1) * (l + 1); ++ch) row[ch] *= gain;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // AmbisonicEncoder
+    // ------------------------------------------------------------------
+
+    AmbisonicEncoder::AmbisonicEncoder(size_t order, size_t num_sources)
+        : order_(std::min(order, AMBISONIC_MAX_ORDER)),
+          num_channels_(get_ambisonic_channel_count(order_)),
+          num_sources_(num_sources),
+          gains_(num_channels_ * num_sources, 0.0f),
+          targets_(num_channels_ * num_sources, 0.0f),
+          deltas_(num_channels_ * num_sources, 0.0f),
+          inputs_(num_sources),
+          outputs_(num_channels_),
+          ramping_(false) {
+        // Everything starts straight ahead
+        for (size_t source = 0; source < num_sources_; ++source) set_direction(source, 0.0f, 0.0f);
+        reset();
+
+        // Pick the kernel now rather than on the audio thread
+        static_cast<void>(get_mix());
+    }
+
+    void AmbisonicEncoder::set_direction(size_t source, float azimuth, float elevation) {
+        if (source >= num_sources_) return;
+
+        float coefficients[get_ambisonic_channel_count(AMBISONIC_MAX_ORDER)];
+        compute_ambisonic_coefficients(order_, azimuth, elevation, coefficients);
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            targets_[ch * num_sources_ + source] = coefficients[ch];
+        }
+        ramping_ = true;
+    }
+
+    void AmbisonicEncoder::reset() {
+        gains_ = targets_;
+        ramping_ = false;
+    }
+
+    void AmbisonicEncoder::process(const BufferView *sources, size_t num_sources, BufferView *ambisonic,
+                                   size_t num_channels) {
+        if (!sources || !ambisonic || num_channels == 0) return;
+
+        num_sources = std::min(num_sources, num_sources_);
+        num_channels = std::min(num_channels, num_channels_);
+        const size_t count = ambisonic[0].size();
+        if (count == 0) return;
+
+        for (size_t source = 0; source < num_sources; ++source) inputs_[source] = sources[source].data();
+        for (size_t ch = 0; ch < num_channels; ++ch) outputs_[ch] = ambisonic[ch].data();
+
+        const float *deltas = nullptr;
+        if (ramping_) {
+            const float step = 1.0f / static_cast<float>(count);
+            for (size_t i = 0; i < gains_.size(); ++i) deltas_[i] = (targets_[i] - gains_[i]) * step;
+            deltas = deltas_.data();
+        }
+
+        // Rows keep their num_sources_ stride when fewer sources are passed
+        get_mix()(inputs_.data(), num_sources, gains_.data(), deltas, num_sources_, outputs_.data(), num_channels,
+                  count);
+
+        if (ramping_) reset();
+    }
+
+    // ------------------------------------------------------------------
+    // AmbisonicRotator
+    // ------------------------------------------------------------------
+
+    AmbisonicRotator::AmbisonicRotator(size_t order)
+        : order_(std::min(order, AMBISONIC_MAX_ORDER)),
+          matrix_(block_offset(order_ + 1), 0.0f),
+          previous_(matrix_.size(), 0.0f),
+          deltas_(matrix_.size(), 0.0f),
+          rotation_(matrix_.size(), 0.0),
+          scratch_(0, 0),
+          inputs_(2 * order_ + 1),
+          outputs_(2 * order_ + 1),
+          changed_(false) {
+        const double identity[9] = {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+        rebuild(identity);
+        previous_ = matrix_;
+        changed_ = false;
+        static_cast<void>(get_mix());
+    }
+
+    void AmbisonicRotator::rebuild(const double *matrix) {
+        build_rotation(order_, matrix, rotation_.data());
+        for (size_t i = 0; i < matrix_.size(); ++i) matrix_[i] = static_cast<float>(rotation_[i]);
+        changed_ = true;
+    }
+
+    void AmbisonicRotator::set_rotation(float yaw, float pitch, float roll) {
+        const double cy = std::cos(static_cast<double>(yaw)), sy = std::sin(static_cast<double>(yaw));
+        const double cp = std::cos(static_cast<double>(pitch)), sp = std::sin(static_cast<double>(pitch));
+        const double cr = std::cos(static_cast<double>(roll)), sr = std::sin(static_cast<double>(roll));
+
+        // Rz(yaw) Ry(pitch) Rx(roll)
+        const double matrix[9] = {
+            cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr,
+            sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr,
+            -sp, cp * sr, cp * cr
+        };
+        rebuild(matrix);
+    }
+
+    void AmbisonicRotator::set_rotation_matrix(const float *matrix) {
+        double values[9];
+        for (size_t i = 0; i < 9; ++i) values[i] = static_cast<double>(matrix[i]);
+        rebuild(values);
+    }
+
+    const float *AmbisonicRotator::get_order_matrix(size_t order) const {
+        if (order > order_) return nullptr;
+        return matrix_.data() + block_offset(order);
+    }
+
+    void AmbisonicRotator::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        static_cast<void>(sample_rate);
+        static_cast<void>(num_channels);
+        // Only one order is copied aside at a time
+        scratch_ = AudioBuffer(2 * order_ + 1, std::max<size_t>(max_block_size, 1));
+    }
+
+    void AmbisonicRotator::reset() {
+        previous_ = matrix_;
+        changed_ = false;
+    }
+
+    void AmbisonicRotator::process(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0 || scratch_.get_num_channels() == 0) return;
+
+        const size_t count = std::min(channels[0].size(), scratch_.get_num_samples());
+        if (count == 0) return;
+
+        // Crossfade from the matrix the last block ended on
+        const float *deltas = nullptr;
+        if (changed_) {
+            const float step = 1.0f / static_cast<float>(count);
+            for (size_t i = 0; i < matrix_.size(); ++i) deltas_[i] = (matrix_[i] - previous_[i]) * step;
+            deltas = deltas_.data();
+        }
+        const float *matrix = changed_ ? previous_.data() : matrix_.data();
+
+        // Order 0 is omnidirectional; an incomplete top order is left alone
+        for (size_t l = 1; l <= order_ && (l + 1) * (l + 1) <= num_channels; ++l) {
+            const size_t size = 2 * l + 1;
+            for (size_t k = 0; k < size; ++k) {
+                float *channel = channels[l * l + k].data();
+                float *copy = scratch_.get_channel_data(k);
+                std::copy_n(channel, count, copy);
+                inputs_[k] = copy;
+                outputs_[k] = channel;
+            }
+
+            const size_t offset = block_offset(l);
+            get_mix()(inputs_.data(), size, matrix + offset, deltas ? deltas + offset : nullptr, size,
+                      outputs_.data(), size, count);
+        }
+
+        if (changed_) reset();
+    }
+
+    // ------------------------------------------------------------------
+    // AmbisonicDecoder
+    // ------------------------------------------------------------------
+
+    AmbisonicDecoder::AmbisonicDecoder(size_t order, size_t num_outputs)
+        : order_(std::min(order, AMBISONIC_MAX_ORDER)),
+          num_channels_(get_ambisonic_channel_count(order_)),
+          num_outputs_(num_outputs),
+          matrix_(num_outputs * num_channels_, 0.0f),
+          inputs_(num_channels_),
+          outputs_(num_outputs) {
+        static_cast<void>(get_mix());
+    }
+
+    void AmbisonicDecoder::set_matrix(const float *matrix) {
+        std::copy_n(matrix, matrix_.size(), matrix_.data());
+    }
+
+    bool AmbisonicDecoder::set_speakers(const float *azimuths, const float *elevations, size_t num_speakers,
+                                        bool max_re) {
+        if (num_speakers != num_outputs_) return false;
+        make_sampling_decoder(order_, azimuths, elevations, num_speakers, max_re, matrix_.data());
+        return true;
+    }
+
+    void AmbisonicDecoder::process(const BufferView *ambisonic, size_t num_channels, BufferView *outputs,
+                                   size_t num_outputs) {
+        if (!ambisonic || !outputs || num_channels == 0 || num_outputs == 0) return;
+
+        num_channels = std::min(num_channels, num_channels_);
+        num_outputs = std::min(num_outputs, num_outputs_);
+        const size_t count = outputs[0].size();
+
+        for (size_t ch = 0; ch < num_channels; ++ch) inputs_[ch] = ambisonic[ch].data();
+        for (size_t o = 0; o < num_outputs; ++o) outputs_[o] = outputs[o].data();
+
+        // A lower-order input uses the leading columns
+        get_mix()(inputs_.data(), num_channels, matrix_.data(), nullptr, num_channels_, outputs_.data(), num_outputs,
+                  count);
+    }
+
+    // ------------------------------------------------------------------
+    // BinauralRenderer
+    // ------------------------------------------------------------------
+
+    BinauralRenderer::BinauralRenderer(size_t order, size_t partition_size, size_t max_hrir_length)
+        : order_(std::min(order, AMBISONIC_MAX_ORDER)),
+          num_channels_(get_ambisonic_channel_count(order_)),
+          partition_size_(round_up_pow2(std::max<size_t>(partition_size, 16))),
+          max_partitions_((std::max<size_t>(max_hrir_length, 1) + partition_size_ - 1) / partition_size_),
+          num_bins_(partition_size_ + 1),
+          filter_length_(0),
+          num_partitions_(0),
+          filters_(2 * num_channels_ * max_partitions_ * partition_size_, 0.0f),
+          spectra_(max_partitions_ * 2 * num_channels_ * 2 * num_bins_, 0.0f),
+          fft_(2 * partition_size_),
+          delay_line_(max_partitions_ * num_channels_ * 2 * num_bins_, 0.0f),
+          head_(0),
+          active_channels_(num_channels_),
+          input_(num_channels_, 2 * partition_size_),
+          output_(2, partition_size_),
+          position_(0),
+          time_(2 * partition_size_, 0.0f),
+          spectrum_(num_bins_),
+          accumulator_(2 * num_bins_, 0.0f) {
+        static_cast<void>(get_multiply_accumulate());
+    }
+
+    const float *BinauralRenderer::get_filter(size_t channel, size_t ear) const {
+        if (channel >= num_channels_ || ear > 1) return nullptr;
+        return filters_.data() + (ear * num_channels_ + channel) * max_partitions_ * partition_size_;
+    }
+
+    bool BinauralRenderer::set_hrirs(const float *azimuths, const float *elevations, const float *const *left,
+                                     const float *const *right, size_t num_directions, size_t length) {
+        const size_t capacity = max_partitions_ * partition_size_;
+        if (num_directions == 0 || length == 0 || length > capacity) return false;
+
+        // Fold the directions into one filter per channel and ear
+        std::vector<float> decoder(num_directions * num_channels_);
+        make_sampling_decoder(order_, azimuths, elevations, num_directions, false, decoder.data());
+
+        std::fill(filters_.begin(), filters_.end(), 0.0f);
+        for (size_t ear = 0; ear < 2; ++ear) {
+            const float *const *hrirs = ear == 0 ? left : right;
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                float *filter = filters_.data() + (ear * num_channels_ + ch) * capacity;
+                for (size_t d = 0; d < num_directions; ++d) {
+                    const float gain = decoder[d * num_channels_ + ch];
+                    for (size_t n = 0; n < length; ++n) filter[n] += gain * hrirs[d][n];
+                }
+            }
+        }
+
+        filter_length_ = length;
+        num_partitions_ = (length + partition_size_ - 1) / partition_size_;
+
+        // Zero-padded spectrum of every partition
+        for (size_t p = 0; p < num_partitions_; ++p) {
+            for (size_t ear = 0; ear < 2; ++ear) {
+                for (size_t ch = 0; ch < num_channels_; ++ch) {
+                    const float *filter = filters_.data() + (ear * num_channels_ + ch) * capacity;
+                    std::fill(time_.begin(), time_.end(), 0.0f);
+                    std::copy_n(filter + p * partition_size_, partition_size_, time_.data());
+                    fft_.forward(time_.data(), spectrum_.data());
+
+                    float *re = spectra_.data() + ((p * 2 + ear) * num_channels_ + ch) * 2 * num_bins_;
+                    float *im = re + num_bins_;
+                    for (size_t k = 0; k < num_bins_; ++k) {
+                        re[k] = spectrum_[k].real();
+                        im[k] = spectrum_[k].imag();
+                    }
+                }
+            }
+        }
+
+        reset();
+        return true;
+    }
+
+    void BinauralRenderer::use_spherical_head(double sample_rate) {
+        // Twice the channel count of directions samples 7th order well
+        const size_t num_directions = 2 * num_channels_;
+        const size_t length = std::min<size_t>(max_partitions_ * partition_size_,
+                                               static_cast<size_t>(std::ceil(sample_rate * 0.003)) + 32);
+
+        std::vector<float> azimuths(num_directions);
+        std::vector<float> elevations(num_directions);
+        make_sphere_directions(num_directions, azimuths.data(), elevations.data());
+
+        std::vector<float> responses(2 * num_directions * length);
+        std::vector<const float *> left(num_directions);
+        std::vector<const float *> right(num_directions);
+        for (size_t d = 0; d < num_directions; ++d) {
+            float *l = responses.data() + 2 * d * length;
+            float *r = l + length;
+            make_head_hrir(sample_rate, azimuths[d], elevations[d], 1.0, l, length);
+            make_head_hrir(sample_rate, azimuths[d], elevations[d], -1.0, r, length);
+            left[d] = l;
+            right[d] = r;
+        }
+
+        set_hrirs(azimuths.data(), elevations.data(), left.data(), right.data(), num_directions, length);
+    }
+
+    void BinauralRenderer::reset() {
+        std::fill(delay_line_.begin(), delay_line_.end(), 0.0f);
+        input_.clear();
+        output_.clear();
+        position_ = 0;
+        head_ = 0;
+    }
+
+    void BinauralRenderer::run_partition() {
+        const size_t stride = 2 * num_bins_;
+        const size_t partitions = std::max<size_t>(num_partitions_, 1);
+        head_ = (head_ + 1) % partitions;
+
+        // Transform the last two partitions of every channel into the delay line
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            float *window = input_.get_channel_data(ch);
+            float *re = delay_line_.data() + (head_ * num_channels_ + ch) * stride;
+            float *im = re + num_bins_;
+
+            fft_.forward(window, spectrum_.data());
+            for (size_t k = 0; k < num_bins_; ++k) {
+                re[k] = spectrum_[k].real();
+                im[k] = spectrum_[k].imag();
+            }
+
+            std::copy_n(window + partition_size_, partition_size_, window);
+        }
+
+        const MultiplyAccumulateFn multiply_accumulate_fn = get_multiply_accumulate();
+        for (size_t ear = 0; ear < 2; ++ear) {
+            float *acc_re = accumulator_.data();
+            float *acc_im = acc_re + num_bins_;
+            std::fill(accumulator_.begin(), accumulator_.end(), 0.0f);
+
+            // Partition p of the filter meets the input from p partitions ago
+            for (size_t p = 0; p < num_partitions_; ++p) {
+                const size_t slot = (head_ + partitions - p) % partitions;
+                for (size_t ch = 0; ch < num_channels_; ++ch) {
+                    const float *x = delay_line_.data() + (slot * num_channels_ + ch) * stride;
+                    const float *h = spectra_.data() + ((p * 2 + ear) * num_channels_ + ch) * stride;
+                    multiply_accumulate_fn(acc_re, acc_im, x, x + num_bins_, h, h + num_bins_, num_bins_);
+                }
+            }
+
+            for (size_t k = 0; k < num_bins_; ++k) spectrum_[k] = {acc_re[k], acc_im[k]};
+            fft_.inverse(spectrum_.data(), time_.data());
+
+            // Overlap-save: only the second half is free of wrap-around
+            std::copy_n(time_.data() + partition_size_, partition_size_, output_.get_channel_data(ear));
+        }
+    }
+
+    void BinauralRenderer::process(const BufferView *ambisonic, size_t num_channels, BufferView &left,
+                                   BufferView &right) {
+        if (!ambisonic) num_channels = 0;
+        num_channels = std::min(num_channels, num_channels_);
+
+        // Channels that stopped arriving are silent from here on
+        if (num_channels < active_channels_) {
+            for (size_t ch = num_channels; ch < active_channels_; ++ch) {
+                float *window = input_.get_channel_data(ch);
+                std::fill_n(window + partition_size_, partition_size_, 0.0f);
+            }
+        }
+        active_channels_ = num_channels;
+
+        const size_t count = std::min(left.size(), right.size());
+        size_t done = 0;
+        while (done < count) {
+            const size_t chunk = std::min(count - done, partition_size_ - position_);
+
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                std::copy_n(ambisonic[ch].data() + done, chunk,
+                            input_.get_channel_data(ch) + partition_size_ + position_);
+            }
+            std::copy_n(output_.get_channel_data(0) + position_, chunk, left.data() + done);
+            std::copy_n(output_.get_channel_data(1) + position_, chunk, right.data() + done);
+
+            position_ += chunk;
+            done += chunk;
+            if (position_ == partition_size_) {
+                run_partition();
+                position_ = 0;
+            }
+        }
+    }
+}
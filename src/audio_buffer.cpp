@@ -1,4 +1,5 @@
 #include "gw/core/audio_buffer.h"
+#include "gw/core/rt.h"
 #include <cstdlib>      // for aligned_alloc, free
 #include <cstring>      // for memcpy, memset
 #include <algorithm>    // for std::min
@@ -7,29 +8,48 @@ namespace gw::core {
     // Alignment for SIMD operations (AVX = 32 bytes)
     static constexpr size_t ALIGNMENT = 32;
 
-    AudioBuffer::AudioBuffer(size_t num_channels, size_t num_samples)
+    template<typename T>
+    BasicAudioBuffer<T>::BasicAudioBuffer(size_t num_channels, size_t num_samples, BufferMemory memory)
         : num_channels_(num_channels),
           num_samples_(num_samples),
-          channel_data_(nullptr) {
+          channel_data_(nullptr),
+          huge_region_(nullptr),
+          huge_region_bytes_(0) {
         if (num_channels_ == 0 || num_samples_ == 0) {
             return; // Empty buffer
         }
 
         // Allocate array of channel pointers
-        channel_data_ = new float *[num_channels_];
+        channel_data_ = new T *[num_channels_];
+
+        const size_t bytes = num_samples_ * sizeof(T);
+
+        // Round up to the next alignment boundary
+        const size_t aligned_bytes = ((bytes + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+        if (memory == BufferMemory::HugePages) {
+            // One mapping for all channels, already zeroed by the kernel
+            huge_region_bytes_ = aligned_bytes * num_channels_;
+            huge_region_ = rt::allocate_huge_pages(huge_region_bytes_);
+
+            if (huge_region_) {
+                for (size_t ch = 0; ch < num_channels_; ++ch) {
+                    channel_data_[ch] = reinterpret_cast<T *>(static_cast<unsigned char *>(huge_region_) +
+                                                              ch * aligned_bytes);
+                }
+                return;
+            }
+            huge_region_bytes_ = 0; // Fall back to the heap
+        }
 
         // Allocate aligned memory for each channel
         for (size_t ch = 0; ch < num_channels_; ++ch) {
-            const size_t bytes = num_samples_ * sizeof(float);
-
-            // Round up to the next alignment boundary
-            const size_t aligned_bytes = ((bytes * ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
 
             // Allocate aligned memory
             // Allocates memory aligned to ALIGNMENT bytes (32 for AVX)
             // CRITICAL: MUST USE std::free() NOT delete TO FREE MEMORY
             // ALLOCATED WITH aligned_alloc()
-            channel_data_[ch] = static_cast<float *>(std::aligned_alloc(ALIGNMENT, aligned_bytes));
+            channel_data_[ch] = static_cast<T *>(std::aligned_alloc(ALIGNMENT, aligned_bytes));
 
             // Zero-initialize
             if (channel_data_[ch]) {
@@ -38,24 +58,31 @@ namespace gw::core {
         }
     }
 
-    AudioBuffer::~AudioBuffer() {
+    template<typename T>
+    BasicAudioBuffer<T>::~BasicAudioBuffer() {
         free_memory();
     }
 
-    AudioBuffer::AudioBuffer(AudioBuffer &&other) noexcept
+    template<typename T>
+    BasicAudioBuffer<T>::BasicAudioBuffer(BasicAudioBuffer &&other) noexcept
         : num_channels_(other.num_channels_),
           num_samples_(other.num_samples_),
-          channel_data_(other.channel_data_) {
+          channel_data_(other.channel_data_),
+          huge_region_(other.huge_region_),
+          huge_region_bytes_(other.huge_region_bytes_) {
         // Take ownership of other's data
         other.num_channels_ = 0;
         other.num_samples_ = 0;
         other.channel_data_ = nullptr; // Don't let 'other' free our memory
+        other.huge_region_ = nullptr;
+        other.huge_region_bytes_ = 0;
         // After moving, the source object is left in a "valid but unspecified" state.
         // Setting pointers to nullptr ensures its deconstructor doesn't free memory
         // we now own.
     }
 
-    AudioBuffer &AudioBuffer::operator=(AudioBuffer &&other) noexcept {
+    template<typename T>
+    BasicAudioBuffer<T> &BasicAudioBuffer<T>::operator=(BasicAudioBuffer &&other) noexcept {
         if (this != &other) {
             // Free our current memory
             free_memory();
@@ -64,53 +91,78 @@ namespace gw::core {
             num_channels_ = other.num_channels_;
             num_samples_ = other.num_samples_;
             channel_data_ = other.channel_data_;
+            huge_region_ = other.huge_region_;
+            huge_region_bytes_ = other.huge_region_bytes_;
 
             other.num_channels_ = 0;
             other.num_samples_ = 0;
             other.channel_data_ = nullptr;
+            other.huge_region_ = nullptr;
+            other.huge_region_bytes_ = 0;
         }
         return *this;
     }
 
-    float *AudioBuffer::get_channel_data(size_t channel) {
+    template<typename T>
+    T *BasicAudioBuffer<T>::get_channel_data(size_t channel) {
         if (channel >= num_channels_ || !channel_data_) {
             return nullptr;
         }
         return channel_data_[channel];
     }
 
-    const float *AudioBuffer::get_channel_data(size_t channel) const {
+    template<typename T>
+    const T *BasicAudioBuffer<T>::get_channel_data(size_t channel) const {
         if (channel >= num_channels_ || !channel_data_) {
             return nullptr;
         }
         return channel_data_[channel];
     }
 
-    float AudioBuffer::get_sample(size_t channel, size_t sample) const {
+    template<typename T>
+    T BasicAudioBuffer<T>::get_sample(size_t channel, size_t sample) const {
         if (channel >= num_channels_ || sample >= num_samples_ || !channel_data_) {
-            return 0.0f;
+            return T{};
         }
         return channel_data_[channel][sample];
     }
 
-    void AudioBuffer::set_sample(size_t channel, size_t sample, float value) {
+    template<typename T>
+    void BasicAudioBuffer<T>::set_sample(size_t channel, size_t sample, T value) {
         if (channel >= num_channels_ || sample >= num_samples_ || !channel_data_) {
             return;
         }
         channel_data_[channel][sample] = value;
     }
 
-    void AudioBuffer::clear() {
+    template<typename T>
+    void BasicAudioBuffer<T>::clear() {
         if (!channel_data_) return;
 
         for (size_t ch = 0; ch < num_channels_; ++ch) {
             if (channel_data_[ch]) {
-                std::memset(channel_data_[ch], 0, num_samples_ * sizeof(float));
+                // All-zero bits is +0.0 for every supported sample type
+                std::memset(channel_data_[ch], 0, num_samples_ * sizeof(T));
             }
         }
     }
 
-    void AudioBuffer::copy_from(const AudioBuffer &source) {
+    template<typename T>
+    void BasicAudioBuffer<T>::prefault() {
+        if (!channel_data_) return;
+
+        if (huge_region_) {
+            rt::prefault(huge_region_, huge_region_bytes_);
+            return;
+        }
+
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            rt::prefault(channel_data_[ch], num_samples_ * sizeof(T));
+        }
+    }
+
+    template<typename T>
+    void BasicAudioBuffer<T>::copy_from(const BasicAudioBuffer &source) {
         if (!channel_data_ || !source.channel_data_) return;
 
         // Copy the minimum number of channels and samples
@@ -120,17 +172,29 @@ namespace gw::core {
         for (size_t ch = 0; ch < channels_to_coopy; ++ch) {
             std::memcpy(channel_data_[ch],
                         source.channel_data_[ch],
-                        samples_to_copy * sizeof(float));
+                        samples_to_copy * sizeof(T));
         }
     }
 
-    void AudioBuffer::free_memory() {
+    template<typename T>
+    void BasicAudioBuffer<T>::free_memory() {
         if (channel_data_) {
-            for (size_t ch = 0; ch < num_channels_; ++ch) {
-                std::free(channel_data_[ch]);
+            if (huge_region_) {
+                rt::free_huge_pages(huge_region_, huge_region_bytes_);
+                huge_region_ = nullptr;
+                huge_region_bytes_ = 0;
+            } else {
+                for (size_t ch = 0; ch < num_channels_; ++ch) {
+                    std::free(channel_data_[ch]);
+                }
             }
             delete[] channel_data_;
             channel_data_ = nullptr;
         }
     }
+
+    template class BasicAudioBuffer<float>;
+    template class BasicAudioBuffer<double>;
+    template class BasicAudioBuffer<Half>;
+    template class BasicAudioBuffer<BFloat16>;
 }
@@ -0,0 +1,102 @@
+#include "gw/core/audio_io.h"
+#include "gw/core/pcm_codec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace gw::core {
+    PcmFileSource::PcmFileSource(const std::string &path, const AudioFormat &format)
+        : file_(nullptr),
+          format_(format) {
+        if (is_pcm_format_supported(format_)) {
+            file_ = std::fopen(path.c_str(), "rb");
+        }
+    }
+
+    PcmFileSource::~PcmFileSource() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    size_t PcmFileSource::read(AudioBuffer &dest, size_t max_frames) {
+        if (!file_) return 0;
+
+        const size_t bytes_per_frame = format_.get_bytes_per_frame();
+        const size_t frames = std::min(max_frames, dest.get_num_samples());
+        scratch_.resize(frames * bytes_per_frame);
+
+        const size_t bytes_read = std::fread(scratch_.data(), 1, scratch_.size(), file_);
+        const size_t frames_read = bytes_read / bytes_per_frame;
+
+        return decode_pcm(scratch_.data(), frames_read, format_, dest, 0);
+    }
+
+    PcmFileSink::PcmFileSink(const std::string &path, const AudioFormat &format)
+        : file_(nullptr),
+          format_(format) {
+        if (is_pcm_format_supported(format_)) {
+            file_ = std::fopen(path.c_str(), "wb");
+        }
+    }
+
+    PcmFileSink::~PcmFileSink() {
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    bool PcmFileSink::write(const AudioBuffer &source, size_t offset, size_t num_frames) {
+        if (!file_) return false;
+
+        scratch_.resize(num_frames * format_.get_bytes_per_frame());
+        const size_t bytes = encode_pcm(source, offset, num_frames, format_, scratch_.data());
+
+        return std::fwrite(scratch_.data(), 1, bytes, file_) == bytes;
+    }
+
+    BufferSource::BufferSource(const AudioBuffer &buffer, double sample_rate)
+        : buffer_(buffer),
+          sample_rate_(sample_rate),
+          position_(0) {
+    }
+
+    size_t BufferSource::read(AudioBuffer &dest, size_t max_frames) {
+        const size_t remaining = buffer_.get_num_samples() - position_;
+        const size_t frames = std::min({max_frames, remaining, dest.get_num_samples()});
+        const size_t channels = std::min(buffer_.get_num_channels(), dest.get_num_channels());
+
+        for (size_t ch = 0; ch < channels; ++ch) {
+            std::memcpy(dest.get_channel_data(ch),
+                        buffer_.get_channel_data(ch) + position_,
+                        frames * sizeof(float));
+        }
+
+        // Channels the source doesn't have are silent
+        for (size_t ch = channels; ch < dest.get_num_channels(); ++ch) {
+            std::memset(dest.get_channel_data(ch), 0, frames * sizeof(float));
+        }
+
+        position_ += frames;
+        return frames;
+    }
+
+    BufferSink::BufferSink(AudioBuffer &buffer)
+        : buffer_(buffer),
+          position_(0) {
+    }
+
+    bool BufferSink::write(const AudioBuffer &source, size_t offset, size_t num_frames) {
+        const size_t remaining = buffer_.get_num_samples() - position_;
+        const size_t frames = std::min(num_frames, remaining);
+        const size_t channels = std::min(buffer_.get_num_channels(), source.get_num_channels());
+
+        for (size_t ch = 0; ch < channels; ++ch) {
+            std::memcpy(buffer_.get_channel_data(ch) + position_,
+                        source.get_channel_data(ch) + offset,
+                        frames * sizeof(float));
+        }
+
+        position_ += frames;
+        return true;
+    }
+}
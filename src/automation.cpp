@@ -0,0 +1,239 @@
+#include "gw/core/automation.h"
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <limits>
+
+namespace gw::core {
+    namespace {
+        // dest[i] = start + step * i. Each lane depends only on i, so this
+        // vectorizes to a convert and a fused multiply-add per vector. The
+        // index is a 32-bit int because only signed 32-bit converts vectorize
+        // below AVX-512; render() caps spans well below 2^31.
+        GW_CORE_FORCE_INLINE void fill_ramp(float *__restrict dest, float start, float step, size_t count) {
+            const auto n = static_cast<int32_t>(count);
+            for (int32_t i = 0; i < n; ++i) {
+                dest[i] = start + step * static_cast<float>(i);
+            }
+        }
+
+        constexpr uint64_t MAX_SPAN = uint64_t{1} << 30;
+
+        using RampFn = void (*)(float *, float, float, size_t);
+
+        void fill_ramp_generic(float *dest, float start, float step, size_t count) {
+            fill_ramp(dest, start, step, count);
+        }
+
+        GW_CORE_TARGET_AVX2
+        void fill_ramp_avx2(float *dest, float start, float step, size_t count) {
+            fill_ramp(dest, start, step, count);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void fill_ramp_avx512(float *dest, float start, float step, size_t count) {
+            fill_ramp(dest, start, step, count);
+        }
+
+        RampFn get_ramp() {
+            // Resolved once on first use
+            static const RampFn kernel = select_kernel<RampFn>(fill_ramp_generic, fill_ramp_avx2, fill_ramp_avx512);
+            return kernel;
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // AutomationCurve
+    // ------------------------------------------------------------------
+
+    AutomationCurve::AutomationCurve(std::vector<AutomationPoint> points) {
+        std::stable_sort(points.begin(), points.end(),
+                         [](const AutomationPoint &a, const AutomationPoint &b) {
+                             return a.position < b.position;
+                         });
+
+        const size_t n = points.size();
+        positions_.resize(n);
+        values_.resize(n);
+        slopes_.assign(n, 0.0);
+
+        for (size_t i = 0; i < n; ++i) {
+            positions_[i] = points[i].position;
+            values_[i] = points[i].value;
+        }
+
+        for (size_t i = 0; i + 1 < n; ++i) {
+            const uint64_t length = positions_[i + 1] - positions_[i];
+            if (points[i].shape == CurveShape::Linear && length > 0) {
+                slopes_[i] = (static_cast<double>(values_[i + 1]) - static_cast<double>(values_[i])) /
+                             static_cast<double>(length);
+            }
+        }
+    }
+
+    size_t AutomationCurve::find_segment(uint64_t position) const {
+        const auto next = std::upper_bound(positions_.begin(), positions_.end(), position);
+        return next == positions_.begin() ? 0 : static_cast<size_t>(next - positions_.begin()) - 1;
+    }
+
+    double AutomationCurve::evaluate(size_t segment, uint64_t position) const {
+        if (positions_.empty()) return 0.0;
+        if (position <= positions_[segment]) return values_[segment];
+
+        return static_cast<double>(values_[segment]) +
+               slopes_[segment] * static_cast<double>(position - positions_[segment]);
+    }
+
+    double AutomationCurve::get_slope(size_t segment, uint64_t position) const {
+        if (positions_.empty() || position < positions_[segment]) return 0.0;
+        return slopes_[segment];
+    }
+
+    float AutomationCurve::get_value(uint64_t position) const {
+        return static_cast<float>(evaluate(find_segment(position), position));
+    }
+
+    // ------------------------------------------------------------------
+    // AutomationTimeline
+    // ------------------------------------------------------------------
+
+    AutomationTimeline::AutomationTimeline(size_t num_lanes)
+        : num_lanes_(num_lanes),
+          lanes_(num_lanes) {
+        // Pick the kernel now rather than on the audio thread
+        static_cast<void>(get_ramp());
+    }
+
+    AutomationTimeline::~AutomationTimeline() {
+        for (Lane &lane: lanes_) {
+            delete lane.pending.load(std::memory_order_acquire);
+            delete lane.retired.load(std::memory_order_acquire);
+            delete lane.current;
+        }
+    }
+
+    bool AutomationTimeline::set_lane(size_t lane, AutomationCurve curve) {
+        if (lane >= num_lanes_) return false;
+
+        collect_garbage();
+
+        // A replacement the audio thread never picked up was never seen by
+        // it, so it can be freed here
+        auto *next = new AutomationCurve(std::move(curve));
+        delete lanes_[lane].pending.exchange(next, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void AutomationTimeline::collect_garbage() {
+        for (Lane &lane: lanes_) {
+            if (lane.retired.load(std::memory_order_relaxed)) {
+                delete lane.retired.exchange(nullptr, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+    void AutomationTimeline::move_cursor(Lane &lane, uint64_t position) {
+        // Playing forward crosses a few breakpoints at most; anything else
+        // (seek, loop, a freshly swapped curve) is one binary search
+        constexpr size_t MAX_STEPS = 8;
+
+        const AutomationCurve &curve = *lane.current;
+        const uint64_t *positions = curve.get_positions();
+        const size_t last = curve.get_num_points() - 1;
+
+        if (position >= lane.next_position) {
+            for (size_t step = 0; step < MAX_STEPS; ++step) {
+                if (lane.segment >= last || positions[lane.segment + 1] > position) return;
+                ++lane.segment;
+            }
+            if (lane.segment >= last || positions[lane.segment + 1] > position) return;
+        }
+
+        lane.segment = curve.find_segment(position);
+    }
+
+    AutomationTimeline::Lane *AutomationTimeline::acquire(size_t lane) {
+        if (lane >= num_lanes_) return nullptr;
+        Lane &state = lanes_[lane];
+
+        // Swap in a new curve only once the control thread has taken the
+        // last one we handed back, so the retired slot is never overwritten
+        if (state.pending.load(std::memory_order_relaxed) &&
+            !state.retired.load(std::memory_order_acquire)) {
+            AutomationCurve *next = state.pending.exchange(nullptr, std::memory_order_acq_rel);
+            if (next) {
+                state.retired.store(state.current, std::memory_order_release);
+                state.current = next;
+                state.segment = 0;
+                state.next_position = std::numeric_limits<uint64_t>::max(); // Force a seek
+            }
+        }
+
+        if (!state.current || state.current->empty()) return nullptr;
+        return &state;
+    }
+
+    bool AutomationTimeline::render(size_t lane, uint64_t position, BufferView output) {
+        const RampFn ramp = get_ramp();
+
+        Lane *state = acquire(lane);
+        if (!state) return false;
+
+        const AutomationCurve &curve = *state->current;
+        const uint64_t *positions = curve.get_positions();
+        const size_t last = curve.get_num_points() - 1;
+
+        move_cursor(*state, position);
+
+        float *dest = output.data();
+        uint64_t current = position;
+        size_t remaining = output.size();
+
+        while (remaining > 0) {
+            // Step past breakpoints this block has reached
+            while (state->segment < last && positions[state->segment + 1] <= current) {
+                ++state->segment;
+            }
+
+            // The span runs to the next breakpoint, or to the end of the block
+            uint64_t boundary = std::numeric_limits<uint64_t>::max();
+            if (current < positions[state->segment]) {
+                boundary = positions[state->segment];
+            } else if (state->segment < last) {
+                boundary = positions[state->segment + 1];
+            }
+            // Also capped so fill_ramp's 32-bit index can't overflow
+            const auto count = static_cast<size_t>(std::min<uint64_t>({remaining, boundary - current, MAX_SPAN}));
+
+            ramp(dest, static_cast<float>(curve.evaluate(state->segment, current)),
+                 static_cast<float>(curve.get_slope(state->segment, current)), count);
+
+            dest += count;
+            current += count;
+            remaining -= count;
+        }
+
+        state->next_position = current;
+        return true;
+    }
+
+    size_t AutomationTimeline::render(uint64_t position, BufferView *outputs, size_t num_outputs) {
+        if (!outputs) return 0;
+
+        size_t rendered = 0;
+        const size_t count = std::min(num_outputs, num_lanes_);
+        for (size_t lane = 0; lane < count; ++lane) {
+            if (render(lane, position, outputs[lane])) ++rendered;
+        }
+        return rendered;
+    }
+
+    bool AutomationTimeline::get_value(size_t lane, uint64_t position, float &value) {
+        Lane *state = acquire(lane);
+        if (!state) return false;
+
+        move_cursor(*state, position);
+        value = static_cast<float>(state->current->evaluate(state->segment, position));
+        state->next_position = position;
+        return true;
+    }
+}
@@ -4,22 +4,26 @@
 #include <algorithm>
 
 namespace gw::core {
-    BufferView::BufferView()
+    template<typename T>
+    BasicBufferView<T>::BasicBufferView()
         : data_(nullptr),
           num_samples_(0) {
     }
 
-    BufferView::BufferView(float *data, size_t num_samples)
+    template<typename T>
+    BasicBufferView<T>::BasicBufferView(T *data, size_t num_samples)
         : data_(data),
           num_samples_(num_samples) {
     }
 
-    BufferView::BufferView(AudioBuffer &buffer, size_t channel)
+    template<typename T>
+    BasicBufferView<T>::BasicBufferView(BasicAudioBuffer<T> &buffer, size_t channel)
         : data_(buffer.get_channel_data(channel)),
           num_samples_(buffer.get_num_samples()) {
     }
 
-    BufferView BufferView::subview(size_t offset, size_t count) const {
+    template<typename T>
+    BasicBufferView<T> BasicBufferView<T>::subview(size_t offset, size_t count) const {
         if (offset >= num_samples_ || !data_) {
             return {}; // Empty view
         }
@@ -30,7 +34,8 @@ namespace gw::core {
         return {data_ + offset, actual_count};
     }
 
-    void BufferView::fill(float value) {
+    template<typename T>
+    void BasicBufferView<T>::fill(T value) {
         if (!data_) return;
 
         for (size_t i = 0; i < num_samples_; ++i) {
@@ -38,8 +43,14 @@ namespace gw::core {
         }
     }
 
-    void BufferView::clear() {
+    template<typename T>
+    void BasicBufferView<T>::clear() {
         if (!data_) return;
-        std::memset(data_, 0, num_samples_ * sizeof(float));
+        std::memset(data_, 0, num_samples_ * sizeof(T));
     }
+
+    template class BasicBufferView<float>;
+    template class BasicBufferView<double>;
+    template class BasicBufferView<Half>;
+    template class BasicBufferView<BFloat16>;
 }
@@ -0,0 +1,304 @@
+#include "gw/core/delay_line.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gw::core {
+    namespace {
+        size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        struct LagrangeCoefficients {
+            float h0, h1, h2, h3;
+        };
+
+        // Third-order Lagrange weights for the point 1 + frac along four
+        // samples spaced one apart (newest first)
+        LagrangeCoefficients lagrange3(float frac) {
+            const float x = 1.0f + frac;
+            return {
+                -(x - 1.0f) * (x - 2.0f) * (x - 3.0f) / 6.0f,
+                x * (x - 2.0f) * (x - 3.0f) / 2.0f,
+                -x * (x - 1.0f) * (x - 3.0f) / 2.0f,
+                x * (x - 1.0f) * (x - 2.0f) / 6.0f
+            };
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // DelayLine
+    // ------------------------------------------------------------------------
+
+    DelayLine::DelayLine(size_t num_channels, size_t max_delay, size_t max_block_size)
+        : buffer_(0, 0),
+          // Room for the longest delay, one block, and the interpolation taps
+          size_(round_up_pow2(max_delay + max_block_size + 4)),
+          mask_(size_ - 1),
+          max_delay_(max_delay),
+          max_block_size_(max_block_size),
+          position_(0),
+          allpass_state_(num_channels, 0.0f) {
+        buffer_ = AudioBuffer(num_channels, 2 * size_);
+    }
+
+    void DelayLine::reset() {
+        buffer_.clear();
+        position_ = 0;
+        std::fill(allpass_state_.begin(), allpass_state_.end(), 0.0f);
+    }
+
+    const float *DelayLine::at(size_t channel, uint64_t time) const {
+        return buffer_.get_channel_data(channel) + (time & mask_);
+    }
+
+    float DelayLine::clamp_delay(float delay, DelayInterpolation interpolation) const {
+        const float minimum = (interpolation == DelayInterpolation::Lagrange3 ||
+                               interpolation == DelayInterpolation::Allpass)
+                                  ? 1.0f
+                                  : 0.0f;
+        return std::clamp(delay, minimum, static_cast<float>(max_delay_));
+    }
+
+    void DelayLine::write(size_t channel, const float *input, size_t count) {
+        float *data = buffer_.get_channel_data(channel);
+        if (!data || !input) return;
+
+        count = std::min(count, max_block_size_);
+        const size_t start = position_ & mask_;
+        const size_t first = std::min(count, size_ - start);
+
+        // Each sample goes to both halves so reads never wrap
+        std::memcpy(data + start, input, first * sizeof(float));
+        std::memcpy(data + start + size_, input, first * sizeof(float));
+        std::memcpy(data, input + first, (count - first) * sizeof(float));
+        std::memcpy(data + size_, input + first, (count - first) * sizeof(float));
+    }
+
+    void DelayLine::read(size_t channel, float delay, float *output, size_t count,
+                         DelayInterpolation interpolation) {
+        if (channel >= buffer_.get_num_channels() || !output) return;
+
+        count = std::min(count, max_block_size_);
+        delay = clamp_delay(delay, interpolation);
+
+        const auto whole = static_cast<uint64_t>(delay);
+        const float frac = delay - static_cast<float>(whole);
+
+        switch (interpolation) {
+            case DelayInterpolation::None: {
+                const auto rounded = static_cast<uint64_t>(std::lround(delay));
+                std::memcpy(output, at(channel, position_ - rounded), count * sizeof(float));
+                break;
+            }
+            case DelayInterpolation::Linear: {
+                // p[i + 1] is x[t + i - whole], p[i] the sample before it
+                const float *p = at(channel, position_ - whole - 1);
+                for (size_t i = 0; i < count; ++i) {
+                    output[i] = p[i + 1] + frac * (p[i] - p[i + 1]);
+                }
+                break;
+            }
+            case DelayInterpolation::Lagrange3: {
+                const LagrangeCoefficients h = lagrange3(frac);
+                const float *p = at(channel, position_ - whole - 2);
+                for (size_t i = 0; i < count; ++i) {
+                    output[i] = h.h0 * p[i + 3] + h.h1 * p[i + 2] + h.h2 * p[i + 1] + h.h3 * p[i];
+                }
+                break;
+            }
+            case DelayInterpolation::Allpass: {
+                // Keep the allpass fraction in [0.618, 1.618) where its pole is well damped
+                uint64_t integer = whole;
+                float alpha = frac;
+                if (alpha < 0.618f) {
+                    integer -= 1;
+                    alpha += 1.0f;
+                }
+                const float eta = (1.0f - alpha) / (1.0f + alpha);
+
+                const float *p = at(channel, position_ - integer - 1);
+                float state = allpass_state_[channel];
+                for (size_t i = 0; i < count; ++i) {
+                    state = eta * p[i + 1] + p[i] - eta * state;
+                    output[i] = state;
+                }
+                allpass_state_[channel] = state;
+                break;
+            }
+        }
+    }
+
+    void DelayLine::read_modulated(size_t channel, const float *delays, float *output, size_t count,
+                                   DelayInterpolation interpolation) const {
+        if (channel >= buffer_.get_num_channels() || !delays || !output) return;
+
+        count = std::min(count, max_block_size_);
+        if (interpolation == DelayInterpolation::Allpass) {
+            interpolation = DelayInterpolation::Linear;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const float delay = clamp_delay(delays[i], interpolation);
+            const auto whole = static_cast<uint64_t>(delay);
+            const float frac = delay - static_cast<float>(whole);
+            const uint64_t time = position_ + i - whole;
+
+            switch (interpolation) {
+                case DelayInterpolation::None:
+                    output[i] = *at(channel, position_ + i - static_cast<uint64_t>(std::lround(delay)));
+                    break;
+                case DelayInterpolation::Lagrange3: {
+                    const LagrangeCoefficients h = lagrange3(frac);
+                    const float *p = at(channel, time - 2);
+                    output[i] = h.h0 * p[3] + h.h1 * p[2] + h.h2 * p[1] + h.h3 * p[0];
+                    break;
+                }
+                default: {
+                    const float *p = at(channel, time - 1);
+                    output[i] = p[1] + frac * (p[0] - p[1]);
+                    break;
+                }
+            }
+        }
+    }
+
+    void DelayLine::read_taps(size_t channel, const float *delays, const float *gains, size_t num_taps,
+                              float *output, size_t count, DelayInterpolation interpolation) const {
+        if (channel >= buffer_.get_num_channels() || !output) return;
+
+        count = std::min(count, max_block_size_);
+        std::memset(output, 0, count * sizeof(float));
+        if (!delays || !gains) return;
+
+        if (interpolation == DelayInterpolation::Allpass) {
+            interpolation = DelayInterpolation::Lagrange3;
+        }
+
+        // One contiguous, branch-free loop per tap
+        for (size_t tap = 0; tap < num_taps; ++tap) {
+            const float delay = clamp_delay(delays[tap], interpolation);
+            const auto whole = static_cast<uint64_t>(delay);
+            const float frac = delay - static_cast<float>(whole);
+            const float gain = gains[tap];
+
+            switch (interpolation) {
+                case DelayInterpolation::None: {
+                    const float *p = at(channel, position_ - static_cast<uint64_t>(std::lround(delay)));
+                    for (size_t i = 0; i < count; ++i) {
+                        output[i] += gain * p[i];
+                    }
+                    break;
+                }
+                case DelayInterpolation::Lagrange3: {
+                    const LagrangeCoefficients h = lagrange3(frac);
+                    const float c0 = gain * h.h0, c1 = gain * h.h1, c2 = gain * h.h2, c3 = gain * h.h3;
+                    const float *p = at(channel, position_ - whole - 2);
+                    for (size_t i = 0; i < count; ++i) {
+                        output[i] += c0 * p[i + 3] + c1 * p[i + 2] + c2 * p[i + 1] + c3 * p[i];
+                    }
+                    break;
+                }
+                default: {
+                    const float newer = gain * (1.0f - frac);
+                    const float older = gain * frac;
+                    const float *p = at(channel, position_ - whole - 1);
+                    for (size_t i = 0; i < count; ++i) {
+                        output[i] += newer * p[i + 1] + older * p[i];
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    void DelayLine::advance(size_t count) {
+        position_ += std::min(count, max_block_size_);
+    }
+
+    void DelayLine::process(BufferView *channels, size_t num_channels, float delay,
+                            DelayInterpolation interpolation) {
+        if (!channels || num_channels == 0) return;
+
+        num_channels = std::min(num_channels, buffer_.get_num_channels());
+        const size_t count = std::min(channels[0].size(), max_block_size_);
+
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            write(ch, channels[ch].data(), count);
+            read(ch, delay, channels[ch].data(), count, interpolation);
+        }
+        advance(count);
+    }
+
+    // ------------------------------------------------------------------------
+    // CompensationDelay
+    // ------------------------------------------------------------------------
+
+    CompensationDelay::CompensationDelay(size_t delay)
+        : delay_(delay),
+          prepared_delay_(0) {
+    }
+
+    void CompensationDelay::prepare(double, size_t max_block_size, size_t num_channels) {
+        prepared_delay_ = delay_;
+        line_.reset();
+
+        if (prepared_delay_ > 0) {
+            line_ = std::make_unique<DelayLine>(num_channels, prepared_delay_, max_block_size);
+        }
+    }
+
+    void CompensationDelay::process(BufferView *channels, size_t num_channels) {
+        if (!line_) return;
+        line_->process(channels, num_channels, static_cast<float>(prepared_delay_), DelayInterpolation::None);
+    }
+
+    void CompensationDelay::reset() {
+        if (line_) line_->reset();
+    }
+
+    // ------------------------------------------------------------------------
+    // LatencyCompensator
+    // ------------------------------------------------------------------------
+
+    size_t LatencyCompensator::add_path(ProcessorChain &chain) {
+        auto *delay = static_cast<CompensationDelay *>(chain.add(std::make_unique<CompensationDelay>()));
+        paths_.push_back({&chain, delay});
+        return paths_.size() - 1;
+    }
+
+    size_t LatencyCompensator::update() {
+        std::vector<size_t> latencies;
+        latencies.reserve(paths_.size());
+
+        for (const Path &path: paths_) {
+            // The chain's latency includes the compensation we added last time
+            latencies.push_back(path.chain->get_latency_samples() - path.delay->get_delay());
+        }
+
+        const std::vector<size_t> delays = compute_compensation_delays(latencies);
+        for (size_t i = 0; i < paths_.size(); ++i) {
+            paths_[i].delay->set_delay(delays[i]);
+        }
+
+        return latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end());
+    }
+
+    size_t LatencyCompensator::get_path_delay(size_t path) const {
+        if (path >= paths_.size()) return 0;
+        return paths_[path].delay->get_delay();
+    }
+
+    std::vector<size_t> compute_compensation_delays(const std::vector<size_t> &latencies) {
+        const size_t longest = latencies.empty() ? 0 : *std::max_element(latencies.begin(), latencies.end());
+
+        std::vector<size_t> delays;
+        delays.reserve(latencies.size());
+        for (const size_t latency: latencies) {
+            delays.push_back(longest - latency);
+        }
+        return delays;
+    }
+}
@@ -0,0 +1,263 @@
+#include "gw/core/dynamics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gw::core {
+    namespace {
+        size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        float db_to_gain(float db) {
+            return std::pow(10.0f, db / 20.0f);
+        }
+
+        // One-pole smoothing coefficient reaching ~63% in time_ms
+        float time_coeff(float time_ms, double sample_rate) {
+            if (time_ms <= 0.0f || sample_rate <= 0.0) return 0.0f;
+            return static_cast<float>(std::exp(-1.0 / (static_cast<double>(time_ms) * 0.001 * sample_rate)));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // DynamicsProcessor
+    // ------------------------------------------------------------------------
+
+    DynamicsProcessor::DynamicsProcessor(float lookahead_ms, ChannelLink link)
+        : lookahead_ms_(std::max(lookahead_ms, 0.0f)),
+          link_(link),
+          sample_rate_(0.0),
+          window_(1),
+          detector_buffer_(0, 0),
+          delay_buffer_(0, 0),
+          delay_mask_(0),
+          delay_write_(0),
+          gain_reduction_db_(0.0f) {
+    }
+
+    void DynamicsProcessor::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        sample_rate_ = sample_rate;
+        window_ = static_cast<size_t>(std::lround(static_cast<double>(lookahead_ms_) * 0.001 * sample_rate)) + 1;
+
+        const size_t num_detectors = (link_ == ChannelLink::Linked) ? 1 : num_channels;
+        detectors_.assign(num_detectors, SlidingWindowMax(window_));
+        detector_buffer_ = AudioBuffer(num_detectors, max_block_size);
+
+        const size_t ring_size = round_up_pow2(window_);
+        delay_buffer_ = AudioBuffer(num_channels, ring_size);
+        delay_mask_ = ring_size - 1;
+
+        prepare_detectors(num_detectors);
+        reset();
+    }
+
+    void DynamicsProcessor::reset() {
+        for (auto &detector: detectors_) {
+            detector.reset();
+        }
+        delay_buffer_.clear();
+        delay_write_ = 0;
+        gain_reduction_db_ = 0.0f;
+
+        reset_detectors();
+    }
+
+    void DynamicsProcessor::process(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0 || detectors_.empty()) return;
+
+        num_channels = std::min(num_channels, delay_buffer_.get_num_channels());
+        const size_t count = std::min(channels[0].size(), detector_buffer_.get_num_samples());
+        const bool linked = (link_ == ChannelLink::Linked);
+
+        // 1. Rectify into the detector buffers (linked: max across channels)
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            const float *in = channels[ch].data();
+            float *levels = detector_buffer_.get_channel_data(linked ? 0 : ch);
+
+            if (!linked || ch == 0) {
+                for (size_t i = 0; i < count; ++i) {
+                    levels[i] = std::fabs(in[i]);
+                }
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    levels[i] = std::max(levels[i], std::fabs(in[i]));
+                }
+            }
+        }
+
+        // 2 + 3. Windowed peak, then gain
+        float min_gain = 1.0f;
+        for (size_t d = 0; d < detectors_.size(); ++d) {
+            float *levels = detector_buffer_.get_channel_data(d);
+            detectors_[d].process(levels, levels, count);
+            compute_gain(levels, count, d);
+
+            for (size_t i = 0; i < count; ++i) {
+                min_gain = std::min(min_gain, levels[i]);
+            }
+        }
+        gain_reduction_db_ = 20.0f * std::log10(std::max(min_gain, 1.0e-6f));
+
+        // 4. Delay by the lookahead and apply the gain
+        const size_t latency = window_ - 1;
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            float *samples = channels[ch].data();
+            float *ring = delay_buffer_.get_channel_data(ch);
+            const float *gain = detector_buffer_.get_channel_data(linked ? 0 : ch);
+
+            size_t write = delay_write_;
+            for (size_t i = 0; i < count; ++i, ++write) {
+                ring[write & delay_mask_] = samples[i];
+                samples[i] = ring[(write - latency) & delay_mask_] * gain[i];
+            }
+        }
+        delay_write_ += count;
+    }
+
+    // ------------------------------------------------------------------------
+    // PeakLimiter
+    // ------------------------------------------------------------------------
+
+    PeakLimiter::PeakLimiter(const LimiterSettings &settings)
+        : DynamicsProcessor(settings.lookahead_ms, settings.link),
+          ceiling_(db_to_gain(settings.ceiling_db)),
+          release_ms_(settings.release_ms),
+          release_coeff_(0.0f),
+          average_history_(0, 0),
+          average_position_(0) {
+    }
+
+    void PeakLimiter::set_ceiling_db(float ceiling_db) {
+        ceiling_ = db_to_gain(ceiling_db);
+    }
+
+    void PeakLimiter::set_release_ms(float release_ms) {
+        release_ms_ = release_ms;
+        release_coeff_ = time_coeff(release_ms_, get_sample_rate());
+    }
+
+    void PeakLimiter::prepare_detectors(size_t num_detectors) {
+        release_state_.assign(num_detectors, 1.0f);
+        average_history_ = AudioBuffer(num_detectors, get_window());
+        average_sum_.assign(num_detectors, 0.0);
+        release_coeff_ = time_coeff(release_ms_, get_sample_rate());
+    }
+
+    void PeakLimiter::reset_detectors() {
+        std::fill(release_state_.begin(), release_state_.end(), 1.0f);
+
+        for (size_t d = 0; d < average_history_.get_num_channels(); ++d) {
+            BufferView(average_history_, d).fill(1.0f);
+            average_sum_[d] = static_cast<double>(get_window());
+        }
+        average_position_ = 0;
+    }
+
+    void PeakLimiter::compute_gain(float *levels, size_t count, size_t detector) {
+        // Gain each sample needs to stay under the ceiling (vectorizes)
+        const float ceiling = ceiling_;
+        for (size_t i = 0; i < count; ++i) {
+            levels[i] = levels[i] > ceiling ? ceiling / levels[i] : 1.0f;
+        }
+
+        // Instant attack, exponential release, then a moving average one
+        // window long. The held minimum covers the whole window ending at the
+        // delayed peak, so the average can't exceed the required gain there.
+        const size_t window = get_window();
+        const float release = release_coeff_;
+        float state = release_state_[detector];
+        float *history = average_history_.get_channel_data(detector);
+        double sum = average_sum_[detector];
+        size_t position = average_position_;
+
+        for (size_t i = 0; i < count; ++i) {
+            state = levels[i] < state ? levels[i] : levels[i] + release * (state - levels[i]);
+
+            sum += static_cast<double>(state) - static_cast<double>(history[position]);
+            history[position] = state;
+            if (++position == window) position = 0;
+
+            levels[i] = static_cast<float>(sum / static_cast<double>(window));
+        }
+
+        release_state_[detector] = state;
+        average_sum_[detector] = sum;
+
+        // All detectors advance in lockstep; commit the position after the last one
+        if (detector + 1 == get_num_detectors()) {
+            average_position_ = position;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Compressor
+    // ------------------------------------------------------------------------
+
+    Compressor::Compressor(const CompressorSettings &settings)
+        : DynamicsProcessor(settings.lookahead_ms, settings.link),
+          settings_(settings),
+          attack_coeff_(0.0f),
+          release_coeff_(0.0f) {
+    }
+
+    void Compressor::set_settings(const CompressorSettings &settings) {
+        settings_.threshold_db = settings.threshold_db;
+        settings_.ratio = settings.ratio;
+        settings_.knee_db = settings.knee_db;
+        settings_.attack_ms = settings.attack_ms;
+        settings_.release_ms = settings.release_ms;
+        settings_.makeup_db = settings.makeup_db;
+        update_coefficients();
+    }
+
+    void Compressor::update_coefficients() {
+        attack_coeff_ = time_coeff(settings_.attack_ms, get_sample_rate());
+        release_coeff_ = time_coeff(settings_.release_ms, get_sample_rate());
+    }
+
+    void Compressor::prepare_detectors(size_t num_detectors) {
+        envelope_.assign(num_detectors, 0.0f);
+        update_coefficients();
+    }
+
+    void Compressor::reset_detectors() {
+        std::fill(envelope_.begin(), envelope_.end(), 0.0f);
+    }
+
+    void Compressor::compute_gain(float *levels, size_t count, size_t detector) {
+        // Envelope follower (the only serial part)
+        const float attack = attack_coeff_;
+        const float release = release_coeff_;
+        float envelope = envelope_[detector];
+
+        for (size_t i = 0; i < count; ++i) {
+            const float coeff = levels[i] > envelope ? attack : release;
+            envelope = levels[i] + coeff * (envelope - levels[i]);
+            levels[i] = envelope;
+        }
+        envelope_[detector] = envelope;
+
+        // Soft-knee gain computer in the log domain
+        const float threshold = settings_.threshold_db;
+        const float knee = std::max(settings_.knee_db, 0.0f);
+        const float slope = 1.0f / std::max(settings_.ratio, 1.0f) - 1.0f;
+        const float makeup = settings_.makeup_db;
+
+        for (size_t i = 0; i < count; ++i) {
+            const float level_db = 20.0f * std::log10(std::max(levels[i], 1.0e-9f));
+            const float over = level_db - threshold;
+
+            float reduction_db = 0.0f;
+            if (2.0f * over >= knee) {
+                reduction_db = slope * over;
+            } else if (2.0f * over > -knee) {
+                const float x = over + 0.5f * knee;
+                reduction_db = slope * x * x / (2.0f * knee);
+            }
+
+            levels[i] = db_to_gain(reduction_db + makeup);
+        }
+    }
+}
@@ -0,0 +1,312 @@
+#include "gw/core/external_processor.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+namespace gw::core {
+    static_assert(sizeof(gw_event) == 24, "gw_event layout is part of the ABI");
+    static_assert(sizeof(gw_parameter_change) == 16, "gw_parameter_change layout is part of the ABI");
+    static_assert(sizeof(void *) != 8 || sizeof(gw_process_block) == 64,
+                  "gw_process_block layout is part of the ABI");
+    static_assert(GW_PROCESSOR_MIN_STRUCT_SIZE == offsetof(gw_processor, process_batch),
+                  "required gw_processor entry points come first");
+
+    namespace {
+        uint32_t to_u32(size_t value) {
+            return static_cast<uint32_t>(std::min<size_t>(value, std::numeric_limits<uint32_t>::max()));
+        }
+
+        // Entry points of an exported BlockProcessor; the instance is the BlockProcessor.
+        // No exception may cross into the host: prepare() reports one as an
+        // error, and the audio-thread calls terminate rather than unwind.
+        BlockProcessor *as_block_processor(void *instance) {
+            return static_cast<BlockProcessor *>(instance);
+        }
+
+        int32_t prepare_entry(void *instance, double sample_rate, uint32_t max_block_size,
+                              uint32_t num_channels) noexcept {
+            try {
+                const bool ok = as_block_processor(instance)->prepare(sample_rate, max_block_size, num_channels);
+                return ok ? GW_STATUS_OK : GW_STATUS_ERROR;
+            } catch (...) {
+                return GW_STATUS_ERROR;
+            }
+        }
+
+        void process_entry(void *instance, const gw_process_block *block) noexcept {
+            if (block) as_block_processor(instance)->process(*block);
+        }
+
+        void process_batch_entry(void *instance, const gw_process_block *blocks, uint32_t num_blocks) noexcept {
+            if (blocks) as_block_processor(instance)->process_batch(blocks, num_blocks);
+        }
+
+        void reset_entry(void *instance) noexcept {
+            as_block_processor(instance)->reset();
+        }
+
+        uint32_t get_latency_entry(const void *instance) noexcept {
+            return to_u32(static_cast<const BlockProcessor *>(instance)->get_latency_samples());
+        }
+
+        void destroy_entry(void *instance) noexcept {
+            delete as_block_processor(instance);
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // ProcessBlockBatch
+    // ------------------------------------------------------------------
+
+    ProcessBlockBatch::ProcessBlockBatch(size_t max_blocks, size_t max_channels, size_t max_events,
+                                         size_t max_parameter_changes)
+        : max_blocks_(max_blocks),
+          max_channels_(max_channels),
+          num_blocks_(0),
+          num_events_(0),
+          num_parameter_changes_(0),
+          blocks_(max_blocks),
+          channels_(max_blocks * max_channels, nullptr),
+          events_(max_events),
+          parameter_changes_(max_parameter_changes) {
+    }
+
+    void ProcessBlockBatch::clear() {
+        num_blocks_ = 0;
+        num_events_ = 0;
+        num_parameter_changes_ = 0;
+    }
+
+    bool ProcessBlockBatch::add_block(AudioBuffer &buffer, size_t offset, size_t num_samples,
+                                      uint64_t sample_position, uint32_t flags) {
+        const size_t num_channels = buffer.get_num_channels();
+        if (num_blocks_ >= max_blocks_ || num_channels > max_channels_) return false;
+        if (offset > buffer.get_num_samples() || num_samples > buffer.get_num_samples() - offset) return false;
+
+        float **slot = channels_.data() + num_blocks_ * max_channels_;
+        for (size_t ch = 0; ch < num_channels; ++ch) slot[ch] = buffer.get_channel_data(ch) + offset;
+        return add_block(slot, num_channels, num_samples, sample_position, flags);
+    }
+
+    bool ProcessBlockBatch::add_block(float *const *channels, size_t num_channels, size_t num_samples,
+                                      uint64_t sample_position, uint32_t flags) {
+        if (num_blocks_ >= max_blocks_ || num_channels > max_channels_) return false;
+        if (!channels && num_channels > 0) return false;
+
+        // The AudioBuffer overload has already written the slot
+        float **slot = channels_.data() + num_blocks_ * max_channels_;
+        if (channels != slot) std::copy_n(channels, num_channels, slot);
+
+        gw_process_block &block = blocks_[num_blocks_++];
+        block = gw_process_block{};
+        block.struct_size = sizeof(gw_process_block);
+        block.flags = flags;
+        block.num_channels = to_u32(num_channels);
+        block.num_samples = to_u32(num_samples);
+        block.sample_position = sample_position;
+        block.channels = slot;
+        block.events = events_.data() + num_events_;
+        block.parameter_changes = parameter_changes_.data() + num_parameter_changes_;
+        return true;
+    }
+
+    bool ProcessBlockBatch::add_event(const gw_event &event) {
+        if (num_blocks_ == 0 || num_events_ >= events_.size()) return false;
+
+        gw_process_block &block = blocks_[num_blocks_ - 1];
+        if (event.sample_offset >= block.num_samples) return false;
+        if (block.num_events > 0 && event.sample_offset < events_[num_events_ - 1].sample_offset) return false;
+
+        events_[num_events_++] = event;
+        ++block.num_events;
+        return true;
+    }
+
+    bool ProcessBlockBatch::add_parameter_change(uint32_t sample_offset, uint32_t parameter_id, float value) {
+        if (num_blocks_ == 0 || num_parameter_changes_ >= parameter_changes_.size()) return false;
+
+        gw_process_block &block = blocks_[num_blocks_ - 1];
+        if (sample_offset >= block.num_samples) return false;
+        if (block.num_parameter_changes > 0 &&
+            sample_offset < parameter_changes_[num_parameter_changes_ - 1].sample_offset) {
+            return false;
+        }
+
+        parameter_changes_[num_parameter_changes_++] = gw_parameter_change{sample_offset, parameter_id, value, 0};
+        ++block.num_parameter_changes;
+        return true;
+    }
+
+    // ------------------------------------------------------------------
+    // ExternalProcessor
+    // ------------------------------------------------------------------
+
+    ExternalProcessor::~ExternalProcessor() {
+        close();
+    }
+
+    bool ExternalProcessor::open(gw_create_processor_fn create) {
+        if (!create) return false;
+
+        gw_processor table{};
+        table.struct_size = sizeof(gw_processor);
+        if (create(GW_PROCESSOR_ABI_VERSION, &table) != GW_STATUS_OK) return false;
+
+        if (!open(table)) {
+            // We created it, so nobody else will free it
+            if (table.destroy && table.instance) table.destroy(table.instance);
+            return false;
+        }
+        return true;
+    }
+
+    bool ExternalProcessor::open(const gw_processor &processor) {
+        if (processor.abi_version != GW_PROCESSOR_ABI_VERSION) return false;
+        if (processor.struct_size < GW_PROCESSOR_MIN_STRUCT_SIZE) return false;
+
+        // A processor built against an older header has a shorter table:
+        // read only what it holds, the entry points it lacks stay NULL
+        gw_processor table{};
+        std::memcpy(&table, &processor, std::min<size_t>(processor.struct_size, sizeof(gw_processor)));
+        if (!table.instance || !table.prepare || !table.process || !table.destroy) return false;
+
+        close();
+        processor_ = table;
+        return true;
+    }
+
+    void ExternalProcessor::close() {
+        if (processor_.instance) processor_.destroy(processor_.instance);
+        processor_ = gw_processor{};
+        prepared_ = false;
+        position_ = 0;
+    }
+
+    void ExternalProcessor::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        prepared_ = false;
+        if (!is_open()) return;
+
+        channels_.assign(num_channels, nullptr);
+        prepared_ = processor_.prepare(processor_.instance, sample_rate, to_u32(max_block_size),
+                                       to_u32(num_channels)) == GW_STATUS_OK;
+        position_ = 0;
+    }
+
+    void ExternalProcessor::process(BufferView *channels, size_t num_channels) {
+        if (!prepared_ || !channels || num_channels == 0) return;
+
+        num_channels = std::min(num_channels, channels_.size());
+        for (size_t ch = 0; ch < num_channels; ++ch) channels_[ch] = channels[ch].data();
+
+        gw_process_block block{};
+        block.struct_size = sizeof(gw_process_block);
+        block.num_channels = to_u32(num_channels);
+        block.num_samples = to_u32(channels[0].size());
+        block.sample_position = position_;
+        block.channels = channels_.data();
+        processor_.process(processor_.instance, &block);
+
+        position_ += block.num_samples;
+    }
+
+    void ExternalProcessor::process(const gw_process_block &block) {
+        if (!prepared_) return;
+        processor_.process(processor_.instance, &block);
+    }
+
+    void ExternalProcessor::process_batch(const gw_process_block *blocks, size_t num_blocks) {
+        if (!prepared_ || !blocks || num_blocks == 0) return;
+
+        if (processor_.process_batch) {
+            processor_.process_batch(processor_.instance, blocks, to_u32(num_blocks));
+            return;
+        }
+
+        for (size_t i = 0; i < num_blocks; ++i) processor_.process(processor_.instance, &blocks[i]);
+    }
+
+    void ExternalProcessor::reset() {
+        if (is_open() && processor_.reset) processor_.reset(processor_.instance);
+        position_ = 0;
+    }
+
+    size_t ExternalProcessor::get_latency_samples() const {
+        if (!is_open() || !processor_.get_latency_samples) return 0;
+        return processor_.get_latency_samples(processor_.instance);
+    }
+
+    // ------------------------------------------------------------------
+    // BlockProcessor / ProcessorBlockAdapter
+    // ------------------------------------------------------------------
+
+    void BlockProcessor::process_batch(const gw_process_block *blocks, size_t num_blocks) {
+        for (size_t i = 0; i < num_blocks; ++i) process(blocks[i]);
+    }
+
+    ProcessorBlockAdapter::ProcessorBlockAdapter(std::unique_ptr<Processor> processor)
+        : processor_(std::move(processor)) {
+    }
+
+    bool ProcessorBlockAdapter::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        if (!processor_) return false;
+        processor_->prepare(sample_rate, max_block_size, num_channels);
+        views_.resize(num_channels);
+        return true;
+    }
+
+    void ProcessorBlockAdapter::process(const gw_process_block &block) {
+        const size_t num_channels = std::min<size_t>(block.num_channels, views_.size());
+        if (num_channels == 0) return;
+
+        for (size_t ch = 0; ch < num_channels; ++ch) views_[ch] = BufferView(block.channels[ch], block.num_samples);
+        processor_->process(views_.data(), num_channels);
+    }
+
+    void ProcessorBlockAdapter::reset() {
+        if (processor_) processor_->reset();
+    }
+
+    size_t ProcessorBlockAdapter::get_latency_samples() const {
+        return processor_ ? processor_->get_latency_samples() : 0;
+    }
+
+    // ------------------------------------------------------------------
+    // Export
+    // ------------------------------------------------------------------
+
+    int32_t export_processor(std::unique_ptr<BlockProcessor> processor, uint32_t host_abi_version,
+                             gw_processor *out) noexcept {
+        if (!processor || !out) return GW_STATUS_INVALID_ARGUMENT;
+        if (host_abi_version != GW_PROCESSOR_ABI_VERSION) return GW_STATUS_VERSION_MISMATCH;
+
+        if (out->struct_size != 0 && out->struct_size < GW_PROCESSOR_MIN_STRUCT_SIZE) {
+            return GW_STATUS_INVALID_ARGUMENT;
+        }
+
+        try {
+            gw_processor table{};
+            table.struct_size = sizeof(gw_processor);
+            table.abi_version = GW_PROCESSOR_ABI_VERSION;
+            table.instance = processor.get();
+            table.prepare = prepare_entry;
+            table.process = process_entry;
+            table.process_batch = process_batch_entry;
+            table.reset = reset_entry;
+            table.get_latency_samples = get_latency_entry;
+            table.destroy = destroy_entry;
+
+            // Write no more than the host's struct holds
+            const size_t size = out->struct_size == 0 ? sizeof(gw_processor)
+                                                      : std::min<size_t>(out->struct_size, sizeof(gw_processor));
+            table.struct_size = static_cast<uint32_t>(size);
+            std::memcpy(out, &table, size);
+        } catch (...) {
+            return GW_STATUS_ERROR;
+        }
+
+        // The table owns it now
+        static_cast<void>(processor.release());
+        return GW_STATUS_OK;
+    }
+}
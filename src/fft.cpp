@@ -0,0 +1,264 @@
+#include "gw/core/fft.h"
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace gw::core {
+    /**
+     *  Size-dependent tables, shared by every RealFft of one size.
+     */
+    struct FftPlan {
+        size_t size = 0;
+        size_t half_size = 0;
+
+        // Stage with half-length h uses e^(-2 pi i k / 2h), k < h, stored at offset h - 1
+        std::vector<float> twiddle_real;
+        std::vector<float> twiddle_imag;
+
+        // e^(-2 pi i k / size), k <= half_size
+        std::vector<float> split_real;
+        std::vector<float> split_imag;
+
+        std::vector<uint32_t> bit_reverse;
+    };
+
+    namespace {
+        size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        std::shared_ptr<const FftPlan> build_plan(size_t size) {
+            auto plan = std::make_shared<FftPlan>();
+            plan->size = size;
+            plan->half_size = size / 2;
+
+            const size_t n = plan->half_size;
+            const double pi = std::acos(-1.0);
+
+            plan->twiddle_real.resize(n > 1 ? n - 1 : 1);
+            plan->twiddle_imag.resize(plan->twiddle_real.size());
+            for (size_t half = 1; half < n; half <<= 1) {
+                for (size_t k = 0; k < half; ++k) {
+                    const double angle = -pi * static_cast<double>(k) / static_cast<double>(half);
+                    plan->twiddle_real[half - 1 + k] = static_cast<float>(std::cos(angle));
+                    plan->twiddle_imag[half - 1 + k] = static_cast<float>(std::sin(angle));
+                }
+            }
+
+            plan->split_real.resize(n + 1);
+            plan->split_imag.resize(n + 1);
+            for (size_t k = 0; k <= n; ++k) {
+                const double angle = -2.0 * pi * static_cast<double>(k) / static_cast<double>(size);
+                plan->split_real[k] = static_cast<float>(std::cos(angle));
+                plan->split_imag[k] = static_cast<float>(std::sin(angle));
+            }
+
+            size_t bits = 0;
+            while ((size_t{1} << bits) < n) ++bits;
+
+            plan->bit_reverse.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                size_t reversed = 0;
+                for (size_t b = 0; b < bits; ++b) {
+                    reversed |= ((i >> b) & 1u) << (bits - 1 - b);
+                }
+                plan->bit_reverse[i] = static_cast<uint32_t>(reversed);
+            }
+
+            return plan;
+        }
+
+        struct PlanCache {
+            std::mutex mutex;
+            std::map<size_t, std::weak_ptr<const FftPlan> > plans;
+        };
+
+        PlanCache &get_plan_cache() {
+            static PlanCache cache;
+            return cache;
+        }
+
+        std::shared_ptr<const FftPlan> acquire_plan(size_t size) {
+            PlanCache &cache = get_plan_cache();
+            std::lock_guard<std::mutex> lock(cache.mutex);
+
+            std::weak_ptr<const FftPlan> &slot = cache.plans[size];
+            std::shared_ptr<const FftPlan> plan = slot.lock();
+            if (!plan) {
+                plan = build_plan(size);
+                slot = plan;
+            }
+            return plan;
+        }
+
+        // One group of radix-2 butterflies: a = a + w b, b = a - w b.
+        // Split arrays and unit-stride twiddles let this loop vectorize.
+        GW_CORE_FORCE_INLINE void butterflies(float *__restrict a_real, float *__restrict a_imag,
+                                              float *__restrict b_real, float *__restrict b_imag,
+                                              const float *__restrict w_real, const float *__restrict w_imag,
+                                              float sign, size_t count) {
+            for (size_t k = 0; k < count; ++k) {
+                const float wr = w_real[k];
+                const float wi = sign * w_imag[k];
+                const float xr = b_real[k] * wr - b_imag[k] * wi;
+                const float xi = b_real[k] * wi + b_imag[k] * wr;
+                b_real[k] = a_real[k] - xr;
+                b_imag[k] = a_imag[k] - xi;
+                a_real[k] += xr;
+                a_imag[k] += xi;
+            }
+        }
+
+        // Iterative radix-2 decimation in time over bit-reversed input.
+        // sign is -1 for the inverse (conjugated twiddles).
+        GW_CORE_FORCE_INLINE void run_stages(float *real, float *imag, const FftPlan &plan, float sign) {
+            const size_t n = plan.half_size;
+
+            // First stage: all twiddles are 1
+            for (size_t start = 0; start + 1 < n; start += 2) {
+                const float br = real[start + 1];
+                const float bi = imag[start + 1];
+                real[start + 1] = real[start] - br;
+                imag[start + 1] = imag[start] - bi;
+                real[start] += br;
+                imag[start] += bi;
+            }
+
+            for (size_t half = 2; half < n; half <<= 1) {
+                const float *w_real = plan.twiddle_real.data() + half - 1;
+                const float *w_imag = plan.twiddle_imag.data() + half - 1;
+
+                for (size_t start = 0; start < n; start += 2 * half) {
+                    butterflies(real + start, imag + start, real + start + half, imag + start + half,
+                                w_real, w_imag, sign, half);
+                }
+            }
+        }
+
+        using StagesFn = void (*)(float *, float *, const FftPlan &, float);
+
+        void run_stages_generic(float *real, float *imag, const FftPlan &plan, float sign) {
+            run_stages(real, imag, plan, sign);
+        }
+
+        GW_CORE_TARGET_AVX2
+        void run_stages_avx2(float *real, float *imag, const FftPlan &plan, float sign) {
+            run_stages(real, imag, plan, sign);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void run_stages_avx512(float *real, float *imag, const FftPlan &plan, float sign) {
+            run_stages(real, imag, plan, sign);
+        }
+
+        StagesFn get_stages() {
+            // Resolved once on first use
+            static const StagesFn kernel = select_kernel<StagesFn>(run_stages_generic, run_stages_avx2,
+                                                                   run_stages_avx512);
+            return kernel;
+        }
+    }
+
+    RealFft::RealFft(size_t size)
+        : size_(round_up_pow2(std::max<size_t>(size, 4))),
+          half_size_(size_ / 2),
+          plan_(acquire_plan(size_)),
+          work_real_(half_size_),
+          work_imag_(half_size_) {
+        // Pick the kernel now rather than on the audio thread
+        static_cast<void>(get_stages());
+    }
+
+    size_t RealFft::get_cached_plan_count() {
+        PlanCache &cache = get_plan_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+
+        size_t count = 0;
+        for (const auto &[size, plan]: cache.plans) {
+            if (!plan.expired()) ++count;
+        }
+        return count;
+    }
+
+    void RealFft::transform(bool inverse) {
+        const StagesFn stages = get_stages();
+
+        const uint32_t *bit_reverse = plan_->bit_reverse.data();
+        for (size_t i = 0; i < half_size_; ++i) {
+            const size_t j = bit_reverse[i];
+            if (i < j) {
+                std::swap(work_real_[i], work_real_[j]);
+                std::swap(work_imag_[i], work_imag_[j]);
+            }
+        }
+
+        stages(work_real_.data(), work_imag_.data(), *plan_, inverse ? -1.0f : 1.0f);
+    }
+
+    void RealFft::forward(const float *input, std::complex<float> *output) {
+        const size_t n = half_size_;
+        float *real = work_real_.data();
+        float *imag = work_imag_.data();
+
+        // Pack even samples into real parts, odd samples into imaginary parts
+        for (size_t k = 0; k < n; ++k) {
+            real[k] = input[2 * k];
+            imag[k] = input[2 * k + 1];
+        }
+
+        transform(false);
+
+        // Split the packed spectrum into the spectra of the even and odd samples
+        const float *w_real = plan_->split_real.data();
+        const float *w_imag = plan_->split_imag.data();
+        for (size_t k = 0; k <= n; ++k) {
+            const size_t i = k % n;
+            const size_t m = (n - k) % n;
+
+            // z = work[k], z_mirror = conj(work[n - k])
+            const float even_real = 0.5f * (real[i] + real[m]);
+            const float even_imag = 0.5f * (imag[i] - imag[m]);
+            const float odd_real = 0.5f * (imag[i] + imag[m]); // -i/2 * (z - z_mirror)
+            const float odd_imag = -0.5f * (real[i] - real[m]);
+
+            output[k] = {even_real + w_real[k] * odd_real - w_imag[k] * odd_imag,
+                         even_imag + w_real[k] * odd_imag + w_imag[k] * odd_real};
+        }
+    }
+
+    void RealFft::inverse(const std::complex<float> *input, float *output) {
+        const size_t n = half_size_;
+        float *real = work_real_.data();
+        float *imag = work_imag_.data();
+        const float *w_real = plan_->split_real.data();
+        const float *w_imag = plan_->split_imag.data();
+
+        for (size_t k = 0; k < n; ++k) {
+            const std::complex<float> x = input[k];
+            const std::complex<float> x_mirror = std::conj(input[n - k]);
+
+            const float even_real = 0.5f * (x.real() + x_mirror.real());
+            const float even_imag = 0.5f * (x.imag() + x_mirror.imag());
+            const float diff_real = 0.5f * (x.real() - x_mirror.real());
+            const float diff_imag = 0.5f * (x.imag() - x_mirror.imag());
+
+            // odd = diff * conj(w); work = even + i * odd
+            const float odd_real = diff_real * w_real[k] + diff_imag * w_imag[k];
+            const float odd_imag = diff_imag * w_real[k] - diff_real * w_imag[k];
+            real[k] = even_real - odd_imag;
+            imag[k] = even_imag + odd_real;
+        }
+
+        transform(true);
+
+        const float scale = 1.0f / static_cast<float>(n);
+        for (size_t k = 0; k < n; ++k) {
+            output[2 * k] = real[k] * scale;
+            output[2 * k + 1] = imag[k] * scale;
+        }
+    }
+}
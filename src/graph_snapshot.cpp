@@ -0,0 +1,384 @@
+#include "gw/core/graph_snapshot.h"
+#include "gw/core/rt.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gw::core {
+    // The records are the file format: pin their layout
+    static_assert(sizeof(SnapshotSectionEntry) == 16);
+    static_assert(sizeof(SnapshotHeader) == 128);
+    static_assert(sizeof(SnapshotNode) == 64);
+    static_assert(sizeof(SnapshotConnection) == 16);
+    static_assert(std::is_trivially_copyable_v<SnapshotHeader> && std::is_trivially_copyable_v<SnapshotNode>);
+
+    namespace {
+        constexpr size_t STATE_ALIGN = 16;
+
+        size_t round_up(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        bool is_little_endian() {
+            const uint32_t probe = 1;
+            uint8_t first = 0;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }
+
+        uint64_t fnv1a(const uint8_t *data, size_t size) {
+            uint64_t hash = 0xcbf29ce484222325ull;
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= data[i];
+                hash *= 0x100000001b3ull;
+            }
+            return hash;
+        }
+
+        // offset + size <= limit, without overflowing
+        bool fits(uint64_t offset, uint64_t size, uint64_t limit) {
+            return offset <= limit && size <= limit - offset;
+        }
+
+        size_t section_index(SnapshotSection section) {
+            return static_cast<size_t>(section);
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // GraphSnapshotWriter
+    // ------------------------------------------------------------------
+
+    uint32_t GraphSnapshotWriter::add_node(uint32_t type_id, std::string_view name, uint32_t num_inputs,
+                                           uint32_t num_outputs, const float *parameters, size_t num_parameters,
+                                           const void *state, size_t state_size, uint32_t flags) {
+        SnapshotNode node{};
+        node.type_id = type_id;
+        node.flags = flags;
+        node.num_inputs = num_inputs;
+        node.num_outputs = num_outputs;
+
+        node.parameter_index = parameters_.size();
+        node.parameter_count = parameters ? num_parameters : 0;
+        if (parameters) parameters_.insert(parameters_.end(), parameters, parameters + num_parameters);
+
+        state_.resize(round_up(state_.size(), STATE_ALIGN), 0);
+        node.state_offset = state_.size();
+        node.state_size = state ? state_size : 0;
+        if (state) {
+            const auto *bytes = static_cast<const uint8_t *>(state);
+            state_.insert(state_.end(), bytes, bytes + state_size);
+        }
+
+        node.name_offset = strings_.size();
+        node.name_size = name.size();
+        strings_.append(name);
+
+        nodes_.push_back(node);
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+    bool GraphSnapshotWriter::connect(uint32_t source_node, uint32_t source_port, uint32_t dest_node,
+                                      uint32_t dest_port) {
+        if (source_node >= nodes_.size() || dest_node >= nodes_.size()) return false;
+        if (source_port >= nodes_[source_node].num_outputs || dest_port >= nodes_[dest_node].num_inputs) {
+            return false;
+        }
+
+        connections_.push_back({source_node, source_port, dest_node, dest_port});
+        return true;
+    }
+
+    size_t GraphSnapshotWriter::get_image_size() const {
+        size_t size = round_up(sizeof(SnapshotHeader), SNAPSHOT_ALIGN);
+        size = round_up(size + nodes_.size() * sizeof(SnapshotNode), SNAPSHOT_ALIGN);
+        size = round_up(size + connections_.size() * sizeof(SnapshotConnection), SNAPSHOT_ALIGN);
+        size = round_up(size + parameters_.size() * sizeof(float), SNAPSHOT_ALIGN);
+        size = round_up(size + state_.size(), SNAPSHOT_ALIGN);
+        return round_up(size + strings_.size(), SNAPSHOT_ALIGN);
+    }
+
+    size_t GraphSnapshotWriter::write(void *dest, size_t capacity) const {
+        const size_t image_size = get_image_size();
+        if (!dest || capacity < image_size) return 0;
+
+        auto *image = static_cast<uint8_t *>(dest);
+        std::memset(image, 0, image_size);
+
+        SnapshotHeader header{};
+        header.magic = SNAPSHOT_MAGIC;
+        header.version_major = SNAPSHOT_VERSION_MAJOR;
+        header.version_minor = SNAPSHOT_VERSION_MINOR;
+        header.byte_order = SNAPSHOT_BYTE_ORDER;
+        header.header_size = sizeof(SnapshotHeader);
+        header.image_size = image_size;
+        header.num_nodes = nodes_.size();
+        header.num_connections = connections_.size();
+
+        const struct {
+            SnapshotSection section;
+            const void *data;
+            size_t size;
+        } sections[] = {
+            {SnapshotSection::Nodes, nodes_.data(), nodes_.size() * sizeof(SnapshotNode)},
+            {SnapshotSection::Connections, connections_.data(), connections_.size() * sizeof(SnapshotConnection)},
+            {SnapshotSection::Parameters, parameters_.data(), parameters_.size() * sizeof(float)},
+            {SnapshotSection::State, state_.data(), state_.size()},
+            {SnapshotSection::Strings, strings_.data(), strings_.size()},
+        };
+
+        size_t offset = round_up(sizeof(SnapshotHeader), SNAPSHOT_ALIGN);
+        for (const auto &section: sections) {
+            header.sections[section_index(section.section)] = {offset, section.size};
+            if (section.size > 0) std::memcpy(image + offset, section.data, section.size);
+            offset = round_up(offset + section.size, SNAPSHOT_ALIGN);
+        }
+
+        header.checksum = fnv1a(image + sizeof(SnapshotHeader), image_size - sizeof(SnapshotHeader));
+        std::memcpy(image, &header, sizeof(header));
+        return image_size;
+    }
+
+    bool GraphSnapshotWriter::save(const std::string &path) const {
+        std::vector<uint8_t> image(get_image_size());
+        write(image.data(), image.size());
+
+        // Write to a private name and rename, so readers never see a partial file
+#ifdef __linux__
+        const auto writer_id = static_cast<unsigned long>(getpid());
+#else
+        const auto writer_id = static_cast<unsigned long>(reinterpret_cast<uintptr_t>(image.data()));
+#endif
+        const std::string temp_path = path + ".tmp" + std::to_string(writer_id);
+        FILE *file = std::fopen(temp_path.c_str(), "wb");
+        if (!file) return false;
+
+        bool ok = std::fwrite(image.data(), 1, image.size(), file) == image.size();
+        ok = std::fclose(file) == 0 && ok;
+#ifdef _WIN32
+        if (ok) std::remove(path.c_str()); // rename() doesn't replace an existing file there
+#endif
+        if (ok) ok = std::rename(temp_path.c_str(), path.c_str()) == 0;
+        if (!ok) std::remove(temp_path.c_str());
+        return ok;
+    }
+
+    // ------------------------------------------------------------------
+    // GraphSnapshot
+    // ------------------------------------------------------------------
+
+    bool GraphSnapshot::open(const void *data, size_t size, bool verify_checksum) {
+        *this = GraphSnapshot();
+
+        const auto *image = static_cast<const uint8_t *>(data);
+        if (!image || size < sizeof(SnapshotHeader) || reinterpret_cast<uintptr_t>(image) % SNAPSHOT_ALIGN != 0) {
+            return false;
+        }
+        if (!is_little_endian()) return false;
+
+        const auto *header = reinterpret_cast<const SnapshotHeader *>(image);
+        if (header->magic != SNAPSHOT_MAGIC || header->version_major != SNAPSHOT_VERSION_MAJOR ||
+            header->byte_order != SNAPSHOT_BYTE_ORDER || header->header_size < sizeof(SnapshotHeader) ||
+            header->image_size > size || header->image_size < header->header_size) {
+            return false;
+        }
+
+        // Sections: aligned, after the header, inside the image
+        for (const SnapshotSectionEntry &section: header->sections) {
+            if (section.offset % SNAPSHOT_ALIGN != 0 || section.offset < header->header_size ||
+                !fits(section.offset, section.size, header->image_size)) {
+                return false;
+            }
+        }
+
+        const SnapshotSectionEntry &nodes = header->sections[section_index(SnapshotSection::Nodes)];
+        const SnapshotSectionEntry &connections = header->sections[section_index(SnapshotSection::Connections)];
+        const SnapshotSectionEntry &parameters = header->sections[section_index(SnapshotSection::Parameters)];
+        const SnapshotSectionEntry &state = header->sections[section_index(SnapshotSection::State)];
+        const SnapshotSectionEntry &strings = header->sections[section_index(SnapshotSection::Strings)];
+
+        if (header->num_nodes > nodes.size / sizeof(SnapshotNode) ||
+            nodes.size != header->num_nodes * sizeof(SnapshotNode) ||
+            header->num_connections > connections.size / sizeof(SnapshotConnection) ||
+            connections.size != header->num_connections * sizeof(SnapshotConnection) ||
+            parameters.size % sizeof(float) != 0) {
+            return false;
+        }
+
+        if (verify_checksum &&
+            fnv1a(image + header->header_size, header->image_size - header->header_size) != header->checksum) {
+            return false;
+        }
+
+        // Every reference a reader will follow stays inside its section
+        const auto *node_records = reinterpret_cast<const SnapshotNode *>(image + nodes.offset);
+        const uint64_t num_parameters = parameters.size / sizeof(float);
+        for (size_t i = 0; i < header->num_nodes; ++i) {
+            const SnapshotNode &node = node_records[i];
+            if (!fits(node.parameter_index, node.parameter_count, num_parameters) ||
+                !fits(node.state_offset, node.state_size, state.size) || node.state_offset % STATE_ALIGN != 0 ||
+                !fits(node.name_offset, node.name_size, strings.size)) {
+                return false;
+            }
+        }
+
+        const auto *connection_records = reinterpret_cast<const SnapshotConnection *>(image + connections.offset);
+        for (size_t i = 0; i < header->num_connections; ++i) {
+            const SnapshotConnection &connection = connection_records[i];
+            if (connection.source_node >= header->num_nodes || connection.dest_node >= header->num_nodes ||
+                connection.source_port >= node_records[connection.source_node].num_outputs ||
+                connection.dest_port >= node_records[connection.dest_node].num_inputs) {
+                return false;
+            }
+        }
+
+        header_ = header;
+        nodes_ = node_records;
+        connections_ = connection_records;
+        parameters_ = reinterpret_cast<const float *>(image + parameters.offset);
+        state_ = image + state.offset;
+        strings_ = reinterpret_cast<const char *>(image + strings.offset);
+        num_nodes_ = static_cast<size_t>(header->num_nodes);
+        num_connections_ = static_cast<size_t>(header->num_connections);
+        return true;
+    }
+
+    const float *GraphSnapshot::get_parameters(size_t node) const {
+        return parameters_ + nodes_[node].parameter_index;
+    }
+
+    const uint8_t *GraphSnapshot::get_state(size_t node) const {
+        return state_ + nodes_[node].state_offset;
+    }
+
+    std::string_view GraphSnapshot::get_name(size_t node) const {
+        return {strings_ + nodes_[node].name_offset, static_cast<size_t>(nodes_[node].name_size)};
+    }
+
+    // ------------------------------------------------------------------
+    // SnapshotArena
+    // ------------------------------------------------------------------
+
+    SnapshotArena::SnapshotArena(size_t capacity, BufferMemory memory)
+        : data_(nullptr),
+          capacity_(round_up(capacity, SNAPSHOT_ALIGN)),
+          size_(0),
+          huge_pages_(false) {
+        if (memory == BufferMemory::HugePages) {
+            data_ = static_cast<uint8_t *>(rt::allocate_huge_pages(capacity_));
+            huge_pages_ = data_ != nullptr;
+        }
+        if (!data_) {
+            data_ = static_cast<uint8_t *>(::operator new(capacity_, std::align_val_t{SNAPSHOT_ALIGN},
+                                                          std::nothrow));
+        }
+        if (!data_) capacity_ = 0;
+    }
+
+    SnapshotArena::~SnapshotArena() {
+        if (huge_pages_) {
+            rt::free_huge_pages(data_, capacity_);
+        } else if (data_) {
+            ::operator delete(data_, std::align_val_t{SNAPSHOT_ALIGN});
+        }
+    }
+
+    bool SnapshotArena::load(const std::string &path, bool verify_checksum) {
+        snapshot_ = GraphSnapshot();
+        size_ = 0;
+
+        FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+
+        long end = -1;
+        if (std::fseek(file, 0, SEEK_END) == 0) end = std::ftell(file);
+        if (end < 0 || static_cast<size_t>(end) > capacity_ || std::fseek(file, 0, SEEK_SET) != 0) {
+            std::fclose(file);
+            return false;
+        }
+
+        // One read straight into place
+        const auto file_size = static_cast<size_t>(end);
+        const size_t done = std::fread(data_, 1, file_size, file);
+        std::fclose(file);
+        if (done != file_size) return false;
+
+        size_ = file_size;
+        return snapshot_.open(data_, size_, verify_checksum);
+    }
+
+    float *SnapshotArena::get_parameters(size_t node) {
+        return const_cast<float *>(snapshot_.get_parameters(node));
+    }
+
+    uint8_t *SnapshotArena::get_state(size_t node) {
+        return const_cast<uint8_t *>(snapshot_.get_state(node));
+    }
+
+    bool SnapshotArena::load(const void *data, size_t size, bool verify_checksum) {
+        snapshot_ = GraphSnapshot();
+        size_ = 0;
+        if (!data || size > capacity_) return false;
+
+        std::memcpy(data_, data, size);
+        size_ = size;
+        return snapshot_.open(data_, size_, verify_checksum);
+    }
+
+    // ------------------------------------------------------------------
+    // MappedSnapshot
+    // ------------------------------------------------------------------
+
+    MappedSnapshot::~MappedSnapshot() {
+        close();
+    }
+
+    bool MappedSnapshot::open(const std::string &path, bool verify_checksum) {
+        close();
+
+#ifdef __linux__
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const auto map_bytes = static_cast<size_t>(info.st_size);
+        void *map = mmap(nullptr, map_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+
+        map_ = map;
+        map_bytes_ = map_bytes;
+        if (!snapshot_.open(map_, map_bytes_, verify_checksum)) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        static_cast<void>(path);
+        static_cast<void>(verify_checksum);
+        return false;
+#endif
+    }
+
+    void MappedSnapshot::close() {
+        snapshot_ = GraphSnapshot();
+#ifdef __linux__
+        if (map_) munmap(map_, map_bytes_);
+#endif
+        map_ = nullptr;
+        map_bytes_ = 0;
+    }
+}
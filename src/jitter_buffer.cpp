@@ -0,0 +1,403 @@
+#include "gw/core/jitter_buffer.h"
+#include "gw/core/pcm_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gw::core {
+    namespace {
+        size_t ms_to_frames(float ms, double sample_rate) {
+            return static_cast<size_t>(std::max(0.0, std::ceil(static_cast<double>(ms) * sample_rate / 1000.0)));
+        }
+
+        // Catmull-Rom spline through four samples, evaluated at t in [0, 1) between s0 and s1
+        inline float cubic(float s_prev, float s0, float s1, float s2, float t) {
+            const float c1 = 0.5f * (s1 - s_prev);
+            const float c2 = s_prev - 2.5f * s0 + 2.0f * s1 - 0.5f * s2;
+            const float c3 = 0.5f * (s2 - s_prev) + 1.5f * (s0 - s1);
+            return ((c3 * t + c2) * t + c1) * t + s0;
+        }
+    }
+
+    JitterBuffer::JitterBuffer(const AudioFormat &format, const JitterBufferSettings &settings)
+        : format_(format),
+          settings_(settings),
+          num_channels_(format.get_num_channels()),
+          bytes_per_frame_(format.get_bytes_per_frame()),
+          min_target_frames_(ms_to_frames(settings.min_latency_ms, format.get_sample_rate())),
+          max_target_frames_(std::max(min_target_frames_,
+                                      ms_to_frames(settings.max_latency_ms, format.get_sample_rate()))),
+          started_(false),
+          expected_position_(0),
+          held_(settings.reorder_packets),
+          decode_scratch_(num_channels_, settings.max_packet_frames),
+          have_transit_(false),
+          last_transit_(0.0),
+          jitter_(0.0),
+          last_packet_frames_(0),
+          playing_(false),
+          // Enough input for the largest block at the fastest ratio, plus the spline taps
+          staging_(num_channels_, static_cast<size_t>(static_cast<double>(settings.max_block_size) *
+                                                      (1.0 + settings.max_ratio_correction)) + 8),
+          staged_(0),
+          phase_(1.0),
+          smoothed_error_(0.0),
+          integral_(0.0),
+          target_frames_(min_target_frames_),
+          ratio_(1.0),
+          jitter_seconds_(0.0),
+          packets_received_(0),
+          packets_lost_(0),
+          packets_late_(0),
+          packets_reordered_(0),
+          packets_rejected_(0),
+          overflows_(0),
+          underruns_(0) {
+        for (HeldPacket &packet: held_) {
+            packet.pcm.resize(settings_.max_packet_frames * bytes_per_frame_);
+        }
+
+        // The rings hold the largest target, the reorder window, and a block of slack
+        const size_t capacity = max_target_frames_ +
+                                (settings_.reorder_packets + 2) * settings_.max_packet_frames +
+                                settings_.max_block_size;
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            rings_.push_back(std::make_unique<RingBuffer>(capacity));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Network side
+    // ------------------------------------------------------------------------
+
+    bool JitterBuffer::push(uint64_t frame_position, const uint8_t *pcm, size_t num_frames, double arrival_seconds) {
+        if (!pcm || num_frames == 0 || num_frames > settings_.max_packet_frames || num_channels_ == 0) {
+            packets_rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        packets_received_.fetch_add(1, std::memory_order_relaxed);
+        update_jitter(frame_position, arrival_seconds, num_frames);
+
+        if (!started_) {
+            // Fill the reorder window before choosing where the stream starts,
+            // so an early packet overtaken by its successors is not lost
+            HeldPacket *slot = nullptr;
+            size_t free_slots = 0;
+            for (HeldPacket &held: held_) {
+                if (held.used) continue;
+                if (!slot) slot = &held;
+                ++free_slots;
+            }
+
+            uint64_t first = frame_position;
+            for (const HeldPacket &held: held_) {
+                if (held.used) first = std::min(first, held.frame_position);
+            }
+
+            if (slot) {
+                slot->used = true;
+                slot->frame_position = frame_position;
+                slot->num_frames = num_frames;
+                std::memcpy(slot->pcm.data(), pcm, num_frames * bytes_per_frame_);
+                if (free_slots > 1) return true;
+            }
+
+            started_ = true;
+            expected_position_ = first;
+            flush_held();
+            if (slot) return true;
+        }
+
+        if (frame_position < expected_position_) {
+            // Its slot was already concealed (or it is a duplicate)
+            packets_late_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        for (const HeldPacket &held: held_) {
+            if (held.used && held.frame_position == frame_position) {
+                packets_late_.fetch_add(1, std::memory_order_relaxed); // Duplicate
+                return false;
+            }
+        }
+
+        while (true) {
+            if (frame_position == expected_position_) {
+                for (const HeldPacket &held: held_) {
+                    if (held.used) {
+                        // Its successors got here first
+                        packets_reordered_.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+
+                write_frames(pcm, num_frames);
+                expected_position_ += num_frames;
+                flush_held();
+                return true;
+            }
+
+            // Ahead of a gap: hold it while the window has room
+            if (frame_position - expected_position_ < max_target_frames_) {
+                for (HeldPacket &held: held_) {
+                    if (!held.used) {
+                        held.used = true;
+                        held.frame_position = frame_position;
+                        held.num_frames = num_frames;
+                        std::memcpy(held.pcm.data(), pcm, num_frames * bytes_per_frame_);
+                        return true;
+                    }
+                }
+            }
+
+            // Window full (or the packet is far ahead): give up on the oldest gap
+            uint64_t next = frame_position;
+            for (const HeldPacket &held: held_) {
+                if (held.used) next = std::min(next, held.frame_position);
+            }
+
+            const uint64_t gap = next - expected_position_;
+            const size_t packet_frames = std::max<size_t>(last_packet_frames_, 1);
+            packets_lost_.fetch_add(std::max<uint64_t>(1, gap / packet_frames), std::memory_order_relaxed);
+
+            write_silence(static_cast<size_t>(std::min<uint64_t>(gap, max_target_frames_)));
+            expected_position_ = next;
+            flush_held();
+        }
+    }
+
+    void JitterBuffer::flush_held() {
+        bool found = true;
+        while (found) {
+            found = false;
+            for (HeldPacket &held: held_) {
+                if (!held.used) continue;
+
+                if (held.frame_position == expected_position_) {
+                    write_frames(held.pcm.data(), held.num_frames);
+                    expected_position_ += held.num_frames;
+                    held.used = false;
+                    found = true;
+                } else if (held.frame_position < expected_position_) {
+                    held.used = false; // Duplicate of audio already written
+                    packets_late_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    void JitterBuffer::write_frames(const uint8_t *pcm, size_t num_frames) {
+        const size_t decoded = decode_pcm(pcm, num_frames, format_, decode_scratch_, 0);
+
+        size_t space = decoded;
+        for (const auto &ring: rings_) {
+            space = std::min(space, ring->get_available_write());
+        }
+
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            rings_[ch]->write(decode_scratch_.get_channel_data(ch), space);
+        }
+
+        if (space < num_frames) {
+            overflows_.fetch_add(num_frames - space, std::memory_order_relaxed);
+        }
+    }
+
+    void JitterBuffer::write_silence(size_t num_frames) {
+        decode_scratch_.clear();
+        const size_t chunk_size = decode_scratch_.get_num_samples();
+
+        while (num_frames > 0) {
+            size_t chunk = std::min(num_frames, chunk_size);
+            for (const auto &ring: rings_) {
+                chunk = std::min(chunk, ring->get_available_write());
+            }
+
+            if (chunk == 0) {
+                overflows_.fetch_add(num_frames, std::memory_order_relaxed);
+                return;
+            }
+
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                rings_[ch]->write(decode_scratch_.get_channel_data(ch), chunk);
+            }
+            num_frames -= chunk;
+        }
+    }
+
+    void JitterBuffer::update_jitter(uint64_t frame_position, double arrival_seconds, size_t num_frames) {
+        // Relative transit time: constant for a perfectly regular stream
+        const double transit = arrival_seconds -
+                               static_cast<double>(frame_position) / static_cast<double>(format_.get_sample_rate());
+
+        if (have_transit_) {
+            const double deviation = std::abs(transit - last_transit_);
+            jitter_ += (deviation - jitter_) / 16.0;
+        }
+        have_transit_ = true;
+        last_transit_ = transit;
+        last_packet_frames_ = num_frames;
+
+        const double jitter_frames = jitter_ * static_cast<double>(format_.get_sample_rate());
+        const auto target = static_cast<size_t>((settings_.reorder_packets + 1) * num_frames) +
+                            static_cast<size_t>(static_cast<double>(settings_.jitter_multiplier) * jitter_frames);
+
+        target_frames_.store(std::clamp(target, min_target_frames_, max_target_frames_), std::memory_order_relaxed);
+        jitter_seconds_.store(jitter_, std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    // Audio side
+    // ------------------------------------------------------------------------
+
+    size_t JitterBuffer::get_ring_available() const {
+        if (rings_.empty()) return 0;
+
+        size_t available = rings_[0]->get_available_read();
+        for (size_t ch = 1; ch < rings_.size(); ++ch) {
+            available = std::min(available, rings_[ch]->get_available_read());
+        }
+        return available;
+    }
+
+    double JitterBuffer::get_fill_frames() const {
+        const double staged = playing_ ? static_cast<double>(staged_) - phase_ : 0.0;
+        return static_cast<double>(get_ring_available()) + std::max(0.0, staged);
+    }
+
+    size_t JitterBuffer::pull(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0) return 0;
+
+        const size_t frames = std::min(channels[0].size(), settings_.max_block_size);
+        const auto output_silence = [&] {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                std::memset(channels[ch].data(), 0, channels[ch].size() * sizeof(float));
+            }
+        };
+
+        if (frames == 0 || num_channels_ == 0) {
+            output_silence();
+            return 0;
+        }
+
+        const size_t target = target_frames_.load(std::memory_order_relaxed);
+        const size_t available = get_ring_available();
+
+        if (!playing_) {
+            // (Re)buffer until the target latency is reached
+            if (available == 0 || available < target) {
+                output_silence();
+                return 0;
+            }
+
+            playing_ = true;
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                staging_.get_channel_data(ch)[0] = 0.0f; // History for the first spline segment
+            }
+            staged_ = 1;
+            phase_ = 1.0;
+            smoothed_error_ = 0.0;
+        }
+
+        // PI controller on the smoothed fill error. With time constant tau,
+        // kp = 2 / (tau * rate) and ki = 1 / (tau^2 * rate) give a critically
+        // damped loop; the integral settles at the sender/receiver drift.
+        const double sample_rate = static_cast<double>(format_.get_sample_rate());
+        const double tau = std::max(0.01, static_cast<double>(settings_.drift_time_constant_s));
+        const double dt = static_cast<double>(frames) / sample_rate;
+        const double limit = settings_.max_ratio_correction;
+
+        const double fill = static_cast<double>(available) + static_cast<double>(staged_) - phase_;
+        const double error = fill - static_cast<double>(target);
+        smoothed_error_ += (error - smoothed_error_) * (dt / (0.25 * tau + dt));
+
+        integral_ = std::clamp(integral_ + smoothed_error_ * dt / (tau * tau * sample_rate), -limit, limit);
+        const double correction = std::clamp(2.0 * smoothed_error_ / (tau * sample_rate) + integral_, -limit, limit);
+        const double ratio = 1.0 + correction;
+
+        // Input needed: up to the sample after the last output's right neighbour
+        const auto needed = static_cast<size_t>(phase_ + static_cast<double>(frames - 1) * ratio) + 3;
+        if (needed > staged_) {
+            const size_t to_read = needed - staged_;
+            if (available < to_read) {
+                underruns_.fetch_add(1, std::memory_order_relaxed);
+                playing_ = false;
+                output_silence();
+                return 0;
+            }
+
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                rings_[ch]->read(staging_.get_channel_data(ch) + staged_, to_read);
+            }
+            staged_ = needed;
+        }
+
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            float *out = channels[ch].data();
+
+            if (ch >= num_channels_) {
+                std::memset(out, 0, channels[ch].size() * sizeof(float));
+                continue;
+            }
+
+            const float *in = staging_.get_channel_data(ch);
+            for (size_t i = 0; i < frames; ++i) {
+                const double position = phase_ + static_cast<double>(i) * ratio;
+                const auto index = static_cast<size_t>(position);
+                const auto t = static_cast<float>(position - static_cast<double>(index));
+                out[i] = cubic(in[index - 1], in[index], in[index + 1], in[index + 2], t);
+            }
+        }
+
+        // Drop consumed input, keeping one sample of history before the next position
+        const double end = phase_ + static_cast<double>(frames) * ratio;
+        const size_t consumed = std::min(static_cast<size_t>(end) - 1, staged_);
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            float *in = staging_.get_channel_data(ch);
+            std::memmove(in, in + consumed, (staged_ - consumed) * sizeof(float));
+        }
+        staged_ -= consumed;
+        phase_ = end - static_cast<double>(consumed);
+
+        ratio_.store(ratio, std::memory_order_relaxed);
+        return frames;
+    }
+
+    void JitterBuffer::reset() {
+        for (const auto &ring: rings_) {
+            ring->clear();
+        }
+        for (HeldPacket &held: held_) {
+            held.used = false;
+        }
+
+        started_ = false;
+        expected_position_ = 0;
+        have_transit_ = false;
+        jitter_ = 0.0;
+        last_packet_frames_ = 0;
+
+        playing_ = false;
+        staged_ = 0;
+        phase_ = 1.0;
+        smoothed_error_ = 0.0;
+        integral_ = 0.0;
+
+        target_frames_.store(min_target_frames_, std::memory_order_relaxed);
+        ratio_.store(1.0, std::memory_order_relaxed);
+        jitter_seconds_.store(0.0, std::memory_order_relaxed);
+    }
+
+    JitterBufferStats JitterBuffer::get_stats() const {
+        JitterBufferStats stats;
+        stats.packets_received = packets_received_.load(std::memory_order_relaxed);
+        stats.packets_lost = packets_lost_.load(std::memory_order_relaxed);
+        stats.packets_late = packets_late_.load(std::memory_order_relaxed);
+        stats.packets_reordered = packets_reordered_.load(std::memory_order_relaxed);
+        stats.packets_rejected = packets_rejected_.load(std::memory_order_relaxed);
+        stats.overflows = overflows_.load(std::memory_order_relaxed);
+        stats.underruns = underruns_.load(std::memory_order_relaxed);
+        return stats;
+    }
+}
@@ -0,0 +1,503 @@
+#include "gw/core/metering.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace gw::core {
+    namespace {
+        constexpr size_t LANES = 8;
+
+        /**
+         *  Peak and sum of squares of a block.
+         *
+         *  Eight independent accumulators let the compiler keep them in one
+         *  vector register without needing -ffast-math to reorder the sums.
+         */
+        void reduce_block(const float *samples, size_t count, float &peak, double &sum_squares) {
+            float lane_peak[LANES] = {};
+            float lane_sum[LANES] = {};
+
+            size_t i = 0;
+            for (; i + LANES <= count; i += LANES) {
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    const float x = samples[i + lane];
+                    const float magnitude = std::fabs(x);
+                    lane_peak[lane] = lane_peak[lane] > magnitude ? lane_peak[lane] : magnitude;
+                    lane_sum[lane] += x * x;
+                }
+            }
+
+            float block_peak = peak;
+            double block_sum = 0.0;
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                block_peak = std::max(block_peak, lane_peak[lane]);
+                block_sum += static_cast<double>(lane_sum[lane]);
+            }
+            for (; i < count; ++i) {
+                block_peak = std::max(block_peak, std::fabs(samples[i]));
+                block_sum += static_cast<double>(samples[i]) * static_cast<double>(samples[i]);
+            }
+
+            peak = block_peak;
+            sum_squares += block_sum;
+        }
+
+        constexpr size_t SHORT_TERM_STEPS = 30; // 3 s of 100 ms steps
+        constexpr size_t MOMENTARY_STEPS = 4; // 400 ms
+
+        // Histogram of gating block loudness: 0.1 LU bins from the absolute
+        // gate (-70 LUFS) up to +5 LUFS, anything louder in the top bin
+        constexpr double GATE_FLOOR_LUFS = -70.0;
+        constexpr double GATE_BIN_LU = 0.1;
+        constexpr size_t GATE_BINS = 750;
+
+        size_t get_gate_bin(double lufs) {
+            const double index = std::floor((lufs - GATE_FLOOR_LUFS) / GATE_BIN_LU);
+            if (index <= 0.0) return 0;
+            return std::min(static_cast<size_t>(index), GATE_BINS - 1);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // MeterTap
+    // ------------------------------------------------------------------------
+
+    MeterTap::MeterTap(const MeterTapSettings &settings)
+        : settings_(settings),
+          sample_rate_(0.0),
+          num_channels_(0),
+          window_samples_(1),
+          window_position_(0),
+          window_index_(0),
+          peak_{},
+          sum_squares_{},
+          overruns_(0) {
+    }
+
+    void MeterTap::prepare(double sample_rate, size_t, size_t num_channels) {
+        sample_rate_ = sample_rate;
+        num_channels_ = std::min(num_channels, MeterLevels::MAX_CHANNELS);
+        window_samples_ = std::max<size_t>(
+            static_cast<size_t>(static_cast<double>(settings_.window_ms) * 0.001 * sample_rate), 1);
+
+        feeds_.clear();
+        if (settings_.analysis_seconds > 0.0f) {
+            const auto capacity = static_cast<size_t>(static_cast<double>(settings_.analysis_seconds) * sample_rate);
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                feeds_.push_back(std::make_unique<RingBuffer>(capacity));
+            }
+        }
+
+        reset();
+    }
+
+    void MeterTap::reset() {
+        window_position_ = 0;
+        std::fill(std::begin(peak_), std::end(peak_), 0.0f);
+        std::fill(std::begin(sum_squares_), std::end(sum_squares_), 0.0);
+    }
+
+    void MeterTap::process(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0) return;
+
+        num_channels = std::min(num_channels, num_channels_);
+        const size_t count = channels[0].size();
+
+        // The block may straddle the end of a metering window
+        size_t offset = 0;
+        while (offset < count) {
+            const size_t chunk = std::min(count - offset, window_samples_ - window_position_);
+
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                reduce_block(channels[ch].data() + offset, chunk, peak_[ch], sum_squares_[ch]);
+            }
+
+            offset += chunk;
+            window_position_ += chunk;
+
+            if (window_position_ == window_samples_) {
+                MeterLevels levels;
+                levels.num_channels = static_cast<uint32_t>(num_channels);
+                levels.window_index = ++window_index_;
+                for (size_t ch = 0; ch < num_channels; ++ch) {
+                    levels.peak[ch] = peak_[ch];
+                    levels.rms[ch] = static_cast<float>(std::sqrt(sum_squares_[ch] / static_cast<double>(window_samples_)));
+                }
+                levels_.store(levels);
+
+                reset();
+            }
+        }
+
+        // Hand the raw audio to the analysis thread
+        for (size_t ch = 0; ch < feeds_.size() && ch < num_channels; ++ch) {
+            const size_t written = feeds_[ch]->write(channels[ch].data(), count);
+            if (written < count) {
+                overruns_.fetch_add(count - written, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t MeterTap::read_analysis(size_t channel, float *dest, size_t count) {
+        if (channel >= feeds_.size()) return 0;
+        return feeds_[channel]->read(dest, count);
+    }
+
+    size_t MeterTap::get_analysis_available(size_t channel) const {
+        if (channel >= feeds_.size()) return 0;
+        return feeds_[channel]->get_available_read();
+    }
+
+    // ------------------------------------------------------------------------
+    // LoudnessMeter
+    // ------------------------------------------------------------------------
+
+    LoudnessMeter::LoudnessMeter(double sample_rate, size_t num_channels, std::vector<float> weights)
+        : num_channels_(num_channels),
+          weights_(num_channels, 1.0),
+          shelf_{},
+          high_pass_{},
+          filter_state_(num_channels * 8, 0.0),
+          step_samples_(std::max<size_t>(static_cast<size_t>(sample_rate * 0.1), 1)),
+          step_position_(0),
+          step_sum_(0.0),
+          recent_steps_(SHORT_TERM_STEPS, 0.0),
+          steps_seen_(0),
+          block_power_(0.0),
+          gate_counts_(GATE_BINS, 0),
+          gate_sums_(GATE_BINS, 0.0) {
+        for (size_t ch = 0; ch < std::min(weights.size(), num_channels); ++ch) {
+            weights_[ch] = static_cast<double>(weights[ch]);
+        }
+
+        // K-weighting filters from BS.1770, re-derived for any sample rate
+        const double pi = std::acos(-1.0);
+        {
+            const double f0 = 1681.974450955533;
+            const double gain_db = 3.999843853973347;
+            const double q = 0.7071752369554196;
+            const double k = std::tan(pi * f0 / sample_rate);
+            const double vh = std::pow(10.0, gain_db / 20.0);
+            const double vb = std::pow(vh, 0.4996667741545416);
+            const double a0 = 1.0 + k / q + k * k;
+            shelf_ = {
+                (vh + vb * k / q + k * k) / a0,
+                2.0 * (k * k - vh) / a0,
+                (vh - vb * k / q + k * k) / a0,
+                2.0 * (k * k - 1.0) / a0,
+                (1.0 - k / q + k * k) / a0
+            };
+        }
+        {
+            const double f0 = 38.13547087602444;
+            const double q = 0.5003270373238773;
+            const double k = std::tan(pi * f0 / sample_rate);
+            const double a0 = 1.0 + k / q + k * k;
+            high_pass_ = {1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0};
+        }
+    }
+
+    void LoudnessMeter::reset() {
+        std::fill(filter_state_.begin(), filter_state_.end(), 0.0);
+        step_position_ = 0;
+        step_sum_ = 0.0;
+        std::fill(recent_steps_.begin(), recent_steps_.end(), 0.0);
+        steps_seen_ = 0;
+        block_power_ = 0.0;
+        std::fill(gate_counts_.begin(), gate_counts_.end(), 0);
+        std::fill(gate_sums_.begin(), gate_sums_.end(), 0.0);
+    }
+
+    void LoudnessMeter::process(const float *const *channels, size_t count) {
+        size_t offset = 0;
+        while (offset < count) {
+            const size_t chunk = std::min(count - offset, step_samples_ - step_position_);
+
+            for (size_t ch = 0; ch < num_channels_; ++ch) {
+                if (weights_[ch] == 0.0) continue;
+
+                const float *in = channels[ch] + offset;
+                double *state = &filter_state_[ch * 8];
+                double sum = 0.0;
+
+                for (size_t i = 0; i < chunk; ++i) {
+                    // Two direct form I biquads in series
+                    const double x = static_cast<double>(in[i]);
+                    const double y1 = shelf_.b0 * x + shelf_.b1 * state[0] + shelf_.b2 * state[1]
+                                      - shelf_.a1 * state[2] - shelf_.a2 * state[3];
+                    state[1] = state[0];
+                    state[0] = x;
+                    state[3] = state[2];
+                    state[2] = y1;
+
+                    const double y2 = high_pass_.b0 * y1 + high_pass_.b1 * state[4] + high_pass_.b2 * state[5]
+                                      - high_pass_.a1 * state[6] - high_pass_.a2 * state[7];
+                    state[5] = state[4];
+                    state[4] = y1;
+                    state[7] = state[6];
+                    state[6] = y2;
+
+                    sum += y2 * y2;
+                }
+
+                step_sum_ += weights_[ch] * sum;
+            }
+
+            offset += chunk;
+            step_position_ += chunk;
+
+            if (step_position_ == step_samples_) {
+                recent_steps_[steps_seen_ % SHORT_TERM_STEPS] = step_sum_ / static_cast<double>(step_samples_);
+                ++steps_seen_;
+                step_sum_ = 0.0;
+                step_position_ = 0;
+
+                // Every 100 ms step completes a 400 ms gating block
+                if (steps_seen_ >= MOMENTARY_STEPS) {
+                    double power = 0.0;
+                    for (size_t s = 0; s < MOMENTARY_STEPS; ++s) {
+                        power += recent_steps_[(steps_seen_ - 1 - s) % SHORT_TERM_STEPS];
+                    }
+                    block_power_ = power / static_cast<double>(MOMENTARY_STEPS);
+
+                    // Blocks at or below the absolute gate never count
+                    const double block_loudness = loudness(block_power_);
+                    if (block_loudness > GATE_FLOOR_LUFS) {
+                        const size_t bin = get_gate_bin(block_loudness);
+                        ++gate_counts_[bin];
+                        gate_sums_[bin] += block_power_;
+                    }
+                }
+            }
+        }
+    }
+
+    double LoudnessMeter::loudness(double power) {
+        if (power <= 0.0) return -std::numeric_limits<double>::infinity();
+        return -0.691 + 10.0 * std::log10(power);
+    }
+
+    LoudnessReading LoudnessMeter::get_reading() const {
+        const float silence = -std::numeric_limits<float>::infinity();
+        LoudnessReading reading{silence, silence, silence};
+
+        if (steps_seen_ >= MOMENTARY_STEPS) {
+            reading.momentary = static_cast<float>(loudness(block_power_));
+        }
+
+        if (steps_seen_ >= SHORT_TERM_STEPS) {
+            double power = 0.0;
+            for (const double step: recent_steps_) power += step;
+            reading.short_term = static_cast<float>(loudness(power / static_cast<double>(SHORT_TERM_STEPS)));
+        }
+
+        // The histogram holds only blocks above the absolute gate; the
+        // relative gate is 10 LU below their mean and keeps its bin and above
+        double sum = 0.0;
+        uint64_t count = 0;
+        for (size_t bin = 0; bin < GATE_BINS; ++bin) {
+            sum += gate_sums_[bin];
+            count += gate_counts_[bin];
+        }
+
+        if (count > 0) {
+            const size_t first_bin = get_gate_bin(loudness(sum / static_cast<double>(count)) - 10.0);
+            double gated_sum = 0.0;
+            uint64_t gated_count = 0;
+            for (size_t bin = first_bin; bin < GATE_BINS; ++bin) {
+                gated_sum += gate_sums_[bin];
+                gated_count += gate_counts_[bin];
+            }
+            if (gated_count > 0) {
+                reading.integrated = static_cast<float>(loudness(gated_sum / static_cast<double>(gated_count)));
+            }
+        }
+
+        return reading;
+    }
+
+    // ------------------------------------------------------------------------
+    // SpectrumAnalyzer
+    // ------------------------------------------------------------------------
+
+    SpectrumAnalyzer::SpectrumAnalyzer(size_t fft_size, float smoothing)
+        : fft_(fft_size),
+          smoothing_(std::clamp(smoothing, 0.0f, 0.99f)),
+          window_(fft_.get_size()),
+          window_gain_(0.0f),
+          history_(fft_.get_size(), 0.0f),
+          history_fill_(0),
+          samples_since_frame_(0),
+          frame_(fft_.get_size()),
+          bins_(fft_.get_num_bins()),
+          power_(fft_.get_num_bins(), 0.0f),
+          magnitudes_db_(fft_.get_num_bins(), -200.0f) {
+        const double pi = std::acos(-1.0);
+        const size_t size = fft_.get_size();
+        double sum = 0.0;
+        for (size_t i = 0; i < size; ++i) {
+            const double w = 0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(i) / static_cast<double>(size));
+            window_[i] = static_cast<float>(w);
+            sum += w;
+        }
+
+        // A full-scale sine peaks at |X| = sum(window) / 2
+        window_gain_ = static_cast<float>(2.0 / sum);
+    }
+
+    bool SpectrumAnalyzer::process(const float *samples, size_t count) {
+        const size_t size = fft_.get_size();
+        const size_t hop = size / 2;
+        bool updated = false;
+
+        for (size_t i = 0; i < count; ++i) {
+            // Shift-free history: write circularly, unroll into frame_ when needed
+            history_[history_fill_ % size] = samples[i];
+            ++history_fill_;
+
+            if (++samples_since_frame_ < hop || history_fill_ < size) continue;
+            samples_since_frame_ = 0;
+
+            const size_t start = history_fill_ % size;
+            for (size_t n = 0; n < size; ++n) {
+                frame_[n] = history_[(start + n) % size] * window_[n];
+            }
+
+            fft_.forward(frame_.data(), bins_.data());
+
+            for (size_t k = 0; k < bins_.size(); ++k) {
+                const float magnitude = std::abs(bins_[k]) * window_gain_;
+                power_[k] = smoothing_ * power_[k] + (1.0f - smoothing_) * magnitude * magnitude;
+                magnitudes_db_[k] = 10.0f * std::log10(std::max(power_[k], 1.0e-20f));
+            }
+            updated = true;
+        }
+
+        return updated;
+    }
+
+    // ------------------------------------------------------------------------
+    // MeterAnalyzer
+    // ------------------------------------------------------------------------
+
+    MeterAnalyzer::MeterAnalyzer(float poll_interval_ms)
+        : poll_interval_ms_(std::max(poll_interval_ms, 1.0f)),
+          running_(false) {
+    }
+
+    MeterAnalyzer::~MeterAnalyzer() {
+        stop();
+    }
+
+    int MeterAnalyzer::attach(MeterTap &tap, const AnalysisSettings &settings) {
+        if (running_.load() || !tap.has_analysis_feed()) return -1;
+
+        auto attachment = std::make_unique<Attachment>();
+        attachment->tap = &tap;
+
+        const size_t num_channels = tap.get_num_channels();
+        const size_t chunk = static_cast<size_t>(tap.get_sample_rate() * 0.001 * static_cast<double>(poll_interval_ms_)) * 2 + 1024;
+        attachment->scratch.assign(num_channels, std::vector<float>(chunk));
+        attachment->mono.resize(chunk);
+        for (const auto &channel: attachment->scratch) {
+            attachment->scratch_pointers.push_back(channel.data());
+        }
+
+        if (settings.loudness) {
+            attachment->loudness = std::make_unique<LoudnessMeter>(tap.get_sample_rate(), num_channels,
+                                                                   settings.channel_weights);
+            attachment->loudness_reading.store(attachment->loudness->get_reading());
+        }
+
+        if (settings.spectrum_size > 0) {
+            attachment->spectrum = std::make_unique<SpectrumAnalyzer>(settings.spectrum_size);
+            attachment->spectrum_output = std::make_unique<TripleBuffer<std::vector<float> > >(
+                attachment->spectrum->get_magnitudes_db());
+        }
+
+        attachments_.push_back(std::move(attachment));
+        return static_cast<int>(attachments_.size() - 1);
+    }
+
+    void MeterAnalyzer::start() {
+        if (running_.exchange(true)) return;
+
+        thread_ = std::thread([this] {
+            while (running_.load(std::memory_order_relaxed)) {
+                poll();
+                std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(poll_interval_ms_));
+            }
+        });
+    }
+
+    void MeterAnalyzer::stop() {
+        if (!running_.exchange(false)) return;
+        if (thread_.joinable()) thread_.join();
+    }
+
+    void MeterAnalyzer::poll() {
+        for (auto &attachment: attachments_) {
+            drain(*attachment);
+        }
+    }
+
+    void MeterAnalyzer::drain(Attachment &attachment) {
+        MeterTap &tap = *attachment.tap;
+        const size_t num_channels = attachment.scratch.size();
+        if (num_channels == 0) return;
+
+        bool spectrum_updated = false;
+        for (;;) {
+            // Only consume what every channel has, so the channels stay aligned
+            size_t count = attachment.mono.size();
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                count = std::min(count, tap.get_analysis_available(ch));
+            }
+            if (count == 0) break;
+
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                tap.read_analysis(ch, attachment.scratch[ch].data(), count);
+            }
+
+            if (attachment.loudness) {
+                attachment.loudness->process(attachment.scratch_pointers.data(), count);
+            }
+
+            if (attachment.spectrum) {
+                const float scale = 1.0f / static_cast<float>(num_channels);
+                for (size_t i = 0; i < count; ++i) {
+                    float sum = 0.0f;
+                    for (size_t ch = 0; ch < num_channels; ++ch) sum += attachment.scratch[ch][i];
+                    attachment.mono[i] = sum * scale;
+                }
+                spectrum_updated |= attachment.spectrum->process(attachment.mono.data(), count);
+            }
+        }
+
+        if (attachment.loudness) {
+            attachment.loudness_reading.store(attachment.loudness->get_reading());
+        }
+
+        if (spectrum_updated) {
+            attachment.spectrum_output->get_write_buffer() = attachment.spectrum->get_magnitudes_db();
+            attachment.spectrum_output->publish();
+        }
+    }
+
+    LoudnessReading MeterAnalyzer::get_loudness(int index) const {
+        if (index < 0 || static_cast<size_t>(index) >= attachments_.size()) return {};
+        return attachments_[static_cast<size_t>(index)]->loudness_reading.load();
+    }
+
+    bool MeterAnalyzer::get_spectrum(int index, std::vector<float> &magnitudes_db) {
+        if (index < 0 || static_cast<size_t>(index) >= attachments_.size()) return false;
+
+        Attachment &attachment = *attachments_[static_cast<size_t>(index)];
+        if (!attachment.spectrum_output) return false;
+
+        attachment.spectrum_output->update();
+        magnitudes_db = attachment.spectrum_output->get_read_buffer();
+        return true;
+    }
+}
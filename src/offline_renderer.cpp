@@ -0,0 +1,262 @@
+#include "gw/core/offline_renderer.h"
+#include "spsc_queue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace gw::core {
+    namespace {
+        struct Block {
+            AudioBuffer buffer;
+            size_t frames = 0; // Valid frames in the buffer
+            size_t offset = 0; // First frame to hand to the sink
+            bool last = false;
+
+            Block(size_t num_channels, size_t block_size)
+                : buffer(num_channels, block_size) {
+            }
+        };
+
+        // Offline stages mustn't burn a whole core while they wait on each
+        // other: spin briefly, then back off to short sleeps.
+        template<typename T>
+        void pop_blocking(SpscQueue<T> &queue, T &item) {
+            for (unsigned spins = 0; !queue.try_pop(item); ++spins) {
+                if (spins < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+        }
+
+        template<typename T>
+        void push_blocking(SpscQueue<T> &queue, const T &item) {
+            while (!queue.try_push(item)) {
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         *  State shared by the three stages of one render.
+         *  Each member is only touched by the stage noted next to it.
+         */
+        class Pipeline {
+        public:
+            Pipeline(AudioSource &source, Processor *processor, AudioSink &sink,
+                     size_t block_size, bool compensate_latency)
+                : source_(source),
+                  processor_(processor),
+                  sink_(sink),
+                  block_size_(block_size),
+                  num_channels_(source.get_num_channels()),
+                  views_(num_channels_) {
+                if (processor_) {
+                    processor_->prepare(source_.get_sample_rate(), block_size_, num_channels_);
+                    processor_->reset();
+
+                    if (compensate_latency) {
+                        tail_remaining_ = processor_->get_latency_samples();
+                        discard_remaining_ = tail_remaining_;
+                    }
+                }
+            }
+
+            [[nodiscard]] size_t get_num_channels() const { return num_channels_; }
+
+            // Read stage
+            void read(Block &block) {
+                size_t frames = source_done_ ? 0 : source_.read(block.buffer, block_size_);
+
+                if (frames == 0) {
+                    // Source exhausted: flush the processors' latency with silence
+                    source_done_ = true;
+                    frames = std::min(block_size_, tail_remaining_);
+                    tail_remaining_ -= frames;
+                    block.buffer.clear();
+                }
+
+                block.frames = frames;
+                block.offset = 0;
+                block.last = source_done_ && tail_remaining_ == 0;
+            }
+
+            // Process stage
+            void process(Block &block) {
+                if (processor_ && block.frames > 0) {
+                    for (size_t ch = 0; ch < num_channels_; ++ch) {
+                        views_[ch] = BufferView(block.buffer.get_channel_data(ch), block.frames);
+                    }
+                    processor_->process(views_.data(), num_channels_);
+                }
+
+                // Drop the latency the processors introduced at the start
+                const size_t skip = std::min(block.frames, discard_remaining_);
+                discard_remaining_ -= skip;
+                block.offset = skip;
+            }
+
+            // Write stage
+            void write(const Block &block) {
+                const size_t frames = block.frames - block.offset;
+                if (frames == 0) return;
+
+                if (!sink_.write(block.buffer, block.offset, frames)) {
+                    ok_.store(false, std::memory_order_relaxed);
+                }
+                frames_written_ += frames;
+            }
+
+            [[nodiscard]] size_t get_frames_written() const { return frames_written_; }
+            [[nodiscard]] bool is_ok() const { return ok_.load(std::memory_order_relaxed); }
+
+        private:
+            AudioSource &source_;
+            Processor *processor_;
+            AudioSink &sink_;
+            size_t block_size_;
+            size_t num_channels_;
+
+            bool source_done_ = false; // Read stage
+            size_t tail_remaining_ = 0; // Read stage
+            std::vector<BufferView> views_; // Process stage
+            size_t discard_remaining_ = 0; // Process stage
+            size_t frames_written_ = 0; // Write stage
+            std::atomic<bool> ok_{true};
+        };
+
+        double seconds_since(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    OfflineRenderer::OfflineRenderer(const RenderConfig &config)
+        : config_(config) {
+        config_.block_size = std::max<size_t>(config_.block_size, 1);
+        config_.blocks_in_flight = std::max<size_t>(config_.blocks_in_flight, 2);
+    }
+
+    RenderStats OfflineRenderer::render(AudioSource &source, Processor &processor, AudioSink &sink) const {
+        return render_job(source, &processor, sink, config_.pipelined);
+    }
+
+    RenderStats OfflineRenderer::render_job(AudioSource &source, Processor *processor, AudioSink &sink,
+                                            bool pipelined) const {
+        const auto start = std::chrono::steady_clock::now();
+
+        Pipeline pipeline(source, processor, sink, config_.block_size, config_.compensate_latency);
+
+        if (!pipelined) {
+            Block block(pipeline.get_num_channels(), config_.block_size);
+            do {
+                pipeline.read(block);
+                pipeline.process(block);
+                pipeline.write(block);
+            } while (!block.last);
+        } else {
+            // Blocks circulate: free -> [read] -> filled -> [process] -> processed -> [write] -> free
+            std::vector<Block> blocks;
+            blocks.reserve(config_.blocks_in_flight);
+            for (size_t i = 0; i < config_.blocks_in_flight; ++i) {
+                blocks.emplace_back(pipeline.get_num_channels(), config_.block_size);
+            }
+
+            SpscQueue<size_t> free_blocks(blocks.size());
+            SpscQueue<size_t> filled_blocks(blocks.size());
+            SpscQueue<size_t> processed_blocks(blocks.size());
+
+            for (size_t i = 0; i < blocks.size(); ++i) {
+                free_blocks.try_push(i);
+            }
+
+            std::thread reader([&] {
+                size_t index = 0;
+                bool last = false;
+                do {
+                    pop_blocking(free_blocks, index);
+                    pipeline.read(blocks[index]);
+                    last = blocks[index].last;
+                    push_blocking(filled_blocks, index);
+                } while (!last);
+            });
+
+            std::thread writer([&] {
+                size_t index = 0;
+                bool last = false;
+                do {
+                    pop_blocking(processed_blocks, index);
+                    pipeline.write(blocks[index]);
+                    last = blocks[index].last;
+                    push_blocking(free_blocks, index);
+                } while (!last);
+            });
+
+            // Processing happens on the calling thread
+            size_t index = 0;
+            bool last = false;
+            do {
+                pop_blocking(filled_blocks, index);
+                pipeline.process(blocks[index]);
+                last = blocks[index].last;
+                push_blocking(processed_blocks, index);
+            } while (!last);
+
+            reader.join();
+            writer.join();
+        }
+
+        RenderStats stats;
+        stats.frames_rendered = pipeline.get_frames_written();
+        stats.audio_seconds = source.get_sample_rate() > 0.0
+                                  ? static_cast<double>(stats.frames_rendered) / source.get_sample_rate()
+                                  : 0.0;
+        stats.wall_seconds = seconds_since(start);
+        stats.realtime_factor = stats.wall_seconds > 0.0 ? stats.audio_seconds / stats.wall_seconds : 0.0;
+        stats.ok = pipeline.is_ok();
+        return stats;
+    }
+
+    RenderStats OfflineRenderer::render_all(std::vector<RenderJob> &jobs, size_t num_threads) const {
+        const auto start = std::chrono::steady_clock::now();
+
+        if (num_threads == 0) {
+            num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        const size_t num_workers = std::min(num_threads, jobs.size());
+        const bool pipelined = config_.pipelined && jobs.size() * 3 <= num_threads;
+
+        std::atomic<size_t> next_job{0};
+        auto worker = [&] {
+            for (size_t i = next_job.fetch_add(1); i < jobs.size(); i = next_job.fetch_add(1)) {
+                RenderJob &job = jobs[i];
+                if (!job.source || !job.sink) {
+                    job.stats.ok = false;
+                    continue;
+                }
+                job.stats = render_job(*job.source, job.processor, *job.sink, pipelined);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 1; i < num_workers; ++i) {
+            workers.emplace_back(worker);
+        }
+        worker(); // The calling thread works too
+        for (auto &thread: workers) {
+            thread.join();
+        }
+
+        RenderStats totals;
+        for (const RenderJob &job: jobs) {
+            totals.frames_rendered += job.stats.frames_rendered;
+            totals.audio_seconds += job.stats.audio_seconds;
+            totals.ok = totals.ok && job.stats.ok;
+        }
+        totals.wall_seconds = seconds_since(start);
+        totals.realtime_factor = totals.wall_seconds > 0.0 ? totals.audio_seconds / totals.wall_seconds : 0.0;
+        return totals;
+    }
+}
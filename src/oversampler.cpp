@@ -0,0 +1,330 @@
+#include "gw/core/oversampler.h"
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gw::core {
+    namespace {
+        // Half-taps M and Kaiser beta per stage, from the base rate up. Stage 0
+        // passes 0.45 fs and stops at 0.55 fs; stage i > 0 only has to stop
+        // above 2^i fs - 0.45 fs, which a much shorter filter does
+        struct StageDesign {
+            size_t half_taps;
+            double beta;
+        };
+
+        constexpr StageDesign STAGE_DESIGNS[] = {
+            {32, 9.5},
+            {8, 10.0},
+            {6, 10.0},
+            {5, 10.0},
+        };
+
+        double bessel_i0(double x) {
+            double sum = 1.0;
+            double term = 1.0;
+            for (int k = 1; k < 50; ++k) {
+                const double half = x / (2.0 * k);
+                term *= half * half;
+                sum += term;
+            }
+            return sum;
+        }
+
+        // The 2M nonzero side taps of a Kaiser-windowed half-band lowpass of
+        // length 4M - 1 (centre tap 0.5), scaled so they sum to exactly 0.5
+        std::vector<float> make_halfband(size_t half_taps, double beta) {
+            const double pi = std::acos(-1.0);
+            const auto centre = static_cast<double>(2 * half_taps - 1);
+
+            std::vector<double> taps(2 * half_taps);
+            double sum = 0.0;
+            for (size_t k = 0; k < taps.size(); ++k) {
+                const double offset = static_cast<double>(2 * k) - centre; // Odd
+                const double ratio = offset / centre;
+                const double window = bessel_i0(beta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) /
+                                      bessel_i0(beta);
+                taps[k] = std::sin(pi * offset / 2.0) / (pi * offset) * window;
+                sum += taps[k];
+            }
+
+            std::vector<float> result(taps.size());
+            for (size_t k = 0; k < taps.size(); ++k) {
+                result[k] = static_cast<float>(taps[k] * 0.5 / sum);
+            }
+            return result;
+        }
+
+        // output[n] = gain * sum_j coefficients[j] * line[n + j]. Looping over
+        // outputs for one tap at a time keeps the inner loop free of
+        // reductions, so it vectorizes without reassociating anything.
+        GW_CORE_FORCE_INLINE void fir(const float *__restrict line, const float *__restrict coefficients,
+                                      size_t num_taps, float gain, float *__restrict output, size_t count) {
+            std::fill(output, output + count, 0.0f);
+            for (size_t j = 0; j < num_taps; ++j) {
+                const float c = gain * coefficients[j];
+                const float *source = line + j;
+                for (size_t n = 0; n < count; ++n) {
+                    output[n] += c * source[n];
+                }
+            }
+        }
+
+        using FirFn = void (*)(const float *, const float *, size_t, float, float *, size_t);
+
+        void fir_generic(const float *line, const float *coefficients, size_t num_taps, float gain,
+                         float *output, size_t count) {
+            fir(line, coefficients, num_taps, gain, output, count);
+        }
+
+        GW_CORE_TARGET_AVX2
+        void fir_avx2(const float *line, const float *coefficients, size_t num_taps, float gain,
+                      float *output, size_t count) {
+            fir(line, coefficients, num_taps, gain, output, count);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void fir_avx512(const float *line, const float *coefficients, size_t num_taps, float gain,
+                        float *output, size_t count) {
+            fir(line, coefficients, num_taps, gain, output, count);
+        }
+
+        FirFn get_fir() {
+            // Resolved once on first use
+            static const FirFn kernel = select_kernel<FirFn>(fir_generic, fir_avx2, fir_avx512);
+            return kernel;
+        }
+
+        size_t count_stages(size_t factor) {
+            size_t stages = 0;
+            while ((size_t{1} << stages) < factor) ++stages;
+            return stages;
+        }
+
+        // Combined delay of all stages, both directions, in top-rate samples
+        size_t get_stage_delay(size_t factor) {
+            const size_t num_stages = count_stages(factor);
+            size_t delay = 0;
+            for (size_t i = 0; i < num_stages; ++i) {
+                const size_t filter_delay = 2 * STAGE_DESIGNS[i].half_taps - 1; // At stage i's upper rate
+                delay += 2 * filter_delay * (factor >> (i + 1));
+            }
+            return delay;
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Oversampler
+    // ------------------------------------------------------------------
+
+    Oversampler::Stage::Stage(size_t num_half_taps, double beta, size_t num_channels)
+        : half_taps(num_half_taps),
+          coefficients(make_halfband(num_half_taps, beta)),
+          up_history(num_channels, 2 * num_half_taps - 1),
+          even_history(num_channels, 2 * num_half_taps - 1),
+          odd_history(num_channels, num_half_taps) {
+    }
+
+    size_t Oversampler::normalize_factor(size_t factor) {
+        size_t result = 2;
+        while (result < factor && result < MAX_FACTOR) result <<= 1;
+        return result;
+    }
+
+    size_t Oversampler::get_latency_for_factor(size_t factor) {
+        factor = normalize_factor(factor);
+        return (get_stage_delay(factor) + factor - 1) / factor;
+    }
+
+    Oversampler::Oversampler(size_t factor, size_t num_channels, size_t max_block_size)
+        : factor_(normalize_factor(factor)),
+          num_channels_(num_channels),
+          max_block_size_(std::max<size_t>(max_block_size, 1)),
+          latency_(get_latency_for_factor(factor_)),
+          pad_(latency_ * factor_ - get_stage_delay(factor_)),
+          oversampled_(num_channels, max_block_size_ * factor_),
+          scratch_(num_channels, max_block_size_ * factor_),
+          pad_history_(num_channels, std::max<size_t>(pad_, 1)) {
+        const size_t num_stages = count_stages(factor_);
+        stages_.reserve(num_stages);
+        for (size_t i = 0; i < num_stages; ++i) {
+            stages_.emplace_back(STAGE_DESIGNS[i].half_taps, STAGE_DESIGNS[i].beta, num_channels);
+        }
+
+        // line_ also holds the padded top-rate block; the longest history is stage 0's
+        const size_t longest = 2 * STAGE_DESIGNS[0].half_taps;
+        line_.resize(max_block_size_ * factor_ + longest + pad_);
+        odd_line_.resize(max_block_size_ * factor_ / 2 + longest);
+
+        // Pick the kernel now rather than on the audio thread
+        static_cast<void>(get_fir());
+    }
+
+    void Oversampler::reset() {
+        for (Stage &stage: stages_) {
+            stage.up_history.clear();
+            stage.even_history.clear();
+            stage.odd_history.clear();
+        }
+        pad_history_.clear();
+    }
+
+    void Oversampler::upsample_stage(Stage &stage, size_t channel, const float *input, float *output,
+                                     size_t count) {
+        const size_t half_taps = stage.half_taps;
+        const size_t history = 2 * half_taps - 1;
+        float *saved = stage.up_history.get_channel_data(channel);
+
+        std::copy_n(saved, history, line_.data());
+        std::copy_n(input, count, line_.data() + history);
+
+        // Even outputs through the FIR (doubled: half the upsampled samples
+        // are zeros), computed into the upper half of output first
+        float *even = output + count;
+        get_fir()(line_.data(), stage.coefficients.data(), 2 * half_taps, 2.0f, even, count);
+
+        // Odd outputs are the centre tap alone: the input, delayed. Reading
+        // even[n] before writing output[2n + 1] keeps the in-place interleave safe
+        const float *delayed = line_.data() + half_taps;
+        for (size_t n = 0; n < count; ++n) {
+            const float value = even[n];
+            output[2 * n] = value;
+            output[2 * n + 1] = delayed[n];
+        }
+
+        std::copy_n(line_.data() + count, history, saved);
+    }
+
+    void Oversampler::downsample_stage(Stage &stage, size_t channel, const float *input, float *output,
+                                       size_t count) {
+        const size_t half_taps = stage.half_taps;
+        const size_t history = 2 * half_taps - 1;
+        float *saved_even = stage.even_history.get_channel_data(channel);
+        float *saved_odd = stage.odd_history.get_channel_data(channel);
+
+        std::copy_n(saved_even, history, line_.data());
+        std::copy_n(saved_odd, half_taps, odd_line_.data());
+
+        float *even = line_.data() + history;
+        float *odd = odd_line_.data() + half_taps;
+        for (size_t n = 0; n < count; ++n) {
+            even[n] = input[2 * n];
+            odd[n] = input[2 * n + 1];
+        }
+
+        get_fir()(line_.data(), stage.coefficients.data(), 2 * half_taps, 1.0f, output, count);
+
+        // Centre tap (0.5) on the odd phase, delayed by M
+        for (size_t n = 0; n < count; ++n) {
+            output[n] += 0.5f * odd_line_[n];
+        }
+
+        std::copy_n(line_.data() + count, history, saved_even);
+        std::copy_n(odd_line_.data() + count, half_taps, saved_odd);
+    }
+
+    void Oversampler::apply_pad(size_t channel, float *data, size_t count) {
+        if (pad_ == 0) return;
+
+        float *saved = pad_history_.get_channel_data(channel);
+        std::copy_n(saved, pad_, line_.data());
+        std::copy_n(data, count, line_.data() + pad_);
+        std::copy_n(line_.data(), count, data);
+        std::copy_n(line_.data() + count, pad_, saved);
+    }
+
+    size_t Oversampler::upsample(const BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0) return 0;
+
+        num_channels = std::min(num_channels, num_channels_);
+        const size_t num_samples = std::min(channels[0].size(), max_block_size_);
+        const size_t num_stages = stages_.size();
+
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            const float *input = channels[ch].data();
+            size_t count = num_samples;
+
+            // Alternate buffers so the last stage lands in oversampled_
+            for (size_t i = 0; i < num_stages; ++i) {
+                AudioBuffer &target = (num_stages - 1 - i) % 2 == 0 ? oversampled_ : scratch_;
+                float *output = target.get_channel_data(ch);
+                upsample_stage(stages_[i], ch, input, output, count);
+                input = output;
+                count *= 2;
+            }
+
+            apply_pad(ch, oversampled_.get_channel_data(ch), count);
+        }
+
+        return num_samples * factor_;
+    }
+
+    void Oversampler::downsample(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0) return;
+
+        num_channels = std::min(num_channels, num_channels_);
+        const size_t num_samples = std::min(channels[0].size(), max_block_size_);
+        const size_t num_stages = stages_.size();
+
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            const float *input = oversampled_.get_channel_data(ch);
+            size_t count = num_samples * factor_ / 2;
+
+            for (size_t i = num_stages; i-- > 0;) {
+                float *output = channels[ch].data();
+                if (i > 0) {
+                    AudioBuffer &target = (num_stages - i) % 2 == 1 ? scratch_ : oversampled_;
+                    output = target.get_channel_data(ch);
+                }
+                downsample_stage(stages_[i], ch, input, output, count);
+                input = output;
+                count /= 2;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // OversampledProcessor
+    // ------------------------------------------------------------------
+
+    OversampledProcessor::OversampledProcessor(std::unique_ptr<Processor> processor, size_t factor)
+        : processor_(std::move(processor)),
+          factor_(Oversampler::normalize_factor(factor)) {
+    }
+
+    void OversampledProcessor::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        oversampler_ = std::make_unique<Oversampler>(factor_, num_channels, max_block_size);
+        views_.resize(num_channels);
+        if (processor_) {
+            processor_->prepare(sample_rate * static_cast<double>(factor_), max_block_size * factor_,
+                                num_channels);
+        }
+    }
+
+    void OversampledProcessor::process(BufferView *channels, size_t num_channels) {
+        if (!oversampler_ || !channels || num_channels == 0) return;
+
+        num_channels = std::min(num_channels, views_.size());
+        const size_t count = oversampler_->upsample(channels, num_channels);
+
+        if (processor_) {
+            AudioBuffer &oversampled = oversampler_->get_oversampled_buffer();
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                views_[ch] = BufferView(oversampled.get_channel_data(ch), count);
+            }
+            processor_->process(views_.data(), num_channels);
+        }
+
+        oversampler_->downsample(channels, num_channels);
+    }
+
+    void OversampledProcessor::reset() {
+        if (oversampler_) oversampler_->reset();
+        if (processor_) processor_->reset();
+    }
+
+    size_t OversampledProcessor::get_latency_samples() const {
+        const size_t inner = processor_ ? processor_->get_latency_samples() : 0;
+        return Oversampler::get_latency_for_factor(factor_) + (inner + factor_ / 2) / factor_;
+    }
+}
@@ -0,0 +1,117 @@
+#include "gw/core/pcm_codec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gw::core {
+    namespace {
+        int32_t quantize(float sample, float scale, int32_t max_value) {
+            const float clipped = std::clamp(sample, -1.0f, 1.0f);
+            const auto value = static_cast<int32_t>(std::lrint(clipped * scale));
+            return std::min(value, max_value); // +1.0 would overflow by one step
+        }
+
+        void store_le(uint8_t *dest, uint32_t value, size_t bytes) {
+            for (size_t b = 0; b < bytes; ++b) {
+                dest[b] = static_cast<uint8_t>(value >> (8 * b));
+            }
+        }
+
+        uint32_t load_le(const uint8_t *source, size_t bytes) {
+            uint32_t value = 0;
+            for (size_t b = 0; b < bytes; ++b) {
+                value |= static_cast<uint32_t>(source[b]) << (8 * b);
+            }
+            return value;
+        }
+    }
+
+    bool is_pcm_format_supported(const AudioFormat &format) {
+        const uint32_t bits = format.get_bit_depth();
+        return format.get_num_channels() > 0 && (bits == 16 || bits == 24 || bits == 32);
+    }
+
+    size_t encode_pcm(const AudioBuffer &source,
+                      size_t source_offset,
+                      size_t num_frames,
+                      const AudioFormat &format,
+                      uint8_t *dest) {
+        if (!dest || !is_pcm_format_supported(format)) return 0;
+
+        const size_t bytes_per_sample = format.get_bytes_per_sample();
+        const size_t bytes_per_frame = format.get_bytes_per_frame();
+        const size_t available = source_offset < source.get_num_samples()
+                                     ? source.get_num_samples() - source_offset
+                                     : 0;
+        const size_t frames_from_source = std::min(num_frames, available);
+
+        for (size_t ch = 0; ch < format.get_num_channels(); ++ch) {
+            const float *samples = source.get_channel_data(ch);
+            uint8_t *out = dest + ch * bytes_per_sample;
+
+            for (size_t i = 0; i < num_frames; ++i, out += bytes_per_frame) {
+                const float sample = (samples && i < frames_from_source) ? samples[source_offset + i] : 0.0f;
+
+                switch (format.get_bit_depth()) {
+                    case 16:
+                        store_le(out, static_cast<uint32_t>(quantize(sample, 32768.0f, 32767)), 2);
+                        break;
+                    case 24:
+                        store_le(out, static_cast<uint32_t>(quantize(sample, 8388608.0f, 8388607)), 3);
+                        break;
+                    default: {
+                        uint32_t bits;
+                        std::memcpy(&bits, &sample, sizeof(bits));
+                        store_le(out, bits, 4);
+                        break;
+                    }
+                }
+            }
+        }
+
+        return num_frames * bytes_per_frame;
+    }
+
+    size_t decode_pcm(const uint8_t *source,
+                      size_t num_frames,
+                      const AudioFormat &format,
+                      AudioBuffer &dest,
+                      size_t dest_offset) {
+        if (!source || !is_pcm_format_supported(format)) return 0;
+        if (dest_offset >= dest.get_num_samples()) return 0;
+
+        const size_t bytes_per_sample = format.get_bytes_per_sample();
+        const size_t bytes_per_frame = format.get_bytes_per_frame();
+        const size_t frames = std::min(num_frames, dest.get_num_samples() - dest_offset);
+        const size_t channels = std::min(static_cast<size_t>(format.get_num_channels()),
+                                         dest.get_num_channels());
+
+        for (size_t ch = 0; ch < channels; ++ch) {
+            float *samples = dest.get_channel_data(ch) + dest_offset;
+            const uint8_t *in = source + ch * bytes_per_sample;
+
+            for (size_t i = 0; i < frames; ++i, in += bytes_per_frame) {
+                switch (format.get_bit_depth()) {
+                    case 16: {
+                        const auto value = static_cast<int16_t>(load_le(in, 2));
+                        samples[i] = static_cast<float>(value) * (1.0f / 32768.0f);
+                        break;
+                    }
+                    case 24: {
+                        // Shift into the top of an int32 to sign-extend
+                        const auto value = static_cast<int32_t>(load_le(in, 3) << 8) >> 8;
+                        samples[i] = static_cast<float>(value) * (1.0f / 8388608.0f);
+                        break;
+                    }
+                    default: {
+                        const uint32_t bits = load_le(in, 4);
+                        std::memcpy(&samples[i], &bits, sizeof(bits));
+                        break;
+                    }
+                }
+            }
+        }
+
+        return frames;
+    }
+}
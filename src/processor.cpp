@@ -0,0 +1,50 @@
+#include "gw/core/processor.h"
+#include <algorithm>
+
+namespace gw::core {
+    Processor *ProcessorChain::add(std::unique_ptr<Processor> processor) {
+        if (!processor) return nullptr;
+
+        processors_.push_back(std::move(processor));
+        return processors_.back().get();
+    }
+
+    void ProcessorChain::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        views_.resize(num_channels);
+
+        for (auto &processor: processors_) {
+            processor->prepare(sample_rate, max_block_size, num_channels);
+        }
+    }
+
+    void ProcessorChain::process(BufferView *channels, size_t num_channels) {
+        for (auto &processor: processors_) {
+            processor->process(channels, num_channels);
+        }
+    }
+
+    void ProcessorChain::process(AudioBuffer &buffer, size_t num_samples) {
+        const size_t num_channels = std::min(buffer.get_num_channels(), views_.size());
+        const size_t block_size = std::min(num_samples, buffer.get_num_samples());
+
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            views_[ch] = BufferView(buffer.get_channel_data(ch), block_size);
+        }
+
+        process(views_.data(), num_channels);
+    }
+
+    void ProcessorChain::reset() {
+        for (auto &processor: processors_) {
+            processor->reset();
+        }
+    }
+
+    size_t ProcessorChain::get_latency_samples() const {
+        size_t latency = 0;
+        for (const auto &processor: processors_) {
+            latency += processor->get_latency_samples();
+        }
+        return latency;
+    }
+}
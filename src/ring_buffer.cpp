@@ -1,25 +1,29 @@
 #include "gw/core/ring_buffer.h"
+#include "gw/core/rt.h"
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
 
 namespace gw::core {
-    RingBuffer::RingBuffer(const size_t capacity)
+    template<typename T>
+    BasicRingBuffer<T>::BasicRingBuffer(const size_t capacity)
         : capacity_(capacity + 1), // +1 to distinguish full from empty
           buffer_(nullptr),
           write_pos_(0),
           read_pos_(0) {
         if (capacity_ > 0) {
-            buffer_ = new float[capacity_];
-            std::memset(buffer_, 0, capacity_ * sizeof(float));
+            buffer_ = new T[capacity_];
+            std::memset(buffer_, 0, capacity_ * sizeof(T));
         }
     }
 
-    RingBuffer::~RingBuffer() {
+    template<typename T>
+    BasicRingBuffer<T>::~BasicRingBuffer() {
         free_memory();
     }
 
-    RingBuffer::RingBuffer(RingBuffer &&other) noexcept
+    template<typename T>
+    BasicRingBuffer<T>::BasicRingBuffer(BasicRingBuffer &&other) noexcept
         : capacity_(other.capacity_),
           buffer_(other.buffer_),
           write_pos_(other.write_pos_.load()),
@@ -30,7 +34,8 @@ namespace gw::core {
         other.read_pos_ = 0;
     }
 
-    RingBuffer &RingBuffer::operator=(RingBuffer &&other) noexcept {
+    template<typename T>
+    BasicRingBuffer<T> &BasicRingBuffer<T>::operator=(BasicRingBuffer &&other) noexcept {
         if (this != &other) {
             free_memory();
 
@@ -47,44 +52,54 @@ namespace gw::core {
         return *this;
     }
 
-    size_t RingBuffer::write(const float *data, size_t count) {
+    template<typename T>
+    size_t BasicRingBuffer<T>::write(const T *data, size_t count) {
         if (!buffer_ || !data) return 0;
 
-        const size_t available = get_available_write();
-        const size_t to_write = std::min(count, available);
+        // Our own index only ever changes on this thread: relaxed is enough.
+        // The consumer's index needs acquire so its reads of the slots we are
+        // about to overwrite have finished.
+        const size_t write_idx = write_pos_.load(std::memory_order_relaxed);
+        const size_t read_idx = read_pos_.load(std::memory_order_acquire);
 
-        size_t write_idx = write_pos_.load(std::memory_order_relaxed);
+        const size_t used = write_idx >= read_idx ? write_idx - read_idx : capacity_ - read_idx + write_idx;
+        const size_t to_write = std::min(count, (capacity_ - 1) - used);
 
-        for (size_t i = 0; i < to_write; ++i) {
-            buffer_[write_idx] = data[i];
-            write_idx = (write_idx + 1) % capacity_;
-        }
+        // At most two contiguous spans: up to the end of storage, then from the start
+        const size_t first = std::min(to_write, capacity_ - write_idx);
+        std::memcpy(buffer_ + write_idx, data, first * sizeof(T));
+        std::memcpy(buffer_, data + first, (to_write - first) * sizeof(T));
 
-        // Release fence: ensure all writes complete before updating write_pos
-        write_pos_.store(write_idx, std::memory_order_release);
+        // Release: the samples are visible before the new index is
+        write_pos_.store((write_idx + to_write) % capacity_, std::memory_order_release);
 
         return to_write;
     }
 
-    size_t RingBuffer::read(float *data, size_t count) {
+    template<typename T>
+    size_t BasicRingBuffer<T>::read(T *data, size_t count) {
         if (!buffer_ || !data) return 0;
 
-        const size_t available = get_available_read();
+        // Mirror of write(): own index relaxed, producer's index acquire so
+        // the samples it published are visible
+        const size_t read_idx = read_pos_.load(std::memory_order_relaxed);
+        const size_t write_idx = write_pos_.load(std::memory_order_acquire);
+
+        const size_t available = write_idx >= read_idx ? write_idx - read_idx : capacity_ - read_idx + write_idx;
         const size_t to_read = std::min(count, available);
 
-        size_t read_idx = read_pos_.load(std::memory_order_relaxed);
-        for (size_t i = 0; i < to_read; ++i) {
-            data[i] = buffer_[read_idx];
-            read_idx = (read_idx + 1) % capacity_;
-        }
+        const size_t first = std::min(to_read, capacity_ - read_idx);
+        std::memcpy(data, buffer_ + read_idx, first * sizeof(T));
+        std::memcpy(data + first, buffer_, (to_read - first) * sizeof(T));
 
-        // Release fence: ensure all reads complete before updating read_pos
-        read_pos_.store(read_idx, std::memory_order_release);
+        // Release: our reads are done before the producer may reuse the slots
+        read_pos_.store((read_idx + to_read) % capacity_, std::memory_order_release);
 
         return to_read;
     }
 
-    size_t RingBuffer::get_available_read() const {
+    template<typename T>
+    size_t BasicRingBuffer<T>::get_available_read() const {
         const size_t write_idx = write_pos_.load(std::memory_order_acquire);
         const size_t read_idx = read_pos_.load(std::memory_order_acquire);
 
@@ -95,22 +110,35 @@ namespace gw::core {
         }
     }
 
-    size_t RingBuffer::get_available_write() const {
+    template<typename T>
+    size_t BasicRingBuffer<T>::get_available_write() const {
         const size_t available_read = get_available_read();
 
         // capacity - 1 because we reserve one slot to distinguish full from empty
         return (capacity_ - 1) - available_read;
     }
 
-    void RingBuffer::clear() {
+    template<typename T>
+    void BasicRingBuffer<T>::clear() {
         write_pos_.store(0, std::memory_order_relaxed);
         read_pos_.store(0, std::memory_order_relaxed);
     }
 
-    void RingBuffer::free_memory() {
+    template<typename T>
+    void BasicRingBuffer<T>::prefault() {
+        rt::prefault(buffer_, capacity_ * sizeof(T));
+    }
+
+    template<typename T>
+    void BasicRingBuffer<T>::free_memory() {
         if (buffer_) {
             delete[] buffer_;
             buffer_ = nullptr;
         }
     }
+
+    template class BasicRingBuffer<float>;
+    template class BasicRingBuffer<double>;
+    template class BasicRingBuffer<Half>;
+    template class BasicRingBuffer<BFloat16>;
 }
@@ -0,0 +1,428 @@
+#include "gw/core/rt.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+#endif
+
+namespace gw::core::rt {
+    namespace {
+#ifdef __linux__
+        // Layout expected by the sched_setattr syscall (no glibc wrapper on older systems)
+        struct SchedAttr {
+            uint32_t size;
+            uint32_t sched_policy;
+            uint64_t sched_flags;
+            int32_t sched_nice;
+            uint32_t sched_priority;
+            uint64_t sched_runtime;
+            uint64_t sched_deadline;
+            uint64_t sched_period;
+        };
+
+        size_t get_page_size() {
+            const long size = sysconf(_SC_PAGESIZE);
+            return size > 0 ? static_cast<size_t>(size) : 4096;
+        }
+
+        size_t round_up(size_t value, size_t multiple) {
+            return ((value + multiple - 1) / multiple) * multiple;
+        }
+
+        bool set_policy(int policy, int priority) {
+            sched_param param{};
+            param.sched_priority = priority;
+            return pthread_setschedparam(pthread_self(), policy, &param) == 0;
+        }
+#else
+        size_t get_page_size() {
+            return 4096;
+        }
+#endif
+
+        // Parse a non-negative decimal number from [begin, end)
+        bool parse_number(const char *begin, const char *end, int &value) {
+            if (begin == end) return false;
+
+            value = 0;
+            for (const char *c = begin; c != end; ++c) {
+                if (*c < '0' || *c > '9' || value > 100000) return false;
+                value = value * 10 + (*c - '0');
+            }
+            return true;
+        }
+    }
+
+    std::vector<int> get_isolated_cpus() {
+        FILE *file = std::fopen("/sys/devices/system/cpu/isolated", "r");
+        if (!file) return {};
+
+        char line[1024] = {};
+        const bool ok = std::fgets(line, sizeof(line), file) != nullptr;
+        std::fclose(file);
+
+        return ok ? parse_cpu_list(line) : std::vector<int>();
+    }
+
+    std::vector<int> parse_cpu_list(const std::string &list) {
+        std::vector<int> cpus;
+
+        size_t start = 0;
+        while (start < list.size()) {
+            size_t end = list.find(',', start);
+            if (end == std::string::npos) end = list.size();
+
+            // Trim whitespace (the sysfs file ends in a newline)
+            size_t first = start;
+            size_t last = end;
+            while (first < last && std::isspace(static_cast<unsigned char>(list[first]))) ++first;
+            while (last > first && std::isspace(static_cast<unsigned char>(list[last - 1]))) --last;
+
+            if (first < last) {
+                const char *begin = list.data() + first;
+                const char *finish = list.data() + last;
+                const char *dash = static_cast<const char *>(std::memchr(begin, '-', last - first));
+
+                int low = 0;
+                int high = 0;
+                if (dash) {
+                    if (!parse_number(begin, dash, low) || !parse_number(dash + 1, finish, high) || high < low) {
+                        return {};
+                    }
+                } else {
+                    if (!parse_number(begin, finish, low)) return {};
+                    high = low;
+                }
+
+                for (int cpu = low; cpu <= high; ++cpu) cpus.push_back(cpu);
+            }
+
+            start = end + 1;
+        }
+
+        return cpus;
+    }
+
+    void prefault(void *data, size_t bytes) {
+        if (!data || bytes == 0) return;
+
+        // A read alone may map the shared zero page; writing the value back
+        // forces a private, writable page without changing the contents
+        auto *bytes_ptr = static_cast<volatile unsigned char *>(data);
+        const size_t page = get_page_size();
+
+        for (size_t i = 0; i < bytes; i += page) {
+            bytes_ptr[i] = bytes_ptr[i];
+        }
+        bytes_ptr[bytes - 1] = bytes_ptr[bytes - 1];
+    }
+
+    size_t get_huge_page_size() {
+        static const size_t size = [] {
+            size_t result = 2 * 1024 * 1024;
+
+            FILE *file = std::fopen("/proc/meminfo", "r");
+            if (!file) return result;
+
+            char line[256];
+            while (std::fgets(line, sizeof(line), file)) {
+                unsigned long kilobytes = 0;
+                if (std::sscanf(line, "Hugepagesize: %lu kB", &kilobytes) == 1 && kilobytes > 0) {
+                    result = static_cast<size_t>(kilobytes) * 1024;
+                    break;
+                }
+            }
+            std::fclose(file);
+            return result;
+        }();
+        return size;
+    }
+
+    // ------------------------------------------------------------------------
+    // Scheduling, memory locking and counters
+    // ------------------------------------------------------------------------
+
+#ifdef __linux__
+    bool set_fifo_priority(int priority) {
+        const int min = sched_get_priority_min(SCHED_FIFO);
+        const int max = sched_get_priority_max(SCHED_FIFO);
+        if (priority < min || priority > max) return false;
+
+        return set_policy(SCHED_FIFO, priority);
+    }
+
+    bool set_deadline(uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns) {
+        // The kernel requires runtime <= deadline <= period
+        if (runtime_ns == 0 || runtime_ns > deadline_ns || deadline_ns > period_ns) return false;
+
+        SchedAttr attr{};
+        attr.size = sizeof(attr);
+        attr.sched_policy = SCHED_DEADLINE;
+        attr.sched_runtime = runtime_ns;
+        attr.sched_deadline = deadline_ns;
+        attr.sched_period = period_ns;
+
+        return syscall(SYS_sched_setattr, 0, &attr, 0) == 0;
+    }
+
+    bool set_normal_priority() {
+        return set_policy(SCHED_OTHER, 0);
+    }
+
+    bool pin_to_cpus(const std::vector<int> &cpus) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        bool any = false;
+        for (const int cpu: cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) continue;
+            CPU_SET(static_cast<size_t>(cpu), &set);
+            any = true;
+        }
+        if (!any) return false;
+
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    std::vector<int> get_allowed_cpus() {
+        std::vector<int> cpus;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0) return cpus;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(static_cast<size_t>(cpu), &set)) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    bool lock_memory() {
+        return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+    }
+
+    bool unlock_memory() {
+        return munlockall() == 0;
+    }
+
+    // Must not be inlined: the alloca'd region has to be released on return
+    __attribute__((noinline)) void prefault_stack(size_t bytes) {
+        if (bytes == 0) return;
+
+        auto *stack = static_cast<volatile unsigned char *>(alloca(bytes));
+        const size_t page = get_page_size();
+
+        for (size_t i = 0; i < bytes; i += page) {
+            stack[i] = 0;
+        }
+        stack[bytes - 1] = 0;
+    }
+
+    void *allocate_huge_pages(size_t bytes) {
+        if (bytes == 0) return nullptr;
+
+        const size_t huge_page = get_huge_page_size();
+        const size_t rounded = round_up(bytes, huge_page);
+
+        // Explicit huge pages, if the administrator reserved some
+        void *data = mmap(nullptr, rounded, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED) return data;
+
+        // Otherwise map a huge-page aligned region and ask for transparent huge pages
+        const size_t padded = rounded + huge_page;
+        void *raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+
+        const auto raw_address = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned_address = round_up(raw_address, huge_page);
+        const size_t head = aligned_address - raw_address;
+        const size_t tail = padded - head - rounded;
+
+        if (head > 0) munmap(raw, head);
+        if (tail > 0) munmap(reinterpret_cast<void *>(aligned_address + rounded), tail);
+
+        data = reinterpret_cast<void *>(aligned_address);
+        madvise(data, rounded, MADV_HUGEPAGE); // Advisory; failure just means normal pages
+        return data;
+    }
+
+    void free_huge_pages(void *data, size_t bytes) {
+        if (!data || bytes == 0) return;
+        munmap(data, round_up(bytes, get_huge_page_size()));
+    }
+
+    ThreadCounters read_thread_counters() {
+        ThreadCounters counters;
+
+        rusage usage{};
+        if (getrusage(RUSAGE_THREAD, &usage) != 0) return counters;
+
+        counters.minor_faults = static_cast<uint64_t>(usage.ru_minflt);
+        counters.major_faults = static_cast<uint64_t>(usage.ru_majflt);
+        counters.voluntary_switches = static_cast<uint64_t>(usage.ru_nvcsw);
+        counters.involuntary_switches = static_cast<uint64_t>(usage.ru_nivcsw);
+        return counters;
+    }
+
+#else
+    // Elsewhere: nothing to configure, callers see the failure and carry on
+
+    bool set_fifo_priority(int priority) {
+        static_cast<void>(priority);
+        return false;
+    }
+
+    bool set_deadline(uint64_t runtime_ns, uint64_t deadline_ns, uint64_t period_ns) {
+        static_cast<void>(runtime_ns);
+        static_cast<void>(deadline_ns);
+        static_cast<void>(period_ns);
+        return false;
+    }
+
+    bool set_normal_priority() {
+        return false;
+    }
+
+    bool pin_to_cpus(const std::vector<int> &cpus) {
+        static_cast<void>(cpus);
+        return false;
+    }
+
+    std::vector<int> get_allowed_cpus() {
+        return {};
+    }
+
+    bool lock_memory() {
+        return false;
+    }
+
+    bool unlock_memory() {
+        return false;
+    }
+
+    void prefault_stack(size_t bytes) {
+        static_cast<void>(bytes);
+    }
+
+    void *allocate_huge_pages(size_t bytes) {
+        static_cast<void>(bytes);
+        return nullptr;
+    }
+
+    void free_huge_pages(void *data, size_t bytes) {
+        static_cast<void>(data);
+        static_cast<void>(bytes);
+    }
+
+    ThreadCounters read_thread_counters() {
+        return {};
+    }
+
+#endif
+
+    // ------------------------------------------------------------------------
+    // FaultMonitor
+    // ------------------------------------------------------------------------
+
+    FaultMonitor::FaultMonitor()
+        : blocks_(0),
+          dirty_blocks_(0),
+          minor_faults_(0),
+          major_faults_(0),
+          voluntary_switches_(0),
+          involuntary_switches_(0) {
+    }
+
+    void FaultMonitor::begin() {
+        start_ = read_thread_counters();
+    }
+
+    bool FaultMonitor::end() {
+        const ThreadCounters now = read_thread_counters();
+
+        const uint64_t minor = now.minor_faults - start_.minor_faults;
+        const uint64_t major = now.major_faults - start_.major_faults;
+        const uint64_t voluntary = now.voluntary_switches - start_.voluntary_switches;
+        const uint64_t involuntary = now.involuntary_switches - start_.involuntary_switches;
+        const bool clean = (minor | major | voluntary | involuntary) == 0;
+
+        blocks_.fetch_add(1, std::memory_order_relaxed);
+        if (!clean) {
+            dirty_blocks_.fetch_add(1, std::memory_order_relaxed);
+            minor_faults_.fetch_add(minor, std::memory_order_relaxed);
+            major_faults_.fetch_add(major, std::memory_order_relaxed);
+            voluntary_switches_.fetch_add(voluntary, std::memory_order_relaxed);
+            involuntary_switches_.fetch_add(involuntary, std::memory_order_relaxed);
+        }
+
+        return clean;
+    }
+
+    FaultStats FaultMonitor::get_stats() const {
+        FaultStats stats;
+        stats.blocks = blocks_.load(std::memory_order_relaxed);
+        stats.dirty_blocks = dirty_blocks_.load(std::memory_order_relaxed);
+        stats.totals.minor_faults = minor_faults_.load(std::memory_order_relaxed);
+        stats.totals.major_faults = major_faults_.load(std::memory_order_relaxed);
+        stats.totals.voluntary_switches = voluntary_switches_.load(std::memory_order_relaxed);
+        stats.totals.involuntary_switches = involuntary_switches_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void FaultMonitor::reset() {
+        blocks_.store(0, std::memory_order_relaxed);
+        dirty_blocks_.store(0, std::memory_order_relaxed);
+        minor_faults_.store(0, std::memory_order_relaxed);
+        major_faults_.store(0, std::memory_order_relaxed);
+        voluntary_switches_.store(0, std::memory_order_relaxed);
+        involuntary_switches_.store(0, std::memory_order_relaxed);
+    }
+
+    // ------------------------------------------------------------------------
+    // make_realtime
+    // ------------------------------------------------------------------------
+
+    RealtimeStatus make_realtime(const RealtimeConfig &config) {
+        RealtimeStatus status;
+
+        // Lock first so the stack pages touched below stay resident
+        status.memory_locked = !config.lock_memory || lock_memory();
+        prefault_stack(config.prefault_stack_bytes);
+
+        // SCHED_DEADLINE refuses threads with a restricted affinity mask
+        if (config.policy == RealtimeConfig::Policy::Deadline) {
+            status.affinity = config.cpus.empty();
+        } else {
+            const std::vector<int> cpus = config.cpus.empty() ? get_isolated_cpus() : config.cpus;
+            status.affinity = cpus.empty() || pin_to_cpus(cpus);
+        }
+
+        switch (config.policy) {
+            case RealtimeConfig::Policy::Normal:
+                status.scheduling = true;
+                break;
+            case RealtimeConfig::Policy::Fifo:
+                status.scheduling = set_fifo_priority(config.priority);
+                break;
+            case RealtimeConfig::Policy::Deadline:
+                status.scheduling = set_deadline(config.runtime_ns, config.deadline_ns, config.period_ns);
+                break;
+        }
+
+        return status;
+    }
+}
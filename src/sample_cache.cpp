@@ -0,0 +1,667 @@
+#include "gw/core/sample_cache.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+namespace gw::core {
+    namespace {
+        // Store file layout (little-endian), see SampleCache:
+        //
+        //      0  magic "GWSC"        4 bytes
+        //      4  version             4
+        //      8  channels            4
+        //      12 reserved            4
+        //      16 frames              8
+        //      24 sample rate         8   (IEEE double)
+        //      32 content id          8
+        //      40 channel stride      8   (bytes between channel starts)
+        //
+        // Channel data starts at STORE_ALIGN and every channel is padded to a
+        // multiple of STORE_ALIGN, so each one can be paged in and out alone.
+        constexpr uint32_t STORE_MAGIC = 0x43535747; // "GWSC"
+        constexpr uint32_t STORE_VERSION = 1;
+        constexpr size_t STORE_ALIGN = 4096;
+        constexpr size_t HEADER_FIELDS_BYTES = 48;
+
+        constexpr uint8_t CHUNK_ABSENT = 0;
+        constexpr uint8_t CHUNK_REQUESTED = 1;
+        constexpr uint8_t CHUNK_RESIDENT = 2;
+
+        void store_le(uint8_t *dest, uint64_t value, size_t bytes) {
+            for (size_t b = 0; b < bytes; ++b) {
+                dest[b] = static_cast<uint8_t>(value >> (8 * b));
+            }
+        }
+
+        uint64_t load_le(const uint8_t *source, size_t bytes) {
+            uint64_t value = 0;
+            for (size_t b = 0; b < bytes; ++b) {
+                value |= static_cast<uint64_t>(source[b]) << (8 * b);
+            }
+            return value;
+        }
+
+        size_t round_up(size_t value, size_t multiple) {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        uint64_t mix64(uint64_t x) {
+            // splitmix64 finalizer
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        uint64_t hash_channels(const float *const *channels, size_t num_channels, size_t num_frames,
+                               double sample_rate) {
+            constexpr uint64_t PRIME = 0x100000001b3ULL;
+            uint64_t rate_bits = 0;
+            std::memcpy(&rate_bits, &sample_rate, sizeof(rate_bits));
+
+            uint64_t hash = mix64(num_channels ^ mix64(num_frames ^ mix64(rate_bits)));
+
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                // Four independent lanes over 64-bit words keep the multiplies
+                // out of one long dependency chain
+                uint64_t lanes[4] = {hash ^ 1, hash ^ 2, hash ^ 3, hash ^ 4};
+                const auto *bytes = reinterpret_cast<const uint8_t *>(channels[ch]);
+                const size_t num_bytes = num_frames * sizeof(float);
+                const size_t block_bytes = 4 * sizeof(uint64_t);
+
+                size_t offset = 0;
+                for (; offset + block_bytes <= num_bytes; offset += block_bytes) {
+                    for (size_t lane = 0; lane < 4; ++lane) {
+                        uint64_t word;
+                        std::memcpy(&word, bytes + offset + lane * sizeof(uint64_t), sizeof(word));
+                        lanes[lane] = (lanes[lane] ^ word) * PRIME;
+                    }
+                }
+                for (; offset < num_bytes; offset += sizeof(float)) {
+                    uint32_t word;
+                    std::memcpy(&word, bytes + offset, sizeof(word));
+                    lanes[0] = (lanes[0] ^ word) * PRIME;
+                }
+
+                for (const uint64_t lane: lanes) {
+                    hash = mix64(hash ^ lane);
+                }
+            }
+
+            return hash;
+        }
+
+        void touch_pages(const uint8_t *begin, size_t bytes, size_t page_size) {
+            const volatile uint8_t *pages = begin;
+            for (size_t offset = 0; offset < bytes; offset += page_size) {
+                static_cast<void>(pages[offset]);
+            }
+        }
+    }
+
+    /**
+     *  One mapped sample. Chunks cover chunk_frames frames of every channel.
+     */
+    struct SampleCacheEntry {
+        SampleCache *cache = nullptr;
+        uint64_t id = 0;
+        size_t num_channels = 0;
+        size_t num_frames = 0;
+        double sample_rate = 0.0;
+
+        uint8_t *map = nullptr;
+        size_t map_bytes = 0;
+        size_t channel_stride = 0; // Bytes
+
+        size_t num_chunks = 0;
+        size_t attack_chunks = 0;
+        size_t attack_bytes = 0;
+        bool attack_locked = false;
+        size_t tail_resident_bytes = 0; // Only touched by the poll thread
+
+        std::atomic<size_t> references{0};
+        std::atomic<bool> pending{false}; // Some chunk is CHUNK_REQUESTED
+        std::atomic<uint32_t> last_used{0};
+        std::unique_ptr<std::atomic<uint8_t>[]> chunk_state;
+        std::unique_ptr<std::atomic<uint32_t>[]> chunk_used;
+
+        [[nodiscard]] const float *get_channel(size_t channel) const {
+            return reinterpret_cast<const float *>(map + STORE_ALIGN + channel * channel_stride);
+        }
+
+        [[nodiscard]] size_t get_chunk_frames(size_t chunk, size_t chunk_frames) const {
+            return std::min(chunk_frames, num_frames - chunk * chunk_frames);
+        }
+
+        void request(size_t chunk) {
+            uint8_t expected = CHUNK_ABSENT;
+            if (chunk_state[chunk].compare_exchange_strong(expected, CHUNK_REQUESTED, std::memory_order_relaxed)) {
+                pending.store(true, std::memory_order_release);
+            }
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    // SampleHandle
+    // ------------------------------------------------------------------------
+
+    SampleHandle::SampleHandle(SampleCacheEntry *entry)
+        : entry_(entry) {
+        if (entry_) entry_->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    SampleHandle::~SampleHandle() {
+        if (entry_) entry_->references.fetch_sub(1, std::memory_order_release);
+    }
+
+    SampleHandle::SampleHandle(const SampleHandle &other)
+        : SampleHandle(other.entry_) {
+    }
+
+    SampleHandle &SampleHandle::operator=(const SampleHandle &other) {
+        if (this != &other) {
+            if (other.entry_) other.entry_->references.fetch_add(1, std::memory_order_relaxed);
+            if (entry_) entry_->references.fetch_sub(1, std::memory_order_release);
+            entry_ = other.entry_;
+        }
+        return *this;
+    }
+
+    SampleHandle::SampleHandle(SampleHandle &&other) noexcept
+        : entry_(other.entry_) {
+        other.entry_ = nullptr;
+    }
+
+    SampleHandle &SampleHandle::operator=(SampleHandle &&other) noexcept {
+        if (this != &other) {
+            if (entry_) entry_->references.fetch_sub(1, std::memory_order_release);
+            entry_ = other.entry_;
+            other.entry_ = nullptr;
+        }
+        return *this;
+    }
+
+    uint64_t SampleHandle::get_id() const {
+        return entry_ ? entry_->id : 0;
+    }
+
+    size_t SampleHandle::get_num_channels() const {
+        return entry_ ? entry_->num_channels : 0;
+    }
+
+    size_t SampleHandle::get_num_frames() const {
+        return entry_ ? entry_->num_frames : 0;
+    }
+
+    double SampleHandle::get_sample_rate() const {
+        return entry_ ? entry_->sample_rate : 0.0;
+    }
+
+    size_t SampleHandle::get_attack_frames() const {
+        if (!entry_) return 0;
+        return std::min(entry_->num_frames, entry_->attack_chunks * entry_->cache->settings_.chunk_frames);
+    }
+
+    BufferView SampleHandle::get_resident_view(size_t channel, size_t start, size_t count) const {
+        if (!entry_ || channel >= entry_->num_channels || start >= entry_->num_frames) return {};
+
+        SampleCache &cache = *entry_->cache;
+        const size_t chunk_frames = cache.settings_.chunk_frames;
+        const size_t end = start + std::min(count, entry_->num_frames - start);
+        const uint32_t tick = cache.tick_.load(std::memory_order_relaxed);
+        entry_->last_used.store(tick, std::memory_order_relaxed);
+
+        // Walk the chunks the range covers until the first one that is not resident
+        size_t resident_end = end;
+        size_t chunk = start / chunk_frames;
+        size_t ahead = cache.settings_.prefetch_chunks;
+        for (; chunk * chunk_frames < end; ++chunk) {
+            if (entry_->chunk_state[chunk].load(std::memory_order_acquire) != CHUNK_RESIDENT) {
+                resident_end = std::max(start, chunk * chunk_frames);
+                cache.misses_.fetch_add(1, std::memory_order_relaxed);
+                ++ahead;
+                break;
+            }
+            entry_->chunk_used[chunk].store(tick, std::memory_order_relaxed);
+        }
+
+        // Queue the missing chunk (if any) and the ones playback reaches next
+        const size_t last_request = std::min(entry_->num_chunks, chunk + ahead);
+        for (; chunk < last_request; ++chunk) {
+            entry_->request(chunk);
+        }
+
+        // The mapping is read-only; BufferView has no const flavour
+        auto *data = const_cast<float *>(entry_->get_channel(channel));
+        return {data + start, resident_end - start};
+    }
+
+    BufferView SampleHandle::get_view(size_t channel) const {
+        if (!entry_ || channel >= entry_->num_channels) return {};
+
+        auto *data = const_cast<float *>(entry_->get_channel(channel));
+        return {data, entry_->num_frames};
+    }
+
+    // ------------------------------------------------------------------------
+    // SampleCache
+    // ------------------------------------------------------------------------
+
+    SampleCache::SampleCache(const SampleCacheSettings &settings)
+        : settings_(settings),
+          page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+          tick_(1),
+          resident_bytes_(0),
+          hits_(0),
+          loads_(0),
+          chunks_streamed_(0),
+          chunks_evicted_(0),
+          samples_evicted_(0),
+          misses_(0),
+          running_(false) {
+        // Chunks start on store-aligned boundaries so they page in and out whole
+        const size_t align_frames = STORE_ALIGN / sizeof(float);
+        settings_.chunk_frames = round_up(std::max<size_t>(settings_.chunk_frames, 1), align_frames);
+        settings_.attack_frames = round_up(settings_.attack_frames, settings_.chunk_frames);
+
+        if (settings_.directory.empty()) settings_.directory = ".";
+        mkdir(settings_.directory.c_str(), 0755);
+    }
+
+    SampleCache::~SampleCache() {
+        stop();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[id, entry]: entries_) {
+            unmap(*entry);
+        }
+        entries_.clear();
+    }
+
+    uint64_t SampleCache::compute_id(const AudioBuffer &samples, size_t num_frames, double sample_rate) {
+        const size_t num_channels = samples.get_num_channels();
+        num_frames = std::min(num_frames, samples.get_num_samples());
+
+        std::vector<const float *> channels(num_channels);
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            channels[ch] = samples.get_channel_data(ch);
+        }
+        return hash_channels(channels.data(), num_channels, num_frames, sample_rate);
+    }
+
+    SampleHandle SampleCache::load(const AudioBuffer &samples, size_t num_frames, double sample_rate) {
+        const size_t num_channels = samples.get_num_channels();
+        num_frames = std::min(num_frames, samples.get_num_samples());
+        if (num_channels == 0 || num_frames == 0) return {};
+
+        std::vector<const float *> channels(num_channels);
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            channels[ch] = samples.get_channel_data(ch);
+        }
+
+        const uint64_t id = hash_channels(channels.data(), num_channels, num_frames, sample_rate);
+        return share(id, channels.data(), num_channels, num_frames, sample_rate);
+    }
+
+    SampleHandle SampleCache::load(AudioSource &source) {
+        const size_t num_channels = source.get_num_channels();
+        if (num_channels == 0) return {};
+
+        const size_t block = 4096;
+        AudioBuffer buffer(num_channels, block);
+        std::vector<std::vector<float> > data(num_channels);
+
+        size_t frames;
+        while ((frames = source.read(buffer, block)) > 0) {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                const float *samples = buffer.get_channel_data(ch);
+                data[ch].insert(data[ch].end(), samples, samples + frames);
+            }
+        }
+
+        const size_t num_frames = data[0].size();
+        if (num_frames == 0) return {};
+
+        std::vector<const float *> channels(num_channels);
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            channels[ch] = data[ch].data();
+        }
+
+        const double sample_rate = source.get_sample_rate();
+        const uint64_t id = hash_channels(channels.data(), num_channels, num_frames, sample_rate);
+        return share(id, channels.data(), num_channels, num_frames, sample_rate);
+    }
+
+    SampleHandle SampleCache::share(uint64_t id, const float *const *channels, size_t num_channels,
+                                    size_t num_frames, double sample_rate) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Already mapped by this cache
+        const auto found = entries_.find(id);
+        if (found != entries_.end()) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return SampleHandle(found->second.get());
+        }
+
+        // Stored by an earlier run or another process, else written now
+        const std::string path = get_path(id);
+        std::unique_ptr<SampleCacheEntry> entry = map_store_file(path, id);
+        if (entry && (entry->num_channels != num_channels || entry->num_frames != num_frames)) {
+            unmap(*entry); // Hash collision or stale file: rewrite it
+            entry.reset();
+        }
+
+        if (entry) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            if (!write_store_file(path, id, channels, num_channels, num_frames, sample_rate)) return {};
+            entry = map_store_file(path, id);
+            if (!entry) return {};
+            loads_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        SampleCacheEntry *raw = entry.get();
+        entries_.emplace(id, std::move(entry));
+        return SampleHandle(raw);
+    }
+
+    std::string SampleCache::get_path(uint64_t id) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.gwsc", static_cast<unsigned long long>(id));
+        return settings_.directory + "/" + name;
+    }
+
+    bool SampleCache::write_store_file(const std::string &path, uint64_t id, const float *const *channels,
+                                       size_t num_channels, size_t num_frames, double sample_rate) const {
+        const size_t channel_stride = round_up(num_frames * sizeof(float), STORE_ALIGN);
+
+        std::vector<uint8_t> header(STORE_ALIGN, 0);
+        uint64_t rate_bits = 0;
+        std::memcpy(&rate_bits, &sample_rate, sizeof(rate_bits));
+        store_le(header.data(), STORE_MAGIC, 4);
+        store_le(header.data() + 4, STORE_VERSION, 4);
+        store_le(header.data() + 8, num_channels, 4);
+        store_le(header.data() + 16, num_frames, 8);
+        store_le(header.data() + 24, rate_bits, 8);
+        store_le(header.data() + 32, id, 8);
+        store_le(header.data() + 40, channel_stride, 8);
+
+        // Write to a private name and rename, so readers never see a partial file
+        const std::string temp_path = path + ".tmp" + std::to_string(getpid());
+        FILE *file = std::fopen(temp_path.c_str(), "wb");
+        if (!file) return false;
+
+        const std::vector<uint8_t> padding(STORE_ALIGN, 0);
+        const size_t data_bytes = num_frames * sizeof(float);
+        bool ok = std::fwrite(header.data(), 1, header.size(), file) == header.size();
+
+        for (size_t ch = 0; ch < num_channels && ok; ++ch) {
+            ok = std::fwrite(channels[ch], sizeof(float), num_frames, file) == num_frames;
+            const size_t pad = channel_stride - data_bytes;
+            if (ok && pad > 0) ok = std::fwrite(padding.data(), 1, pad, file) == pad;
+        }
+
+        ok = std::fclose(file) == 0 && ok;
+        if (ok) ok = std::rename(temp_path.c_str(), path.c_str()) == 0;
+        if (!ok) std::remove(temp_path.c_str());
+        return ok;
+    }
+
+    std::unique_ptr<SampleCacheEntry> SampleCache::map_store_file(const std::string &path, uint64_t id) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return nullptr;
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < STORE_ALIGN) {
+            close(fd);
+            return nullptr;
+        }
+
+        const auto map_bytes = static_cast<size_t>(info.st_size);
+        void *map = mmap(nullptr, map_bytes, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) return nullptr;
+
+        auto entry = std::make_unique<SampleCacheEntry>();
+        entry->cache = this;
+        entry->map = static_cast<uint8_t *>(map);
+        entry->map_bytes = map_bytes;
+
+        const uint8_t *header = entry->map;
+        const uint64_t rate_bits = load_le(header + 24, 8);
+        std::memcpy(&entry->sample_rate, &rate_bits, sizeof(rate_bits));
+        entry->num_channels = static_cast<size_t>(load_le(header + 8, 4));
+        entry->num_frames = static_cast<size_t>(load_le(header + 16, 8));
+        entry->id = load_le(header + 32, 8);
+        entry->channel_stride = static_cast<size_t>(load_le(header + 40, 8));
+
+        const bool valid = load_le(header, 4) == STORE_MAGIC &&
+                           load_le(header + 4, 4) == STORE_VERSION &&
+                           entry->id == id &&
+                           entry->num_channels > 0 && entry->num_frames > 0 &&
+                           entry->channel_stride >= entry->num_frames * sizeof(float) &&
+                           entry->channel_stride % STORE_ALIGN == 0 &&
+                           STORE_ALIGN + entry->num_channels * entry->channel_stride <= map_bytes;
+        static_assert(HEADER_FIELDS_BYTES <= STORE_ALIGN);
+        if (!valid) {
+            munmap(map, map_bytes);
+            return nullptr;
+        }
+
+        const size_t chunk_frames = settings_.chunk_frames;
+        entry->num_chunks = (entry->num_frames + chunk_frames - 1) / chunk_frames;
+        entry->attack_chunks = std::min(entry->num_chunks, settings_.attack_frames / chunk_frames);
+        entry->chunk_state = std::make_unique<std::atomic<uint8_t>[]>(entry->num_chunks);
+        entry->chunk_used = std::make_unique<std::atomic<uint32_t>[]>(entry->num_chunks);
+
+        const uint32_t tick = tick_.load(std::memory_order_relaxed);
+        entry->last_used.store(tick, std::memory_order_relaxed);
+        for (size_t chunk = 0; chunk < entry->num_chunks; ++chunk) {
+            entry->chunk_state[chunk].store(chunk < entry->attack_chunks ? CHUNK_RESIDENT : CHUNK_ABSENT,
+                                            std::memory_order_relaxed);
+            entry->chunk_used[chunk].store(tick, std::memory_order_relaxed);
+        }
+
+        // Preload the attack of every channel and lock it in (if RLIMIT_MEMLOCK allows)
+        const size_t attack_frames = std::min(entry->num_frames, entry->attack_chunks * chunk_frames);
+        const size_t attack_span = round_up(attack_frames * sizeof(float), page_size_);
+        if (attack_frames > 0) {
+            entry->attack_locked = true;
+            for (size_t ch = 0; ch < entry->num_channels; ++ch) {
+                auto *begin = const_cast<float *>(entry->get_channel(ch));
+                madvise(begin, attack_span, MADV_WILLNEED);
+                touch_pages(reinterpret_cast<const uint8_t *>(begin), attack_span, page_size_);
+                if (mlock(begin, attack_span) != 0) entry->attack_locked = false;
+            }
+            if (!entry->attack_locked) {
+                for (size_t ch = 0; ch < entry->num_channels; ++ch) {
+                    munlock(entry->get_channel(ch), attack_span);
+                }
+            }
+        }
+
+        entry->attack_bytes = attack_frames * sizeof(float) * entry->num_channels;
+        resident_bytes_.fetch_add(entry->attack_bytes, std::memory_order_relaxed);
+        return entry;
+    }
+
+    void SampleCache::unmap(SampleCacheEntry &entry) {
+        if (!entry.map) return;
+
+        resident_bytes_.fetch_sub(entry.attack_bytes + entry.tail_resident_bytes, std::memory_order_relaxed);
+        munmap(entry.map, entry.map_bytes); // Also drops the attack locks
+        entry.map = nullptr;
+        entry.attack_bytes = 0;
+        entry.tail_resident_bytes = 0;
+    }
+
+    void SampleCache::stream_chunk(SampleCacheEntry &entry, size_t chunk) {
+        const size_t chunk_frames = settings_.chunk_frames;
+        const size_t bytes = entry.get_chunk_frames(chunk, chunk_frames) * sizeof(float);
+        const size_t span = round_up(bytes, page_size_);
+
+        for (size_t ch = 0; ch < entry.num_channels; ++ch) {
+            const auto *begin = reinterpret_cast<const uint8_t *>(entry.get_channel(ch) + chunk * chunk_frames);
+            madvise(const_cast<uint8_t *>(begin), span, MADV_WILLNEED);
+            touch_pages(begin, span, page_size_);
+        }
+
+        const size_t chunk_bytes = bytes * entry.num_channels;
+        entry.tail_resident_bytes += chunk_bytes;
+        resident_bytes_.fetch_add(chunk_bytes, std::memory_order_relaxed);
+        chunks_streamed_.fetch_add(1, std::memory_order_relaxed);
+
+        entry.chunk_used[chunk].store(tick_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        entry.chunk_state[chunk].store(CHUNK_RESIDENT, std::memory_order_release);
+    }
+
+    void SampleCache::start() {
+        if (running_.exchange(true)) return;
+
+        thread_ = std::thread([this] {
+            while (running_.load(std::memory_order_relaxed)) {
+                poll();
+                std::this_thread::sleep_for(std::chrono::duration<float, std::milli>(settings_.poll_interval_ms));
+            }
+        });
+    }
+
+    void SampleCache::stop() {
+        if (!running_.exchange(false)) return;
+        if (thread_.joinable()) thread_.join();
+    }
+
+    void SampleCache::poll() {
+        tick_.fetch_add(1, std::memory_order_relaxed);
+
+        // Entries are only ever removed by poll() itself, so the pointers stay
+        // valid while the chunks are read without holding the lock
+        std::vector<SampleCacheEntry *> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &[id, entry]: entries_) {
+                if (entry->pending.exchange(false, std::memory_order_acquire)) pending.push_back(entry.get());
+            }
+        }
+
+        for (SampleCacheEntry *entry: pending) {
+            for (size_t chunk = entry->attack_chunks; chunk < entry->num_chunks; ++chunk) {
+                if (entry->chunk_state[chunk].load(std::memory_order_relaxed) == CHUNK_REQUESTED) {
+                    stream_chunk(*entry, chunk);
+                }
+            }
+        }
+
+        enforce_budget();
+    }
+
+    void SampleCache::enforce_budget() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (resident_bytes_.load(std::memory_order_relaxed) <= settings_.memory_budget) return;
+
+        const uint32_t tick = tick_.load(std::memory_order_relaxed);
+        const auto is_idle = [&](uint32_t last_used) {
+            return tick - last_used > settings_.eviction_grace_polls;
+        };
+
+        // First drop streamed tail chunks, least recently used first
+        std::vector<std::tuple<uint32_t, SampleCacheEntry *, size_t> > chunks;
+        for (auto &[id, entry]: entries_) {
+            for (size_t chunk = entry->attack_chunks; chunk < entry->num_chunks; ++chunk) {
+                const uint32_t used = entry->chunk_used[chunk].load(std::memory_order_relaxed);
+                if (entry->chunk_state[chunk].load(std::memory_order_relaxed) == CHUNK_RESIDENT && is_idle(used)) {
+                    chunks.emplace_back(used, entry.get(), chunk);
+                }
+            }
+        }
+        std::sort(chunks.begin(), chunks.end());
+
+        const size_t chunk_frames = settings_.chunk_frames;
+        for (const auto &[used, entry, chunk]: chunks) {
+            if (resident_bytes_.load(std::memory_order_relaxed) <= settings_.memory_budget) return;
+
+            // Mark it absent first: a voice that still reads it faults the page back in
+            entry->chunk_state[chunk].store(CHUNK_ABSENT, std::memory_order_release);
+
+            const size_t bytes = entry->get_chunk_frames(chunk, chunk_frames) * sizeof(float);
+            for (size_t ch = 0; ch < entry->num_channels; ++ch) {
+                auto *begin = const_cast<float *>(entry->get_channel(ch) + chunk * chunk_frames);
+                madvise(begin, round_up(bytes, page_size_), MADV_DONTNEED);
+            }
+
+            entry->tail_resident_bytes -= bytes * entry->num_channels;
+            resident_bytes_.fetch_sub(bytes * entry->num_channels, std::memory_order_relaxed);
+            chunks_evicted_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Then unmap samples nobody holds a handle to, least recently used first
+        std::vector<std::pair<uint32_t, uint64_t> > samples;
+        for (auto &[id, entry]: entries_) {
+            if (entry->references.load(std::memory_order_acquire) == 0) {
+                samples.emplace_back(entry->last_used.load(std::memory_order_relaxed), id);
+            }
+        }
+        std::sort(samples.begin(), samples.end());
+
+        for (const auto &[used, id]: samples) {
+            if (resident_bytes_.load(std::memory_order_relaxed) <= settings_.memory_budget) return;
+
+            const auto found = entries_.find(id);
+            unmap(*found->second);
+            entries_.erase(found);
+            samples_evicted_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SampleCacheStats SampleCache::get_stats() const {
+        SampleCacheStats stats;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats.samples = entries_.size();
+            for (const auto &[id, entry]: entries_) {
+                if (entry->references.load(std::memory_order_relaxed) > 0) ++stats.referenced_samples;
+                stats.mapped_bytes += entry->num_channels * entry->num_frames * sizeof(float);
+                stats.attack_bytes += entry->attack_bytes;
+            }
+        }
+
+        stats.resident_bytes = resident_bytes_.load(std::memory_order_relaxed);
+        stats.memory_budget = settings_.memory_budget;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.loads = loads_.load(std::memory_order_relaxed);
+        stats.chunks_streamed = chunks_streamed_.load(std::memory_order_relaxed);
+        stats.chunks_evicted = chunks_evicted_.load(std::memory_order_relaxed);
+        stats.samples_evicted = samples_evicted_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    size_t SampleCache::measure_resident_bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        size_t resident = 0;
+        std::vector<unsigned char> pages;
+        for (const auto &[id, entry]: entries_) {
+            for (size_t ch = 0; ch < entry->num_channels; ++ch) {
+                auto *begin = const_cast<float *>(entry->get_channel(ch));
+                const size_t span = round_up(entry->num_frames * sizeof(float), page_size_);
+                pages.resize(span / page_size_);
+                if (mincore(begin, span, pages.data()) != 0) continue;
+
+                for (const unsigned char page: pages) {
+                    if (page & 1) resident += page_size_;
+                }
+            }
+        }
+        return resident;
+    }
+}
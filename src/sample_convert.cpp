@@ -0,0 +1,141 @@
+#include "gw/core/sample_convert.h"
+#include "simd_dispatch.h"
+
+#ifdef GW_CORE_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace gw::core {
+    namespace {
+        using FloatToHalfFn = void (*)(const float *, Half *, size_t);
+        using HalfToFloatFn = void (*)(const Half *, float *, size_t);
+
+        void float_to_half_scalar(const float *src, Half *dst, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = Half(src[i]);
+            }
+        }
+
+        void half_to_float_scalar(const Half *src, float *dst, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = static_cast<float>(src[i]);
+            }
+        }
+
+#ifdef GW_CORE_X86_DISPATCH
+        // Half is a plain 16-bit wrapper, so a Half array can be
+        // loaded and stored as raw 16-bit lanes.
+
+        __attribute__((target("avx,f16c")))
+        void float_to_half_f16c(const float *src, Half *dst, size_t count) {
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 v = _mm256_loadu_ps(src + i);
+                const __m128i h = _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), h);
+            }
+            float_to_half_scalar(src + i, dst + i, count - i);
+        }
+
+        __attribute__((target("avx,f16c")))
+        void half_to_float_f16c(const Half *src, float *dst, size_t count) {
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+            }
+            half_to_float_scalar(src + i, dst + i, count - i);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void float_to_half_avx512(const float *src, Half *dst, size_t count) {
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m512 v = _mm512_loadu_ps(src + i);
+                const __m256i h = _mm512_maskz_cvtps_ph(static_cast<__mmask16>(0xffff), v,
+                                                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), h);
+            }
+            float_to_half_scalar(src + i, dst + i, count - i);
+        }
+
+        GW_CORE_TARGET_AVX512
+        void half_to_float_avx512(const Half *src, float *dst, size_t count) {
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                _mm512_storeu_ps(dst + i, _mm512_maskz_cvtph_ps(static_cast<__mmask16>(0xffff), h));
+            }
+            half_to_float_scalar(src + i, dst + i, count - i);
+        }
+
+        // F16C came with AVX, before AVX2, so it is probed on its own
+        bool has_f16c() {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+        }
+#endif
+
+        FloatToHalfFn select_float_to_half() {
+#ifdef GW_CORE_X86_DISPATCH
+            if (get_simd_level() == SimdLevel::Avx512) return float_to_half_avx512;
+            if (has_f16c()) return float_to_half_f16c;
+#endif
+            return float_to_half_scalar;
+        }
+
+        HalfToFloatFn select_half_to_float() {
+#ifdef GW_CORE_X86_DISPATCH
+            if (get_simd_level() == SimdLevel::Avx512) return half_to_float_avx512;
+            if (has_f16c()) return half_to_float_f16c;
+#endif
+            return half_to_float_scalar;
+        }
+    }
+
+    void convert_samples(const float *src, Half *dst, size_t count) {
+        // Resolved once on first use
+        static const FloatToHalfFn kernel = select_float_to_half();
+
+        if (!src || !dst) return;
+        kernel(src, dst, count);
+    }
+
+    void convert_samples(const Half *src, float *dst, size_t count) {
+        static const HalfToFloatFn kernel = select_half_to_float();
+
+        if (!src || !dst) return;
+        kernel(src, dst, count);
+    }
+
+    // The bfloat16 conversions are pure integer shifts and adds; written as
+    // straight loops over the raw bits they vectorize without intrinsics.
+
+    void convert_samples(const float *src, BFloat16 *dst, size_t count) {
+        if (!src || !dst) return;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = BFloat16(src[i]);
+        }
+    }
+
+    void convert_samples(const BFloat16 *src, float *dst, size_t count) {
+        if (!src || !dst) return;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = BFloat16::to_float(src[i].get_bits());
+        }
+    }
+
+    void convert_samples(const float *src, double *dst, size_t count) {
+        if (!src || !dst) return;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<double>(src[i]);
+        }
+    }
+
+    void convert_samples(const double *src, float *dst, size_t count) {
+        if (!src || !dst) return;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<float>(src[i]);
+        }
+    }
+}
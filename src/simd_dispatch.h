@@ -0,0 +1,74 @@
+#ifndef GW_CORE_SIMD_DISPATCH_H
+#define GW_CORE_SIMD_DISPATCH_H
+
+/**
+ *  Runtime kernel selection for the vectorized modules.
+ *
+ *  A module writes its inner loop once as a GW_CORE_FORCE_INLINE function
+ *  and wraps it three times: plain, GW_CORE_TARGET_AVX2 and
+ *  GW_CORE_TARGET_AVX512. The compiler vectorizes each wrapper for its
+ *  instruction set and select_kernel() returns the one this CPU can run.
+ *  Off x86 (or without GCC/Clang) the target macros are empty and the
+ *  generic wrapper is always chosen.
+ *
+ *  Private to gw-core.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GW_CORE_X86_DISPATCH 1
+#define GW_CORE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define GW_CORE_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define GW_CORE_TARGET_AVX2
+#define GW_CORE_TARGET_AVX512
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define GW_CORE_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define GW_CORE_FORCE_INLINE inline
+#endif
+
+namespace gw::core {
+    enum class SimdLevel {
+        Generic,
+        Avx2, // AVX2 and FMA
+        Avx512 // AVX-512F
+    };
+
+    /**
+     *  The widest supported instruction set, probed once per process.
+     */
+    inline SimdLevel get_simd_level() {
+        static const SimdLevel level = [] {
+#ifdef GW_CORE_X86_DISPATCH
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::Avx2;
+#endif
+            return SimdLevel::Generic;
+        }();
+        return level;
+    }
+
+    /**
+     *  Pick the variant of a kernel (or a table of kernels) for this CPU.
+     *
+     *  The first call probes the CPU, so resolve kernels when the owning
+     *  object is constructed rather than on the audio thread.
+     */
+    template<typename Kernel>
+    Kernel select_kernel(Kernel generic, Kernel avx2, Kernel avx512) {
+        switch (get_simd_level()) {
+            case SimdLevel::Avx512:
+                return avx512;
+            case SimdLevel::Avx2:
+                return avx2;
+            case SimdLevel::Generic:
+                break;
+        }
+        return generic;
+    }
+}
+
+#endif //GW_CORE_SIMD_DISPATCH_H
@@ -0,0 +1,43 @@
+#include "gw/core/sliding_window_max.h"
+#include <algorithm>
+
+namespace gw::core {
+    namespace {
+        size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+    }
+
+    SlidingWindowMax::SlidingWindowMax(size_t max_window)
+        : max_window_(std::max<size_t>(max_window, 1)),
+          window_(max_window_),
+          // The deque briefly holds window + 1 entries inside push()
+          mask_(round_up_pow2(max_window_ + 1) - 1),
+          values_(mask_ + 1, 0.0f),
+          positions_(mask_ + 1, 0),
+          head_(0),
+          size_(0),
+          position_(0) {
+    }
+
+    void SlidingWindowMax::set_window(size_t window) {
+        window_ = std::clamp<size_t>(window, 1, max_window_);
+        reset();
+    }
+
+    void SlidingWindowMax::reset() {
+        head_ = 0;
+        size_ = 0;
+        position_ = 0;
+    }
+
+    void SlidingWindowMax::process(const float *input, float *output, size_t count) {
+        if (!input || !output) return;
+
+        for (size_t i = 0; i < count; ++i) {
+            output[i] = push(input[i]);
+        }
+    }
+}
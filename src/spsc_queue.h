@@ -0,0 +1,82 @@
+#ifndef GW_CORE_SPSC_QUEUE_H
+#define GW_CORE_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace gw::core {
+    /**
+     *  Bounded lock-free single-producer single-consumer queue of small values.
+     *
+     *  Same threading contract as RingBuffer, but for arbitrary trivially
+     *  copyable items (block indices, meter requests, ...) instead of samples.
+     *  Capacity is rounded up to a power of two so wrapping is a mask.
+     *
+     *  Private to gw-core: used to hand work between pipeline stages.
+     */
+    template<typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(size_t capacity)
+            : mask_(round_up_pow2(capacity + 1) - 1),
+              items_(mask_ + 1),
+              head_(0),
+              tail_(0) {
+        }
+
+        SpscQueue(const SpscQueue &) = delete;
+
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        /**
+         *  Producer side. Returns false if the queue is full.
+         */
+        bool try_push(const T &item) {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            const size_t next = (tail + 1) & mask_;
+            if (next == head_.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            items_[tail] = item;
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         *  Consumer side. Returns false if the queue is empty.
+         */
+        bool try_pop(T &item) {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            item = items_[head];
+            head_.store((head + 1) & mask_, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+        }
+
+    private:
+        static size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+
+        size_t mask_;
+        std::vector<T> items_;
+
+        // Keep the two indices on separate cache lines so the producer and
+        // consumer don't invalidate each other on every operation
+        alignas(64) std::atomic<size_t> head_;
+        alignas(64) std::atomic<size_t> tail_;
+    };
+}
+
+#endif //GW_CORE_SPSC_QUEUE_H
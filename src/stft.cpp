@@ -0,0 +1,189 @@
+#include "gw/core/stft.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gw::core {
+    namespace {
+        size_t round_up_pow2(size_t value) {
+            size_t result = 1;
+            while (result < value) result <<= 1;
+            return result;
+        }
+    }
+
+    void make_window(WindowType type, float *dest, size_t size) {
+        if (!dest) return;
+
+        const double pi = std::acos(-1.0);
+        for (size_t n = 0; n < size; ++n) {
+            const double x = 2.0 * pi * static_cast<double>(n) / static_cast<double>(size);
+            double value = 1.0;
+
+            switch (type) {
+                case WindowType::Rectangular:
+                    break;
+                case WindowType::Hann:
+                    value = 0.5 - 0.5 * std::cos(x);
+                    break;
+                case WindowType::Hamming:
+                    value = 0.54 - 0.46 * std::cos(x);
+                    break;
+                case WindowType::Blackman:
+                    value = 0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2.0 * x);
+                    break;
+                case WindowType::SqrtHann:
+                    value = std::sqrt(0.5 - 0.5 * std::cos(x));
+                    break;
+            }
+
+            dest[n] = static_cast<float>(value);
+        }
+    }
+
+    Stft::Stft(const StftSettings &settings, StftCallback callback)
+        : settings_(settings),
+          callback_(std::move(callback)),
+          fft_size_(round_up_pow2(std::max<size_t>(settings.fft_size, 4))),
+          hop_size_(std::clamp<size_t>(settings.hop_size, 1, fft_size_)),
+          num_channels_(0),
+          block_size_(std::max<size_t>(settings.max_block_size, 1)),
+          fft_(fft_size_),
+          windows_(2, fft_size_),
+          history_(0, 0),
+          frame_(0, 0),
+          spectra_(0, 0),
+          overlap_(0, 0),
+          frame_index_(0) {
+        float *analysis = windows_.get_channel_data(0);
+        float *synthesis = windows_.get_channel_data(1);
+        make_window(settings_.analysis_window, analysis, fft_size_);
+        make_window(settings_.synthesis_window, synthesis, fft_size_);
+
+        // Every output sample is the sum of fft_size / hop_size overlapping
+        // frames; divide out what the two windows contribute at each offset
+        std::vector<double> overlap_sum(hop_size_, 0.0);
+        for (size_t n = 0; n < fft_size_; ++n) {
+            overlap_sum[n % hop_size_] += static_cast<double>(analysis[n]) * static_cast<double>(synthesis[n]);
+        }
+        for (size_t n = 0; n < fft_size_; ++n) {
+            const double sum = overlap_sum[n % hop_size_];
+            synthesis[n] = sum > 1e-9 ? static_cast<float>(static_cast<double>(synthesis[n]) / sum) : 0.0f;
+        }
+
+        allocate(std::max<size_t>(settings_.max_channels, 1));
+        reset();
+    }
+
+    void Stft::allocate(size_t num_channels) {
+        num_channels_ = num_channels;
+
+        const size_t num_bins = fft_size_ / 2 + 1;
+        history_ = AudioBuffer(num_channels, fft_size_);
+        frame_ = AudioBuffer(1, fft_size_);
+        spectra_ = AudioBuffer(num_channels, 2 * num_bins);
+        overlap_ = AudioBuffer(num_channels, fft_size_);
+
+        // std::complex<float> is layout-compatible with float[2]
+        spectrum_pointers_.resize(num_channels);
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            spectrum_pointers_[ch] = reinterpret_cast<std::complex<float> *>(spectra_.get_channel_data(ch));
+        }
+
+        // Input holds at most a block plus an unfinished hop; output a block,
+        // the priming and the hops produced ahead of the read position
+        const size_t capacity = block_size_ + fft_size_ + 2 * hop_size_;
+        input_.clear();
+        output_.clear();
+        input_.reserve(num_channels);
+        output_.reserve(num_channels);
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            input_.emplace_back(capacity);
+            output_.emplace_back(capacity);
+        }
+    }
+
+    void Stft::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        static_cast<void>(sample_rate);
+        static_cast<void>(max_block_size);
+
+        if (num_channels > num_channels_) allocate(num_channels);
+        reset();
+    }
+
+    void Stft::reset() {
+        history_.clear();
+        overlap_.clear();
+        frame_index_ = 0;
+
+        // hop_size - 1 samples of silence keep the output one hop ahead of
+        // the reader whatever the block size (see get_latency_samples())
+        for (size_t ch = 0; ch < num_channels_; ++ch) {
+            input_[ch].clear();
+            output_[ch].clear();
+            output_[ch].write(overlap_.get_channel_data(ch), hop_size_ - 1);
+        }
+    }
+
+    void Stft::process(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0) return;
+
+        num_channels = std::min(num_channels, num_channels_);
+        const size_t num_samples = channels[0].size();
+
+        for (size_t offset = 0; offset < num_samples; offset += block_size_) {
+            const size_t count = std::min(block_size_, num_samples - offset);
+
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                input_[ch].write(channels[ch].data() + offset, count);
+            }
+
+            while (input_[0].get_available_read() >= hop_size_) {
+                run_frame(num_channels);
+            }
+
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                output_[ch].read(channels[ch].data() + offset, count);
+            }
+        }
+    }
+
+    void Stft::run_frame(size_t num_channels) {
+        const float *analysis = windows_.get_channel_data(0);
+        const float *synthesis = windows_.get_channel_data(1);
+        float *frame = frame_.get_channel_data(0);
+        const size_t keep = fft_size_ - hop_size_;
+
+        // Analysis: slide the history by one hop and transform it windowed
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            float *history = history_.get_channel_data(ch);
+            std::copy(history + hop_size_, history + fft_size_, history);
+            input_[ch].read(history + keep, hop_size_);
+
+            for (size_t n = 0; n < fft_size_; ++n) {
+                frame[n] = history[n] * analysis[n];
+            }
+            fft_.forward(frame, spectrum_pointers_[ch]);
+        }
+
+        if (callback_) {
+            const StftFrame info{spectrum_pointers_.data(), num_channels, fft_size_ / 2 + 1, frame_index_};
+            callback_(info);
+        }
+
+        // Resynthesis: overlap-add, then the oldest hop is complete
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+            float *overlap = overlap_.get_channel_data(ch);
+            fft_.inverse(spectrum_pointers_[ch], frame);
+
+            for (size_t n = 0; n < fft_size_; ++n) {
+                overlap[n] += frame[n] * synthesis[n];
+            }
+
+            output_[ch].write(overlap, hop_size_);
+            std::copy(overlap + hop_size_, overlap + fft_size_, overlap);
+            std::fill(overlap + keep, overlap + fft_size_, 0.0f);
+        }
+
+        ++frame_index_;
+    }
+}
@@ -0,0 +1,324 @@
+#include "gw/core/udp_transport.h"
+#include "gw/core/pcm_codec.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace gw::core {
+    namespace {
+        // Largest UDP payload over IPv4
+        constexpr size_t MAX_DATAGRAM = 65507;
+
+        void store_le(uint8_t *dest, uint64_t value, size_t bytes) {
+            for (size_t b = 0; b < bytes; ++b) {
+                dest[b] = static_cast<uint8_t>(value >> (8 * b));
+            }
+        }
+
+        uint64_t load_le(const uint8_t *source, size_t bytes) {
+            uint64_t value = 0;
+            for (size_t b = 0; b < bytes; ++b) {
+                value |= static_cast<uint64_t>(source[b]) << (8 * b);
+            }
+            return value;
+        }
+
+        bool make_address(const char *address, uint16_t port, sockaddr_in &result) {
+            std::memset(&result, 0, sizeof(result));
+            result.sin_family = AF_INET;
+            result.sin_port = htons(port);
+            return address && inet_pton(AF_INET, address, &result.sin_addr) == 1;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // MessageBatch
+    // ------------------------------------------------------------------------
+
+    struct MessageBatch {
+        MessageBatch(size_t count, size_t slot_bytes)
+            : packet_bytes(slot_bytes),
+              storage(count * slot_bytes, 0),
+              iovecs(count),
+              messages(count) {
+            for (size_t i = 0; i < count; ++i) {
+                iovecs[i].iov_base = get_slot(i);
+                iovecs[i].iov_len = packet_bytes;
+
+                std::memset(&messages[i], 0, sizeof(mmsghdr));
+                messages[i].msg_hdr.msg_iov = &iovecs[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+            }
+        }
+
+        [[nodiscard]] size_t size() const { return messages.size(); }
+
+        uint8_t *get_slot(size_t index) { return storage.data() + index * packet_bytes; }
+
+        size_t packet_bytes;
+        std::vector<uint8_t> storage; // One packet_bytes slot per message
+        std::vector<iovec> iovecs;
+        std::vector<mmsghdr> messages;
+    };
+
+    // ------------------------------------------------------------------------
+    // PacketHeader
+    // ------------------------------------------------------------------------
+
+    size_t write_packet_header(const PacketHeader &header, uint8_t *dest) {
+        store_le(dest, PacketHeader::MAGIC, 4);
+        dest[4] = PacketHeader::VERSION;
+        dest[5] = header.bit_depth;
+        store_le(dest + 6, header.num_channels, 2);
+        store_le(dest + 8, header.sample_rate, 4);
+        store_le(dest + 12, header.sequence, 4);
+        store_le(dest + 16, header.frame_position, 8);
+        store_le(dest + 24, header.num_frames, 2);
+        store_le(dest + 26, 0, 2);
+        return PacketHeader::SIZE;
+    }
+
+    bool read_packet_header(const uint8_t *packet, size_t size, PacketHeader &header) {
+        if (!packet || size < PacketHeader::SIZE) return false;
+        if (load_le(packet, 4) != PacketHeader::MAGIC || packet[4] != PacketHeader::VERSION) return false;
+
+        header.bit_depth = packet[5];
+        header.num_channels = static_cast<uint16_t>(load_le(packet + 6, 2));
+        header.sample_rate = static_cast<uint32_t>(load_le(packet + 8, 4));
+        header.sequence = static_cast<uint32_t>(load_le(packet + 12, 4));
+        header.frame_position = load_le(packet + 16, 8);
+        header.num_frames = static_cast<uint16_t>(load_le(packet + 24, 2));
+
+        const AudioFormat format(header.sample_rate, header.num_channels, header.bit_depth);
+        if (!is_pcm_format_supported(format)) return false;
+
+        return size >= PacketHeader::SIZE + header.num_frames * format.get_bytes_per_frame();
+    }
+
+    // ------------------------------------------------------------------------
+    // UdpSocket
+    // ------------------------------------------------------------------------
+
+    UdpSocket::UdpSocket(uint16_t port, const char *address)
+        : fd_(-1),
+          port_(0) {
+        sockaddr_in local{};
+        if (!make_address(address, port, local)) return;
+
+        fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0) return;
+
+        if (bind(fd_, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != 0) {
+            close(fd_);
+            fd_ = -1;
+            return;
+        }
+
+        socklen_t length = sizeof(local);
+        getsockname(fd_, reinterpret_cast<sockaddr *>(&local), &length);
+        port_ = ntohs(local.sin_port);
+    }
+
+    UdpSocket::~UdpSocket() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    bool UdpSocket::connect(const char *address, uint16_t port) {
+        sockaddr_in remote{};
+        if (fd_ < 0 || !make_address(address, port, remote)) return false;
+
+        return ::connect(fd_, reinterpret_cast<const sockaddr *>(&remote), sizeof(remote)) == 0;
+    }
+
+    bool UdpSocket::set_buffer_sizes(int send_bytes, int receive_bytes) {
+        if (fd_ < 0) return false;
+
+        const bool send_ok = setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &send_bytes, sizeof(send_bytes)) == 0;
+        const bool receive_ok = setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receive_bytes, sizeof(receive_bytes)) == 0;
+        return send_ok && receive_ok;
+    }
+
+    size_t UdpSocket::send_messages(MessageBatch &batch, size_t count) {
+        if (fd_ < 0) return 0;
+
+        count = std::min(count, batch.size());
+        mmsghdr *messages = batch.messages.data();
+
+        size_t sent = 0;
+        while (sent < count) {
+            const int result = sendmmsg(fd_, messages + sent, static_cast<unsigned int>(count - sent), 0);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            sent += static_cast<size_t>(result);
+        }
+        return sent;
+    }
+
+    size_t UdpSocket::receive_messages(MessageBatch &batch, int timeout_ms) {
+        if (fd_ < 0 || batch.size() == 0) return 0;
+
+        pollfd descriptor{};
+        descriptor.fd = fd_;
+        descriptor.events = POLLIN;
+        if (poll(&descriptor, 1, timeout_ms) <= 0) return 0;
+
+        const int result = recvmmsg(fd_, batch.messages.data(), static_cast<unsigned int>(batch.size()), MSG_DONTWAIT,
+                                    nullptr);
+        return result > 0 ? static_cast<size_t>(result) : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // PacketSender
+    // ------------------------------------------------------------------------
+
+    PacketSender::PacketSender(UdpSocket &socket, const AudioFormat &format, size_t frames_per_packet,
+                               size_t max_batch)
+        : socket_(socket),
+          format_(format),
+          frames_per_packet_(std::clamp<size_t>(frames_per_packet, 1, 65535)),
+          packet_bytes_(0),
+          max_batch_(std::max<size_t>(max_batch, 1)),
+          sequence_(0),
+          frame_position_(0),
+          packets_sent_(0),
+          packets_dropped_(0),
+          random_state_(1) {
+        if (!is_pcm_format_supported(format_)) return;
+
+        // Shrink the packet until it fits in one datagram
+        const size_t bytes_per_frame = format_.get_bytes_per_frame();
+        frames_per_packet_ = std::min(frames_per_packet_, (MAX_DATAGRAM - PacketHeader::SIZE) / bytes_per_frame);
+        packet_bytes_ = PacketHeader::SIZE + frames_per_packet_ * bytes_per_frame;
+
+        batch_ = std::make_unique<MessageBatch>(max_batch_, packet_bytes_);
+    }
+
+    PacketSender::~PacketSender() = default;
+
+    void PacketSender::set_impairment(const TransportImpairment &impairment) {
+        impairment_ = impairment;
+        random_state_ = impairment.seed != 0 ? impairment.seed : 1;
+    }
+
+    float PacketSender::next_random() {
+        // xorshift32
+        random_state_ ^= random_state_ << 13;
+        random_state_ ^= random_state_ >> 17;
+        random_state_ ^= random_state_ << 5;
+        return static_cast<float>(random_state_ >> 8) * (1.0f / 16777216.0f);
+    }
+
+    size_t PacketSender::send(const AudioBuffer &source, size_t offset, size_t num_frames) {
+        if (!batch_) return 0;
+
+        const size_t bytes_per_frame = format_.get_bytes_per_frame();
+        size_t frames_done = 0;
+
+        while (frames_done < num_frames) {
+            size_t batch = 0;
+
+            // Encode up to max_batch packets straight into their send slots
+            for (size_t slot = 0; slot < max_batch_ && frames_done < num_frames; ++slot) {
+                const size_t frames = std::min(frames_per_packet_, num_frames - frames_done);
+                uint8_t *packet = batch_->get_slot(slot);
+
+                PacketHeader header;
+                header.sequence = sequence_++;
+                header.frame_position = frame_position_;
+                header.sample_rate = format_.get_sample_rate();
+                header.num_channels = static_cast<uint16_t>(format_.get_num_channels());
+                header.bit_depth = static_cast<uint8_t>(format_.get_bit_depth());
+                header.num_frames = static_cast<uint16_t>(frames);
+
+                write_packet_header(header, packet);
+                encode_pcm(source, offset + frames_done, frames, format_, packet + PacketHeader::SIZE);
+
+                frames_done += frames;
+                frame_position_ += frames;
+
+                if (impairment_.loss_probability > 0.0f && next_random() < impairment_.loss_probability) {
+                    ++packets_dropped_;
+                    continue;
+                }
+
+                batch_->iovecs[batch].iov_base = packet;
+                batch_->iovecs[batch].iov_len = PacketHeader::SIZE + frames * bytes_per_frame;
+                ++batch;
+            }
+
+            // Simulated reordering: shuffle within windows of reorder_distance + 1
+            // packets, so no packet moves further than reorder_distance
+            if (impairment_.reorder_distance > 0) {
+                const size_t window = impairment_.reorder_distance + 1;
+                for (size_t start = 0; start < batch; start += window) {
+                    const size_t end = std::min(start + window, batch);
+                    for (size_t i = end - 1; i > start; --i) {
+                        const size_t range = i - start + 1;
+                        const size_t j = start + std::min(range - 1,
+                                                          static_cast<size_t>(next_random() * static_cast<float>(range)));
+                        std::swap(batch_->iovecs[i], batch_->iovecs[j]);
+                    }
+                }
+            }
+
+            packets_sent_ += socket_.send_messages(*batch_, batch);
+        }
+
+        return frames_done;
+    }
+
+    // ------------------------------------------------------------------------
+    // PacketReceiver
+    // ------------------------------------------------------------------------
+
+    PacketReceiver::PacketReceiver(UdpSocket &socket, JitterBuffer &jitter_buffer, size_t max_batch)
+        : socket_(socket),
+          jitter_buffer_(jitter_buffer),
+          packet_bytes_(std::min(MAX_DATAGRAM,
+                                 PacketHeader::SIZE + jitter_buffer.get_settings().max_packet_frames *
+                                                      jitter_buffer.get_format().get_bytes_per_frame())),
+          packets_invalid_(0) {
+        batch_ = std::make_unique<MessageBatch>(std::max<size_t>(max_batch, 1), packet_bytes_);
+    }
+
+    PacketReceiver::~PacketReceiver() = default;
+
+    size_t PacketReceiver::receive(int timeout_ms) {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return receive(timeout_ms, std::chrono::duration<double>(now).count());
+    }
+
+    size_t PacketReceiver::receive(int timeout_ms, double arrival_seconds) {
+        const size_t count = socket_.receive_messages(*batch_, timeout_ms);
+        const AudioFormat &format = jitter_buffer_.get_format();
+
+        for (size_t i = 0; i < count; ++i) {
+            const auto *packet = static_cast<const uint8_t *>(batch_->iovecs[i].iov_base);
+            const size_t size = batch_->messages[i].msg_len;
+
+            PacketHeader header;
+            if (!read_packet_header(packet, size, header) ||
+                header.sample_rate != format.get_sample_rate() ||
+                header.num_channels != format.get_num_channels() ||
+                header.bit_depth != format.get_bit_depth()) {
+                ++packets_invalid_;
+                continue;
+            }
+
+            jitter_buffer_.push(header.frame_position, packet + PacketHeader::SIZE, header.num_frames,
+                                arrival_seconds);
+        }
+
+        return count;
+    }
+}
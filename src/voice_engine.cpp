@@ -0,0 +1,525 @@
+#include "gw/core/voice_engine.h"
+#include "gw/core/fft.h"
+#include "simd_dispatch.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+namespace gw::core {
+    namespace {
+        constexpr float PI = 3.14159265358979f;
+        constexpr size_t LANES = VoiceEngine::LANES;
+
+        // Highest harmonic of wavetable level 0; each level halves it
+        constexpr size_t MAX_HARMONIC = Wavetable::TABLE_SIZE / 2 - 1;
+
+        // ---- Per-lane oscillator math ----
+        // Everything here is branch-free (selects only) and force-inlined, so
+        // the lane loops in render_groups() vectorize across voices.
+
+        // sin(2 pi p) for p in [0, 1), |error| < 1e-5
+        GW_CORE_FORCE_INLINE float sin_cycle(float p) {
+            float x = p - 0.5f; // sin(2 pi p) = -sin(2 pi x)
+            x = x > 0.25f ? 0.5f - x : x;
+            x = x < -0.25f ? -0.5f - x : x;
+
+            const float y = 2.0f * PI * x;
+            const float y2 = y * y;
+            const float poly = 1.0f + y2 * (-1.0f / 6.0f + y2 * (1.0f / 120.0f + y2 * (-1.0f / 5040.0f +
+                                                                                     y2 * (1.0f / 362880.0f))));
+            return -y * poly;
+        }
+
+        // Residual of a band-limited step of height 2 at phase 0 (polyBLEP)
+        GW_CORE_FORCE_INLINE float poly_blep(float t, float dt) {
+            const float a = t / dt; // Just after the step
+            const float b = (t - 1.0f) / dt; // Just before it
+            const float after = a + a - a * a - 1.0f;
+            const float before = b * b + b + b + 1.0f;
+            return t < dt ? after : (t > 1.0f - dt ? before : 0.0f);
+        }
+
+        // Residual of a band-limited slope change of 2 per sample at phase 0 (polyBLAMP)
+        GW_CORE_FORCE_INLINE float poly_blamp(float t, float dt) {
+            const float a = t / dt - 1.0f;
+            const float b = (t - 1.0f) / dt + 1.0f;
+            const float after = -a * a * a * (1.0f / 3.0f);
+            const float before = b * b * b * (1.0f / 3.0f);
+            return t < dt ? after : (t > 1.0f - dt ? before : 0.0f);
+        }
+
+        GW_CORE_FORCE_INLINE float wrap(float p) {
+            return p >= 1.0f ? p - 1.0f : p;
+        }
+
+        template<Waveform W>
+        GW_CORE_FORCE_INLINE float oscillate(float p, float dt, const float *table, int32_t offset) {
+            if constexpr (W == Waveform::Sine) {
+                return sin_cycle(p);
+            } else if constexpr (W == Waveform::Saw) {
+                return 2.0f * p - 1.0f - poly_blep(p, dt);
+            } else if constexpr (W == Waveform::Square) {
+                const float naive = p < 0.5f ? 1.0f : -1.0f;
+                return naive + poly_blep(p, dt) - poly_blep(wrap(p + 0.5f), dt);
+            } else if constexpr (W == Waveform::Triangle) {
+                // Trough at phase 0, peak at 0.5; the slope changes by 8 dt per sample at each corner
+                const float naive = 1.0f - 4.0f * std::fabs(p - 0.5f);
+                return naive + 4.0f * dt * (poly_blamp(p, dt) - poly_blamp(wrap(p + 0.5f), dt));
+            } else {
+                const float position = p * static_cast<float>(Wavetable::TABLE_SIZE);
+                const auto index = static_cast<int32_t>(position);
+                const float fraction = position - static_cast<float>(index);
+                const float a = table[offset + index];
+                const float b = table[offset + index + 1];
+                return a + fraction * (b - a);
+            }
+        }
+
+        struct GroupArgs {
+            float *phase;
+            const float *increment;
+            float *level;
+            const float *step;
+            const float *target;
+            const float *gain_left;
+            const float *gain_right;
+            const int32_t *table_offsets;
+            const float *table;
+            size_t num_groups;
+            size_t num_frames; // <= CONTROL_FRAMES
+            float *sums_left; // [num_frames][LANES], accumulated into
+            float *sums_right;
+        };
+
+        // Render LANES voices at a time. State is copied into local arrays so
+        // it lives in registers for the whole control block; the per-lane
+        // partial sums are reduced later, once for all groups.
+        template<Waveform W>
+        GW_CORE_FORCE_INLINE void render_groups(const GroupArgs &args) {
+            for (size_t group = 0; group < args.num_groups; ++group) {
+                const size_t base = group * LANES;
+
+                float phase[LANES], increment[LANES], level[LANES], step[LANES], target[LANES];
+                float gain_left[LANES], gain_right[LANES];
+                int32_t offset[LANES];
+
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    phase[lane] = args.phase[base + lane];
+                    increment[lane] = args.increment[base + lane];
+                    level[lane] = args.level[base + lane];
+                    step[lane] = args.step[base + lane];
+                    target[lane] = args.target[base + lane];
+                    gain_left[lane] = args.gain_left[base + lane];
+                    gain_right[lane] = args.gain_right[base + lane];
+                    offset[lane] = args.table_offsets[base + lane];
+                }
+
+                for (size_t i = 0; i < args.num_frames; ++i) {
+                    float *sum_left = args.sums_left + i * LANES;
+                    float *sum_right = args.sums_right + i * LANES;
+
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        const float value = oscillate<W>(phase[lane], increment[lane], args.table, offset[lane]);
+                        phase[lane] = wrap(phase[lane] + increment[lane]);
+
+                        const float next = level[lane] + step[lane];
+                        level[lane] = step[lane] >= 0.0f ? std::min(next, target[lane]) : std::max(next, target[lane]);
+
+                        const float voice = value * level[lane];
+                        sum_left[lane] += voice * gain_left[lane];
+                        sum_right[lane] += voice * gain_right[lane];
+                    }
+                }
+
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    args.phase[base + lane] = phase[lane];
+                    args.level[base + lane] = level[lane];
+                }
+            }
+        }
+
+        using GroupFn = void (*)(const GroupArgs &);
+
+        struct GroupKernels {
+            GroupFn kernels[5];
+        };
+
+        template<Waveform W>
+        void render_groups_generic(const GroupArgs &args) {
+            render_groups<W>(args);
+        }
+
+        template<Waveform W>
+        GW_CORE_TARGET_AVX2
+        void render_groups_avx2(const GroupArgs &args) {
+            render_groups<W>(args);
+        }
+
+        template<Waveform W>
+        GW_CORE_TARGET_AVX512
+        void render_groups_avx512(const GroupArgs &args) {
+            render_groups<W>(args);
+        }
+
+        template<template<Waveform> class Wrapper>
+        GroupKernels make_kernels() {
+            return {{Wrapper<Waveform::Sine>::fn, Wrapper<Waveform::Saw>::fn, Wrapper<Waveform::Square>::fn,
+                     Wrapper<Waveform::Triangle>::fn, Wrapper<Waveform::Wavetable>::fn}};
+        }
+
+        template<Waveform W>
+        struct Generic {
+            static constexpr GroupFn fn = render_groups_generic<W>;
+        };
+
+        template<Waveform W>
+        struct Avx2 {
+            static constexpr GroupFn fn = render_groups_avx2<W>;
+        };
+
+        template<Waveform W>
+        struct Avx512 {
+            static constexpr GroupFn fn = render_groups_avx512<W>;
+        };
+
+        const GroupKernels &get_kernels() {
+            // Resolved once on first use
+            static const GroupKernels kernels = select_kernel(make_kernels<Generic>(), make_kernels<Avx2>(),
+                                                              make_kernels<Avx512>());
+            return kernels;
+        }
+
+        size_t round_up_lanes(size_t value) {
+            return (value + LANES - 1) / LANES * LANES;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Wavetable
+    // ------------------------------------------------------------------------
+
+    Wavetable::Wavetable(const std::vector<float> &harmonics)
+        : num_levels_(0) {
+        // Level l keeps harmonics up to MAX_HARMONIC >> l, down to the fundamental alone
+        for (size_t limit = MAX_HARMONIC; limit > 0; limit >>= 1) {
+            ++num_levels_;
+        }
+
+        const size_t stride = TABLE_SIZE + 1;
+        tables_.assign(num_levels_ * stride, 0.0f);
+
+        RealFft fft(TABLE_SIZE);
+        std::vector<std::complex<float> > bins(fft.get_num_bins());
+        const float half_size = static_cast<float>(TABLE_SIZE) / 2.0f;
+
+        for (size_t level = 0; level < num_levels_; ++level) {
+            const size_t limit = std::min(MAX_HARMONIC >> level, harmonics.size());
+
+            // Sine phase: a sin(2 pi k n / N) transforms to -i a N / 2 in bin k
+            std::fill(bins.begin(), bins.end(), std::complex<float>(0.0f, 0.0f));
+            for (size_t k = 1; k <= limit; ++k) {
+                bins[k] = std::complex<float>(0.0f, -harmonics[k - 1] * half_size);
+            }
+
+            float *table = tables_.data() + level * stride;
+            fft.inverse(bins.data(), table);
+            table[TABLE_SIZE] = table[0];
+        }
+
+        // Normalize every level by the full-band peak, so levels match in loudness
+        float peak = 0.0f;
+        for (size_t i = 0; i < TABLE_SIZE; ++i) {
+            peak = std::max(peak, std::fabs(tables_[i]));
+        }
+        if (peak > 0.0f) {
+            for (float &sample: tables_) {
+                sample /= peak;
+            }
+        }
+    }
+
+    Wavetable Wavetable::make_saw() {
+        std::vector<float> harmonics(MAX_HARMONIC);
+        for (size_t k = 0; k < harmonics.size(); ++k) {
+            harmonics[k] = 1.0f / static_cast<float>(k + 1);
+        }
+        return Wavetable(harmonics);
+    }
+
+    size_t Wavetable::select_level(float phase_increment) const {
+        // The highest harmonic of the level must stay below Nyquist (0.5 cycles per sample)
+        size_t level = 0;
+        while (level + 1 < num_levels_ &&
+               static_cast<float>(MAX_HARMONIC >> level) * phase_increment >= 0.5f) {
+            ++level;
+        }
+        return level;
+    }
+
+    const float *Wavetable::get_level(size_t level) const {
+        return tables_.data() + std::min(level, num_levels_ - 1) * (TABLE_SIZE + 1);
+    }
+
+    // ------------------------------------------------------------------------
+    // VoiceEngine
+    // ------------------------------------------------------------------------
+
+    VoiceEngine::VoiceEngine(const VoiceEngineSettings &settings)
+        : settings_(settings),
+          max_voices_(round_up_lanes(std::max<size_t>(settings.max_voices, 1))),
+          sample_rate_(48000.0),
+          attack_step_(1.0f),
+          decay_step_(1.0f),
+          release_samples_(1.0f),
+          state_(NUM_ROWS, max_voices_),
+          table_offsets_(max_voices_, 0),
+          notes_(max_voices_, 0.0f),
+          velocities_(max_voices_, 0.0f),
+          stages_(max_voices_, Stage::Release),
+          num_active_(0),
+          voices_stolen_(0),
+          wavetable_(nullptr) {
+        settings_.sustain = std::clamp(settings_.sustain, 0.0f, 1.0f);
+
+        // Pick the kernels now rather than on the audio thread
+        static_cast<void>(get_kernels());
+    }
+
+    void VoiceEngine::prepare(double sample_rate, size_t max_block_size, size_t num_channels) {
+        static_cast<void>(max_block_size);
+        static_cast<void>(num_channels);
+
+        sample_rate_ = sample_rate;
+        const auto samples = [&](float ms) {
+            return std::max(1.0f, ms * 0.001f * static_cast<float>(sample_rate));
+        };
+
+        attack_step_ = 1.0f / samples(settings_.attack_ms);
+        decay_step_ = (1.0f - settings_.sustain) / samples(settings_.decay_ms);
+        release_samples_ = samples(settings_.release_ms);
+
+        sums_left_.assign(CONTROL_FRAMES * LANES, 0.0f);
+        sums_right_.assign(CONTROL_FRAMES * LANES, 0.0f);
+        reset();
+    }
+
+    void VoiceEngine::set_wavetable(const Wavetable *wavetable) {
+        wavetable_ = wavetable;
+    }
+
+    void VoiceEngine::reset() {
+        state_.clear();
+        std::fill(table_offsets_.begin(), table_offsets_.end(), 0);
+        num_active_ = 0;
+    }
+
+    bool VoiceEngine::is_voice_releasing(size_t i) const {
+        return stages_[i] == Stage::Release;
+    }
+
+    void VoiceEngine::start_voice(size_t slot, float note, float velocity, float pan) {
+        const float frequency = settings_.tuning_hz * std::exp2((note - 69.0f) / 12.0f);
+        const float increment = std::clamp(frequency / static_cast<float>(sample_rate_), 0.0f, 0.49f);
+        const float angle = (std::clamp(pan, -1.0f, 1.0f) + 1.0f) * 0.25f * PI;
+        const float gain = std::clamp(velocity, 0.0f, 1.0f) * settings_.gain;
+
+        // A stolen voice keeps its phase and level, so the new note starts without a click
+        row(INCREMENT)[slot] = increment;
+        row(STEP)[slot] = attack_step_;
+        row(TARGET)[slot] = 1.0f;
+        row(GAIN_LEFT)[slot] = gain * std::cos(angle);
+        row(GAIN_RIGHT)[slot] = gain * std::sin(angle);
+
+        table_offsets_[slot] = 0;
+        if (wavetable_) {
+            const size_t level = wavetable_->select_level(increment);
+            table_offsets_[slot] = static_cast<int32_t>(wavetable_->get_level(level) - wavetable_->get_level(0));
+        }
+
+        notes_[slot] = note;
+        velocities_[slot] = velocity;
+        stages_[slot] = Stage::Attack;
+    }
+
+    void VoiceEngine::note_on(float note, float velocity, float pan) {
+        if (num_active_ < max_voices_) {
+            const size_t slot = num_active_++;
+            row(PHASE)[slot] = 0.0f;
+            row(LEVEL)[slot] = 0.0f;
+            start_voice(slot, note, velocity, pan);
+            return;
+        }
+
+        // Steal the quietest releasing voice, else the oldest (slot 0)
+        size_t victim = 0;
+        float quietest = 2.0f;
+        const float *level = row(LEVEL);
+        for (size_t i = 0; i < num_active_; ++i) {
+            if (stages_[i] == Stage::Release && level[i] < quietest) {
+                quietest = level[i];
+                victim = i;
+            }
+        }
+
+        // The new note is the youngest: move it to the end to keep slots in age order
+        const float phase = row(PHASE)[victim];
+        const float current = row(LEVEL)[victim];
+        for (size_t i = victim + 1; i < num_active_; ++i) {
+            move_voice(i, i - 1);
+        }
+
+        const size_t slot = num_active_ - 1;
+        row(PHASE)[slot] = phase;
+        row(LEVEL)[slot] = current;
+        start_voice(slot, note, velocity, pan);
+        ++voices_stolen_;
+    }
+
+    void VoiceEngine::note_off(float note) {
+        for (size_t i = 0; i < num_active_; ++i) {
+            if (notes_[i] == note) release_voice(i);
+        }
+    }
+
+    void VoiceEngine::all_notes_off() {
+        for (size_t i = 0; i < num_active_; ++i) {
+            release_voice(i);
+        }
+    }
+
+    void VoiceEngine::release_voice(size_t slot) {
+        if (stages_[slot] == Stage::Release) return;
+
+        // Linear ramp from wherever the envelope is to zero over release_ms
+        stages_[slot] = Stage::Release;
+        row(TARGET)[slot] = 0.0f;
+        row(STEP)[slot] = -std::max(row(LEVEL)[slot], 1e-6f) / release_samples_;
+    }
+
+    void VoiceEngine::update_stages() {
+        float *level = row(LEVEL);
+        float *step = row(STEP);
+        float *target = row(TARGET);
+        bool finished = false;
+
+        for (size_t i = 0; i < num_active_; ++i) {
+            switch (stages_[i]) {
+                case Stage::Attack:
+                    if (level[i] >= 1.0f) {
+                        stages_[i] = Stage::Decay;
+                        target[i] = settings_.sustain;
+                        step[i] = -decay_step_;
+                    }
+                    break;
+                case Stage::Decay:
+                    if (level[i] <= settings_.sustain) {
+                        stages_[i] = Stage::Sustain;
+                        step[i] = 0.0f;
+                    }
+                    break;
+                case Stage::Sustain:
+                    break;
+                case Stage::Release:
+                    finished = finished || level[i] <= 0.0f;
+                    break;
+            }
+        }
+
+        if (finished) compact();
+    }
+
+    void VoiceEngine::move_voice(size_t from, size_t to) {
+        for (size_t r = 0; r < NUM_ROWS; ++r) {
+            float *data = row(static_cast<Row>(r));
+            data[to] = data[from];
+        }
+        table_offsets_[to] = table_offsets_[from];
+        notes_[to] = notes_[from];
+        velocities_[to] = velocities_[from];
+        stages_[to] = stages_[from];
+    }
+
+    void VoiceEngine::compact() {
+        // Stable: the survivors keep their age order
+        const float *level = row(LEVEL);
+        size_t kept = 0;
+        for (size_t i = 0; i < num_active_; ++i) {
+            if (stages_[i] == Stage::Release && level[i] <= 0.0f) continue;
+            if (kept != i) move_voice(i, kept);
+            ++kept;
+        }
+
+        // Freed slots render as silence until reused
+        for (size_t r = 0; r < NUM_ROWS; ++r) {
+            std::fill(row(static_cast<Row>(r)) + kept, row(static_cast<Row>(r)) + num_active_, 0.0f);
+        }
+        num_active_ = kept;
+    }
+
+    void VoiceEngine::process(BufferView *channels, size_t num_channels) {
+        if (!channels || num_channels == 0) return;
+
+        const GroupKernels &kernels = get_kernels();
+        Waveform waveform = settings_.waveform;
+        if (waveform == Waveform::Wavetable && !wavetable_) waveform = Waveform::Saw;
+        const GroupFn kernel = kernels.kernels[static_cast<size_t>(waveform)];
+
+        const size_t num_frames = channels[0].size();
+        float *left = channels[0].data();
+        float *right = num_channels > 1 ? channels[1].data() : nullptr;
+
+        for (size_t offset = 0; offset < num_frames; offset += CONTROL_FRAMES) {
+            update_stages();
+            if (num_active_ == 0) continue;
+
+            const size_t frames = std::min(CONTROL_FRAMES, num_frames - offset);
+            std::fill(sums_left_.begin(), sums_left_.end(), 0.0f);
+            std::fill(sums_right_.begin(), sums_right_.end(), 0.0f);
+
+            GroupArgs args{};
+            args.phase = row(PHASE);
+            args.increment = row(INCREMENT);
+            args.level = row(LEVEL);
+            args.step = row(STEP);
+            args.target = row(TARGET);
+            args.gain_left = row(GAIN_LEFT);
+            args.gain_right = row(GAIN_RIGHT);
+            args.table_offsets = table_offsets_.data();
+            args.table = wavetable_ ? wavetable_->get_level(0) : nullptr;
+            args.num_groups = round_up_lanes(num_active_) / LANES;
+            args.num_frames = frames;
+            args.sums_left = sums_left_.data();
+            args.sums_right = sums_right_.data();
+            kernel(args);
+
+            // One horizontal reduction per frame, however many voices played
+            for (size_t i = 0; i < frames; ++i) {
+                float sum_left = 0.0f;
+                float sum_right = 0.0f;
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    sum_left += sums_left_[i * LANES + lane];
+                    sum_right += sums_right_[i * LANES + lane];
+                }
+
+                if (right) {
+                    left[offset + i] += sum_left;
+                    right[offset + i] += sum_right;
+                } else {
+                    left[offset + i] += (sum_left + sum_right) * 0.70710678f;
+                }
+            }
+        }
+    }
+
+    void VoiceEngine::render(AudioBuffer &output, size_t num_frames) {
+        output.clear();
+        num_frames = std::min(num_frames, output.get_num_samples());
+
+        BufferView views[2];
+        const size_t num_views = std::min<size_t>(output.get_num_channels(), 2);
+        for (size_t ch = 0; ch < num_views; ++ch) {
+            views[ch] = BufferView(output.get_channel_data(ch), num_frames);
+        }
+        process(views, num_views);
+    }
+}
@@ -0,0 +1,199 @@
+/**
+ *  Concurrent stress test for BasicRingBuffer.
+ *
+ *  A producer and a consumer thread hammer one ring buffer with random
+ *  chunk sizes, random capacities and random pauses. Every sample carries
+ *  a running sequence number, so a torn, lost, duplicated or reordered
+ *  sample fails the run. Meant to be run under ThreadSanitizer and
+ *  AddressSanitizer (see the tsan and asan presets) as well as in normal
+ *  builds, where it also reports sustained throughput.
+ *
+ *  Usage: gw-core-stress [--seconds S] [--seed N] [--min-msps M]
+ *
+ *  --min-msps fails the run when sustained throughput (million samples
+ *  per second, averaged over both sample types) drops below M.
+ */
+
+#include <gw/core/ring_buffer.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Options {
+        double seconds = 1.0;
+        uint64_t seed = 1;
+        double min_msps = 0.0;
+    };
+
+    struct RoundResult {
+        uint64_t samples = 0;
+        uint64_t errors = 0;
+    };
+
+    // Sequence numbers wrap so every value is exact in the sample type
+    // (floats hold integers exactly up to 2^24)
+    template<typename T>
+    constexpr uint64_t sequence_period() {
+        return sizeof(T) == sizeof(float) ? uint64_t{1} << 24 : uint64_t{1} << 52;
+    }
+
+    template<typename T>
+    RoundResult run_round(size_t capacity, size_t max_chunk, std::chrono::steady_clock::duration duration,
+                          uint64_t seed) {
+        gw::core::BasicRingBuffer<T> ring(capacity);
+
+        std::atomic<bool> stop{false};
+        std::atomic<bool> done{false};
+        uint64_t produced = 0;
+        RoundResult result;
+
+        std::thread producer([&] {
+            std::mt19937_64 random(seed);
+            std::uniform_int_distribution<size_t> chunk_size(1, max_chunk);
+            std::vector<T> chunk(max_chunk);
+            uint64_t sequence = 0;
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                const size_t count = chunk_size(random);
+                for (size_t i = 0; i < count; ++i) {
+                    chunk[i] = static_cast<T>((sequence + i) % sequence_period<T>());
+                }
+
+                // A short write is legal; the remainder is simply not sent
+                const size_t written = ring.write(chunk.data(), count);
+                sequence += written;
+
+                if (written == 0 || random() % 64 == 0) std::this_thread::yield();
+            }
+
+            produced = sequence;
+            done.store(true, std::memory_order_release);
+        });
+
+        std::thread consumer([&] {
+            std::mt19937_64 random(seed ^ 0x9e3779b97f4a7c15ull);
+            std::uniform_int_distribution<size_t> chunk_size(1, max_chunk);
+            std::vector<T> chunk(max_chunk);
+            uint64_t sequence = 0;
+            uint64_t total = UINT64_MAX;
+
+            while (sequence < total) {
+                const size_t available = ring.get_available_read();
+                if (available > capacity) ++result.errors;
+
+                const size_t read = ring.read(chunk.data(), chunk_size(random));
+                for (size_t i = 0; i < read; ++i) {
+                    if (chunk[i] != static_cast<T>((sequence + i) % sequence_period<T>())) ++result.errors;
+                }
+                sequence += read;
+
+                if (read == 0) {
+                    // Only once the producer has stopped is "empty" final
+                    if (total == UINT64_MAX && done.load(std::memory_order_acquire)) total = produced;
+                    std::this_thread::yield();
+                } else if (random() % 64 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+
+            // A round that moved nothing tested nothing
+            if (sequence != total || sequence == 0) ++result.errors;
+            result.samples = sequence;
+        });
+
+        std::this_thread::sleep_for(duration);
+        stop.store(true, std::memory_order_relaxed);
+        producer.join();
+        consumer.join();
+
+        if (ring.get_available_read() != 0) ++result.errors;
+        return result;
+    }
+
+    // Returns throughput in million samples per second, or a negative value on failure
+    template<typename T>
+    double run_type(const char *name, const Options &options) {
+        std::mt19937_64 random(options.seed);
+        const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.seconds);
+        const auto start = std::chrono::steady_clock::now();
+
+        uint64_t samples = 0;
+        uint64_t errors = 0;
+        size_t rounds = 0;
+
+        // Small capacities exercise wraparound and full/empty edges; large ones the bulk path.
+        // Capacity 1 alternates strictly between full and empty
+        const size_t capacities[] = {1, 2, 3, 7, 64, 1000, 4096, 48000};
+
+        do {
+            const size_t capacity = capacities[random() % (sizeof(capacities) / sizeof(capacities[0]))];
+            const size_t max_chunk = 1 + random() % (2 * capacity + 1);
+            const RoundResult result = run_round<T>(capacity, max_chunk, std::chrono::milliseconds(25), random());
+            samples += result.samples;
+            errors += result.errors;
+            ++rounds;
+        } while (std::chrono::steady_clock::now() < end);
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double msps = static_cast<double>(samples) / elapsed / 1e6;
+
+        std::cout << "  - " << name << ": " << rounds << " rounds, " << samples << " samples, "
+                << msps << " Msamples/s";
+        if (errors != 0) {
+            std::cout << ", " << errors << " ERRORS" << std::endl;
+            return -1.0;
+        }
+        std::cout << ": OK" << std::endl;
+        return msps;
+    }
+
+    bool parse_options(int argc, char **argv, Options &options) {
+        for (int i = 1; i < argc; ++i) {
+            const bool has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--seconds") == 0 && has_value) {
+                options.seconds = std::atof(argv[++i]);
+            } else if (std::strcmp(argv[i], "--seed") == 0 && has_value) {
+                options.seed = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--min-msps") == 0 && has_value) {
+                options.min_msps = std::atof(argv[++i]);
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--seconds S] [--seed N] [--min-msps M]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) return 2;
+
+    std::cout << "Running RingBuffer stress test (seed " << options.seed << ", "
+            << options.seconds << " s per type)..." << std::endl;
+
+    const double float_msps = run_type<float>("float", options);
+    const double double_msps = run_type<double>("double", options);
+
+    if (float_msps < 0.0 || double_msps < 0.0) {
+        std::cout << "\n=== Stress test FAILED (rerun with --seed " << options.seed << ") ===" << std::endl;
+        return 1;
+    }
+
+    const double average = 0.5 * (float_msps + double_msps);
+    if (average < options.min_msps) {
+        std::cout << "\n=== Throughput regression: " << average << " Msamples/s, expected at least "
+                << options.min_msps << " ===" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n=== Stress test passed (" << average << " Msamples/s) ===" << std::endl;
+    return 0;
+}
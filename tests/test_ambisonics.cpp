@@ -0,0 +1,342 @@
+#include <gw/core/ambisonics.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr size_t MAX_CHANNELS = gw::core::get_ambisonic_channel_count(gw::core::AMBISONIC_MAX_ORDER);
+
+    struct Direction {
+        float azimuth;
+        float elevation;
+    };
+
+    Direction random_direction(std::mt19937 &random) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        const float pi = std::acos(-1.0f);
+        return {pi * unit(random), std::asin(unit(random))};
+    }
+
+    // Rz(yaw) Ry(pitch) Rx(roll) applied to a direction
+    Direction rotate(Direction direction, float yaw, float pitch, float roll) {
+        const double ce = std::cos(direction.elevation);
+        double v[3] = {ce * std::cos(direction.azimuth), ce * std::sin(direction.azimuth),
+                       std::sin(direction.elevation)};
+
+        const auto apply = [&v](size_t a, size_t b, double angle) {
+            const double c = std::cos(angle), s = std::sin(angle);
+            const double va = v[a], vb = v[b];
+            v[a] = c * va - s * vb;
+            v[b] = s * va + c * vb;
+        };
+        apply(1, 2, roll); // About x
+        apply(2, 0, pitch); // About y
+        apply(0, 1, yaw); // About z
+
+        return {static_cast<float>(std::atan2(v[1], v[0])),
+                static_cast<float>(std::asin(std::clamp(v[2], -1.0, 1.0)))};
+    }
+
+    std::vector<float> random_signal(std::mt19937 &random, size_t size) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<float> signal(size);
+        for (float &sample: signal) sample = unit(random);
+        return signal;
+    }
+}
+
+void test_ambisonics() {
+    const float pi = std::acos(-1.0f);
+    std::mt19937 random(7);
+
+    // Test the spherical harmonics against the AmbiX first-order formulas,
+    // and that every SN3D order has unit energy in any direction
+    {
+        float coefficients[MAX_CHANNELS];
+        const float azimuth = 0.7f, elevation = 0.3f;
+        gw::core::compute_ambisonic_coefficients(2, azimuth, elevation, coefficients);
+        assert(std::fabs(coefficients[0] - 1.0f) < 1e-6f);
+        assert(std::fabs(coefficients[1] - std::sin(azimuth) * std::cos(elevation)) < 1e-6f);
+        assert(std::fabs(coefficients[2] - std::sin(elevation)) < 1e-6f);
+        assert(std::fabs(coefficients[3] - std::cos(azimuth) * std::cos(elevation)) < 1e-6f);
+        const float r = 0.5f * (3.0f * std::sin(elevation) * std::sin(elevation) - 1.0f);
+        assert(std::fabs(coefficients[6] - r) < 1e-6f);
+
+        for (int trial = 0; trial < 20; ++trial) {
+            const Direction direction = random_direction(random);
+            gw::core::compute_ambisonic_coefficients(7, direction.azimuth, direction.elevation, coefficients);
+            for (size_t l = 0; l <= 7; ++l) {
+                double energy = 0.0;
+                for (size_t ch = l * l; ch < (l + 1) * (l + 1); ++ch) energy += coefficients[ch] * coefficients[ch];
+                assert(std::fabs(energy - 1.0) < 1e-4);
+            }
+        }
+    }
+
+    std::cout << "  - Spherical harmonics: OK" << std::endl;
+
+    // Test a rotated encoding equals encoding the rotated direction, at every order up to 7
+    {
+        gw::core::AmbisonicRotator rotator(7);
+        rotator.prepare(48000.0, 16, MAX_CHANNELS);
+
+        for (int trial = 0; trial < 10; ++trial) {
+            std::uniform_real_distribution<float> angle(-pi, pi);
+            const float yaw = angle(random), pitch = angle(random), roll = angle(random);
+            rotator.set_rotation(yaw, pitch, roll);
+            rotator.reset(); // Jump straight to the new orientation
+
+            const Direction source = random_direction(random);
+            std::vector<float> signal(MAX_CHANNELS);
+            gw::core::compute_ambisonic_coefficients(7, source.azimuth, source.elevation, signal.data());
+
+            std::vector<gw::core::BufferView> views;
+            for (size_t ch = 0; ch < MAX_CHANNELS; ++ch) views.emplace_back(&signal[ch], 1);
+            rotator.process(views.data(), views.size());
+
+            const Direction rotated = rotate(source, yaw, pitch, roll);
+            float expected[MAX_CHANNELS];
+            gw::core::compute_ambisonic_coefficients(7, rotated.azimuth, rotated.elevation, expected);
+            for (size_t ch = 0; ch < MAX_CHANNELS; ++ch) {
+                assert(std::fabs(signal[ch] - expected[ch]) < 2e-4f);
+            }
+        }
+
+        // Every order's block is orthogonal
+        for (size_t l = 1; l <= 7; ++l) {
+            const float *block = rotator.get_order_matrix(l);
+            const size_t size = 2 * l + 1;
+            for (size_t a = 0; a < size; ++a) {
+                for (size_t b = 0; b < size; ++b) {
+                    double dot = 0.0;
+                    for (size_t k = 0; k < size; ++k) dot += block[a * size + k] * block[b * size + k];
+                    assert(std::fabs(dot - (a == b ? 1.0 : 0.0)) < 1e-4);
+                }
+            }
+        }
+    }
+
+    std::cout << "  - Rotation: OK" << std::endl;
+
+    // Test a change of orientation crossfades over one block, then holds
+    {
+        gw::core::AmbisonicRotator rotator(1);
+        rotator.prepare(48000.0, 64, 4);
+
+        // A constant source straight ahead (X = 1) turned a quarter to the left (Y = 1)
+        std::vector<float> signal(4 * 64);
+        std::vector<gw::core::BufferView> views;
+        for (size_t ch = 0; ch < 4; ++ch) views.emplace_back(signal.data() + ch * 64, 64);
+        const auto fill = [&] {
+            std::fill(signal.begin(), signal.end(), 0.0f);
+            std::fill_n(signal.data(), 64, 1.0f);
+            std::fill_n(signal.data() + 3 * 64, 64, 1.0f);
+        };
+
+        rotator.set_rotation(pi / 2.0f, 0.0f, 0.0f);
+        fill();
+        rotator.process(views.data(), 4);
+        const float *y = signal.data() + 64;
+        const float *x = signal.data() + 3 * 64;
+        assert(std::fabs(y[0]) < 1e-6f && std::fabs(x[0] - 1.0f) < 1e-6f);
+        assert(std::fabs(y[32] - 0.5f) < 1e-5f && std::fabs(x[32] - 0.5f) < 1e-5f);
+
+        fill();
+        rotator.process(views.data(), 4);
+        for (size_t n = 0; n < 64; ++n) assert(std::fabs(y[n] - 1.0f) < 1e-6f && std::fabs(x[n]) < 1e-6f);
+    }
+
+    std::cout << "  - Rotation crossfade: OK" << std::endl;
+
+    // Test the encoder's gains and its ramp when a source moves
+    {
+        gw::core::AmbisonicEncoder encoder(3, 2);
+        encoder.set_direction(0, 0.5f, 0.2f);
+        encoder.set_direction(1, -1.0f, -0.4f);
+        encoder.reset();
+
+        std::vector<float> first(100, 1.0f), second(100, 0.0f);
+        const gw::core::BufferView sources[2] = {{first.data(), 100}, {second.data(), 100}};
+        std::vector<float> output(16 * 100);
+        std::vector<gw::core::BufferView> views;
+        for (size_t ch = 0; ch < 16; ++ch) views.emplace_back(output.data() + ch * 100, 100);
+
+        float before[16], after[16];
+        gw::core::compute_ambisonic_coefficients(3, 0.5f, 0.2f, before);
+        encoder.process(sources, 2, views.data(), 16);
+        for (size_t ch = 0; ch < 16; ++ch) assert(std::fabs(output[ch * 100 + 99] - before[ch]) < 1e-6f);
+
+        encoder.set_direction(0, 2.0f, 0.0f);
+        gw::core::compute_ambisonic_coefficients(3, 2.0f, 0.0f, after);
+        encoder.process(sources, 2, views.data(), 16);
+        for (size_t ch = 0; ch < 16; ++ch) {
+            assert(std::fabs(output[ch * 100] - before[ch]) < 1e-6f);
+            const float halfway = before[ch] + 0.5f * (after[ch] - before[ch]);
+            assert(std::fabs(output[ch * 100 + 50] - halfway) < 1e-5f);
+        }
+
+        encoder.process(sources, 2, views.data(), 16);
+        for (size_t ch = 0; ch < 16; ++ch) assert(std::fabs(output[ch * 100] - after[ch]) < 1e-6f);
+    }
+
+    std::cout << "  - Encoder: OK" << std::endl;
+
+    // Test the blocked decoder against a plain per-sample matrix loop, 64 in / 32 out
+    {
+        const size_t num_outputs = 32;
+        gw::core::AmbisonicDecoder decoder(7, num_outputs);
+        const std::vector<float> matrix = random_signal(random, num_outputs * MAX_CHANNELS);
+        decoder.set_matrix(matrix.data());
+
+        for (const size_t count: {1u, 129u, 300u}) {
+            const std::vector<float> input = random_signal(random, MAX_CHANNELS * count);
+            std::vector<float> output(num_outputs * count);
+            std::vector<gw::core::BufferView> inputs, outputs;
+            for (size_t ch = 0; ch < MAX_CHANNELS; ++ch) {
+                inputs.emplace_back(const_cast<float *>(input.data()) + ch * count, count);
+            }
+            for (size_t o = 0; o < num_outputs; ++o) outputs.emplace_back(output.data() + o * count, count);
+
+            // Full order, then third order through the leading 16 columns
+            for (const size_t channels: {MAX_CHANNELS, size_t{16}}) {
+                decoder.process(inputs.data(), channels, outputs.data(), num_outputs);
+                for (size_t o = 0; o < num_outputs; ++o) {
+                    for (size_t n = 0; n < count; ++n) {
+                        double expected = 0.0;
+                        for (size_t ch = 0; ch < channels; ++ch) {
+                            expected += matrix[o * MAX_CHANNELS + ch] * input[ch * count + n];
+                        }
+                        assert(std::fabs(output[o * count + n] - expected) < 1e-4);
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "  - Matrix decoding: OK" << std::endl;
+
+    // Test a sampling decoder puts a source on the speaker it points at
+    {
+        // Cube corners plus the six axes
+        std::vector<float> azimuths, elevations;
+        const float corner = std::atan(1.0f / std::sqrt(2.0f));
+        for (int i = 0; i < 4; ++i) {
+            azimuths.insert(azimuths.end(), {pi / 4.0f + static_cast<float>(i) * pi / 2.0f,
+                                             pi / 4.0f + static_cast<float>(i) * pi / 2.0f});
+            elevations.insert(elevations.end(), {corner, -corner});
+            azimuths.push_back(static_cast<float>(i) * pi / 2.0f);
+            elevations.push_back(0.0f);
+        }
+        azimuths.insert(azimuths.end(), {0.0f, 0.0f});
+        elevations.insert(elevations.end(), {pi / 2.0f, -pi / 2.0f});
+        const size_t num_speakers = azimuths.size();
+
+        gw::core::AmbisonicDecoder decoder(2, num_speakers);
+        assert(!decoder.set_speakers(azimuths.data(), elevations.data(), num_speakers - 1));
+        assert(decoder.set_speakers(azimuths.data(), elevations.data(), num_speakers));
+
+        for (size_t target = 0; target < num_speakers; ++target) {
+            float signal[9];
+            gw::core::compute_ambisonic_coefficients(2, azimuths[target], elevations[target], signal);
+            std::vector<gw::core::BufferView> inputs;
+            for (float &value: signal) inputs.emplace_back(&value, 1);
+
+            std::vector<float> gains(num_speakers);
+            std::vector<gw::core::BufferView> outputs;
+            for (float &gain: gains) outputs.emplace_back(&gain, 1);
+            decoder.process(inputs.data(), 9, outputs.data(), num_speakers);
+
+            const auto loudest = std::max_element(gains.begin(), gains.end()) - gains.begin();
+            assert(static_cast<size_t>(loudest) == target);
+        }
+    }
+
+    std::cout << "  - Speaker decoding: OK" << std::endl;
+
+    // Test the partitioned convolution equals direct convolution with the
+    // channel filters, delayed by one partition, for uneven block sizes
+    {
+        gw::core::BinauralRenderer renderer(2, 32, 200);
+        renderer.use_spherical_head(48000.0);
+        const size_t length = renderer.get_filter_length();
+        const size_t latency = renderer.get_latency_samples();
+        assert(latency == 32 && length > 64 && length <= 200);
+
+        const size_t total = 1000;
+        const std::vector<float> input = random_signal(random, 9 * total);
+        std::vector<float> left(total), right(total);
+
+        size_t offset = 0;
+        const size_t block_sizes[] = {1, 31, 64, 100, 7};
+        for (size_t next = 0; offset < total; ++next) {
+            const size_t count = std::min(block_sizes[next % 5], total - offset);
+            std::vector<gw::core::BufferView> views;
+            for (size_t ch = 0; ch < 9; ++ch) {
+                views.emplace_back(const_cast<float *>(input.data()) + ch * total + offset, count);
+            }
+            gw::core::BufferView left_view(left.data() + offset, count);
+            gw::core::BufferView right_view(right.data() + offset, count);
+            renderer.process(views.data(), 9, left_view, right_view);
+            offset += count;
+        }
+
+        for (size_t ear = 0; ear < 2; ++ear) {
+            const std::vector<float> &output = ear == 0 ? left : right;
+            for (size_t n = 0; n < total; ++n) {
+                double expected = 0.0;
+                if (n >= latency) {
+                    for (size_t ch = 0; ch < 9; ++ch) {
+                        const float *filter = renderer.get_filter(ch, ear);
+                        for (size_t k = 0; k < length && k <= n - latency; ++k) {
+                            expected += filter[k] * input[ch * total + n - latency - k];
+                        }
+                    }
+                }
+                assert(std::fabs(output[n] - expected) < 1e-3);
+            }
+        }
+    }
+
+    std::cout << "  - Partitioned convolution: OK" << std::endl;
+
+    // Test a 7th-order source on the left is louder and earlier in the left ear
+    {
+        gw::core::BinauralRenderer renderer(7);
+        renderer.use_spherical_head(48000.0);
+
+        for (const float side: {1.0f, -1.0f}) {
+            renderer.reset();
+            std::vector<float> signal(MAX_CHANNELS * 512, 0.0f);
+            float coefficients[MAX_CHANNELS];
+            gw::core::compute_ambisonic_coefficients(7, side * pi / 2.0f, 0.0f, coefficients);
+            for (size_t ch = 0; ch < MAX_CHANNELS; ++ch) signal[ch * 512] = coefficients[ch]; // An impulse
+
+            std::vector<gw::core::BufferView> views;
+            for (size_t ch = 0; ch < MAX_CHANNELS; ++ch) views.emplace_back(signal.data() + ch * 512, 512);
+            std::vector<float> left(512), right(512);
+            gw::core::BufferView left_view(left.data(), 512), right_view(right.data(), 512);
+            renderer.process(views.data(), MAX_CHANNELS, left_view, right_view);
+
+            double left_energy = 0.0, right_energy = 0.0;
+            for (size_t n = 0; n < 512; ++n) {
+                left_energy += left[n] * left[n];
+                right_energy += right[n] * right[n];
+            }
+            const auto peak = [](const std::vector<float> &ear) {
+                return std::max_element(ear.begin(), ear.end(), [](float a, float b) {
+                    return std::fabs(a) < std::fabs(b);
+                }) - ear.begin();
+            };
+
+            const double near = side > 0.0f ? left_energy : right_energy;
+            const double far = side > 0.0f ? right_energy : left_energy;
+            assert(near > 2.0 * far);
+            assert(side > 0.0f ? peak(left) < peak(right) : peak(right) < peak(left));
+        }
+    }
+
+    std::cout << "  - Binaural lateralization: OK" << std::endl;
+}
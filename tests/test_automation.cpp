@@ -0,0 +1,168 @@
+#include <gw/core/automation.h>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+    gw::core::AutomationCurve make_random_curve(size_t num_points, uint64_t length, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint64_t> position(0, length);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        std::bernoulli_distribution hold(0.25);
+
+        std::vector<gw::core::AutomationPoint> points;
+        for (size_t i = 0; i < num_points; ++i) {
+            points.push_back({position(rng), value(rng),
+                              hold(rng) ? gw::core::CurveShape::Hold : gw::core::CurveShape::Linear});
+        }
+        return gw::core::AutomationCurve(std::move(points));
+    }
+}
+
+void test_automation() {
+    // Test curve evaluation: sorting, interpolation, hold, jumps and the ends
+    {
+        const gw::core::AutomationCurve curve({
+            {200, 0.0f, gw::core::CurveShape::Hold},
+            {100, 1.0f},
+            {300, 0.5f},
+            {300, 0.25f},
+            {400, 0.75f},
+        });
+
+        assert(curve.get_num_points() == 5);
+        assert(curve.get_positions()[0] == 100 && curve.get_positions()[1] == 200);
+
+        assert(curve.get_value(0) == 1.0f); // Holds the first value before it
+        assert(curve.get_value(100) == 1.0f);
+        assert(std::fabs(curve.get_value(150) - 0.5f) < 1e-6f); // Linear 1 -> 0
+        assert(curve.get_value(250) == 0.0f); // Hold
+        assert(curve.get_value(300) == 0.25f); // Later of two equal positions wins
+        assert(std::fabs(curve.get_value(350) - 0.5f) < 1e-6f);
+        assert(curve.get_value(10000) == 0.75f); // Holds the last value after it
+    }
+
+    std::cout << "  - Curve evaluation: OK" << std::endl;
+
+    // Test block rendering matches per-sample evaluation for any block size,
+    // across many breakpoints per block, and after seeks back and forth
+    {
+        const uint64_t length = 20000;
+        gw::core::AutomationTimeline timeline(1);
+        timeline.set_lane(0, make_random_curve(500, length, 11));
+        const gw::core::AutomationCurve reference = make_random_curve(500, length, 11);
+
+        std::vector<float> block(4096);
+        const size_t block_sizes[] = {1, 7, 64, 333, 4096};
+        const uint64_t starts[] = {0, 5000, 1000, 19000, 1000};
+
+        for (const uint64_t start: starts) {
+            uint64_t position = start;
+            size_t next = 0;
+            while (position < length + 500) {
+                const size_t count = block_sizes[next++ % 5];
+                const bool rendered = timeline.render(0, position, gw::core::BufferView(block.data(), count));
+                assert(rendered);
+
+                for (size_t i = 0; i < count; ++i) {
+                    const float expected = reference.get_value(position + i);
+                    assert(std::fabs(block[i] - expected) < 1e-4f);
+                }
+                position += count;
+            }
+        }
+
+        float value = 0.0f;
+        const bool found = timeline.get_value(0, 1234, value);
+        assert(found && std::fabs(value - reference.get_value(1234)) < 1e-5f);
+    }
+
+    std::cout << "  - Block rendering: OK" << std::endl;
+
+    // Test multi-lane rendering: empty lanes are reported and left alone
+    {
+        gw::core::AutomationTimeline timeline(3);
+        timeline.set_lane(0, gw::core::AutomationCurve({{0, 0.0f}, {100, 1.0f}}));
+        timeline.set_lane(2, gw::core::AutomationCurve({{0, 0.5f}}));
+
+        std::vector<float> data(3 * 64, -9.0f);
+        gw::core::BufferView views[3] = {
+            {data.data(), 64}, {data.data() + 64, 64}, {data.data() + 128, 64}
+        };
+
+        assert(timeline.render(10, views, 3) == 2);
+        assert(std::fabs(data[0] - 0.1f) < 1e-6f && std::fabs(data[63] - 0.73f) < 1e-6f);
+        assert(data[64] == -9.0f && data[127] == -9.0f);
+        assert(data[128] == 0.5f && data[191] == 0.5f);
+
+        // Clearing a lane
+        timeline.set_lane(0, gw::core::AutomationCurve());
+        assert(timeline.render(10, views, 3) == 1);
+        assert(!timeline.set_lane(3, gw::core::AutomationCurve()));
+    }
+
+    std::cout << "  - Multiple lanes: OK" << std::endl;
+
+    // Test replacing lanes while another thread renders them: every block
+    // comes from exactly one curve, and curves only ever move forward
+    {
+        constexpr size_t NUM_LANES = 4;
+        constexpr size_t NUM_REPLACEMENTS = 2000;
+        gw::core::AutomationTimeline timeline(NUM_LANES);
+
+        std::atomic<bool> done{false};
+        std::atomic<bool> consistent{true};
+
+        std::thread audio([&] {
+            std::vector<float> block(128);
+            std::vector<float> last_seen(NUM_LANES, -1.0f);
+            uint64_t position = 0;
+
+            while (!done.load(std::memory_order_acquire)) {
+                for (size_t lane = 0; lane < NUM_LANES; ++lane) {
+                    if (!timeline.render(lane, position, gw::core::BufferView(block.data(), block.size()))) {
+                        continue;
+                    }
+
+                    // Each curve is flat at its generation number
+                    for (const float sample: block) {
+                        if (sample != block[0]) consistent = false;
+                    }
+                    if (block[0] < last_seen[lane]) consistent = false;
+                    last_seen[lane] = block[0];
+                }
+                position += block.size();
+            }
+        });
+
+        for (size_t generation = 0; generation < NUM_REPLACEMENTS; ++generation) {
+            const auto value = static_cast<float>(generation);
+            timeline.set_lane(generation % NUM_LANES,
+                              gw::core::AutomationCurve({{0, value}, {1000000000, value}}));
+            if (generation % 16 == 0) std::this_thread::yield();
+        }
+
+        // Let the audio thread pick up the final curves
+        for (int i = 0; i < 100; ++i) {
+            timeline.collect_garbage();
+            std::this_thread::yield();
+        }
+
+        done.store(true, std::memory_order_release);
+        audio.join();
+        assert(consistent.load());
+
+        float value = 0.0f;
+        for (size_t lane = 0; lane < NUM_LANES; ++lane) {
+            timeline.collect_garbage();
+            const bool found = timeline.get_value(lane, 0, value);
+            assert(found && value == static_cast<float>(NUM_REPLACEMENTS - NUM_LANES + lane));
+        }
+    }
+
+    std::cout << "  - Lock-free lane replacement: OK" << std::endl;
+}
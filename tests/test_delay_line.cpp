@@ -0,0 +1,221 @@
+#include <gw/core/delay_line.h>
+#include <gw/core/dynamics.h>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+void test_delay_line() {
+    // Test whole-sample delays across block and wrap boundaries
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    {
+        const size_t block = 64;
+        const size_t delay = 100;
+        gw::core::DelayLine line(2, 200, block);
+        gw::core::AudioBuffer buffer(2, block);
+        std::vector<float> input;
+        std::vector<float> output;
+
+        for (size_t b = 0; b < 50; ++b) {
+            for (size_t i = 0; i < block; ++i) {
+                const float sample = dist(rng);
+                input.push_back(sample);
+                buffer.set_sample(0, i, sample);
+                buffer.set_sample(1, i, -sample);
+            }
+
+            gw::core::BufferView views[2] = {{buffer, 0}, {buffer, 1}};
+            line.process(views, 2, static_cast<float>(delay), gw::core::DelayInterpolation::None);
+
+            for (size_t i = 0; i < block; ++i) {
+                output.push_back(buffer.get_sample(0, i));
+                assert(buffer.get_sample(1, i) == -buffer.get_sample(0, i));
+            }
+        }
+
+        for (size_t n = 0; n < output.size(); ++n) {
+            const float expected = n >= delay ? input[n - delay] : 0.0f;
+            assert(output[n] == expected);
+        }
+    }
+
+    std::cout << "  - Integer delay: OK" << std::endl;
+
+    // Test fractional delays on a low-frequency sine
+    {
+        const size_t block = 50;
+        const float delay = 10.3f;
+        const double omega = 2.0 * std::acos(-1.0) * 0.01;
+
+        gw::core::DelayLine line(1, 64, block);
+        std::vector<float> input(block);
+        std::vector<float> linear(block);
+        std::vector<float> lagrange(block);
+        std::vector<float> allpass(block);
+        double linear_error = 0.0;
+        double lagrange_error = 0.0;
+        double allpass_error = 0.0;
+
+        for (size_t b = 0; b < 20; ++b) {
+            for (size_t i = 0; i < block; ++i) {
+                input[i] = static_cast<float>(std::sin(omega * static_cast<double>(b * block + i)));
+            }
+
+            line.write(0, input.data(), block);
+            line.read(0, delay, linear.data(), block, gw::core::DelayInterpolation::Linear);
+            line.read(0, delay, lagrange.data(), block, gw::core::DelayInterpolation::Lagrange3);
+            line.read(0, delay, allpass.data(), block, gw::core::DelayInterpolation::Allpass);
+            line.advance(block);
+
+            // Skip the start-up while the history fills and the allpass settles
+            if (b < 4) continue;
+
+            for (size_t i = 0; i < block; ++i) {
+                const double t = static_cast<double>(b * block + i) - static_cast<double>(delay);
+                const double expected = std::sin(omega * t);
+                linear_error = std::max(linear_error, std::abs(linear[i] - expected));
+                lagrange_error = std::max(lagrange_error, std::abs(lagrange[i] - expected));
+                allpass_error = std::max(allpass_error, std::abs(allpass[i] - expected));
+            }
+        }
+
+        assert(linear_error < 1e-3);
+        assert(lagrange_error < 2e-5);
+        assert(lagrange_error < linear_error);
+        assert(allpass_error < 2e-3);
+    }
+
+    std::cout << "  - Fractional delay: OK" << std::endl;
+
+    // Test modulated and multi-tap reads on a ramp (both interpolators are exact on it)
+    {
+        const size_t block = 32;
+        gw::core::DelayLine line(1, 40, block);
+        std::vector<float> input(block);
+        std::vector<float> delays(block);
+        std::vector<float> output(block);
+
+        const float tap_delays[3] = {3.25f, 17.0f, 30.5f};
+        const float tap_gains[3] = {0.5f, -1.0f, 0.25f};
+
+        for (size_t b = 0; b < 10; ++b) {
+            for (size_t i = 0; i < block; ++i) {
+                input[i] = static_cast<float>(b * block + i);
+                delays[i] = 2.0f + 20.0f * static_cast<float>(i) / static_cast<float>(block);
+            }
+            line.write(0, input.data(), block);
+
+            if (b >= 2) {
+                for (const auto interpolation: {gw::core::DelayInterpolation::Linear,
+                                                gw::core::DelayInterpolation::Lagrange3}) {
+                    line.read_modulated(0, delays.data(), output.data(), block, interpolation);
+                    for (size_t i = 0; i < block; ++i) {
+                        assert(std::abs(output[i] - (input[i] - delays[i])) < 1e-3f);
+                    }
+
+                    line.read_taps(0, tap_delays, tap_gains, 3, output.data(), block, interpolation);
+                    for (size_t i = 0; i < block; ++i) {
+                        float expected = 0.0f;
+                        for (size_t tap = 0; tap < 3; ++tap) {
+                            expected += tap_gains[tap] * (input[i] - tap_delays[tap]);
+                        }
+                        assert(std::abs(output[i] - expected) < 1e-3f);
+                    }
+                }
+            }
+
+            line.advance(block);
+        }
+
+        // Delays are clamped to the maximum
+        line.read(0, 1000.0f, output.data(), block, gw::core::DelayInterpolation::None);
+        assert(output[0] == input[block - 1] + 1.0f - 40.0f);
+    }
+
+    std::cout << "  - Modulated and multi-tap reads: OK" << std::endl;
+
+    // Test CompensationDelay as a processor
+    {
+        gw::core::CompensationDelay delay(7);
+        assert(delay.get_latency_samples() == 7);
+        delay.prepare(48000.0, 16, 1);
+
+        gw::core::AudioBuffer buffer(1, 16);
+        buffer.set_sample(0, 0, 1.0f);
+        gw::core::BufferView view(buffer, 0);
+        delay.process(&view, 1);
+
+        for (size_t i = 0; i < 16; ++i) {
+            assert(buffer.get_sample(0, i) == (i == 7 ? 1.0f : 0.0f));
+        }
+
+        // Zero delay passes audio straight through
+        gw::core::CompensationDelay none;
+        none.prepare(48000.0, 16, 1);
+        none.process(&view, 1);
+        assert(buffer.get_sample(0, 7) == 1.0f);
+    }
+
+    std::cout << "  - CompensationDelay: OK" << std::endl;
+
+    // Test LatencyCompensator lines up a limited path with a dry one
+    {
+        const std::vector<size_t> delays = gw::core::compute_compensation_delays({10, 0, 4});
+        assert(delays.size() == 3);
+        assert(delays[0] == 0 && delays[1] == 10 && delays[2] == 6);
+
+        gw::core::ProcessorChain wet;
+        gw::core::ProcessorChain dry;
+
+        gw::core::LimiterSettings settings;
+        settings.ceiling_db = -1.0f;
+        settings.lookahead_ms = 2.0f;
+        wet.add(std::make_unique<gw::core::PeakLimiter>(settings));
+
+        gw::core::LatencyCompensator compensator;
+        const size_t wet_path = compensator.add_path(wet);
+        const size_t dry_path = compensator.add_path(dry);
+        assert(wet_path == 0 && dry_path == 1);
+        assert(compensator.get_num_paths() == 2);
+
+        const size_t block = 256;
+        wet.prepare(48000.0, block, 1);
+        dry.prepare(48000.0, block, 1);
+
+        const size_t latency = compensator.update();
+        assert(latency == 96);
+        assert(compensator.get_path_delay(0) == 0);
+        assert(compensator.get_path_delay(1) == 96);
+
+        // Updating again does not count the compensation as latency
+        const size_t again = compensator.update();
+        assert(again == 96);
+        assert(compensator.get_path_delay(1) == 96);
+        assert(wet.get_latency_samples() == dry.get_latency_samples());
+
+        wet.prepare(48000.0, block, 1);
+        dry.prepare(48000.0, block, 1);
+
+        gw::core::AudioBuffer wet_buffer(1, block);
+        gw::core::AudioBuffer dry_buffer(1, block);
+        wet_buffer.set_sample(0, 10, 0.1f);
+        dry_buffer.set_sample(0, 10, 0.1f);
+        wet.process(wet_buffer, block);
+        dry.process(dry_buffer, block);
+
+        size_t wet_peak = 0;
+        size_t dry_peak = 0;
+        for (size_t i = 0; i < block; ++i) {
+            if (std::abs(wet_buffer.get_sample(0, i)) > std::abs(wet_buffer.get_sample(0, wet_peak))) wet_peak = i;
+            if (std::abs(dry_buffer.get_sample(0, i)) > std::abs(dry_buffer.get_sample(0, dry_peak))) dry_peak = i;
+        }
+        assert(dry_peak == 10 + latency);
+        assert(wet_peak == dry_peak);
+    }
+
+    std::cout << "  - LatencyCompensator: OK" << std::endl;
+}
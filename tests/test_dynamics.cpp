@@ -0,0 +1,116 @@
+#include <gw/core/dynamics.h>
+#include <gw/core/sliding_window_max.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+void test_dynamics() {
+    // Test the sliding window max against a naive scan
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<float> input(5000);
+    for (auto &value: input) value = dist(rng);
+
+    for (const size_t window: {1u, 2u, 7u, 64u, 480u}) {
+        gw::core::SlidingWindowMax max(480);
+        max.set_window(window);
+        assert(max.get_window() == window);
+
+        for (size_t i = 0; i < input.size(); ++i) {
+            const size_t first = i + 1 >= window ? i + 1 - window : 0;
+            const float expected = *std::max_element(input.begin() + static_cast<long>(first),
+                                                     input.begin() + static_cast<long>(i) + 1);
+            assert(max.push(input[i]) == expected);
+        }
+    }
+
+    std::cout << "  - Sliding window max: OK" << std::endl;
+
+    // Test the limiter never lets a sample above the ceiling
+    const double sample_rate = 48000.0;
+    gw::core::LimiterSettings limiter_settings;
+    limiter_settings.ceiling_db = -6.0f;
+    limiter_settings.lookahead_ms = 2.0f;
+    gw::core::PeakLimiter limiter(limiter_settings);
+    limiter.prepare(sample_rate, 256, 2);
+
+    const size_t latency = limiter.get_latency_samples();
+    assert(latency == 96);
+
+    const float ceiling = std::pow(10.0f, -6.0f / 20.0f);
+    gw::core::AudioBuffer buffer(2, 256);
+    std::vector<float> original;
+
+    for (size_t block = 0; block < 40; ++block) {
+        for (size_t i = 0; i < 256; ++i) {
+            // Loud bursts with occasional isolated spikes
+            const float spike = (dist(rng) > 0.995f) ? 4.0f : 1.0f;
+            const float sample = (dist(rng) * 2.0f - 1.0f) * spike * (block % 4 == 0 ? 0.1f : 1.5f);
+            buffer.set_sample(0, i, sample);
+            buffer.set_sample(1, i, sample * 0.5f);
+        }
+
+        gw::core::BufferView views[2] = {{buffer, 0}, {buffer, 1}};
+        limiter.process(views, 2);
+
+        for (size_t i = 0; i < 256; ++i) {
+            assert(std::fabs(buffer.get_sample(0, i)) <= ceiling * 1.0001f);
+            assert(std::fabs(buffer.get_sample(1, i)) <= ceiling * 1.0001f);
+        }
+    }
+    assert(limiter.get_gain_reduction_db() < 0.0f);
+
+    std::cout << "  - Limiter ceiling: OK" << std::endl;
+
+    // Test quiet material passes through, delayed by the latency
+    limiter.reset();
+    gw::core::AudioBuffer quiet(2, 256);
+    quiet.set_sample(0, 10, 0.25f);
+    gw::core::BufferView quiet_views[2] = {{quiet, 0}, {quiet, 1}};
+    limiter.process(quiet_views, 2);
+    assert(quiet.get_sample(0, 10 + latency) == 0.25f);
+    assert(quiet.get_sample(0, 10) == 0.0f);
+
+    std::cout << "  - Limiter latency: OK" << std::endl;
+
+    // Test the compressor reaches the static curve on a steady signal
+    gw::core::CompressorSettings compressor_settings;
+    compressor_settings.threshold_db = -20.0f;
+    compressor_settings.ratio = 4.0f;
+    compressor_settings.knee_db = 0.0f;
+    compressor_settings.link = gw::core::ChannelLink::Independent;
+    gw::core::Compressor compressor(compressor_settings);
+    compressor.prepare(sample_rate, 512, 2);
+    assert(compressor.get_latency_samples() == 0);
+
+    gw::core::AudioBuffer steady(2, 512);
+    for (size_t block = 0; block < 100; ++block) {
+        gw::core::BufferView(steady, 0).fill(1.0f); // 0 dBFS: 20 dB over, 15 dB reduction
+        gw::core::BufferView(steady, 1).fill(0.01f); // -40 dBFS: untouched
+        gw::core::BufferView views[2] = {{steady, 0}, {steady, 1}};
+        compressor.process(views, 2);
+    }
+
+    assert(std::fabs(steady.get_sample(0, 511) - std::pow(10.0f, -15.0f / 20.0f)) < 1.0e-3f);
+    assert(std::fabs(steady.get_sample(1, 511) - 0.01f) < 1.0e-6f);
+
+    std::cout << "  - Compressor static curve: OK" << std::endl;
+
+    // Test linking: the loud channel pulls the quiet one down too
+    compressor_settings.link = gw::core::ChannelLink::Linked;
+    gw::core::Compressor linked(compressor_settings);
+    linked.prepare(sample_rate, 512, 2);
+    for (size_t block = 0; block < 100; ++block) {
+        gw::core::BufferView(steady, 0).fill(1.0f);
+        gw::core::BufferView(steady, 1).fill(0.01f);
+        gw::core::BufferView views[2] = {{steady, 0}, {steady, 1}};
+        linked.process(views, 2);
+    }
+    assert(std::fabs(steady.get_sample(1, 511) - 0.01f * std::pow(10.0f, -15.0f / 20.0f)) < 1.0e-4f);
+
+    std::cout << "  - Compressor linking: OK" << std::endl;
+}
@@ -0,0 +1,64 @@
+#include <gw/core/fft.h>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <random>
+#include <vector>
+
+void test_fft() {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    const double pi = std::acos(-1.0);
+
+    for (const size_t size: {4u, 16u, 256u}) {
+        gw::core::RealFft fft(size);
+        assert(fft.get_size() == size);
+        assert(fft.get_num_bins() == size / 2 + 1);
+
+        std::vector<float> input(size);
+        for (auto &sample: input) sample = dist(rng);
+
+        std::vector<std::complex<float> > bins(fft.get_num_bins());
+        fft.forward(input.data(), bins.data());
+
+        // Test against a direct DFT
+        for (size_t k = 0; k < bins.size(); ++k) {
+            std::complex<double> expected(0.0, 0.0);
+            for (size_t n = 0; n < size; ++n) {
+                const double angle = -2.0 * pi * static_cast<double>(k * n) / static_cast<double>(size);
+                expected += static_cast<double>(input[n]) * std::complex<double>(std::cos(angle), std::sin(angle));
+            }
+            assert(std::abs(std::complex<double>(bins[k]) - expected) < 1.0e-3);
+        }
+
+        // Test the round trip
+        std::vector<float> output(size);
+        fft.inverse(bins.data(), output.data());
+        for (size_t n = 0; n < size; ++n) {
+            assert(std::fabs(output[n] - input[n]) < 1.0e-5f);
+        }
+    }
+
+    std::cout << "  - Forward against DFT: OK" << std::endl;
+    std::cout << "  - Inverse round trip: OK" << std::endl;
+
+    // Non power-of-two sizes round up
+    const gw::core::RealFft rounded(1000);
+    assert(rounded.get_size() == 1024);
+
+    std::cout << "  - Size rounding: OK" << std::endl;
+
+    // Instances of one size share a plan, which goes away with the last of them
+    {
+        const size_t before = gw::core::RealFft::get_cached_plan_count();
+        {
+            const gw::core::RealFft first(8192);
+            const gw::core::RealFft second(8192);
+            assert(gw::core::RealFft::get_cached_plan_count() == before + 1);
+        }
+        assert(gw::core::RealFft::get_cached_plan_count() == before);
+    }
+
+    std::cout << "  - Plan cache: OK" << std::endl;
+}
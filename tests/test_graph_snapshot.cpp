@@ -0,0 +1,227 @@
+#include <gw/core/graph_snapshot.h>
+#include <unistd.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct GainState {
+        double smoothed;
+        uint32_t mode;
+    };
+
+    // Input -> two gains in parallel -> mixer
+    gw::core::GraphSnapshotWriter make_graph() {
+        gw::core::GraphSnapshotWriter writer;
+
+        const uint32_t input = writer.add_node(1, "input", 0, 2, nullptr, 0, nullptr, 0);
+
+        const float left_parameters[] = {0.5f, -3.0f};
+        const GainState left_state{0.25, 7};
+        const uint32_t left = writer.add_node(2, "gain L", 1, 1, left_parameters, 2, &left_state,
+                                              sizeof(left_state));
+
+        const float right_parameters[] = {0.75f, 1.0f};
+        const GainState right_state{0.125, 9};
+        const uint32_t right = writer.add_node(2, "gain R", 1, 1, right_parameters, 2, &right_state,
+                                               sizeof(right_state), 1);
+
+        const float mixer_parameters[] = {1.0f};
+        const uint32_t mixer = writer.add_node(3, "mixer", 2, 2, mixer_parameters, 1, nullptr, 0);
+
+        bool ok = writer.connect(input, 0, left, 0);
+        ok = writer.connect(input, 1, right, 0) && ok;
+        ok = writer.connect(left, 0, mixer, 0) && ok;
+        ok = writer.connect(right, 0, mixer, 1) && ok;
+        assert(ok);
+        return writer;
+    }
+
+    void check_graph(const gw::core::GraphSnapshot &snapshot) {
+        assert(snapshot.is_valid());
+        assert(snapshot.get_num_nodes() == 4 && snapshot.get_num_connections() == 4);
+
+        const gw::core::SnapshotNode *nodes = snapshot.get_nodes();
+        assert(nodes[0].type_id == 1 && nodes[0].num_outputs == 2 && nodes[0].parameter_count == 0);
+        assert(nodes[2].flags == 1 && nodes[3].num_inputs == 2);
+
+        assert(snapshot.get_name(1) == "gain L" && snapshot.get_name(3) == "mixer");
+        assert(snapshot.get_parameters(1)[1] == -3.0f && snapshot.get_parameters(2)[0] == 0.75f);
+        assert(snapshot.get_parameters(3)[0] == 1.0f);
+
+        // State blobs are aligned, so they can be read in place
+        assert(reinterpret_cast<uintptr_t>(snapshot.get_state(2)) % 16 == 0);
+        const auto *state = reinterpret_cast<const GainState *>(snapshot.get_state(2));
+        assert(state->smoothed == 0.125 && state->mode == 9);
+
+        const gw::core::SnapshotConnection &connection = snapshot.get_connections()[3];
+        assert(connection.source_node == 2 && connection.dest_node == 3 && connection.dest_port == 1);
+    }
+}
+
+void test_graph_snapshot() {
+    const gw::core::GraphSnapshotWriter writer = make_graph();
+
+    // Test the writer rejects connections to missing nodes or ports
+    {
+        gw::core::GraphSnapshotWriter invalid = make_graph();
+        assert(!invalid.connect(0, 2, 1, 0)); // Input has two outputs
+        assert(!invalid.connect(0, 0, 9, 0));
+        assert(!invalid.connect(1, 0, 0, 0)); // Input has no inputs
+    }
+
+    std::cout << "  - Writer validation: OK" << std::endl;
+
+    // Test an image in memory opens in place
+    {
+        gw::core::SnapshotArena arena(writer.get_image_size());
+        assert(writer.write(arena.get_data(), arena.get_capacity() - 64) == 0);
+        assert(writer.write(arena.get_data(), arena.get_capacity()) == writer.get_image_size());
+
+        gw::core::GraphSnapshot snapshot;
+        assert(snapshot.open(arena.get_data(), writer.get_image_size(), true));
+        check_graph(snapshot);
+        assert(snapshot.get_header()->version_major == gw::core::SNAPSHOT_VERSION_MAJOR);
+    }
+
+    std::cout << "  - In-memory image: OK" << std::endl;
+
+    // Test loading from a file into an arena and by mapping it
+    {
+        const std::string path = "/tmp/gw-graph-snapshot-test-" + std::to_string(getpid()) + ".gwgs";
+        assert(writer.save(path));
+
+        gw::core::SnapshotArena arena(1 << 16);
+        assert(arena.load(path, true));
+        assert(arena.get_size() == writer.get_image_size());
+        check_graph(arena.get_snapshot());
+
+        // The arena copy is the live session's: parameters are writable
+        arena.get_parameters(1)[0] = 0.9f;
+        assert(arena.get_snapshot().get_parameters(1)[0] == 0.9f);
+
+        gw::core::MappedSnapshot mapped;
+        assert(mapped.open(path, true));
+        check_graph(mapped.get_snapshot());
+        mapped.close();
+        assert(!mapped.get_snapshot().is_valid());
+
+        // Too small an arena fails cleanly
+        gw::core::SnapshotArena small(256);
+        assert(!small.load(path));
+        assert(!small.get_snapshot().is_valid());
+
+        std::remove(path.c_str());
+        assert(!mapped.open(path));
+    }
+
+    std::cout << "  - File loading: OK" << std::endl;
+
+    // Test malformed images are rejected
+    {
+        const size_t size = writer.get_image_size();
+        gw::core::SnapshotArena original(size);
+        writer.write(original.get_data(), size);
+
+        gw::core::SnapshotArena arena(size);
+        gw::core::GraphSnapshot snapshot;
+
+        const auto corrupt = [&](size_t offset, const void *value, size_t bytes) {
+            std::memcpy(arena.get_data(), original.get_data(), size);
+            std::memcpy(arena.get_data() + offset, value, bytes);
+        };
+
+        // Baseline opens
+        std::memcpy(arena.get_data(), original.get_data(), size);
+        assert(snapshot.open(arena.get_data(), size, true));
+
+        // Truncated
+        assert(!snapshot.open(arena.get_data(), size - 64));
+        assert(!snapshot.is_valid());
+
+        // Wrong magic, major version and byte order
+        const uint32_t bad_magic = 0x12345678;
+        corrupt(offsetof(gw::core::SnapshotHeader, magic), &bad_magic, 4);
+        assert(!snapshot.open(arena.get_data(), size));
+
+        const uint16_t next_major = gw::core::SNAPSHOT_VERSION_MAJOR + 1;
+        corrupt(offsetof(gw::core::SnapshotHeader, version_major), &next_major, 2);
+        assert(!snapshot.open(arena.get_data(), size));
+
+        const uint32_t swapped = 0x04030201;
+        corrupt(offsetof(gw::core::SnapshotHeader, byte_order), &swapped, 4);
+        assert(!snapshot.open(arena.get_data(), size));
+
+        // A newer minor version still opens
+        const uint16_t next_minor = gw::core::SNAPSHOT_VERSION_MINOR + 1;
+        corrupt(offsetof(gw::core::SnapshotHeader, version_minor), &next_minor, 2);
+        assert(snapshot.open(arena.get_data(), size));
+
+        // A node pointing past the parameters, and a connection to a missing port
+        gw::core::GraphSnapshot reference;
+        const bool opened = reference.open(original.get_data(), size);
+        assert(opened);
+        const size_t nodes_offset = static_cast<size_t>(
+            reinterpret_cast<const uint8_t *>(reference.get_nodes()) - original.get_data());
+        const size_t connections_offset = static_cast<size_t>(
+            reinterpret_cast<const uint8_t *>(reference.get_connections()) - original.get_data());
+
+        const uint64_t bad_index = 1000;
+        corrupt(nodes_offset + sizeof(gw::core::SnapshotNode) + offsetof(gw::core::SnapshotNode, parameter_index),
+                &bad_index, 8);
+        assert(!snapshot.open(arena.get_data(), size));
+
+        const uint32_t bad_port = 5;
+        corrupt(connections_offset + offsetof(gw::core::SnapshotConnection, dest_port), &bad_port, 4);
+        assert(!snapshot.open(arena.get_data(), size));
+
+        // A flipped parameter only shows up with the checksum
+        const float changed = 42.0f;
+        const size_t parameter_offset = static_cast<size_t>(
+            reinterpret_cast<const uint8_t *>(reference.get_parameters(1)) - original.get_data());
+        corrupt(parameter_offset, &changed, 4);
+        assert(snapshot.open(arena.get_data(), size, false));
+        assert(!snapshot.open(arena.get_data(), size, true));
+
+        // Misaligned images are refused rather than read unaligned
+        std::vector<uint8_t> shifted(size + 8);
+        assert(!snapshot.open(shifted.data() + (reinterpret_cast<uintptr_t>(shifted.data()) % 64 == 0 ? 8 : 0),
+                              size));
+    }
+
+    std::cout << "  - Malformed images: OK" << std::endl;
+
+    // Test a large session round-trips
+    {
+        gw::core::GraphSnapshotWriter large;
+        std::vector<float> parameters(32);
+        std::vector<uint8_t> state(200);
+
+        for (uint32_t i = 0; i < 2000; ++i) {
+            for (size_t p = 0; p < parameters.size(); ++p) parameters[p] = static_cast<float>(i * 100 + p);
+            state[0] = static_cast<uint8_t>(i);
+            large.add_node(i % 7, "node " + std::to_string(i), 2, 2, parameters.data(), parameters.size(),
+                           state.data(), state.size());
+            if (i > 0) {
+                const bool ok = large.connect(i - 1, 0, i, 0);
+                assert(ok);
+            }
+        }
+
+        gw::core::SnapshotArena arena(large.get_image_size());
+        large.write(arena.get_data(), arena.get_capacity());
+
+        gw::core::GraphSnapshot snapshot;
+        assert(snapshot.open(arena.get_data(), large.get_image_size()));
+        assert(snapshot.get_num_nodes() == 2000 && snapshot.get_num_connections() == 1999);
+        assert(snapshot.get_parameters(1234)[31] == 123431.0f);
+        assert(snapshot.get_state(1999)[0] == static_cast<uint8_t>(1999));
+        assert(snapshot.get_name(1500) == "node 1500");
+    }
+
+    std::cout << "  - Large session: OK" << std::endl;
+}
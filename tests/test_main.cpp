@@ -9,26 +9,146 @@ void test_buffer_view();
 
 void test_ring_buffer();
 
+void test_sample_convert();
+
+void test_processor();
+
+void test_pcm_codec();
+
+void test_offline_renderer();
+
+void test_dynamics();
+
+void test_fft();
+
+void test_metering();
+
+void test_delay_line();
+
+void test_rt();
+
+#ifdef GW_CORE_HAS_UDP_TRANSPORT
+void test_udp_transport();
+#endif
+
+#ifdef GW_CORE_HAS_SAMPLE_CACHE
+void test_sample_cache();
+#endif
+
+void test_voice_engine();
+
+void test_stft();
+
+void test_automation();
+
+void test_graph_snapshot();
+
+void test_oversampler();
+
+void test_ambisonics();
+
+void test_processor_abi();
+
 int main() {
     std::cout << "=== Running GhostWire Core Tests ===" << std::endl;
 
     try {
-        std::cout << "\n[1/4] Testing AudioFormat..." << std::endl;
+        std::cout << "\n[1/22] Testing AudioFormat..." << std::endl;
         test_audio_format();
         std::cout << "  ✓ AudioFormat tests passed" << std::endl;
 
-        std::cout << "\n[2/4] Testing AudioBuffer..." << std::endl;
+        std::cout << "\n[2/22] Testing AudioBuffer..." << std::endl;
         test_audio_buffer();
         std::cout << "  ✓ AudioBuffer tests passed" << std::endl;
 
-        std::cout << "\n[3/4] Testing BufferView..." << std::endl;
+        std::cout << "\n[3/22] Testing BufferView..." << std::endl;
         test_buffer_view();
         std::cout << "  ✓ BufferView tests passed" << std::endl;
 
-        std::cout << "\n[4/4] Testing RingBuffer..." << std::endl;
+        std::cout << "\n[4/22] Testing RingBuffer..." << std::endl;
         test_ring_buffer();
         std::cout << "  ✓ RingBuffer tests passed" << std::endl;
 
+        std::cout << "\n[5/22] Testing sample conversion..." << std::endl;
+        test_sample_convert();
+        std::cout << "  ✓ Sample conversion tests passed" << std::endl;
+
+        std::cout << "\n[6/22] Testing ProcessorChain..." << std::endl;
+        test_processor();
+        std::cout << "  ✓ ProcessorChain tests passed" << std::endl;
+
+        std::cout << "\n[7/22] Testing PCM codec..." << std::endl;
+        test_pcm_codec();
+        std::cout << "  ✓ PCM codec tests passed" << std::endl;
+
+        std::cout << "\n[8/22] Testing OfflineRenderer..." << std::endl;
+        test_offline_renderer();
+        std::cout << "  ✓ OfflineRenderer tests passed" << std::endl;
+
+        std::cout << "\n[9/22] Testing Dynamics..." << std::endl;
+        test_dynamics();
+        std::cout << "  ✓ Dynamics tests passed" << std::endl;
+
+        std::cout << "\n[10/22] Testing RealFft..." << std::endl;
+        test_fft();
+        std::cout << "  ✓ RealFft tests passed" << std::endl;
+
+        std::cout << "\n[11/22] Testing Metering..." << std::endl;
+        test_metering();
+        std::cout << "  ✓ Metering tests passed" << std::endl;
+
+        std::cout << "\n[12/22] Testing DelayLine..." << std::endl;
+        test_delay_line();
+        std::cout << "  ✓ DelayLine tests passed" << std::endl;
+
+        std::cout << "\n[13/22] Testing Real-time setup..." << std::endl;
+        test_rt();
+        std::cout << "  ✓ Real-time setup tests passed" << std::endl;
+
+        std::cout << "\n[14/22] Testing UDP transport..." << std::endl;
+#ifdef GW_CORE_HAS_UDP_TRANSPORT
+        test_udp_transport();
+        std::cout << "  ✓ UDP transport tests passed" << std::endl;
+#else
+        std::cout << "  - skipped (GW_CORE_UDP_TRANSPORT is off)" << std::endl;
+#endif
+
+        std::cout << "\n[15/22] Testing Sample cache..." << std::endl;
+#ifdef GW_CORE_HAS_SAMPLE_CACHE
+        test_sample_cache();
+        std::cout << "  ✓ Sample cache tests passed" << std::endl;
+#else
+        std::cout << "  - skipped (GW_CORE_SAMPLE_CACHE is off)" << std::endl;
+#endif
+
+        std::cout << "\n[16/22] Testing Voice engine..." << std::endl;
+        test_voice_engine();
+        std::cout << "  ✓ Voice engine tests passed" << std::endl;
+
+        std::cout << "\n[17/22] Testing STFT..." << std::endl;
+        test_stft();
+        std::cout << "  ✓ STFT tests passed" << std::endl;
+
+        std::cout << "\n[18/22] Testing Automation..." << std::endl;
+        test_automation();
+        std::cout << "  ✓ Automation tests passed" << std::endl;
+
+        std::cout << "\n[19/22] Testing Graph snapshot..." << std::endl;
+        test_graph_snapshot();
+        std::cout << "  ✓ Graph snapshot tests passed" << std::endl;
+
+        std::cout << "\n[20/22] Testing Oversampler..." << std::endl;
+        test_oversampler();
+        std::cout << "  ✓ Oversampler tests passed" << std::endl;
+
+        std::cout << "\n[21/22] Testing Ambisonics..." << std::endl;
+        test_ambisonics();
+        std::cout << "  ✓ Ambisonics tests passed" << std::endl;
+
+        std::cout << "\n[22/22] Testing Processor ABI..." << std::endl;
+        test_processor_abi();
+        std::cout << "  ✓ Processor ABI tests passed" << std::endl;
+
         std::cout << "\n=== All tests passed! ===" << std::endl;
         return 0;
     } catch (const std::exception &e) {
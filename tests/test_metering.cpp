@@ -0,0 +1,191 @@
+#include <gw/core/metering.h>
+#include <gw/core/seqlock.h>
+#include <gw/core/triple_buffer.h>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct Pair {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    // Fill a stereo buffer with a sine, continuing from sample index `start`
+    void fill_sine(gw::core::AudioBuffer &buffer, size_t start, float frequency, float amplitude, double sample_rate) {
+        const double pi = std::acos(-1.0);
+        for (size_t i = 0; i < buffer.get_num_samples(); ++i) {
+            const double phase = 2.0 * pi * static_cast<double>(frequency) * static_cast<double>(start + i) / sample_rate;
+            const auto value = static_cast<float>(static_cast<double>(amplitude) * std::sin(phase));
+            for (size_t ch = 0; ch < buffer.get_num_channels(); ++ch) {
+                buffer.set_sample(ch, i, value);
+            }
+        }
+    }
+}
+
+void test_metering() {
+    // Test the seqlock never hands out a torn value
+    {
+        gw::core::Seqlock<Pair> lock;
+        std::thread writer([&lock] {
+            for (uint32_t i = 1; i <= 200000; ++i) {
+                lock.store({i, ~i});
+            }
+        });
+
+        for (int i = 0; i < 200000; ++i) {
+            const Pair value = lock.load();
+            assert(value.b == ~value.a || (value.a == 0 && value.b == 0));
+        }
+        writer.join();
+        assert(lock.get_version() == 200000);
+    }
+
+    std::cout << "  - Seqlock: OK" << std::endl;
+
+    // Test the triple buffer hands over the latest value only
+    {
+        gw::core::TripleBuffer<int> triple(0);
+        assert(!triple.update());
+
+        triple.get_write_buffer() = 1;
+        triple.publish();
+        triple.get_write_buffer() = 2;
+        triple.publish();
+
+        assert(triple.update());
+        assert(triple.get_read_buffer() == 2);
+        assert(!triple.update());
+    }
+
+    std::cout << "  - Triple buffer: OK" << std::endl;
+
+    // Test block peak/RMS publishing
+    const double sample_rate = 48000.0;
+    gw::core::MeterTapSettings settings;
+    settings.window_ms = 10.0f; // 480 samples
+    gw::core::MeterTap tap(settings);
+    tap.prepare(sample_rate, 256, 2);
+
+    gw::core::AudioBuffer block(2, 256);
+    gw::core::BufferView views[2] = {{block, 0}, {block, 1}};
+
+    gw::core::BufferView(block, 0).fill(0.5f);
+    gw::core::BufferView(block, 1).fill(-0.25f);
+    block.set_sample(1, 100, 0.9f);
+
+    tap.process(views, 2); // 256 of 480: nothing published yet
+    assert(tap.get_levels().window_index == 0);
+
+    tap.process(views, 2); // Window complete
+    const gw::core::MeterLevels levels = tap.get_levels();
+    assert(levels.window_index == 1);
+    assert(levels.num_channels == 2);
+    assert(levels.peak[0] == 0.5f);
+    assert(levels.peak[1] == 0.9f);
+    assert(std::fabs(levels.rms[0] - 0.5f) < 1.0e-6f);
+    assert(block.get_sample(0, 0) == 0.5f); // Audio untouched
+
+    std::cout << "  - Peak/RMS tap: OK" << std::endl;
+
+    // Test EBU R128: a stereo 997 Hz sine at -23 dBFS measures -23 LUFS
+    {
+        gw::core::LoudnessMeter meter(sample_rate, 2);
+        gw::core::AudioBuffer sine(2, 4800);
+        const float amplitude = std::pow(10.0f, -23.0f / 20.0f);
+
+        for (size_t start = 0; start < 48000 * 4; start += 4800) {
+            fill_sine(sine, start, 997.0f, amplitude, sample_rate);
+            const float *pointers[2] = {sine.get_channel_data(0), sine.get_channel_data(1)};
+            meter.process(pointers, 4800);
+        }
+
+        const gw::core::LoudnessReading reading = meter.get_reading();
+        assert(std::fabs(reading.momentary + 23.0f) < 0.1f);
+        assert(std::fabs(reading.short_term + 23.0f) < 0.1f);
+        assert(std::fabs(reading.integrated + 23.0f) < 0.1f);
+    }
+
+    // Test the relative gate: 10 s at -20 LUFS, then 10 s at -40 LUFS that falls below it
+    {
+        gw::core::LoudnessMeter meter(sample_rate, 2);
+        gw::core::AudioBuffer sine(2, 4800);
+
+        for (size_t start = 0; start < 48000 * 20; start += 4800) {
+            const float level = start < 48000 * 10 ? -20.0f : -40.0f;
+            fill_sine(sine, start, 997.0f, std::pow(10.0f, level / 20.0f), sample_rate);
+            const float *pointers[2] = {sine.get_channel_data(0), sine.get_channel_data(1)};
+            meter.process(pointers, 4800);
+        }
+
+        const gw::core::LoudnessReading reading = meter.get_reading();
+        assert(std::fabs(reading.momentary + 40.0f) < 0.1f);
+        assert(std::fabs(reading.integrated + 20.0f) < 0.2f);
+
+        meter.reset();
+        assert(std::isinf(meter.get_reading().integrated));
+    }
+
+    std::cout << "  - LUFS: OK" << std::endl;
+
+    // Test the spectrum finds a sine in the right bin at the right level
+    {
+        gw::core::SpectrumAnalyzer analyzer(1024, 0.0f);
+        gw::core::AudioBuffer sine(1, 4096);
+        const float bin_frequency = static_cast<float>(sample_rate / 1024.0);
+        fill_sine(sine, 0, 64.0f * bin_frequency, 0.5f, sample_rate);
+
+        const bool updated = analyzer.process(sine.get_channel_data(0), 4096);
+        assert(updated);
+
+        const std::vector<float> &magnitudes = analyzer.get_magnitudes_db();
+        assert(std::fabs(magnitudes[64] - 20.0f * std::log10(0.5f)) < 0.1f);
+        assert(magnitudes[200] < -100.0f);
+    }
+
+    std::cout << "  - Spectrum: OK" << std::endl;
+
+    // Test the background analyzer end to end
+    {
+        gw::core::MeterTapSettings feed_settings;
+        feed_settings.analysis_seconds = 5.0f; // Holds the whole stream, however slow the analyzer thread is
+        gw::core::MeterTap feed_tap(feed_settings);
+        feed_tap.prepare(sample_rate, 4800, 2);
+
+        gw::core::MeterAnalyzer analyzer(1.0f);
+        gw::core::AnalysisSettings analysis;
+        analysis.spectrum_size = 512;
+        const int index = analyzer.attach(feed_tap, analysis);
+        assert(index == 0);
+        assert(analyzer.attach(tap) == -1); // No feed
+
+        analyzer.start();
+
+        gw::core::AudioBuffer sine(2, 4800);
+        gw::core::BufferView sine_views[2] = {{sine, 0}, {sine, 1}};
+        const float amplitude = std::pow(10.0f, -18.0f / 20.0f);
+        for (size_t start = 0; start < 48000 * 4; start += 4800) {
+            fill_sine(sine, start, 997.0f, amplitude, sample_rate);
+            feed_tap.process(sine_views, 2);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+
+        analyzer.stop();
+        analyzer.poll(); // Pick up anything left in the feeds
+
+        assert(feed_tap.get_analysis_overruns() == 0);
+        const gw::core::LoudnessReading reading = analyzer.get_loudness(index);
+        assert(std::fabs(reading.integrated + 18.0f) < 0.1f);
+
+        std::vector<float> spectrum;
+        const bool has_spectrum = analyzer.get_spectrum(index, spectrum);
+        assert(has_spectrum);
+        assert(spectrum.size() == 257);
+    }
+
+    std::cout << "  - Background analyzer: OK" << std::endl;
+}
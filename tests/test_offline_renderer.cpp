@@ -0,0 +1,141 @@
+#include <gw/core/offline_renderer.h>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+namespace {
+    // Delays the signal by a fixed number of samples and scales it
+    class DelayedGain : public gw::core::Processor {
+    public:
+        DelayedGain(size_t delay, float gain) : delay_(delay), gain_(gain) {
+        }
+
+        void prepare(double, size_t, size_t num_channels) override {
+            history_.assign(num_channels, std::vector<float>(delay_, 0.0f));
+        }
+
+        void process(gw::core::BufferView *channels, size_t num_channels) override {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                auto &history = history_[ch];
+                for (size_t i = 0; i < channels[ch].size(); ++i) {
+                    float out = channels[ch][i] * gain_;
+                    if (delay_ > 0) {
+                        std::swap(out, history[position_[ch] % delay_]);
+                        ++position_[ch];
+                    }
+                    channels[ch][i] = out;
+                }
+            }
+        }
+
+        void reset() override {
+            for (auto &history: history_) {
+                std::fill(history.begin(), history.end(), 0.0f);
+            }
+            position_[0] = position_[1] = 0;
+        }
+
+        [[nodiscard]] size_t get_latency_samples() const override { return delay_; }
+
+    private:
+        size_t delay_;
+        float gain_;
+        std::vector<std::vector<float> > history_;
+        size_t position_[2] = {0, 0};
+    };
+
+    gw::core::AudioBuffer make_ramp(size_t num_samples) {
+        gw::core::AudioBuffer buffer(2, num_samples);
+        for (size_t i = 0; i < num_samples; ++i) {
+            buffer.set_sample(0, i, static_cast<float>(i));
+            buffer.set_sample(1, i, -static_cast<float>(i));
+        }
+        return buffer;
+    }
+}
+
+void test_offline_renderer() {
+    const size_t length = 10000; // Not a multiple of the block size
+    const gw::core::AudioBuffer input = make_ramp(length);
+
+    gw::core::RenderConfig config;
+    config.block_size = 512;
+
+    // Test serial and pipelined renders produce the same, latency-compensated output
+    for (const bool pipelined: {false, true}) {
+        config.pipelined = pipelined;
+        const gw::core::OfflineRenderer renderer(config);
+
+        gw::core::BufferSource source(input, 48000.0);
+        gw::core::AudioBuffer output(2, length);
+        gw::core::BufferSink sink(output);
+        DelayedGain processor(700, 0.5f);
+
+        const gw::core::RenderStats stats = renderer.render(source, processor, sink);
+        assert(stats.ok);
+        assert(stats.frames_rendered == length);
+        assert(stats.realtime_factor > 0.0);
+
+        for (size_t i = 0; i < length; ++i) {
+            assert(output.get_sample(0, i) == 0.5f * static_cast<float>(i));
+            assert(output.get_sample(1, i) == -0.5f * static_cast<float>(i));
+        }
+    }
+
+    std::cout << "  - Serial and pipelined render: OK" << std::endl;
+
+    // Test that latency compensation can be turned off
+    config.compensate_latency = false;
+    {
+        const gw::core::OfflineRenderer renderer(config);
+        gw::core::BufferSource source(input, 48000.0);
+        gw::core::AudioBuffer output(2, length);
+        gw::core::BufferSink sink(output);
+        DelayedGain processor(10, 1.0f);
+
+        const gw::core::RenderStats stats = renderer.render(source, processor, sink);
+        assert(stats.frames_rendered == length);
+        assert(output.get_sample(0, 9) == 0.0f);
+        assert(output.get_sample(0, 10) == 0.0f);
+        assert(output.get_sample(0, 11) == 1.0f);
+    }
+
+    std::cout << "  - Uncompensated render: OK" << std::endl;
+
+    // Test concurrent stems
+    config.compensate_latency = true;
+    const gw::core::OfflineRenderer renderer(config);
+
+    std::vector<gw::core::BufferSource> sources;
+    std::vector<gw::core::AudioBuffer> outputs;
+    std::vector<gw::core::BufferSink> sinks;
+    std::vector<DelayedGain> processors;
+    sources.reserve(4);
+    outputs.reserve(4);
+    sinks.reserve(4);
+    processors.reserve(4);
+
+    std::vector<gw::core::RenderJob> jobs(4);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        sources.emplace_back(input, 48000.0);
+        outputs.emplace_back(2, length);
+        sinks.emplace_back(outputs.back());
+        processors.emplace_back(64 * i, static_cast<float>(i + 1));
+
+        jobs[i].source = &sources.back();
+        jobs[i].processor = &processors.back();
+        jobs[i].sink = &sinks.back();
+    }
+
+    const gw::core::RenderStats totals = renderer.render_all(jobs, 3);
+    assert(totals.ok);
+    assert(totals.frames_rendered == 4 * length);
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        assert(jobs[i].stats.frames_rendered == length);
+        assert(outputs[i].get_sample(0, 1234) == static_cast<float>(i + 1) * 1234.0f);
+    }
+
+    std::cout << "  - Concurrent stems: OK (batch realtime factor "
+            << static_cast<int>(totals.realtime_factor) << "x)" << std::endl;
+}
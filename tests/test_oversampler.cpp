@@ -0,0 +1,197 @@
+#include <gw/core/oversampler.h>
+#include <gw/core/fft.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+
+    // Hard clipper at +-0.5: a worst case for aliasing
+    class Clipper : public gw::core::Processor {
+    public:
+        explicit Clipper(size_t latency = 0) : latency_(latency) {
+        }
+
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override {
+            prepared_rate = sample_rate;
+            prepared_block = max_block_size;
+            static_cast<void>(num_channels);
+        }
+
+        void process(gw::core::BufferView *channels, size_t num_channels) override {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                float *data = channels[ch].data();
+                for (size_t i = 0; i < channels[ch].size(); ++i) {
+                    data[i] = std::clamp(data[i], -0.5f, 0.5f);
+                }
+            }
+        }
+
+        [[nodiscard]] size_t get_latency_samples() const override { return latency_; }
+
+        double prepared_rate = 0.0;
+        size_t prepared_block = 0;
+
+    private:
+        size_t latency_;
+    };
+
+    std::vector<float> make_sine(double frequency, size_t size, double amplitude = 0.9) {
+        const double pi = std::acos(-1.0);
+        std::vector<float> signal(size);
+        for (size_t n = 0; n < size; ++n) {
+            signal[n] = static_cast<float>(amplitude * std::sin(2.0 * pi * frequency * static_cast<double>(n) /
+                                                                SAMPLE_RATE));
+        }
+        return signal;
+    }
+
+    // Run a mono signal through a processor in blocks of block_size
+    std::vector<float> run(gw::core::Processor &processor, std::vector<float> signal, size_t block_size) {
+        for (size_t offset = 0; offset < signal.size(); offset += block_size) {
+            gw::core::BufferView view(signal.data() + offset, std::min(block_size, signal.size() - offset));
+            processor.process(&view, 1);
+        }
+        return signal;
+    }
+
+    // Energy in the bins that are not harmonics of the fundamental bin
+    double alias_energy(const std::vector<float> &signal, size_t offset, size_t size, size_t fundamental) {
+        gw::core::RealFft fft(size);
+        std::vector<std::complex<float> > spectrum(size / 2 + 1);
+        fft.forward(signal.data() + offset, spectrum.data());
+
+        double energy = 0.0;
+        for (size_t k = 1; k < spectrum.size(); ++k) {
+            if (k % fundamental != 0) energy += std::norm(spectrum[k]);
+        }
+        return energy;
+    }
+}
+
+void test_oversampler() {
+    // Test factors and latencies are what the stage table gives
+    {
+        assert(gw::core::Oversampler::normalize_factor(1) == 2);
+        assert(gw::core::Oversampler::normalize_factor(3) == 4);
+        assert(gw::core::Oversampler::normalize_factor(64) == 16);
+
+        assert(gw::core::Oversampler::get_latency_for_factor(2) == 63);
+        assert(gw::core::Oversampler::get_latency_for_factor(4) == 71);
+
+        gw::core::Oversampler oversampler(8, 2, 256);
+        assert(oversampler.get_factor() == 8 && oversampler.get_num_stages() == 3);
+        assert(oversampler.get_latency_samples() == gw::core::Oversampler::get_latency_for_factor(8));
+        assert(oversampler.get_oversampled_buffer().get_num_samples() == 256 * 8);
+    }
+
+    std::cout << "  - Factors and latency: OK" << std::endl;
+
+    // Test a round trip returns the input delayed by exactly the latency, for
+    // every factor and uneven block sizes
+    {
+        const std::vector<float> input = make_sine(1000.0, 6000, 0.8);
+
+        for (const size_t factor: {2u, 4u, 8u, 16u}) {
+            gw::core::Oversampler oversampler(factor, 1, 256);
+            const size_t latency = oversampler.get_latency_samples();
+
+            std::vector<float> output(input);
+            const size_t block_sizes[] = {1, 256, 100, 37, 255};
+            size_t offset = 0;
+            size_t next = 0;
+            while (offset < output.size()) {
+                const size_t count = std::min(block_sizes[next++ % 5], output.size() - offset);
+                gw::core::BufferView view(output.data() + offset, count);
+                const size_t oversampled = oversampler.upsample(&view, 1);
+                assert(oversampled == count * factor);
+                oversampler.downsample(&view, 1);
+                offset += count;
+            }
+
+            for (size_t n = latency + 200; n < output.size(); ++n) {
+                assert(std::fabs(output[n] - input[n - latency]) < 1e-4f);
+            }
+        }
+    }
+
+    std::cout << "  - Round trip: OK" << std::endl;
+
+    // Test the upsampler removes the image: a 5 kHz tone upsampled 2x must
+    // not show up at 48 - 5 = 43 kHz
+    {
+        gw::core::Oversampler oversampler(2, 1, 4096);
+        std::vector<float> input = make_sine(5000.0, 4096);
+        gw::core::BufferView view(input.data(), input.size());
+        oversampler.upsample(&view, 1);
+        const float *upsampled = oversampler.get_oversampled_buffer().get_channel_data(0);
+
+        const double pi = std::acos(-1.0);
+        const auto correlate = [&](double frequency) {
+            // Hann-windowed, so the tone's own leakage stays below the image
+            double re = 0.0, im = 0.0;
+            for (size_t n = 0; n < 7168; ++n) {
+                const double window = 0.5 - 0.5 * std::cos(2.0 * pi * static_cast<double>(n) / 7168.0);
+                const double phase = 2.0 * pi * frequency * static_cast<double>(n) / (2.0 * SAMPLE_RATE);
+                re += window * upsampled[n + 1024] * std::cos(phase);
+                im += window * upsampled[n + 1024] * std::sin(phase);
+            }
+            return std::hypot(re, im);
+        };
+
+        const double tone = correlate(5000.0);
+        const double image = correlate(43000.0);
+        assert(tone > 1000.0);
+        assert(20.0 * std::log10(image / tone) < -85.0);
+    }
+
+    std::cout << "  - Image rejection: OK" << std::endl;
+
+    // Test a wrapped clipper aliases far less than the same clipper at the
+    // base rate. The tone sits on bin 397 of 4096, so every harmonic is on a
+    // multiple of it and every aliased harmonic is not.
+    {
+        const size_t size = 4096;
+        const size_t fundamental = 397;
+        const std::vector<float> input = make_sine(SAMPLE_RATE * fundamental / size, 3 * size);
+
+        Clipper direct;
+        const std::vector<float> direct_output = run(direct, input, 512);
+        const double direct_alias = alias_energy(direct_output, size, size, fundamental);
+
+        auto clipper = std::make_unique<Clipper>();
+        Clipper *inner = clipper.get();
+        gw::core::OversampledProcessor oversampled(std::move(clipper), 8);
+        oversampled.prepare(SAMPLE_RATE, 512, 1);
+        assert(inner->prepared_rate == SAMPLE_RATE * 8 && inner->prepared_block == 512 * 8);
+
+        const std::vector<float> output = run(oversampled, input, 512);
+        const double oversampled_alias = alias_energy(output, size, size, fundamental);
+
+        assert(10.0 * std::log10(oversampled_alias / direct_alias) < -30.0);
+    }
+
+    std::cout << "  - Wrapped processor: OK" << std::endl;
+
+    // Test latency reporting and reset
+    {
+        gw::core::OversampledProcessor oversampled(std::make_unique<Clipper>(10), 4);
+        assert(oversampled.get_latency_samples() == gw::core::Oversampler::get_latency_for_factor(4) + 3);
+        oversampled.prepare(SAMPLE_RATE, 128, 2);
+
+        const std::vector<float> input = make_sine(3000.0, 1024);
+        const std::vector<float> first = run(oversampled, input, 128);
+        oversampled.reset();
+        const std::vector<float> second = run(oversampled, input, 128);
+        for (size_t n = 0; n < first.size(); ++n) {
+            assert(first[n] == second[n]);
+        }
+    }
+
+    std::cout << "  - Latency and reset: OK" << std::endl;
+}
@@ -0,0 +1,83 @@
+#include <gw/core/pcm_codec.h>
+#include <gw/core/audio_io.h>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+void test_pcm_codec() {
+    gw::core::AudioBuffer source(2, 64);
+    for (size_t i = 0; i < 64; ++i) {
+        source.set_sample(0, i, std::sin(static_cast<float>(i) * 0.2f));
+        source.set_sample(1, i, -0.5f);
+    }
+
+    // Test 16-bit: interleaving, little-endian and clipping
+    const gw::core::AudioFormat format16(48000, 2, 16);
+    std::vector<uint8_t> bytes(64 * format16.get_bytes_per_frame());
+
+    source.set_sample(0, 0, 2.0f); // Clips to full scale
+    const size_t encoded = gw::core::encode_pcm(source, 0, 64, format16, bytes.data());
+    assert(encoded == bytes.size());
+    assert(bytes[0] == 0xff && bytes[1] == 0x7f); // Frame 0, channel 0 = 32767
+    assert(bytes[2] == 0x00 && bytes[3] == 0xc0); // Frame 0, channel 1 = -16384
+
+    gw::core::AudioBuffer decoded(2, 64);
+    const size_t frames = gw::core::decode_pcm(bytes.data(), 64, format16, decoded, 0);
+    assert(frames == 64);
+    for (size_t i = 1; i < 64; ++i) {
+        assert(std::fabs(decoded.get_sample(0, i) - source.get_sample(0, i)) < 1.0f / 32768.0f);
+        assert(decoded.get_sample(1, i) == -0.5f);
+    }
+
+    std::cout << "  - 16-bit round trip: OK" << std::endl;
+
+    // Test 24-bit sign extension and 32-bit float exactness
+    const gw::core::AudioFormat format24(48000, 2, 24);
+    bytes.resize(64 * format24.get_bytes_per_frame());
+    gw::core::encode_pcm(source, 0, 64, format24, bytes.data());
+    gw::core::decode_pcm(bytes.data(), 64, format24, decoded, 0);
+    assert(decoded.get_sample(1, 10) == -0.5f);
+    assert(std::fabs(decoded.get_sample(0, 10) - source.get_sample(0, 10)) < 1.0f / 8388608.0f);
+
+    const gw::core::AudioFormat format32(48000, 2, 32);
+    bytes.resize(64 * format32.get_bytes_per_frame());
+    gw::core::encode_pcm(source, 0, 64, format32, bytes.data());
+    gw::core::decode_pcm(bytes.data(), 64, format32, decoded, 0);
+    for (size_t i = 0; i < 64; ++i) {
+        assert(decoded.get_sample(0, i) == source.get_sample(0, i));
+    }
+
+    assert(!gw::core::is_pcm_format_supported(gw::core::AudioFormat(48000, 2, 12)));
+
+    std::cout << "  - 24/32-bit round trip: OK" << std::endl;
+
+    // Test the file source/sink
+    const std::string path = (std::filesystem::temp_directory_path() / "gw_core_test_pcm.raw").string();
+    {
+        gw::core::PcmFileSink sink(path, format24);
+        assert(sink.is_open());
+        const bool written = sink.write(source, 16, 48);
+        assert(written);
+    }
+    {
+        gw::core::PcmFileSource file_source(path, format24);
+        assert(file_source.is_open());
+        assert(file_source.get_num_channels() == 2);
+
+        gw::core::AudioBuffer block(2, 32);
+        size_t read_count = file_source.read(block, 32);
+        assert(read_count == 32);
+        assert(std::fabs(block.get_sample(0, 0) - source.get_sample(0, 16)) < 1.0e-6f);
+
+        read_count = file_source.read(block, 32);
+        assert(read_count == 16);
+        read_count = file_source.read(block, 32);
+        assert(read_count == 0);
+    }
+    std::remove(path.c_str());
+
+    std::cout << "  - PCM files: OK" << std::endl;
+}
@@ -0,0 +1,71 @@
+#include <gw/core/processor.h>
+#include <cassert>
+#include <iostream>
+#include <memory>
+
+namespace {
+    class TestGain : public gw::core::Processor {
+    public:
+        explicit TestGain(float gain, size_t latency = 0) : gain_(gain), latency_(latency) {
+        }
+
+        void prepare(double, size_t max_block_size, size_t num_channels) override {
+            prepared_block_size = max_block_size;
+            prepared_channels = num_channels;
+        }
+
+        void process(gw::core::BufferView *channels, size_t num_channels) override {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                for (size_t i = 0; i < channels[ch].size(); ++i) {
+                    channels[ch][i] *= gain_;
+                }
+            }
+        }
+
+        void reset() override { ++reset_count; }
+
+        [[nodiscard]] size_t get_latency_samples() const override { return latency_; }
+
+        size_t prepared_block_size = 0;
+        size_t prepared_channels = 0;
+        int reset_count = 0;
+
+    private:
+        float gain_;
+        size_t latency_;
+    };
+}
+
+void test_processor() {
+    gw::core::ProcessorChain chain;
+    auto *first = static_cast<TestGain *>(chain.add(std::make_unique<TestGain>(2.0f, 3)));
+    chain.add(std::make_unique<TestGain>(0.25f, 5));
+
+    assert(chain.size() == 2);
+    assert(chain.get_latency_samples() == 8);
+
+    chain.prepare(48000.0, 256, 2);
+    assert(first->prepared_block_size == 256);
+    assert(first->prepared_channels == 2);
+
+    std::cout << "  - Chain setup: OK" << std::endl;
+
+    // Process a buffer: both gains apply in order, only the first num_samples change
+    gw::core::AudioBuffer buffer(2, 256);
+    for (size_t i = 0; i < 256; ++i) {
+        buffer.set_sample(0, i, 1.0f);
+        buffer.set_sample(1, i, -4.0f);
+    }
+
+    chain.process(buffer, 128);
+    assert(buffer.get_sample(0, 0) == 0.5f);
+    assert(buffer.get_sample(1, 127) == -2.0f);
+    assert(buffer.get_sample(0, 128) == 1.0f);
+
+    std::cout << "  - Chain process: OK" << std::endl;
+
+    chain.reset();
+    assert(first->reset_count == 1);
+
+    std::cout << "  - Chain reset: OK" << std::endl;
+}
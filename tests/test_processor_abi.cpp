@@ -0,0 +1,308 @@
+#include <gw/core/external_processor.h>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+    int live_instances = 0;
+
+    // Gain with sample-accurate parameter changes; counts notes
+    class GainBlockProcessor : public gw::core::BlockProcessor {
+    public:
+        GainBlockProcessor() { ++live_instances; }
+        ~GainBlockProcessor() override { --live_instances; }
+
+        bool prepare(double sample_rate, size_t max_block_size, size_t num_channels) override {
+            static_cast<void>(sample_rate);
+            static_cast<void>(max_block_size);
+            return num_channels <= 8;
+        }
+
+        void process(const gw_process_block &block) override {
+            size_t change = 0;
+            for (uint32_t n = 0; n < block.num_samples; ++n) {
+                while (change < block.num_parameter_changes && block.parameter_changes[change].sample_offset == n) {
+                    gain = block.parameter_changes[change++].value;
+                }
+                for (uint32_t ch = 0; ch < block.num_channels; ++ch) block.channels[ch][n] *= gain;
+            }
+            for (uint32_t e = 0; e < block.num_events; ++e) {
+                if (block.events[e].type == GW_EVENT_NOTE_ON) ++notes;
+            }
+            positions.push_back(block.sample_position);
+            ++process_calls;
+        }
+
+        void process_batch(const gw_process_block *blocks, size_t num_blocks) override {
+            ++batch_calls;
+            BlockProcessor::process_batch(blocks, num_blocks);
+        }
+
+        void reset() override { gain = 1.0f; }
+
+        [[nodiscard]] size_t get_latency_samples() const override { return 12; }
+
+        float gain = 1.0f;
+        int notes = 0;
+        int process_calls = 0;
+        int batch_calls = 0;
+        std::vector<uint64_t> positions;
+    };
+
+    GainBlockProcessor *created = nullptr;
+
+    class ThrowingBlockProcessor : public gw::core::BlockProcessor {
+    public:
+        bool prepare(double, size_t, size_t) override { throw std::bad_alloc(); }
+
+        void process(const gw_process_block &) override {
+        }
+    };
+
+    // What a processor library's entry point looks like
+    int32_t create_gain(uint32_t host_abi_version, gw_processor *out) {
+        auto processor = std::make_unique<GainBlockProcessor>();
+        created = processor.get();
+        return gw::core::export_processor(std::move(processor), host_abi_version, out);
+    }
+
+    class Doubler : public gw::core::Processor {
+    public:
+        void prepare(double sample_rate, size_t max_block_size, size_t num_channels) override {
+            static_cast<void>(sample_rate);
+            static_cast<void>(max_block_size);
+            static_cast<void>(num_channels);
+        }
+
+        void process(gw::core::BufferView *channels, size_t num_channels) override {
+            for (size_t ch = 0; ch < num_channels; ++ch) {
+                for (size_t i = 0; i < channels[ch].size(); ++i) channels[ch][i] *= 2.0f;
+            }
+        }
+    };
+
+    // A processor written against the C table alone, without process_batch
+    int c_process_calls = 0;
+
+    int32_t c_prepare(void *, double, uint32_t, uint32_t) { return GW_STATUS_OK; }
+    void c_process(void *, const gw_process_block *block) {
+        ++c_process_calls;
+        block->channels[0][0] = static_cast<float>(block->sample_position);
+    }
+    void c_destroy(void *instance) { *static_cast<int *>(instance) = -1; }
+    void c_process_batch(void *, const gw_process_block *, uint32_t) { c_process_calls += 100; }
+}
+
+void test_processor_abi() {
+    // Test the ABI structs keep their layout
+    {
+        assert(sizeof(gw_event) == 24 && sizeof(gw_parameter_change) == 16);
+        if (sizeof(void *) == 8) assert(sizeof(gw_process_block) == 64);
+        assert(offsetof(gw_process_block, struct_size) == 0 && offsetof(gw_processor, struct_size) == 0);
+        assert(GW_PROCESSOR_MIN_STRUCT_SIZE < sizeof(gw_processor));
+    }
+
+    std::cout << "  - ABI layout: OK" << std::endl;
+
+    // Test a batch describes consecutive slices of one buffer, and rejects what doesn't fit
+    {
+        gw::core::AudioBuffer buffer(2, 64);
+        gw::core::ProcessBlockBatch batch(2, 2, 2, 1);
+        bool ok = !batch.add_event(gw_event{0, GW_EVENT_NOTE_ON, 60, 1.0f, {}, 0}); // No block yet
+        ok = batch.add_block(buffer, 0, 32, 1000) && ok;
+        ok = batch.add_event(gw_event{4, GW_EVENT_NOTE_ON, 60, 1.0f, {}, 0}) && ok;
+        ok = !batch.add_event(gw_event{2, GW_EVENT_NOTE_ON, 62, 1.0f, {}, 0}) && ok; // Out of order
+        ok = !batch.add_event(gw_event{32, GW_EVENT_NOTE_ON, 62, 1.0f, {}, 0}) && ok; // Past the block
+        ok = batch.add_block(buffer, 32, 32, 1032) && ok;
+        ok = !batch.add_block(buffer, 0, 1, 0) && ok; // Full
+        assert(ok);
+
+        const gw_process_block *blocks = batch.get_blocks();
+        assert(batch.size() == 2 && blocks[1].channels[1] == buffer.get_channel_data(1) + 32);
+        assert(blocks[0].num_events == 1 && blocks[1].num_events == 0);
+        assert(blocks[1].sample_position == 1032 && blocks[1].struct_size == sizeof(gw_process_block));
+
+        batch.clear();
+        assert(batch.empty());
+        gw::core::AudioBuffer wide(3, 8);
+        ok = !batch.add_block(buffer, 40, 32, 0); // Runs past the end
+        ok = !batch.add_block(wide, 0, 8, 0) && ok;
+        assert(ok && batch.empty());
+    }
+
+    std::cout << "  - Block batches: OK" << std::endl;
+
+    // Test a processor exported through the entry point, driven per block and in batches
+    {
+        gw::core::ExternalProcessor external;
+        const bool opened = external.open(create_gain);
+        assert(opened);
+        assert(external.is_open() && external.supports_batch() && live_instances == 1);
+        assert(external.get_latency_samples() == 12);
+
+        external.prepare(48000.0, 64, 9);
+        assert(!external.is_prepared()); // The processor refused 9 channels
+        external.prepare(48000.0, 64, 2);
+        assert(external.is_prepared());
+
+        // Four 16-sample blocks in one call; the gain drops to 0.5 halfway through the second
+        gw::core::AudioBuffer buffer(2, 64);
+        for (size_t ch = 0; ch < 2; ++ch) {
+            for (size_t i = 0; i < 64; ++i) buffer.set_sample(ch, i, 1.0f);
+        }
+
+        gw::core::ProcessBlockBatch batch(4, 2);
+        for (size_t b = 0; b < 4; ++b) {
+            const bool added = batch.add_block(buffer, b * 16, 16, 480 + b * 16);
+            assert(added);
+            if (b == 1) {
+                const bool changed = batch.add_parameter_change(8, 0, 0.5f);
+                assert(changed);
+            }
+            const bool noted = batch.add_event(gw_event{3, GW_EVENT_NOTE_ON, 60, 0.8f, {}, 0});
+            assert(noted);
+        }
+        external.process_batch(batch);
+
+        assert(created->batch_calls == 1 && created->process_calls == 4 && created->notes == 4);
+        assert(created->positions[3] == 528);
+        for (size_t ch = 0; ch < 2; ++ch) {
+            assert(buffer.get_sample(ch, 23) == 1.0f && buffer.get_sample(ch, 24) == 0.5f);
+            assert(buffer.get_sample(ch, 63) == 0.5f);
+        }
+
+        // Through the Processor interface (as in a ProcessorChain): one descriptor per block
+        gw::core::BufferView views[2] = {{buffer, 0}, {buffer, 1}};
+        external.reset();
+        external.process(views, 2);
+        assert(created->process_calls == 5 && created->positions.back() == 0);
+        assert(buffer.get_sample(0, 0) == 1.0f);
+
+        external.close();
+        assert(live_instances == 0 && !external.is_open());
+    }
+
+    std::cout << "  - Exported processor: OK" << std::endl;
+
+    // Test version and table checks, and the per-block fallback without process_batch
+    {
+        gw_processor table{};
+        table.struct_size = sizeof(gw_processor);
+        const int32_t status = gw::core::export_processor(std::make_unique<GainBlockProcessor>(),
+                                                          GW_PROCESSOR_ABI_VERSION + 1, &table);
+        assert(status == GW_STATUS_VERSION_MISMATCH);
+        assert(live_instances == 0 && table.instance == nullptr);
+
+        int state = 0;
+        gw_processor minimal{};
+        minimal.struct_size = sizeof(gw_processor);
+        minimal.abi_version = GW_PROCESSOR_ABI_VERSION;
+        minimal.instance = &state;
+        minimal.prepare = c_prepare;
+        minimal.process = c_process;
+
+        gw::core::ExternalProcessor external;
+        bool ok = !external.open(minimal); // No destroy()
+        minimal.destroy = c_destroy;
+        minimal.abi_version = GW_PROCESSOR_ABI_VERSION + 1;
+        ok = !external.open(minimal) && ok;
+        minimal.abi_version = GW_PROCESSOR_ABI_VERSION;
+        ok = external.open(minimal) && ok;
+        assert(ok && !external.supports_batch());
+
+        gw::core::AudioBuffer buffer(1, 8);
+        gw::core::ProcessBlockBatch batch(3, 1);
+        external.process_batch(batch); // Not prepared: ignored
+        external.prepare(48000.0, 8, 1);
+        for (size_t b = 0; b < 3; ++b) {
+            const bool added = batch.add_block(buffer, 0, 8, 100 + b);
+            assert(added);
+        }
+        external.process_batch(batch);
+        assert(c_process_calls == 3 && buffer.get_sample(0, 0) == 102.0f);
+
+        external.close();
+        assert(state == -1);
+    }
+
+    std::cout << "  - Version checks and fallback: OK" << std::endl;
+
+    // Test a table from an older processor, which ends at destroy
+    {
+        int state = 0;
+        gw_processor older{};
+        older.struct_size = GW_PROCESSOR_MIN_STRUCT_SIZE;
+        older.abi_version = GW_PROCESSOR_ABI_VERSION;
+        older.instance = &state;
+        older.prepare = c_prepare;
+        older.process = c_process;
+        older.destroy = c_destroy;
+        older.process_batch = c_process_batch; // Past struct_size: must not be read
+
+        gw::core::ExternalProcessor external;
+        older.struct_size = GW_PROCESSOR_MIN_STRUCT_SIZE - 1;
+        bool ok = !external.open(older); // Cuts into destroy
+        older.struct_size = GW_PROCESSOR_MIN_STRUCT_SIZE;
+        ok = external.open(older) && ok;
+        assert(ok && !external.supports_batch() && external.get_latency_samples() == 0);
+
+        gw::core::AudioBuffer buffer(1, 8);
+        gw::core::ProcessBlockBatch batch(2, 1);
+        external.prepare(48000.0, 8, 1);
+        const bool added = batch.add_block(buffer, 0, 8, 7) && batch.add_block(buffer, 0, 8, 9);
+        assert(added);
+        c_process_calls = 0;
+        external.process_batch(batch);
+        external.reset(); // No reset() entry point
+        assert(c_process_calls == 2 && buffer.get_sample(0, 0) == 9.0f);
+
+        external.close();
+        assert(state == -1);
+    }
+
+    std::cout << "  - Older, shorter tables: OK" << std::endl;
+
+    // Test an exception thrown by prepare() is reported, not propagated to the host
+    {
+        gw_processor table{};
+        table.struct_size = sizeof(gw_processor);
+        const int32_t status = gw::core::export_processor(std::make_unique<ThrowingBlockProcessor>(),
+                                                          GW_PROCESSOR_ABI_VERSION, &table);
+        const int32_t prepared = table.prepare(table.instance, 48000.0, 64, 2);
+        assert(status == GW_STATUS_OK && prepared == GW_STATUS_ERROR);
+
+        gw::core::ExternalProcessor external;
+        const bool opened = external.open(table);
+        assert(opened);
+        external.prepare(48000.0, 64, 2);
+        assert(!external.is_prepared());
+    }
+
+    std::cout << "  - Exceptions stay inside: OK" << std::endl;
+
+    // Test an ordinary Processor exported through the adapter
+    {
+        gw::core::ExternalProcessor external;
+        gw_processor table{};
+        table.struct_size = sizeof(gw_processor);
+        const int32_t status = gw::core::export_processor(
+            std::make_unique<gw::core::ProcessorBlockAdapter>(std::make_unique<Doubler>()),
+            GW_PROCESSOR_ABI_VERSION, &table);
+        const bool opened = status == GW_STATUS_OK && external.open(table);
+        assert(opened);
+
+        gw::core::AudioBuffer buffer(2, 32);
+        for (size_t i = 0; i < 32; ++i) buffer.set_sample(1, i, 1.5f);
+        external.prepare(48000.0, 32, 2);
+        gw::core::ProcessBlockBatch batch(2, 2);
+        const bool added = batch.add_block(buffer, 0, 16, 0) && batch.add_block(buffer, 16, 16, 16);
+        assert(added);
+        external.process_batch(batch);
+        for (size_t i = 0; i < 32; ++i) assert(buffer.get_sample(1, i) == 3.0f);
+    }
+
+    std::cout << "  - Processor adapter: OK" << std::endl;
+}
@@ -0,0 +1,160 @@
+#include <gw/core/audio_buffer.h>
+#include <gw/core/ring_buffer.h>
+#include <gw/core/rt.h>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+void test_rt() {
+    // Test CPU list parsing
+    {
+        const std::vector<int> cpus = gw::core::rt::parse_cpu_list("2-4,7\n");
+        assert((cpus == std::vector<int>{2, 3, 4, 7}));
+
+        const std::vector<int> empty = gw::core::rt::parse_cpu_list("\n");
+        assert(empty.empty());
+
+        const std::vector<int> malformed = gw::core::rt::parse_cpu_list("3-1");
+        assert(malformed.empty());
+
+        const std::vector<int> garbage = gw::core::rt::parse_cpu_list("a,b");
+        assert(garbage.empty());
+    }
+
+    std::cout << "  - CPU lists: OK" << std::endl;
+
+    // Test pinning to a CPU we are already allowed on
+    {
+        const std::vector<int> allowed = gw::core::rt::get_allowed_cpus();
+        assert(!allowed.empty());
+
+        const bool pinned = gw::core::rt::pin_to_cpus({allowed[0]});
+        assert(pinned);
+        assert(gw::core::rt::get_allowed_cpus() == std::vector<int>{allowed[0]});
+
+        // Restore the original mask
+        const bool restored = gw::core::rt::pin_to_cpus(allowed);
+        assert(restored);
+
+        const bool invalid = gw::core::rt::pin_to_cpus({-1});
+        assert(!invalid);
+    }
+
+    std::cout << "  - CPU pinning: OK" << std::endl;
+
+    // Test prefaulting keeps buffer contents
+    {
+        gw::core::AudioBuffer buffer(2, 100000);
+        buffer.set_sample(1, 12345, 0.5f);
+        buffer.prefault();
+        assert(buffer.get_sample(1, 12345) == 0.5f);
+        assert(buffer.get_sample(0, 0) == 0.0f);
+
+        gw::core::RingBuffer ring(50000);
+        const float value = 0.25f;
+        ring.write(&value, 1);
+        ring.prefault();
+
+        float read_back = 0.0f;
+        const size_t count = ring.read(&read_back, 1);
+        assert(count == 1 && read_back == 0.25f);
+
+        gw::core::rt::prefault_stack(64 * 1024);
+    }
+
+    std::cout << "  - Prefault: OK" << std::endl;
+
+    // Test huge-page backed buffers (falls back to the heap if unavailable)
+    {
+        gw::core::AudioBuffer buffer(4, 300000, gw::core::BufferMemory::HugePages);
+        assert(buffer.get_num_channels() == 4);
+
+        for (size_t ch = 0; ch < 4; ++ch) {
+            const float *data = buffer.get_channel_data(ch);
+            assert(data != nullptr);
+            assert(reinterpret_cast<uintptr_t>(data) % 32 == 0);
+            assert(data[0] == 0.0f && data[299999] == 0.0f);
+        }
+
+        buffer.set_sample(3, 299999, 1.0f);
+        buffer.set_sample(0, 0, -1.0f);
+        buffer.prefault();
+
+        gw::core::AudioBuffer moved(std::move(buffer));
+        assert(moved.get_sample(3, 299999) == 1.0f);
+        assert(moved.get_sample(0, 0) == -1.0f);
+        assert(moved.get_sample(1, 299999) == 0.0f);
+
+        void *region = gw::core::rt::allocate_huge_pages(1000);
+        assert(region != nullptr);
+        assert(reinterpret_cast<uintptr_t>(region) % 4096 == 0);
+        std::memset(region, 1, 1000);
+        gw::core::rt::free_huge_pages(region, 1000);
+    }
+
+    std::cout << "  - Huge pages: OK" << std::endl;
+
+    // Test the fault monitor sees first-touch faults and nothing on resident memory
+    {
+        gw::core::rt::FaultMonitor monitor;
+        const size_t bytes = 8 * 1024 * 1024;
+
+        std::vector<unsigned char> resident(bytes);
+        gw::core::rt::prefault(resident.data(), bytes);
+
+        void *fresh = gw::core::rt::allocate_huge_pages(bytes);
+        assert(fresh != nullptr);
+
+        monitor.begin();
+        std::memset(fresh, 1, bytes);
+        const bool fresh_clean = monitor.end();
+        assert(!fresh_clean);
+
+        const gw::core::rt::FaultStats stats = monitor.get_stats();
+        assert(stats.blocks == 1);
+        assert(stats.dirty_blocks == 1);
+        assert(stats.totals.minor_faults + stats.totals.major_faults > 0);
+
+        // A resident, already written region should normally run clean;
+        // preemption can still happen, so only the totals are checked
+        monitor.begin();
+        std::memset(resident.data(), 2, bytes);
+        monitor.end();
+        assert(monitor.get_stats().blocks == 2);
+
+        monitor.reset();
+        assert(monitor.get_stats().blocks == 0);
+        assert(monitor.get_stats().totals.minor_faults == 0);
+
+        gw::core::rt::free_huge_pages(fresh, bytes);
+    }
+
+    std::cout << "  - Fault monitor: OK" << std::endl;
+
+    // Test make_realtime reports what it could do without privileges
+    {
+        gw::core::rt::RealtimeConfig config;
+        config.policy = gw::core::rt::RealtimeConfig::Policy::Normal;
+        config.lock_memory = false;
+        config.cpus = gw::core::rt::get_allowed_cpus();
+
+        const gw::core::rt::RealtimeStatus status = gw::core::rt::make_realtime(config);
+        assert(status.scheduling && status.affinity && status.memory_locked);
+
+        // FIFO may be refused without CAP_SYS_NICE; either way it must not crash
+        if (gw::core::rt::set_fifo_priority(10)) {
+            const bool normal = gw::core::rt::set_normal_priority();
+            assert(normal);
+        }
+
+        const bool bad_priority = gw::core::rt::set_fifo_priority(1000);
+        assert(!bad_priority);
+
+        const bool bad_deadline = gw::core::rt::set_deadline(2000000, 1000000, 1000000);
+        assert(!bad_deadline);
+    }
+
+    std::cout << "  - Realtime setup: OK" << std::endl;
+}
@@ -0,0 +1,215 @@
+#include <gw/core/sample_cache.h>
+#include <unistd.h>
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    void fill_sample(gw::core::AudioBuffer &buffer, float seed) {
+        for (size_t ch = 0; ch < buffer.get_num_channels(); ++ch) {
+            for (size_t i = 0; i < buffer.get_num_samples(); ++i) {
+                buffer.set_sample(ch, i, seed + static_cast<float>(ch) * 0.5f + static_cast<float>(i) * 1e-5f);
+            }
+        }
+    }
+
+    gw::core::SampleCacheSettings make_settings(const std::string &directory) {
+        gw::core::SampleCacheSettings settings;
+        settings.directory = directory;
+        settings.chunk_frames = 1024;
+        settings.attack_frames = 2048;
+        settings.prefetch_chunks = 1;
+        settings.eviction_grace_polls = 2;
+        settings.poll_interval_ms = 1.0f;
+        return settings;
+    }
+}
+
+void test_sample_cache() {
+    const std::string directory = "/tmp/gw-sample-cache-test-" + std::to_string(getpid());
+    std::filesystem::remove_all(directory);
+
+    const size_t frames = 10000;
+    gw::core::AudioBuffer source(2, frames);
+    fill_sample(source, 0.25f);
+
+    // Test identical content is stored once and shared
+    {
+        gw::core::SampleCache cache(make_settings(directory));
+
+        const gw::core::SampleHandle first = cache.load(source, frames, 48000.0);
+        const gw::core::SampleHandle second = cache.load(source, frames, 48000.0);
+        assert(first.is_valid() && second.is_valid());
+        assert(first.get_id() == second.get_id());
+        assert(first.get_id() == gw::core::SampleCache::compute_id(source, frames, 48000.0));
+        assert(first.get_num_channels() == 2 && first.get_num_frames() == frames);
+        assert(first.get_sample_rate() == 48000.0);
+
+        // A different rate is different content
+        const gw::core::SampleHandle other_rate = cache.load(source, frames, 44100.0);
+        assert(other_rate.get_id() != first.get_id());
+
+        const gw::core::SampleCacheStats stats = cache.get_stats();
+        assert(stats.samples == 2 && stats.loads == 2 && stats.hits == 1);
+        assert(stats.referenced_samples == 2);
+    }
+
+    // A second cache on the same directory maps the stored file instead of writing it
+    {
+        gw::core::SampleCache cache(make_settings(directory));
+        const gw::core::SampleHandle handle = cache.load(source, frames, 48000.0);
+        assert(handle.is_valid());
+
+        const gw::core::SampleCacheStats stats = cache.get_stats();
+        assert(stats.loads == 0 && stats.hits == 1);
+    }
+
+    std::cout << "  - Content addressing: OK" << std::endl;
+
+    // Test handle reference counting
+    {
+        gw::core::SampleCache cache(make_settings(directory));
+        gw::core::SampleHandle handle = cache.load(source, frames, 48000.0);
+
+        {
+            const gw::core::SampleHandle copy = handle; // NOLINT(performance-unnecessary-copy-initialization)
+            gw::core::SampleHandle moved = std::move(handle);
+            assert(!handle.is_valid() && moved.is_valid() && copy.is_valid());
+            assert(cache.get_stats().referenced_samples == 1);
+        }
+
+        // Released but still mapped until the budget needs the space
+        const gw::core::SampleCacheStats stats = cache.get_stats();
+        assert(stats.samples == 1 && stats.referenced_samples == 0);
+    }
+
+    std::cout << "  - Reference counting: OK" << std::endl;
+
+    // Test views read the mapped data without copies, attack first, tails on demand
+    {
+        gw::core::SampleCache cache(make_settings(directory));
+        const gw::core::SampleHandle handle = cache.load(source, frames, 48000.0);
+        assert(handle.get_attack_frames() == 2048);
+
+        // The whole sample is there for offline use
+        for (size_t ch = 0; ch < 2; ++ch) {
+            const gw::core::BufferView view = handle.get_view(ch);
+            assert(view.size() == frames);
+            for (size_t i = 0; i < frames; ++i) {
+                assert(view[i] == source.get_sample(ch, i));
+            }
+        }
+
+        // The attack is always resident
+        const gw::core::BufferView attack = handle.get_resident_view(1, 0, 2048);
+        assert(attack.size() == 2048 && attack[100] == source.get_sample(1, 100));
+
+        // Reading past the attack is cut short and queues chunk 2 (+1 prefetch)
+        const gw::core::BufferView partial = handle.get_resident_view(0, 1500, 1000);
+        assert(partial.size() == 548 && partial[0] == source.get_sample(0, 1500));
+        assert(cache.get_stats().misses == 1);
+
+        cache.poll();
+        assert(cache.get_stats().chunks_streamed == 2);
+
+        const gw::core::BufferView full = handle.get_resident_view(0, 1500, 1000);
+        assert(full.size() == 1000);
+        for (size_t i = 0; i < full.size(); ++i) {
+            assert(full[i] == source.get_sample(0, 1500 + i));
+        }
+
+        // Past the end of the sample the view is clipped
+        const gw::core::BufferView end = handle.get_resident_view(0, frames - 10, 100);
+        assert(end.empty()); // Last chunk not streamed yet
+        cache.poll();
+        const gw::core::BufferView tail = handle.get_resident_view(0, frames - 10, 100);
+        assert(tail.size() == 10);
+
+        const gw::core::SampleCacheStats stats = cache.get_stats();
+        assert(stats.attack_bytes == 2 * 2048 * sizeof(float));
+        assert(stats.resident_bytes == stats.attack_bytes + 2 * (2048 + 784) * sizeof(float));
+        assert(stats.mapped_bytes == 2 * frames * sizeof(float));
+        assert(cache.measure_resident_bytes() >= stats.attack_bytes);
+    }
+
+    std::cout << "  - Resident views: OK" << std::endl;
+
+    // Test LRU eviction under a budget: idle tails go first, then unreferenced samples
+    {
+        gw::core::SampleCacheSettings settings = make_settings(directory);
+        const size_t attack_bytes = 2 * 2048 * sizeof(float);
+        settings.memory_budget = 2 * attack_bytes + 4 * 2 * 1024 * sizeof(float);
+        gw::core::SampleCache cache(settings);
+
+        gw::core::AudioBuffer second_source(2, frames);
+        fill_sample(second_source, -0.75f);
+
+        const gw::core::SampleHandle first = cache.load(source, frames, 48000.0);
+        gw::core::SampleHandle second = cache.load(second_source, frames, 48000.0);
+
+        // Stream the whole first sample: over budget, but everything is still in use
+        for (size_t start = 0; start < frames; start += 1024) {
+            static_cast<void>(first.get_resident_view(0, start, 1024));
+        }
+        cache.poll();
+        assert(cache.get_stats().chunks_evicted == 0);
+        assert(cache.get_stats().resident_bytes > settings.memory_budget);
+
+        // Only the end of the first sample keeps playing; its start goes idle and is dropped
+        for (size_t p = 0; p < 4; ++p) {
+            const gw::core::BufferView view = first.get_resident_view(0, 8192, 1808);
+            assert(view.size() == 1808);
+            cache.poll();
+        }
+
+        gw::core::SampleCacheStats stats = cache.get_stats();
+        assert(stats.chunks_evicted > 0 && stats.samples_evicted == 0);
+        assert(stats.resident_bytes <= settings.memory_budget);
+
+        // The recently played chunks survived, the evicted ones are requested again
+        assert(first.get_resident_view(0, 8192, 1808).size() == 1808);
+        assert(first.get_resident_view(0, 2048, 1024).empty());
+
+        // A tighter budget with the second sample released unmaps it
+        second = gw::core::SampleHandle();
+        gw::core::SampleCacheSettings tight = settings;
+        tight.memory_budget = attack_bytes;
+        gw::core::SampleCache tight_cache(tight);
+        const gw::core::SampleHandle kept = tight_cache.load(source, frames, 48000.0);
+        {
+            const gw::core::SampleHandle released = tight_cache.load(second_source, frames, 48000.0);
+        }
+        tight_cache.poll();
+
+        stats = tight_cache.get_stats();
+        assert(stats.samples == 1 && stats.samples_evicted == 1);
+        assert(kept.get_resident_view(0, 0, 2048).size() == 2048);
+    }
+
+    std::cout << "  - LRU eviction: OK" << std::endl;
+
+    // Test the background reader serves requests on its own
+    {
+        gw::core::SampleCache cache(make_settings(directory));
+        const gw::core::SampleHandle handle = cache.load(source, frames, 48000.0);
+        cache.start();
+
+        size_t resident = 0;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (resident < 1024 && std::chrono::steady_clock::now() < deadline) {
+            resident = handle.get_resident_view(1, 6000, 1024).size();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        cache.stop();
+
+        assert(resident == 1024);
+        assert(cache.get_stats().chunks_streamed > 0);
+    }
+
+    std::cout << "  - Background reader: OK" << std::endl;
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,105 @@
+#include <gw/core/sample_types.h>
+#include <gw/core/sample_convert.h>
+#include <gw/core/audio_buffer.h>
+#include <gw/core/buffer_view.h>
+#include <gw/core/ring_buffer.h>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+void test_sample_convert() {
+    using gw::core::Half;
+    using gw::core::BFloat16;
+
+    // Test scalar Half conversions against known bit patterns
+    assert(Half(1.0f).get_bits() == 0x3c00);
+    assert(Half(-2.0f).get_bits() == 0xc000);
+    assert(Half(65504.0f).get_bits() == 0x7bff); // Largest finite half
+    assert(Half(1.0e6f).get_bits() == 0x7c00); // Overflow becomes infinity
+    assert(Half(5.9604645e-8f).get_bits() == 0x0001); // Smallest subnormal
+    assert(static_cast<float>(Half::from_bits(0x3555)) == 0.333251953125f);
+    assert(std::isnan(static_cast<float>(Half(std::numeric_limits<float>::quiet_NaN()))));
+
+    // 1 + 2^-11 is exactly halfway between two halves: rounds to even (1.0)
+    assert(Half(1.00048828125f).get_bits() == 0x3c00);
+
+    std::cout << "  - Half scalar: OK" << std::endl;
+
+    assert(BFloat16(1.0f).get_bits() == 0x3f80);
+    assert(static_cast<float>(BFloat16(-3.0f)) == -3.0f);
+    assert(std::isnan(static_cast<float>(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+    std::cout << "  - BFloat16 scalar: OK" << std::endl;
+
+    // Test the block conversions match the scalar ones, including the
+    // tail that doesn't fill a whole vector
+    std::vector<float> source(1003);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = std::sin(static_cast<float>(i) * 0.37f) * static_cast<float>(i % 17);
+    }
+
+    std::vector<Half> halves(source.size());
+    std::vector<float> round_trip(source.size());
+    gw::core::convert_samples(source.data(), halves.data(), source.size());
+    gw::core::convert_samples(halves.data(), round_trip.data(), source.size());
+
+    for (size_t i = 0; i < source.size(); ++i) {
+        assert(halves[i].get_bits() == Half(source[i]).get_bits());
+        assert(std::fabs(round_trip[i] - source[i]) <= std::fabs(source[i]) * 0.001f);
+    }
+
+    std::vector<BFloat16> bfloats(source.size());
+    gw::core::convert_samples(source.data(), bfloats.data(), source.size());
+    gw::core::convert_samples(bfloats.data(), round_trip.data(), source.size());
+
+    for (size_t i = 0; i < source.size(); ++i) {
+        assert(std::fabs(round_trip[i] - source[i]) <= std::fabs(source[i]) * 0.008f);
+    }
+
+    std::cout << "  - Block conversion: OK" << std::endl;
+
+    // Test converted copies between containers
+    gw::core::AudioBuffer buffer(2, 100);
+    for (size_t i = 0; i < 100; ++i) {
+        buffer.set_sample(0, i, static_cast<float>(i) * 0.25f);
+    }
+
+    gw::core::DoubleAudioBuffer doubles(2, 100);
+    doubles.copy_from(buffer);
+    assert(doubles.get_sample(0, 10) == 2.5);
+
+    gw::core::HalfAudioBuffer compact(2, 64);
+    compact.copy_from(doubles);
+    assert(static_cast<float>(compact.get_sample(0, 63)) == 15.75f);
+    assert(static_cast<float>(compact.get_sample(1, 63)) == 0.0f);
+
+    buffer.clear();
+    buffer.copy_from(compact);
+    assert(buffer.get_sample(0, 63) == 15.75f);
+    assert(buffer.get_sample(0, 64) == 0.0f); // Beyond the shorter source
+
+    std::cout << "  - AudioBuffer conversion: OK" << std::endl;
+
+    gw::core::HalfBufferView half_view(compact, 0);
+    gw::core::BufferView float_view(buffer, 1);
+    float_view.copy_from(half_view);
+    assert(float_view[40] == 10.0f);
+
+    half_view.fill(Half(0.5f));
+    assert(static_cast<float>(half_view[0]) == 0.5f);
+
+    std::cout << "  - BufferView conversion: OK" << std::endl;
+
+    gw::core::DoubleRingBuffer ring(16);
+    const double in[3] = {0.1, 0.2, 0.3};
+    double out[3] = {};
+    const size_t written = ring.write(in, 3);
+    const size_t read_count = ring.read(out, 3);
+    assert(written == 3);
+    assert(read_count == 3);
+    assert(out[2] == 0.3);
+
+    std::cout << "  - Typed RingBuffer: OK" << std::endl;
+}
@@ -0,0 +1,179 @@
+#include <gw/core/stft.h>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    // Push a signal through in irregular block sizes and collect the output
+    std::vector<float> run_blocks(gw::core::Stft &stft, const std::vector<float> &input,
+                                  const std::vector<size_t> &block_sizes) {
+        std::vector<float> output(input.size());
+        std::vector<float> scratch(input.size());
+        size_t position = 0;
+        size_t next = 0;
+
+        while (position < input.size()) {
+            const size_t count = std::min(block_sizes[next++ % block_sizes.size()], input.size() - position);
+            std::copy_n(input.data() + position, count, scratch.data());
+
+            gw::core::BufferView view(scratch.data(), count);
+            stft.process(&view, 1);
+
+            std::copy_n(scratch.data(), count, output.data() + position);
+            position += count;
+        }
+        return output;
+    }
+
+    std::vector<float> make_noise(size_t size, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> signal(size);
+        for (auto &sample: signal) sample = dist(rng);
+        return signal;
+    }
+}
+
+void test_stft() {
+    // Test windows are periodic and have the expected shapes
+    {
+        std::vector<float> window(8);
+        gw::core::make_window(gw::core::WindowType::Hann, window.data(), window.size());
+        assert(window[0] == 0.0f && std::fabs(window[4] - 1.0f) < 1e-6f);
+        assert(std::fabs(window[2] - 0.5f) < 1e-6f && std::fabs(window[6] - 0.5f) < 1e-6f);
+
+        gw::core::make_window(gw::core::WindowType::SqrtHann, window.data(), window.size());
+        assert(std::fabs(window[2] * window[2] - 0.5f) < 1e-6f);
+
+        gw::core::make_window(gw::core::WindowType::Rectangular, window.data(), window.size());
+        assert(window[0] == 1.0f && window[7] == 1.0f);
+    }
+
+    std::cout << "  - Windows: OK" << std::endl;
+
+    // Test an untouched spectrum reconstructs the input delayed by the latency,
+    // for several window pairs and hops, in arbitrary block sizes
+    {
+        const std::vector<float> input = make_noise(20000, 3);
+
+        struct Case {
+            gw::core::WindowType analysis;
+            gw::core::WindowType synthesis;
+            size_t fft_size;
+            size_t hop_size;
+        };
+        const Case cases[] = {
+            {gw::core::WindowType::Hann, gw::core::WindowType::Hann, 1024, 256},
+            {gw::core::WindowType::SqrtHann, gw::core::WindowType::SqrtHann, 512, 256},
+            {gw::core::WindowType::Hann, gw::core::WindowType::Rectangular, 256, 128},
+            {gw::core::WindowType::Blackman, gw::core::WindowType::Hamming, 2048, 512},
+            {gw::core::WindowType::Rectangular, gw::core::WindowType::Rectangular, 64, 64},
+        };
+
+        for (const Case &c: cases) {
+            gw::core::StftSettings settings;
+            settings.fft_size = c.fft_size;
+            settings.hop_size = c.hop_size;
+            settings.analysis_window = c.analysis;
+            settings.synthesis_window = c.synthesis;
+            settings.max_channels = 1;
+            settings.max_block_size = 700;
+
+            size_t frames = 0;
+            gw::core::Stft stft(settings, [&](const gw::core::StftFrame &frame) {
+                assert(frame.num_channels == 1 && frame.num_bins == c.fft_size / 2 + 1);
+                assert(frame.index == frames);
+                assert(reinterpret_cast<uintptr_t>(frame.spectra[0]) % 32 == 0);
+                ++frames;
+            });
+            stft.prepare(48000.0, 700, 1);
+
+            // Blocks smaller than a hop, larger than max_block_size, and odd sizes
+            const std::vector<float> output = run_blocks(stft, input, {1, 37, 500, 2000, 64, 3});
+            const size_t latency = stft.get_latency_samples();
+            assert(latency == c.fft_size - 1);
+            assert(frames == stft.get_frames_processed() && frames == input.size() / c.hop_size);
+
+            for (size_t n = 0; n < latency; ++n) {
+                assert(std::fabs(output[n]) < 1e-5f);
+            }
+            for (size_t n = latency; n < output.size(); ++n) {
+                assert(std::fabs(output[n] - input[n - latency]) < 1e-4f);
+            }
+        }
+    }
+
+    std::cout << "  - Perfect reconstruction: OK" << std::endl;
+
+    // Test the callback shapes the output: zeroing bins above 2 kHz removes a 10 kHz tone
+    {
+        gw::core::StftSettings settings;
+        settings.fft_size = 1024;
+        settings.hop_size = 256;
+        settings.max_channels = 2;
+
+        const double sample_rate = 48000.0;
+        const auto cutoff = static_cast<size_t>(2000.0 / sample_rate * 1024.0);
+        gw::core::Stft stft(settings, [&](const gw::core::StftFrame &frame) {
+            for (size_t ch = 0; ch < frame.num_channels; ++ch) {
+                for (size_t k = cutoff; k < frame.num_bins; ++k) {
+                    frame.spectra[ch][k] = 0.0f;
+                }
+            }
+        });
+        stft.prepare(sample_rate, 512, 2);
+
+        gw::core::AudioBuffer buffer(2, 512);
+        double low_energy = 0.0;
+        double high_energy = 0.0;
+        const double pi = std::acos(-1.0);
+
+        for (size_t b = 0; b < 40; ++b) {
+            for (size_t i = 0; i < 512; ++i) {
+                const auto t = static_cast<double>(b * 512 + i) / sample_rate;
+                buffer.set_sample(0, i, static_cast<float>(0.5 * std::sin(2.0 * pi * 500.0 * t)));
+                buffer.set_sample(1, i, static_cast<float>(0.5 * std::sin(2.0 * pi * 10000.0 * t)));
+            }
+
+            gw::core::BufferView views[2] = {{buffer, 0}, {buffer, 1}};
+            stft.process(views, 2);
+
+            if (b >= 4) {
+                for (size_t i = 0; i < 512; ++i) {
+                    low_energy += static_cast<double>(buffer.get_sample(0, i)) * buffer.get_sample(0, i);
+                    high_energy += static_cast<double>(buffer.get_sample(1, i)) * buffer.get_sample(1, i);
+                }
+            }
+        }
+
+        // 500 Hz passes at full power (0.125 per sample), 10 kHz is gone
+        const double samples = 36.0 * 512.0;
+        assert(std::fabs(low_energy / samples - 0.125) < 0.01);
+        assert(high_energy / samples < 1e-8);
+    }
+
+    std::cout << "  - Spectral callback: OK" << std::endl;
+
+    // Test reset() restarts the stream cleanly
+    {
+        gw::core::StftSettings settings;
+        settings.fft_size = 256;
+        settings.hop_size = 64;
+        settings.max_channels = 1;
+        gw::core::Stft stft(settings, nullptr);
+
+        const std::vector<float> input = make_noise(4000, 8);
+        const std::vector<float> first = run_blocks(stft, input, {128});
+        stft.reset();
+        const std::vector<float> second = run_blocks(stft, input, {128});
+
+        assert(stft.get_frames_processed() == 4000 / 64);
+        for (size_t n = 0; n < first.size(); ++n) {
+            assert(first[n] == second[n]);
+        }
+    }
+
+    std::cout << "  - Reset: OK" << std::endl;
+}
@@ -0,0 +1,262 @@
+#include <gw/core/jitter_buffer.h>
+#include <gw/core/pcm_codec.h>
+#include <gw/core/udp_transport.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+    struct LoopbackResult {
+        std::vector<float> input;
+        std::vector<float> output; // Only frames pull() produced
+        gw::core::JitterBufferStats stats;
+        uint64_t dropped = 0;
+    };
+
+    // Stream a stereo ramp-like signal over a loopback UDP socket pair
+    LoopbackResult run_loopback(const gw::core::TransportImpairment &impairment, size_t reorder_packets) {
+        const gw::core::AudioFormat format(48000, 2, 32);
+        const size_t block = 1024;
+        const size_t pull_block = 256;
+
+        gw::core::UdpSocket receive_socket(0, "127.0.0.1");
+        gw::core::UdpSocket send_socket(0, "127.0.0.1");
+        assert(receive_socket.is_open() && send_socket.is_open());
+
+        const bool connected = send_socket.connect("127.0.0.1", receive_socket.get_port());
+        assert(connected);
+
+        gw::core::JitterBufferSettings settings;
+        settings.reorder_packets = reorder_packets;
+        settings.max_ratio_correction = 0.0f; // Bit-exact passthrough
+        settings.min_latency_ms = 25.0f; // Above the 1024-frame bursts this test sends
+        gw::core::JitterBuffer jitter(format, settings);
+
+        gw::core::PacketSender sender(send_socket, format, 128);
+        sender.set_impairment(impairment);
+        gw::core::PacketReceiver receiver(receive_socket, jitter);
+
+        LoopbackResult result;
+        gw::core::AudioBuffer buffer(2, block);
+        gw::core::AudioBuffer out(2, pull_block);
+        double now = 0.0;
+
+        for (size_t b = 0; b < 40; ++b) {
+            for (size_t i = 0; i < block; ++i) {
+                const auto value = static_cast<float>(b * block + i + 1) / 65536.0f;
+                buffer.set_sample(0, i, value);
+                buffer.set_sample(1, i, -value);
+                result.input.push_back(value);
+            }
+
+            const size_t sent = sender.send(buffer, 0, block);
+            assert(sent == block);
+
+            // Drain what arrived; loopback delivers before sendmmsg returns
+            while (receiver.receive(0, now) > 0) {
+            }
+
+            for (size_t p = 0; p < block / pull_block; ++p) {
+                gw::core::BufferView views[2] = {{out, 0}, {out, 1}};
+                const size_t produced = jitter.pull(views, 2);
+
+                for (size_t i = 0; i < produced; ++i) {
+                    assert(out.get_sample(1, i) == -out.get_sample(0, i));
+                    result.output.push_back(out.get_sample(0, i));
+                }
+                now += static_cast<double>(pull_block) / 48000.0;
+            }
+        }
+
+        assert(receiver.get_packets_invalid() == 0);
+        result.stats = jitter.get_stats();
+        result.dropped = sender.get_packets_dropped();
+        return result;
+    }
+}
+
+void test_udp_transport() {
+    // Test packet header round trip and validation
+    {
+        gw::core::PacketHeader header;
+        header.sequence = 0xfffffffe;
+        header.frame_position = 0x123456789abcULL;
+        header.sample_rate = 96000;
+        header.num_channels = 6;
+        header.bit_depth = 24;
+        header.num_frames = 64;
+
+        std::vector<uint8_t> packet(gw::core::PacketHeader::SIZE + 64 * 6 * 3);
+        const size_t size = gw::core::write_packet_header(header, packet.data());
+        assert(size == gw::core::PacketHeader::SIZE);
+
+        gw::core::PacketHeader parsed;
+        const bool ok = gw::core::read_packet_header(packet.data(), packet.size(), parsed);
+        assert(ok);
+        assert(parsed.sequence == header.sequence);
+        assert(parsed.frame_position == header.frame_position);
+        assert(parsed.sample_rate == 96000 && parsed.num_channels == 6);
+        assert(parsed.bit_depth == 24 && parsed.num_frames == 64);
+
+        // Truncated payload and bad magic are rejected
+        const bool truncated = gw::core::read_packet_header(packet.data(), packet.size() - 1, parsed);
+        assert(!truncated);
+        packet[0] ^= 0xff;
+        const bool bad_magic = gw::core::read_packet_header(packet.data(), packet.size(), parsed);
+        assert(!bad_magic);
+    }
+
+    std::cout << "  - Packet header: OK" << std::endl;
+
+    // Test a clean loopback stream arrives bit-exact
+    {
+        const LoopbackResult result = run_loopback(gw::core::TransportImpairment(), 2);
+
+        assert(result.stats.packets_received == 40 * 1024 / 128);
+        assert(result.stats.packets_lost == 0 && result.stats.underruns == 0);
+        assert(result.output.size() > 30 * 1024);
+
+        for (size_t n = 0; n < result.output.size(); ++n) {
+            assert(result.output[n] == result.input[n]);
+        }
+    }
+
+    std::cout << "  - Loopback stream: OK" << std::endl;
+
+    // Test reordered packets are put back in order
+    {
+        gw::core::TransportImpairment impairment;
+        impairment.reorder_distance = 2;
+        impairment.seed = 7;
+
+        const LoopbackResult result = run_loopback(impairment, 4);
+        assert(result.stats.packets_reordered > 0);
+        assert(result.stats.packets_lost == 0 && result.stats.packets_late == 0);
+
+        for (size_t n = 0; n < result.output.size(); ++n) {
+            assert(result.output[n] == result.input[n]);
+        }
+    }
+
+    std::cout << "  - Reordering: OK" << std::endl;
+
+    // Test lost packets are concealed with silence and the timeline stays aligned
+    {
+        gw::core::TransportImpairment impairment;
+        impairment.loss_probability = 0.05f;
+        impairment.seed = 99;
+
+        const LoopbackResult result = run_loopback(impairment, 2);
+        assert(result.dropped > 0);
+        assert(result.stats.packets_lost > 0 && result.stats.packets_lost <= result.dropped);
+
+        // If the very first packet was lost, the stream simply starts at the second
+        const auto offset = static_cast<size_t>(result.output[0] * 65536.0f) - 1;
+        assert(offset % 128 == 0);
+
+        size_t silent = 0;
+        for (size_t n = 0; n < result.output.size(); ++n) {
+            if (result.output[n] == 0.0f) {
+                ++silent;
+            } else {
+                assert(result.output[n] == result.input[n + offset]);
+            }
+        }
+        assert(silent >= 128 && silent % 128 == 0);
+    }
+
+    std::cout << "  - Packet loss: OK" << std::endl;
+
+    // Test drift correction and jitter adaptation on a simulated timeline:
+    // the sender's clock runs 1000 ppm fast and packets arrive with up to
+    // 3 ms of random delay (so some arrive out of order)
+    {
+        const gw::core::AudioFormat format(48000, 1, 16);
+        const size_t packet_frames = 64;
+        const size_t block = 128;
+        const double sender_rate = 48000.0 * 1.001;
+
+        gw::core::JitterBufferSettings settings;
+        settings.reorder_packets = 4;
+        gw::core::JitterBuffer jitter(format, settings);
+
+        struct InFlight {
+            double arrival;
+            uint64_t position;
+            std::vector<uint8_t> pcm;
+        };
+        std::vector<InFlight> in_flight;
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> delay(0.0, 0.003);
+        gw::core::AudioBuffer packet_audio(1, packet_frames);
+        gw::core::AudioBuffer out(1, block);
+
+        uint64_t sent_frames = 0;
+        double fill_error_sum = 0.0;
+        double ratio_sum = 0.0;
+        size_t fill_samples = 0;
+
+        for (size_t b = 0; b < 30000; ++b) {
+            const double now = static_cast<double>(b * block) / 48000.0;
+
+            // Sender: emit every packet whose last frame exists by now on its clock
+            while (static_cast<double>(sent_frames + packet_frames) <= now * sender_rate) {
+                for (size_t i = 0; i < packet_frames; ++i) {
+                    const double t = static_cast<double>(sent_frames + i) / sender_rate;
+                    packet_audio.set_sample(0, i, static_cast<float>(0.5 * std::sin(2.0 * 3.14159265 * 440.0 * t)));
+                }
+
+                InFlight packet;
+                packet.arrival = static_cast<double>(sent_frames + packet_frames) / sender_rate + delay(rng);
+                packet.position = sent_frames;
+                packet.pcm.resize(packet_frames * 2);
+                gw::core::encode_pcm(packet_audio, 0, packet_frames, format, packet.pcm.data());
+                in_flight.push_back(std::move(packet));
+                sent_frames += packet_frames;
+            }
+
+            // Network: deliver what has arrived, in arrival order
+            std::sort(in_flight.begin(), in_flight.end(),
+                      [](const InFlight &a, const InFlight &c) { return a.arrival < c.arrival; });
+            size_t delivered = 0;
+            while (delivered < in_flight.size() && in_flight[delivered].arrival <= now) {
+                const InFlight &packet = in_flight[delivered];
+                jitter.push(packet.position, packet.pcm.data(), packet_frames, packet.arrival);
+                ++delivered;
+            }
+            in_flight.erase(in_flight.begin(), in_flight.begin() + static_cast<long>(delivered));
+
+            // Measure the steady state over the last 20 seconds, where the controller looks
+            if (b >= 22500) {
+                fill_error_sum += jitter.get_fill_frames() - static_cast<double>(jitter.get_target_frames());
+                ratio_sum += jitter.get_ratio();
+                ++fill_samples;
+            }
+
+            gw::core::BufferView view(out, 0);
+            jitter.pull(&view, 1);
+        }
+
+        const gw::core::JitterBufferStats stats = jitter.get_stats();
+        assert(stats.packets_lost == 0 && stats.packets_late == 0);
+        assert(stats.underruns <= 2);
+
+        // The ratio has locked onto the drift
+        const double mean_ratio = ratio_sum / static_cast<double>(fill_samples);
+        assert(std::abs(mean_ratio - 1.001) < 5e-5);
+
+        // Jitter was measured and widened the target beyond the reorder window
+        assert(jitter.get_jitter_seconds() > 0.0002);
+        assert(jitter.get_target_frames() > (settings.reorder_packets + 1) * packet_frames);
+
+        // On average the fill sits at the target
+        const double mean_error = fill_error_sum / static_cast<double>(fill_samples);
+        assert(std::abs(mean_error) < 0.1 * static_cast<double>(jitter.get_target_frames()));
+    }
+
+    std::cout << "  - Drift and jitter: OK" << std::endl;
+}
@@ -0,0 +1,237 @@
+#include <gw/core/fft.h>
+#include <gw/core/voice_engine.h>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr size_t FFT_SIZE = 4096;
+    constexpr size_t FUNDAMENTAL_BIN = 400;
+
+    // Note 69 lands exactly on bin 400 of a 4096-point FFT (4687.5 Hz, an
+    // increment of 400/4096 cycles per sample), so harmonics fall on multiples
+    // of bin 400 and anything else is aliasing
+    gw::core::VoiceEngineSettings make_tone_settings(gw::core::Waveform waveform) {
+        gw::core::VoiceEngineSettings settings;
+        settings.max_voices = 16;
+        settings.waveform = waveform;
+        settings.attack_ms = 0.0f;
+        settings.sustain = 1.0f;
+        settings.gain = 1.0f;
+        settings.tuning_hz = static_cast<float>(SAMPLE_RATE) * static_cast<float>(FUNDAMENTAL_BIN) /
+                             static_cast<float>(FFT_SIZE);
+        return settings;
+    }
+
+    // Mono at center pan: the output equals the raw oscillator
+    std::vector<float> render_tone(gw::core::Waveform waveform, const gw::core::Wavetable *wavetable = nullptr) {
+        gw::core::VoiceEngine engine(make_tone_settings(waveform));
+        engine.set_wavetable(wavetable);
+        engine.prepare(SAMPLE_RATE, 2 * FFT_SIZE, 1);
+        engine.note_on(69.0f, 1.0f);
+
+        gw::core::AudioBuffer buffer(1, 2 * FFT_SIZE);
+        engine.render(buffer, 2 * FFT_SIZE);
+
+        const float *data = buffer.get_channel_data(0);
+        return {data, data + 2 * FFT_SIZE};
+    }
+
+    // Energy off the harmonic bins relative to the total, over the last FFT_SIZE samples
+    double alias_ratio(const std::vector<float> &signal) {
+        gw::core::RealFft fft(FFT_SIZE);
+        std::vector<std::complex<float> > bins(fft.get_num_bins());
+        fft.forward(signal.data() + signal.size() - FFT_SIZE, bins.data());
+
+        double harmonic = 0.0;
+        double alias = 0.0;
+        for (size_t k = 1; k < bins.size(); ++k) {
+            const double energy = std::norm(bins[k]);
+            if (k % FUNDAMENTAL_BIN == 0) {
+                harmonic += energy;
+            } else {
+                alias += energy;
+            }
+        }
+        return alias / (harmonic + alias);
+    }
+
+    std::vector<float> naive_tone(const std::function<float(double)> &shape) {
+        const double increment = static_cast<double>(FUNDAMENTAL_BIN) / static_cast<double>(FFT_SIZE);
+        std::vector<float> signal(2 * FFT_SIZE);
+        for (size_t n = 0; n < signal.size(); ++n) {
+            const double phase = std::fmod(static_cast<double>(n) * increment, 1.0);
+            signal[n] = shape(phase);
+        }
+        return signal;
+    }
+
+    void render_blocks(gw::core::VoiceEngine &engine, gw::core::AudioBuffer &buffer, size_t blocks) {
+        for (size_t b = 0; b < blocks; ++b) {
+            engine.render(buffer, buffer.get_num_samples());
+        }
+    }
+}
+
+void test_voice_engine() {
+    // Test the sine oscillator
+    {
+        const std::vector<float> tone = render_tone(gw::core::Waveform::Sine);
+        const double increment = static_cast<double>(FUNDAMENTAL_BIN) / static_cast<double>(FFT_SIZE);
+
+        for (size_t n = 0; n < tone.size(); ++n) {
+            const double expected = std::sin(2.0 * 3.14159265358979 * static_cast<double>(n) * increment);
+            assert(std::abs(tone[n] - expected) < 1e-4);
+        }
+    }
+
+    std::cout << "  - Sine oscillator: OK" << std::endl;
+
+    // Test polyBLEP/polyBLAMP and wavetables alias far less than naive waveforms
+    {
+        const double naive_saw = alias_ratio(naive_tone([](double p) { return static_cast<float>(2.0 * p - 1.0); }));
+        const double naive_square = alias_ratio(naive_tone([](double p) { return p < 0.5 ? 1.0f : -1.0f; }));
+        const double naive_triangle = alias_ratio(naive_tone([](double p) {
+            return static_cast<float>(1.0 - 4.0 * std::abs(p - 0.5));
+        }));
+
+        const double saw = alias_ratio(render_tone(gw::core::Waveform::Saw));
+        const double square = alias_ratio(render_tone(gw::core::Waveform::Square));
+        const double triangle = alias_ratio(render_tone(gw::core::Waveform::Triangle));
+
+        const gw::core::Wavetable wavetable = gw::core::Wavetable::make_saw();
+        const double table_saw = alias_ratio(render_tone(gw::core::Waveform::Wavetable, &wavetable));
+
+        assert(saw < 0.25 * naive_saw);
+        assert(square < 0.25 * naive_square);
+        assert(triangle < 0.25 * naive_triangle);
+        assert(table_saw < 1e-4);
+
+        // Higher notes select sparser levels
+        assert(wavetable.select_level(0.0004f) == 0);
+        assert(wavetable.select_level(0.1f) > wavetable.select_level(0.01f));
+        assert(wavetable.select_level(0.45f) == wavetable.get_num_levels() - 1);
+    }
+
+    std::cout << "  - Band-limited oscillators: OK" << std::endl;
+
+    // Test constant-power panning
+    {
+        gw::core::VoiceEngine engine(make_tone_settings(gw::core::Waveform::Saw));
+        engine.prepare(SAMPLE_RATE, 256, 2);
+        engine.note_on(30.0f, 1.0f, -1.0f);
+
+        gw::core::AudioBuffer buffer(2, 256);
+        engine.render(buffer, 256);
+
+        float left_peak = 0.0f;
+        for (size_t i = 0; i < 256; ++i) {
+            left_peak = std::max(left_peak, std::abs(buffer.get_sample(0, i)));
+            assert(std::abs(buffer.get_sample(1, i)) < 1e-6f);
+        }
+        assert(left_peak > 0.9f);
+    }
+
+    std::cout << "  - Panning: OK" << std::endl;
+
+    // Test released voices are compacted out and the rest keep their order
+    {
+        gw::core::VoiceEngineSettings settings;
+        settings.max_voices = 16;
+        settings.attack_ms = 1.0f;
+        settings.release_ms = 10.0f;
+        gw::core::VoiceEngine engine(settings);
+        engine.prepare(SAMPLE_RATE, 256, 2);
+
+        for (const float note: {60.0f, 62.0f, 64.0f, 67.0f}) {
+            engine.note_on(note, 0.8f);
+        }
+        assert(engine.get_num_active_voices() == 4);
+
+        gw::core::AudioBuffer buffer(2, 256);
+        render_blocks(engine, buffer, 2);
+
+        engine.note_off(62.0f);
+        assert(engine.get_num_active_voices() == 4 && engine.is_voice_releasing(1));
+
+        render_blocks(engine, buffer, 4); // 20 ms > release
+        assert(engine.get_num_active_voices() == 3);
+        assert(engine.get_voice_note(0) == 60.0f);
+        assert(engine.get_voice_note(1) == 64.0f);
+        assert(engine.get_voice_note(2) == 67.0f);
+
+        engine.all_notes_off();
+        render_blocks(engine, buffer, 4);
+        assert(engine.get_num_active_voices() == 0);
+
+        // Silent once every voice is gone
+        engine.render(buffer, 256);
+        for (size_t i = 0; i < 256; ++i) {
+            assert(buffer.get_sample(0, i) == 0.0f && buffer.get_sample(1, i) == 0.0f);
+        }
+    }
+
+    std::cout << "  - Compaction: OK" << std::endl;
+
+    // Test voice stealing: the quietest releasing voice, else the oldest
+    {
+        gw::core::VoiceEngineSettings settings;
+        settings.max_voices = 16;
+        settings.release_ms = 1000.0f;
+        gw::core::VoiceEngine engine(settings);
+        engine.prepare(SAMPLE_RATE, 256, 2);
+
+        for (size_t n = 0; n < 16; ++n) {
+            engine.note_on(static_cast<float>(40 + n), 1.0f);
+        }
+        gw::core::AudioBuffer buffer(2, 256);
+        render_blocks(engine, buffer, 2);
+
+        engine.note_off(45.0f);
+        render_blocks(engine, buffer, 1);
+        engine.note_on(80.0f, 1.0f);
+
+        assert(engine.get_voices_stolen() == 1);
+        assert(engine.get_num_active_voices() == 16);
+        assert(engine.get_voice_note(5) == 46.0f);
+        assert(engine.get_voice_note(15) == 80.0f);
+
+        // No voice is releasing now: the oldest goes
+        engine.note_on(81.0f, 1.0f);
+        assert(engine.get_voices_stolen() == 2);
+        assert(engine.get_voice_note(0) == 41.0f);
+        assert(engine.get_voice_note(15) == 81.0f);
+    }
+
+    std::cout << "  - Voice stealing: OK" << std::endl;
+
+    // Test a full 256-voice load stays finite and bounded
+    {
+        gw::core::VoiceEngineSettings settings;
+        settings.gain = 1.0f / 256.0f;
+        gw::core::VoiceEngine engine(settings);
+        engine.prepare(SAMPLE_RATE, 512, 2);
+
+        for (size_t n = 0; n < 256; ++n) {
+            engine.note_on(24.0f + static_cast<float>(n % 96), 1.0f, static_cast<float>(n % 5) * 0.5f - 1.0f);
+        }
+        assert(engine.get_num_active_voices() == 256);
+
+        gw::core::AudioBuffer buffer(2, 512);
+        for (size_t b = 0; b < 20; ++b) {
+            engine.render(buffer, 512);
+            for (size_t ch = 0; ch < 2; ++ch) {
+                for (size_t i = 0; i < 512; ++i) {
+                    const float sample = buffer.get_sample(ch, i);
+                    assert(std::isfinite(sample) && std::abs(sample) <= 1.0f);
+                }
+            }
+        }
+    }
+
+    std::cout << "  - Full polyphony: OK" << std::endl;
+}